@@ -169,8 +169,9 @@ SolveSummary AMRLaplaceSolver::Run(
     const ParsedConfig parsed = ParseConfig(config, max_boundary_attribute);
 
 #if defined(MFEM_USE_MPI)
+    ProfiledPhase phase(context.profiler, "fe_space_setup");
     mesh.EnsureNCMesh();
-    mfem::ParMesh pmesh(MPI_COMM_WORLD, mesh);
+    mfem::ParMesh &pmesh = context.mesh_distributor.Distribute(mesh);
     const int sdim = pmesh.SpaceDimension();
 
     mfem::H1_FECollection fec(1, dim);
@@ -233,10 +234,12 @@ SolveSummary AMRLaplaceSolver::Run(
     int final_linear_iterations = 0;
     int amr_iterations_completed = 0;
     std::string stop_reason = "max_iterations";
+    phase.End();
 
     for (int iteration = 0; iteration < parsed.max_iterations; ++iteration)
     {
         const HYPRE_BigInt global_dofs = fespace.GlobalTrueVSize();
+        context.profiler.RecordDofs("solution", global_dofs);
         if (global_dofs >= static_cast<HYPRE_BigInt>(parsed.max_dofs))
         {
             stop_reason = "max_dofs";
@@ -254,6 +257,7 @@ SolveSummary AMRLaplaceSolver::Run(
             fespace.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
         }
 
+        ProfiledPhase step_phase(context.profiler, "assembly");
         b.Assemble();
         a.Assemble();
 
@@ -280,9 +284,11 @@ SolveSummary AMRLaplaceSolver::Run(
         );
         X_hypre = 0.0;
 
+        step_phase.Switch("preconditioner_setup");
         mfem::HypreBoomerAMG amg(A_hypre);
         amg.SetPrintLevel(0);
 
+        step_phase.Switch("solve");
         mfem::HyprePCG pcg(A_hypre);
         pcg.SetTol(1.0e-6);
         pcg.SetAbsTol(0.0);
@@ -314,10 +320,12 @@ SolveSummary AMRLaplaceSolver::Run(
 
         int linear_iterations = 0;
         pcg.GetNumIterations(linear_iterations);
+        context.profiler.RecordLinearSolve("pcg", linear_iterations);
 
         final_energy = 0.5 * mfem::InnerProduct(fespace.GetComm(), X, B);
         final_linear_iterations = linear_iterations;
         final_residual_norm = std::sqrt(mfem::InnerProduct(fespace.GetComm(), residual, residual));
+        step_phase.Switch("error_estimation");
         (void)estimator.GetLocalErrors();
         final_total_error = estimator.GetTotalError();
         amr_iterations_completed = iteration + 1;
@@ -337,6 +345,7 @@ SolveSummary AMRLaplaceSolver::Run(
             break;
         }
 
+        step_phase.Switch("refinement");
         refiner.Apply(pmesh);
         if (refiner.Stop())
         {
@@ -349,7 +358,9 @@ SolveSummary AMRLaplaceSolver::Run(
         a.Update();
         b.Update();
     }
+    context.profiler.SetCounter("amr_iterations", amr_iterations_completed);
 
+    phase.Switch("output");
     const fs::path vtk_path(context.vtk_path);
     const std::string collection_name = vtk_path.stem().empty() ? "solution" : vtk_path.stem().string();
     const std::string output_dir = vtk_path.has_parent_path()
@@ -357,7 +368,7 @@ SolveSummary AMRLaplaceSolver::Run(
         : context.working_directory;
     fs::create_directories(output_dir);
 
-    mfem::ParaViewDataCollection paraview(collection_name, &pmesh);
+    ProbedDataCollection paraview(collection_name, &pmesh, context.probes);
     paraview.SetPrefixPath(output_dir);
     paraview.SetLevelsOfDetail(1);
     paraview.SetDataFormat(mfem::VTKFormat::ASCII);
@@ -366,8 +377,11 @@ SolveSummary AMRLaplaceSolver::Run(
     paraview.SetTime(static_cast<double>(amr_iterations_completed));
     paraview.Save();
 
-    std::ofstream vtk_stub(context.vtk_path);
-    vtk_stub << "# AMR Laplace field written to " << collection_name << ".pvd\n";
+    if (context.probes.FieldOutput())
+    {
+        std::ofstream vtk_stub(context.vtk_path);
+        vtk_stub << "# AMR Laplace field written to " << collection_name << ".pvd\n";
+    }
 
     const fs::path metadata_path = fs::path(context.working_directory) / "amr_laplace.json";
     json metadata = {
@@ -386,6 +400,7 @@ SolveSummary AMRLaplaceSolver::Run(
         throw std::runtime_error("Unable to write amr_laplace.json.");
     }
     metadata_out << metadata.dump(2);
+    phase.End();
 
     SolveSummary summary;
     summary.energy = final_energy;
@@ -3,6 +3,7 @@
 // Uses MFEM (BSD-3-Clause). See THIRD_PARTY_NOTICES.md.
 
 #include "AcousticWave.hpp"
+#include "ExplicitNewmark.hpp"
 
 #include <algorithm>
 #include <cctype>
@@ -44,6 +45,20 @@ double require_positive_number(const json &config, const char *field_name)
 }
 
 #if defined(MFEM_USE_MPI)
+// Row-sum lumped mass of a nodal H1 space, as the diagonal of the assembled
+// lumped form.
+mfem::Vector assemble_lumped_mass(mfem::ParFiniteElementSpace &fespace)
+{
+    mfem::ParBilinearForm lumped_form(&fespace);
+    lumped_form.AddDomainIntegrator(new mfem::LumpedIntegrator(new mfem::MassIntegrator()));
+    lumped_form.Assemble(0);
+    lumped_form.Finalize(0);
+    std::unique_ptr<mfem::HypreParMatrix> lumped(lumped_form.ParallelAssemble());
+    mfem::Vector diagonal(fespace.GetTrueVSize());
+    lumped->GetDiag(diagonal);
+    return diagonal;
+}
+
 class GaussianPulseCoefficient final : public mfem::Coefficient
 {
 public:
@@ -240,6 +255,31 @@ AcousticWaveSolver::AcousticWaveConfig AcousticWaveSolver::ParseConfig(
     parsed.dt = require_positive_number(config, "dt");
     parsed.t_final = require_positive_number(config, "t_final");
 
+    if (config.contains("time_integration"))
+    {
+        if (!config["time_integration"].is_string())
+        {
+            throw std::runtime_error("config.time_integration must be a string.");
+        }
+        parsed.time_integration = to_lower(config["time_integration"].get<std::string>());
+        if (parsed.time_integration != "implicit" && parsed.time_integration != "explicit")
+        {
+            throw std::runtime_error("config.time_integration must be implicit or explicit.");
+        }
+    }
+    if (config.contains("cfl"))
+    {
+        if (!config["cfl"].is_number())
+        {
+            throw std::runtime_error("config.cfl must be numeric.");
+        }
+        parsed.cfl = config["cfl"].get<double>();
+        if (!(parsed.cfl > 0.0 && parsed.cfl < 1.0))
+        {
+            throw std::runtime_error("config.cfl must be in (0, 1).");
+        }
+    }
+
     if (!config.contains("initial_condition") || !config["initial_condition"].is_object())
     {
         throw std::runtime_error("config.initial_condition is required and must be an object.");
@@ -337,9 +377,11 @@ SolveSummary AcousticWaveSolver::Run(
     const AcousticWaveConfig parsed = ParseConfig(config, max_boundary_attribute, dim);
 
 #if defined(MFEM_USE_MPI)
-    mfem::ParMesh pmesh(MPI_COMM_WORLD, mesh);
+    ProfiledPhase phase(context.profiler, "fe_space_setup");
+    mfem::ParMesh &pmesh = context.mesh_distributor.Distribute(mesh);
     mfem::H1_FECollection fec(1, dim);
     mfem::ParFiniteElementSpace fespace(&pmesh, &fec);
+    context.profiler.RecordDofs("acoustic_potential", fespace.GlobalTrueVSize());
 
     mfem::Array<int> ess_bdr(max_boundary_attribute);
     ess_bdr = 0;
@@ -371,10 +413,32 @@ SolveSummary AcousticWaveSolver::Run(
         rate_true.SetSubVector(ess_tdof_list, 0.0);
     }
 
+    phase.Switch("assembly");
     AcousticWaveOperator wave_operator(fespace, ess_tdof_list, parsed.wave_speed);
     mfem::NewmarkSolver ode_solver;
     ode_solver.Init(wave_operator);
 
+    const bool explicit_stepping = parsed.time_integration == "explicit";
+    std::unique_ptr<ExplicitNewmarkSolver> explicit_solver;
+    double stable_dt = 0.0;
+    if (explicit_stepping)
+    {
+        explicit_solver = std::make_unique<ExplicitNewmarkSolver>(
+            wave_operator.StiffnessMatrix(),
+            assemble_lumped_mass(fespace),
+            mfem::Vector(),
+            ess_tdof_list);
+        stable_dt = explicit_solver->StableTimeStep(parsed.cfl);
+        if (!(stable_dt > 0.0))
+        {
+            throw std::runtime_error("Unable to estimate a stable explicit time step.");
+        }
+        explicit_solver->Init(potential_true, rate_true);
+        context.profiler.SetCounter("cfl_dt", stable_dt);
+    }
+    long long explicit_substeps = 0;
+
+    phase.Switch("output");
     const fs::path vtk_path(context.vtk_path);
     const std::string collection_name = vtk_path.stem().empty() ? "solution" : vtk_path.stem().string();
     const std::string output_dir = vtk_path.has_parent_path()
@@ -382,7 +446,7 @@ SolveSummary AcousticWaveSolver::Run(
         : context.working_directory;
     fs::create_directories(output_dir);
 
-    mfem::ParaViewDataCollection paraview(collection_name, &pmesh);
+    ProbedDataCollection paraview(collection_name, &pmesh, context.probes);
     paraview.SetPrefixPath(output_dir);
     paraview.SetLevelsOfDetail(1);
     paraview.SetDataFormat(mfem::VTKFormat::ASCII);
@@ -401,21 +465,53 @@ SolveSummary AcousticWaveSolver::Run(
     int step = 0;
     save_step(step, time);
 
+    phase.Switch("solve");
     while (time + 1.0e-12 < parsed.t_final)
     {
         mfem::real_t step_dt = std::min(parsed.dt, parsed.t_final - time);
-        ode_solver.Step(potential_true, rate_true, time, step_dt);
+        if (explicit_stepping)
+        {
+            // Output stays on the dt grid; the explicit steps in between are
+            // equal and no longer than the CFL limit.
+            const int substeps = std::max(1, static_cast<int>(std::ceil(step_dt / stable_dt - 1.0e-12)));
+            const double substep_dt = step_dt / substeps;
+            for (int substep = 0; substep < substeps; ++substep)
+            {
+                explicit_solver->Step(potential_true, rate_true, substep_dt);
+            }
+            explicit_substeps += substeps;
+            time += step_dt;
+        }
+        else
+        {
+            const int iterations_before = wave_operator.TotalImplicitIterations();
+            ode_solver.Step(potential_true, rate_true, time, step_dt);
+            context.profiler.RecordLinearSolve(
+                "implicit_cg",
+                wave_operator.TotalImplicitIterations() - iterations_before);
+        }
         if (ess_tdof_list.Size() > 0)
         {
             potential_true.SetSubVector(ess_tdof_list, 0.0);
             rate_true.SetSubVector(ess_tdof_list, 0.0);
         }
         ++step;
+        ProfiledPhase output_phase(context.profiler, "output");
         save_step(step, time);
     }
+    phase.End();
+    context.profiler.SetCounter("time_steps", step);
+    if (explicit_stepping)
+    {
+        context.profiler.SetCounter("explicit_substeps", static_cast<double>(explicit_substeps));
+        context.profiler.SetCounter("stiffness_matvecs", explicit_solver->StiffnessMatVecs());
+    }
 
-    std::ofstream vtk_stub(context.vtk_path);
-    vtk_stub << "# acoustic fields written to " << collection_name << ".pvd\n";
+    if (context.probes.FieldOutput())
+    {
+        std::ofstream vtk_stub(context.vtk_path);
+        vtk_stub << "# acoustic fields written to " << collection_name << ".pvd\n";
+    }
 
     mfem::Vector mass_rate(rate_true.Size());
     wave_operator.MassMatrix().Mult(rate_true, mass_rate);
@@ -29,6 +29,11 @@ private:
         double dt = 0.001;
         double t_final = 0.5;
         double initial_amplitude = 1.0;
+        // implicit: Newmark on the consistent mass. explicit: central
+        // differences on a lumped mass, sub-stepped at cfl times the
+        // stability limit within each dt.
+        std::string time_integration = "implicit";
+        double cfl = 0.8;
         std::vector<double> initial_center;
         std::vector<int> rigid_wall_marker;
     };
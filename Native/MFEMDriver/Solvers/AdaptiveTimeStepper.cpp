@@ -0,0 +1,291 @@
+// SPDX-License-Identifier: MIT
+// AutoSage MFEM driver extension.
+// Uses MFEM (BSD-3-Clause). See THIRD_PARTY_NOTICES.md.
+
+#include "AdaptiveTimeStepper.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using json = nlohmann::json;
+
+namespace
+{
+// Smallest factor a rejected step is cut by.
+constexpr double kMinShrink = 0.2;
+
+void read_number(const json &time_stepping, const char *key, double lower_bound, bool inclusive, double &value)
+{
+    if (!time_stepping.contains(key))
+    {
+        return;
+    }
+    const std::string field = std::string("config.time_stepping.") + key;
+    if (!time_stepping[key].is_number())
+    {
+        throw std::runtime_error(field + " must be numeric.");
+    }
+    const double parsed = time_stepping[key].get<double>();
+    if (!std::isfinite(parsed) || (inclusive ? parsed < lower_bound : parsed <= lower_bound))
+    {
+        std::ostringstream message;
+        message << field << " must be " << (inclusive ? ">= " : "> ") << lower_bound << ".";
+        throw std::runtime_error(message.str());
+    }
+    value = parsed;
+}
+
+void read_integer(const json &time_stepping, const char *key, int lower_bound, int &value)
+{
+    if (!time_stepping.contains(key))
+    {
+        return;
+    }
+    const std::string field = std::string("config.time_stepping.") + key;
+    if (!time_stepping[key].is_number_integer())
+    {
+        throw std::runtime_error(field + " must be an integer.");
+    }
+    const int parsed = time_stepping[key].get<int>();
+    if (parsed < lower_bound)
+    {
+        throw std::runtime_error(field + " must be >= " + std::to_string(lower_bound) + ".");
+    }
+    value = parsed;
+}
+} // namespace
+
+namespace autosage
+{
+TimeStepSettings ParseTimeStepSettings(const json &config)
+{
+    TimeStepSettings settings;
+    if (!config.contains("time_stepping"))
+    {
+        return settings;
+    }
+    const json &time_stepping = config["time_stepping"];
+    if (!time_stepping.is_object())
+    {
+        throw std::runtime_error("config.time_stepping must be an object when provided.");
+    }
+
+    if (time_stepping.contains("adaptive"))
+    {
+        if (!time_stepping["adaptive"].is_boolean())
+        {
+            throw std::runtime_error("config.time_stepping.adaptive must be a boolean.");
+        }
+        settings.adaptive = time_stepping["adaptive"].get<bool>();
+    }
+    read_number(time_stepping, "rel_tol", 0.0, false, settings.rel_tol);
+    read_number(time_stepping, "abs_tol", 0.0, false, settings.abs_tol);
+    read_number(time_stepping, "dt_min", 0.0, true, settings.dt_min);
+    read_number(time_stepping, "dt_max", 0.0, true, settings.dt_max);
+    read_number(time_stepping, "safety", 0.0, false, settings.safety);
+    read_number(time_stepping, "max_growth", 1.0, false, settings.max_growth);
+    read_number(time_stepping, "dt_rebuild_band", 0.0, true, settings.dt_rebuild_band);
+    read_integer(time_stepping, "max_rejections", 1, settings.max_rejections);
+
+    if (settings.safety > 1.0)
+    {
+        throw std::runtime_error("config.time_stepping.safety must be <= 1.");
+    }
+    if (settings.dt_rebuild_band >= 1.0)
+    {
+        throw std::runtime_error("config.time_stepping.dt_rebuild_band must be < 1.");
+    }
+    if (settings.dt_min > 0.0 && settings.dt_max > 0.0 && settings.dt_min > settings.dt_max)
+    {
+        throw std::runtime_error("config.time_stepping.dt_min must not exceed dt_max.");
+    }
+    return settings;
+}
+
+double ParseOutputIntervalTime(const json &config)
+{
+    if (!config.contains("output_interval_time"))
+    {
+        return 0.0;
+    }
+    if (!config["output_interval_time"].is_number())
+    {
+        throw std::runtime_error("config.output_interval_time must be numeric when provided.");
+    }
+    const double interval = config["output_interval_time"].get<double>();
+    if (!(interval > 0.0))
+    {
+        throw std::runtime_error("config.output_interval_time must be > 0.");
+    }
+    return interval;
+}
+
+void RecordTimeStepStatistics(SolverProfiler &profiler, const TimeStepStatistics &statistics)
+{
+    profiler.SetCounter("rejected_steps", statistics.rejected_steps);
+    profiler.SetCounter("implicit_operator_setups", statistics.operator_setups);
+    profiler.SetCounter("min_dt", statistics.min_dt);
+    profiler.SetCounter("max_dt", statistics.max_dt);
+}
+
+json TimeStepStatisticsToJson(const TimeStepSettings &settings, const TimeStepStatistics &statistics)
+{
+    return json{
+        {"adaptive", settings.adaptive},
+        {"accepted_steps", statistics.accepted_steps},
+        {"rejected_steps", statistics.rejected_steps},
+        {"operator_setups", statistics.operator_setups},
+        {"min_dt", statistics.min_dt},
+        {"max_dt", statistics.max_dt},
+        {"max_error_estimate", statistics.max_error_estimate}
+    };
+}
+
+#if defined(MFEM_USE_MPI)
+AdaptiveBackwardEuler::AdaptiveBackwardEuler(
+    MPI_Comm comm,
+    const TimeStepSettings &settings,
+    double initial_dt,
+    double t_final)
+    : comm_(comm), settings_(settings), dt_(initial_dt)
+{
+    if (settings_.dt_min <= 0.0)
+    {
+        settings_.dt_min = 1.0e-6 * initial_dt;
+    }
+    if (settings_.dt_max <= 0.0)
+    {
+        settings_.dt_max = t_final;
+    }
+    if (settings_.adaptive)
+    {
+        dt_ = std::min(std::max(dt_, settings_.dt_min), settings_.dt_max);
+    }
+}
+
+void AdaptiveBackwardEuler::Init(mfem::TimeDependentOperator &op)
+{
+    op_ = &op;
+    slope_.SetSize(op.Height());
+    k_.SetSize(op.Height());
+    have_slope_ = false;
+
+    double local_size = static_cast<double>(op.Height());
+    MPI_Allreduce(&local_size, &global_size_, 1, MPI_DOUBLE, MPI_SUM, comm_);
+}
+
+double AdaptiveBackwardEuler::Step(mfem::Vector &x, double &t, double t_final)
+{
+    if (!settings_.adaptive)
+    {
+        const double dt = std::min(dt_, t_final - t);
+        Solve(x, t, dt);
+        x.Add(dt, k_);
+        t += dt;
+        CountStep(dt);
+        return dt;
+    }
+
+    if (!have_slope_)
+    {
+        op_->SetTime(t);
+        op_->Mult(x, slope_);
+        have_slope_ = true;
+    }
+
+    for (int rejections = 0;; ++rejections)
+    {
+        // Stretch a step that nearly reaches t_final onto it instead of
+        // leaving a sliver that would cost one more operator setup, but
+        // never past dt_max.
+        const double remaining = t_final - t;
+        const bool last = remaining <= std::min(dt_ * (1.0 + settings_.dt_rebuild_band), settings_.dt_max);
+        const double dt = last ? std::min(remaining, settings_.dt_max) : dt_;
+        Solve(x, t, dt);
+
+        const double error = ErrorNorm(x, dt);
+        if (error <= 1.0)
+        {
+            x.Add(dt, k_);
+            t += dt;
+            slope_.Swap(k_);
+            CountStep(dt);
+            statistics_.max_error_estimate = std::max(statistics_.max_error_estimate, error);
+            if (!last)
+            {
+                const double factor = error > 0.0
+                    ? std::min(settings_.max_growth, settings_.safety / std::sqrt(error))
+                    : settings_.max_growth;
+                const double proposed = std::min(std::max(dt * factor, settings_.dt_min), settings_.dt_max);
+                if (std::abs(proposed - dt_) > settings_.dt_rebuild_band * dt_)
+                {
+                    dt_ = proposed;
+                }
+            }
+            return dt;
+        }
+
+        ++statistics_.rejected_steps;
+        if (rejections + 1 >= settings_.max_rejections)
+        {
+            throw std::runtime_error(
+                "Adaptive time step was rejected config.time_stepping.max_rejections times in a row at t=" +
+                std::to_string(t) + ".");
+        }
+        if (dt <= settings_.dt_min)
+        {
+            throw std::runtime_error(
+                "Adaptive time step cannot go below config.time_stepping.dt_min at t=" + std::to_string(t) + ".");
+        }
+        dt_ = std::max(dt * std::max(kMinShrink, settings_.safety / std::sqrt(error)), settings_.dt_min);
+    }
+}
+
+void AdaptiveBackwardEuler::Repeat(mfem::Vector &x, double &t)
+{
+    Solve(x, t, last_dt_);
+    x.Add(last_dt_, k_);
+    t += last_dt_;
+    slope_ = k_;
+    have_slope_ = true;
+}
+
+void AdaptiveBackwardEuler::Solve(const mfem::Vector &x, double t, double dt)
+{
+    if (dt != last_dt_)
+    {
+        ++statistics_.operator_setups;
+        last_dt_ = dt;
+    }
+    // Same convention as mfem::BackwardEulerSolver: the operator's time is
+    // the end of the step and k = f(x + dt k, t + dt).
+    op_->SetTime(t + dt);
+    op_->ImplicitSolve(dt, x, k_);
+}
+
+double AdaptiveBackwardEuler::ErrorNorm(const mfem::Vector &x, double dt) const
+{
+    double local = 0.0;
+    for (int i = 0; i < x.Size(); ++i)
+    {
+        const double next = x[i] + dt * k_[i];
+        const double scale = settings_.abs_tol + settings_.rel_tol * std::max(std::abs(x[i]), std::abs(next));
+        const double error = 0.5 * dt * (k_[i] - slope_[i]) / scale;
+        local += error * error;
+    }
+    double global = 0.0;
+    MPI_Allreduce(&local, &global, 1, MPI_DOUBLE, MPI_SUM, comm_);
+    return global_size_ > 0.0 ? std::sqrt(global / global_size_) : 0.0;
+}
+
+void AdaptiveBackwardEuler::CountStep(double dt)
+{
+    statistics_.min_dt = statistics_.accepted_steps == 0 ? dt : std::min(statistics_.min_dt, dt);
+    statistics_.max_dt = std::max(statistics_.max_dt, dt);
+    ++statistics_.accepted_steps;
+}
+#endif
+} // namespace autosage
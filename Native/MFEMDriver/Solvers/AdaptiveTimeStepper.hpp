@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: MIT
+// AutoSage MFEM driver extension.
+// Uses MFEM (BSD-3-Clause). See THIRD_PARTY_NOTICES.md.
+
+#pragma once
+
+#include "SolverProfiler.hpp"
+
+#include <mfem.hpp>
+#include <nlohmann/json.hpp>
+
+namespace autosage
+{
+// Controls for AdaptiveBackwardEuler, read from the optional
+// config.time_stepping object. config.dt is the (initial) step size.
+struct TimeStepSettings
+{
+    // Without adaptivity every step uses config.dt, as MFEM's
+    // BackwardEulerSolver does.
+    bool adaptive = false;
+    double rel_tol = 1.0e-3;
+    double abs_tol = 1.0e-6;
+    // 0 selects 1e-6 * config.dt for dt_min and t_final for dt_max.
+    double dt_min = 0.0;
+    double dt_max = 0.0;
+    double safety = 0.9;
+    double max_growth = 2.0;
+    // A proposed step within this relative distance of the current one is
+    // not taken: the step stays put so the implicit operator and its
+    // preconditioner, which solvers key on the exact dt, are reused.
+    double dt_rebuild_band = 0.2;
+    int max_rejections = 10;
+};
+
+TimeStepSettings ParseTimeStepSettings(const nlohmann::json &config);
+
+// Time-based output cadence from the optional config.output_interval_time.
+// Returns 0 when absent, which keeps output_interval_steps in charge.
+double ParseOutputIntervalTime(const nlohmann::json &config);
+
+// Decides when transient solvers write a ParaView cycle. With an interval
+// time the first step at or past each multiple of it is written, so output
+// does not depend on how many steps the controller took.
+class OutputCadence
+{
+public:
+    OutputCadence(int interval_steps, double interval_time)
+        : interval_steps_(interval_steps), interval_time_(interval_time), next_time_(interval_time)
+    {
+    }
+
+    bool Due(int step, double time, double t_final)
+    {
+        if (time + 1.0e-12 >= t_final)
+        {
+            return true;
+        }
+        if (interval_time_ <= 0.0)
+        {
+            return step % interval_steps_ == 0;
+        }
+        if (time + 1.0e-12 < next_time_)
+        {
+            return false;
+        }
+        while (next_time_ <= time + 1.0e-12)
+        {
+            next_time_ += interval_time_;
+        }
+        return true;
+    }
+
+private:
+    int interval_steps_;
+    double interval_time_;
+    double next_time_;
+};
+
+struct TimeStepStatistics
+{
+    int accepted_steps = 0;
+    int rejected_steps = 0;
+    // Distinct consecutive step sizes handed to ImplicitSolve, i.e. the
+    // number of times a solver keyed on dt rebuilt its implicit operator.
+    int operator_setups = 0;
+    double min_dt = 0.0;
+    double max_dt = 0.0;
+    double max_error_estimate = 0.0;
+};
+
+void RecordTimeStepStatistics(SolverProfiler &profiler, const TimeStepStatistics &statistics);
+nlohmann::json TimeStepStatisticsToJson(const TimeStepSettings &settings, const TimeStepStatistics &statistics);
+
+#if defined(MFEM_USE_MPI)
+// Backward Euler with an embedded error estimate. BE solves for the slope at
+// the end of the step, k = f(t + dt, x + dt k), so the trapezoidal rule
+// x + dt/2 (k_prev + k) is available from the same stages; their difference
+// dt/2 (k - k_prev) estimates the local error at no extra solve. Steps with
+// a weighted RMS error above 1 are rejected and retried smaller.
+class AdaptiveBackwardEuler
+{
+public:
+    // `t_final` is the default dt_max.
+    AdaptiveBackwardEuler(MPI_Comm comm, const TimeStepSettings &settings, double initial_dt, double t_final);
+
+    void Init(mfem::TimeDependentOperator &op);
+
+    // Advances (x, t) by one accepted step that does not pass t_final and
+    // returns its size. Throws when the step would fall below dt_min.
+    double Step(mfem::Vector &x, double &t, double t_final);
+
+    // Re-takes the last step from (x, t) with the same dt and no error
+    // control. For coupling iterations that change the operator's data.
+    void Repeat(mfem::Vector &x, double &t);
+
+    // The operator's right-hand side changed, so the stored slope no longer
+    // matches the current state; it is re-evaluated before the next step.
+    void InvalidateSlope() { have_slope_ = false; }
+
+    const TimeStepStatistics &Statistics() const { return statistics_; }
+
+private:
+    void Solve(const mfem::Vector &x, double t, double dt);
+    double ErrorNorm(const mfem::Vector &x, double dt) const;
+    void CountStep(double dt);
+
+    MPI_Comm comm_;
+    TimeStepSettings settings_;
+    mfem::TimeDependentOperator *op_ = nullptr;
+    double dt_;
+    double last_dt_ = -1.0;
+    double global_size_ = 0.0;
+    bool have_slope_ = false;
+    mfem::Vector slope_;
+    mfem::Vector k_;
+    TimeStepStatistics statistics_;
+};
+#endif
+} // namespace autosage
@@ -300,8 +300,10 @@ SolveSummary AdvectionSolver::Run(
     const int max_boundary_attribute = mesh.bdr_attributes.Size() > 0 ? mesh.bdr_attributes.Max() : 0;
     const AdvectionConfig parsed = ParseConfig(config, dim, max_boundary_attribute);
 
+    ProfiledPhase phase(context.profiler, "fe_space_setup");
     mfem::L2_FECollection fec(parsed.order, dim);
     mfem::FiniteElementSpace fespace(&mesh, &fec);
+    context.profiler.RecordDofs("concentration", fespace.GetTrueVSize());
 
     mfem::Vector velocity_vector(dim);
     velocity_vector = 0.0;
@@ -313,6 +315,7 @@ SolveSummary AdvectionSolver::Run(
 
     constexpr double alpha = -1.0;
 
+    phase.Switch("assembly");
     mfem::BilinearForm mass_form(&fespace);
     mass_form.AddDomainIntegrator(new mfem::MassIntegrator());
 
@@ -370,6 +373,7 @@ SolveSummary AdvectionSolver::Run(
     mfem::RK4Solver ode_solver;
     ode_solver.Init(evolution);
 
+    phase.Switch("output");
     const fs::path vtk_path(context.vtk_path);
     const std::string collection_name = vtk_path.stem().empty() ? "solution" : vtk_path.stem().string();
     const std::string output_dir = vtk_path.has_parent_path()
@@ -377,7 +381,7 @@ SolveSummary AdvectionSolver::Run(
         : context.working_directory;
     fs::create_directories(output_dir);
 
-    mfem::ParaViewDataCollection paraview(collection_name, &mesh);
+    ProbedDataCollection paraview(collection_name, &mesh, context.probes);
     paraview.SetPrefixPath(output_dir);
     paraview.SetLevelsOfDetail(1);
     paraview.SetDataFormat(mfem::VTKFormat::ASCII);
@@ -394,6 +398,7 @@ SolveSummary AdvectionSolver::Run(
     int step = 0;
     save_step(step, time);
 
+    phase.Switch("solve");
     while (time + 1.0e-12 < parsed.t_final)
     {
         mfem::real_t step_dt = std::min(parsed.dt, parsed.t_final - time);
@@ -402,12 +407,18 @@ SolveSummary AdvectionSolver::Run(
 
         if (step % parsed.output_interval_steps == 0 || time + 1.0e-12 >= parsed.t_final)
         {
+            ProfiledPhase output_phase(context.profiler, "output");
             save_step(step, time);
         }
     }
+    phase.End();
+    context.profiler.SetCounter("time_steps", step);
 
-    std::ofstream vtk_stub(context.vtk_path);
-    vtk_stub << "# advection field written to " << collection_name << ".pvd\n";
+    if (context.probes.FieldOutput())
+    {
+        std::ofstream vtk_stub(context.vtk_path);
+        vtk_stub << "# advection field written to " << collection_name << ".pvd\n";
+    }
 
     mfem::Vector du_dt(solution.Size());
     evolution.Mult(solution, du_dt);
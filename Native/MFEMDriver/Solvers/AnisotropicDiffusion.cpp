@@ -163,9 +163,11 @@ SolveSummary AnisotropicDiffusionSolver::Run(
     const AnisotropicConfig parsed = ParseConfig(config, max_boundary_attribute);
 
 #if defined(MFEM_USE_MPI)
-    mfem::ParMesh pmesh(MPI_COMM_WORLD, mesh);
+    ProfiledPhase phase(context.profiler, "fe_space_setup");
+    mfem::ParMesh &pmesh = context.mesh_distributor.Distribute(mesh);
     mfem::H1_FECollection fec(1, dim);
     mfem::ParFiniteElementSpace fespace(&pmesh, &fec);
+    context.profiler.RecordDofs("solution", fespace.GlobalTrueVSize());
     mfem::ParGridFunction solution(&fespace);
     solution = 0.0;
 
@@ -193,6 +195,7 @@ SolveSummary AnisotropicDiffusionSolver::Run(
         fespace.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
     }
 
+    phase.Switch("assembly");
     mfem::DenseMatrix tensor_matrix(dim);
     tensor_matrix = 0.0;
     for (int r = 0; r < dim; ++r)
@@ -251,9 +254,11 @@ SolveSummary AnisotropicDiffusionSolver::Run(
     );
     X_hypre = 0.0;
 
+    phase.Switch("preconditioner_setup");
     mfem::HypreBoomerAMG amg(A_hypre);
     amg.SetPrintLevel(0);
 
+    phase.Switch("solve");
     mfem::HyprePCG pcg(A_hypre);
     pcg.SetTol(1.0e-12);
     pcg.SetAbsTol(0.0);
@@ -283,6 +288,7 @@ SolveSummary AnisotropicDiffusionSolver::Run(
 
     stiffness.RecoverFEMSolution(X, rhs, solution);
 
+    phase.Switch("output");
     const fs::path vtk_path(context.vtk_path);
     const std::string collection_name = vtk_path.stem().empty() ? "solution" : vtk_path.stem().string();
     const std::string output_dir = vtk_path.has_parent_path()
@@ -290,7 +296,7 @@ SolveSummary AnisotropicDiffusionSolver::Run(
         : context.working_directory;
     fs::create_directories(output_dir);
 
-    mfem::ParaViewDataCollection paraview(collection_name, &pmesh);
+    ProbedDataCollection paraview(collection_name, &pmesh, context.probes);
     paraview.SetPrefixPath(output_dir);
     paraview.SetLevelsOfDetail(1);
     paraview.SetDataFormat(mfem::VTKFormat::ASCII);
@@ -299,11 +305,16 @@ SolveSummary AnisotropicDiffusionSolver::Run(
     paraview.SetTime(0.0);
     paraview.Save();
 
-    std::ofstream vtk_stub(context.vtk_path);
-    vtk_stub << "# anisotropic diffusion field written to " << collection_name << ".pvd\n";
+    if (context.probes.FieldOutput())
+    {
+        std::ofstream vtk_stub(context.vtk_path);
+        vtk_stub << "# anisotropic diffusion field written to " << collection_name << ".pvd\n";
+    }
+    phase.End();
 
     int num_iterations = 0;
     pcg.GetNumIterations(num_iterations);
+    context.profiler.RecordLinearSolve("pcg", num_iterations);
 
     SolveSummary summary;
     summary.energy = 0.5 * mfem::InnerProduct(fespace.GetComm(), X, B);
@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: MIT
+// AutoSage MFEM driver extension.
+// Uses MFEM (BSD-3-Clause). See THIRD_PARTY_NOTICES.md.
+
+#include "BlockPreconditioners.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+namespace
+{
+std::string to_lower(std::string value)
+{
+    std::transform(
+        value.begin(),
+        value.end(),
+        value.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return value;
+}
+} // namespace
+
+namespace autosage
+{
+SchurApproximation ParseSchurApproximation(const std::string &name)
+{
+    const std::string normalized = to_lower(name);
+    if (normalized == "mass_jacobi")
+    {
+        return SchurApproximation::MassJacobi;
+    }
+    if (normalized == "mass_amg")
+    {
+        return SchurApproximation::MassAMG;
+    }
+    if (normalized == "mass_chebyshev")
+    {
+        return SchurApproximation::MassChebyshev;
+    }
+    if (normalized == "lsc")
+    {
+        return SchurApproximation::LeastSquaresCommutator;
+    }
+    throw std::runtime_error("Schur approximation must be mass_jacobi, mass_amg, mass_chebyshev or lsc.");
+}
+
+const char *SchurApproximationName(SchurApproximation approximation)
+{
+    switch (approximation)
+    {
+    case SchurApproximation::MassJacobi:
+        return "mass_jacobi";
+    case SchurApproximation::MassAMG:
+        return "mass_amg";
+    case SchurApproximation::MassChebyshev:
+        return "mass_chebyshev";
+    case SchurApproximation::LeastSquaresCommutator:
+        return "lsc";
+    }
+    return "unknown";
+}
+
+#if defined(MFEM_USE_MPI)
+std::unique_ptr<mfem::Solver> MakePressureMassSchurInverse(
+    SchurApproximation approximation,
+    const mfem::HypreParMatrix &scaled_mass)
+{
+    mfem::Vector diagonal(scaled_mass.GetNumRows());
+    scaled_mass.GetDiag(diagonal);
+    const mfem::Array<int> empty_tdof_list;
+
+    switch (approximation)
+    {
+    case SchurApproximation::MassJacobi:
+    {
+        auto jacobi = std::make_unique<mfem::OperatorJacobiSmoother>(diagonal, empty_tdof_list);
+        jacobi->iterative_mode = false;
+        return jacobi;
+    }
+    case SchurApproximation::MassAMG:
+    {
+        auto amg = std::make_unique<mfem::HypreBoomerAMG>(scaled_mass);
+        amg->SetPrintLevel(0);
+        return amg;
+    }
+    case SchurApproximation::MassChebyshev:
+    {
+        // The Jacobi-scaled mass matrix has a spectrum bounded independently of
+        // h, so a fixed low order is enough for a spectrally equivalent solve.
+        auto chebyshev = std::make_unique<mfem::OperatorChebyshevSmoother>(
+            scaled_mass,
+            diagonal,
+            empty_tdof_list,
+            3,
+            scaled_mass.GetComm());
+        chebyshev->iterative_mode = false;
+        return chebyshev;
+    }
+    case SchurApproximation::LeastSquaresCommutator:
+        break;
+    }
+    throw std::runtime_error("lsc is not a pressure-mass Schur approximation.");
+}
+
+LeastSquaresCommutatorInverse::LeastSquaresCommutatorInverse(
+    const mfem::HypreParMatrix &divergence,
+    const mfem::Operator &velocity_operator,
+    const mfem::Vector &velocity_mass_diagonal)
+    : mfem::Solver(divergence.Height()),
+      divergence_(divergence),
+      velocity_operator_(&velocity_operator),
+      inverse_mass_diagonal_(velocity_mass_diagonal.Size()),
+      pressure_work_(divergence.Height()),
+      velocity_work_(divergence.Width()),
+      velocity_image_(divergence.Width())
+{
+    for (int i = 0; i < velocity_mass_diagonal.Size(); ++i)
+    {
+        inverse_mass_diagonal_[i] = 1.0 / velocity_mass_diagonal[i];
+    }
+
+    std::unique_ptr<mfem::HypreParMatrix> scaled_gradient(divergence.Transpose());
+    scaled_gradient->InvScaleRows(velocity_mass_diagonal);
+    pressure_laplacian_.reset(mfem::ParMult(&divergence, scaled_gradient.get()));
+    // Pressure dofs that only touch essential velocity dofs get a unit row.
+    pressure_laplacian_->EliminateZeroRows();
+
+    pressure_laplacian_amg_ = std::make_unique<mfem::HypreBoomerAMG>(*pressure_laplacian_);
+    pressure_laplacian_amg_->SetPrintLevel(0);
+    pressure_laplacian_amg_->iterative_mode = false;
+}
+
+void LeastSquaresCommutatorInverse::Mult(const mfem::Vector &x, mfem::Vector &y) const
+{
+    pressure_laplacian_amg_->Mult(x, pressure_work_);
+
+    divergence_.MultTranspose(pressure_work_, velocity_work_);
+    velocity_work_ *= inverse_mass_diagonal_;
+    velocity_operator_->Mult(velocity_work_, velocity_image_);
+    velocity_image_ *= inverse_mass_diagonal_;
+    divergence_.Mult(velocity_image_, pressure_work_);
+
+    pressure_laplacian_amg_->Mult(pressure_work_, y);
+}
+
+BlockUpperTriangularPreconditioner::BlockUpperTriangularPreconditioner(
+    const mfem::Array<int> &block_offsets,
+    const mfem::Operator &gradient,
+    mfem::Solver &velocity_inverse,
+    mfem::Solver &schur_inverse)
+    : mfem::Solver(block_offsets.Last()),
+      block_offsets_(block_offsets),
+      gradient_(gradient),
+      velocity_inverse_(velocity_inverse),
+      schur_inverse_(schur_inverse),
+      velocity_rhs_(block_offsets[1] - block_offsets[0])
+{
+}
+
+void BlockUpperTriangularPreconditioner::Mult(const mfem::Vector &x, mfem::Vector &y) const
+{
+    const int velocity_size = block_offsets_[1] - block_offsets_[0];
+    const int pressure_size = block_offsets_[2] - block_offsets_[1];
+    const mfem::Vector x_velocity(const_cast<double *>(x.GetData()) + block_offsets_[0], velocity_size);
+    const mfem::Vector x_pressure(const_cast<double *>(x.GetData()) + block_offsets_[1], pressure_size);
+    mfem::Vector y_velocity(y.GetData() + block_offsets_[0], velocity_size);
+    mfem::Vector y_pressure(y.GetData() + block_offsets_[1], pressure_size);
+
+    schur_inverse_.Mult(x_pressure, y_pressure);
+    y_pressure.Neg();
+
+    gradient_.Mult(y_pressure, velocity_rhs_);
+    mfem::subtract(x_velocity, velocity_rhs_, velocity_rhs_);
+    velocity_inverse_.Mult(velocity_rhs_, y_velocity);
+}
+#endif
+} // namespace autosage
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: MIT
+// AutoSage MFEM driver extension.
+// Uses MFEM (BSD-3-Clause). See THIRD_PARTY_NOTICES.md.
+
+#pragma once
+
+#include <mfem.hpp>
+
+#include <memory>
+#include <string>
+
+namespace autosage
+{
+// Approximations of the inverse of the (positive) pressure Schur complement
+// B F^{-1} B^T of a saddle-point system [F B^T; B 0].
+enum class SchurApproximation
+{
+    MassJacobi,
+    MassAMG,
+    MassChebyshev,
+    LeastSquaresCommutator
+};
+
+// Accepts mass_jacobi, mass_amg, mass_chebyshev and lsc.
+SchurApproximation ParseSchurApproximation(const std::string &name);
+const char *SchurApproximationName(SchurApproximation approximation);
+
+#if defined(MFEM_USE_MPI)
+// Pressure-mass based approximations. scaled_mass is the pressure mass
+// matrix weighted by 1 / viscosity and must outlive the returned solver.
+std::unique_ptr<mfem::Solver> MakePressureMassSchurInverse(
+    SchurApproximation approximation,
+    const mfem::HypreParMatrix &scaled_mass);
+
+// Scaled least-squares commutator (Elman et al.):
+//   S^{-1} ~ (B D^{-1} B^T)^{-1} (B D^{-1} F D^{-1} B^T) (B D^{-1} B^T)^{-1}
+// with D the diagonal of the velocity mass matrix. F only needs to be an
+// Operator, so Oseen or Newton velocity blocks can be swapped in with
+// SetVelocityOperator while the pressure Laplacian AMG is kept.
+class LeastSquaresCommutatorInverse final : public mfem::Solver
+{
+public:
+    LeastSquaresCommutatorInverse(
+        const mfem::HypreParMatrix &divergence,
+        const mfem::Operator &velocity_operator,
+        const mfem::Vector &velocity_mass_diagonal);
+
+    void SetOperator(const mfem::Operator &op) override { SetVelocityOperator(op); }
+    void SetVelocityOperator(const mfem::Operator &velocity_operator) { velocity_operator_ = &velocity_operator; }
+    void Mult(const mfem::Vector &x, mfem::Vector &y) const override;
+
+private:
+    const mfem::HypreParMatrix &divergence_;
+    const mfem::Operator *velocity_operator_ = nullptr;
+    mfem::Vector inverse_mass_diagonal_;
+    std::unique_ptr<mfem::HypreParMatrix> pressure_laplacian_;
+    std::unique_ptr<mfem::HypreBoomerAMG> pressure_laplacian_amg_;
+    mutable mfem::Vector pressure_work_;
+    mutable mfem::Vector velocity_work_;
+    mutable mfem::Vector velocity_image_;
+};
+
+// Right block of [F B^T; 0 -S] for GMRES:
+//   y_p = -S^{-1} x_p,  y_u = F^{-1} (x_u - B^T y_p).
+// Both inverses are applied once per Mult, so the AMG hierarchies built for
+// the first right-hand side are reused for every later one.
+class BlockUpperTriangularPreconditioner final : public mfem::Solver
+{
+public:
+    BlockUpperTriangularPreconditioner(
+        const mfem::Array<int> &block_offsets,
+        const mfem::Operator &gradient,
+        mfem::Solver &velocity_inverse,
+        mfem::Solver &schur_inverse);
+
+    void SetOperator(const mfem::Operator &) override {}
+    void Mult(const mfem::Vector &x, mfem::Vector &y) const override;
+
+private:
+    mfem::Array<int> block_offsets_;
+    const mfem::Operator &gradient_;
+    mfem::Solver &velocity_inverse_;
+    mfem::Solver &schur_inverse_;
+    mutable mfem::Vector velocity_rhs_;
+};
+#endif
+} // namespace autosage
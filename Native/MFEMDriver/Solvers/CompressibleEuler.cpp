@@ -387,11 +387,13 @@ SolveSummary CompressibleEulerSolver::Run(
     const int max_boundary_attribute = mesh.bdr_attributes.Size() > 0 ? mesh.bdr_attributes.Max() : 0;
     const CompressibleEulerConfig parsed = ParseConfig(config, max_boundary_attribute);
 
+    ProfiledPhase phase(context.profiler, "fe_space_setup");
     const int num_equations = dim + 2;
     mfem::L2_FECollection fec(parsed.order, dim);
     mfem::FiniteElementSpace scalar_fespace(&mesh, &fec);
     mfem::FiniteElementSpace momentum_fespace(&mesh, &fec, dim, mfem::Ordering::byNODES);
     mfem::FiniteElementSpace vector_fespace(&mesh, &fec, num_equations, mfem::Ordering::byNODES);
+    context.profiler.RecordDofs("state", vector_fespace.GetTrueVSize());
 
     mfem::Vector left_conservative = conservative_state(
         parsed.left_state.density,
@@ -451,6 +453,7 @@ SolveSummary CompressibleEulerSolver::Run(
     }
     ConstantEulerBoundaryStateCoefficient slip_wall_state(boundary_state);
 
+    phase.Switch("assembly");
     DGEulerOperator euler_operator(
         vector_fespace,
         parsed.specific_heat_ratio,
@@ -484,6 +487,7 @@ SolveSummary CompressibleEulerSolver::Run(
         }
     };
 
+    phase.Switch("output");
     const fs::path vtk_path(context.vtk_path);
     const std::string collection_name = vtk_path.stem().empty() ? "solution" : vtk_path.stem().string();
     const std::string output_dir = vtk_path.has_parent_path()
@@ -491,7 +495,7 @@ SolveSummary CompressibleEulerSolver::Run(
         : context.working_directory;
     fs::create_directories(output_dir);
 
-    mfem::ParaViewDataCollection paraview(collection_name, &mesh);
+    ProbedDataCollection paraview(collection_name, &mesh, context.probes);
     paraview.SetPrefixPath(output_dir);
     paraview.SetLevelsOfDetail(1);
     paraview.SetDataFormat(mfem::VTKFormat::ASCII);
@@ -512,6 +516,7 @@ SolveSummary CompressibleEulerSolver::Run(
     int step = 0;
     save_step(step, time);
 
+    phase.Switch("solve");
     while (time + 1.0e-12 < parsed.t_final)
     {
         mfem::real_t step_dt = std::min(parsed.dt, parsed.t_final - time);
@@ -520,12 +525,18 @@ SolveSummary CompressibleEulerSolver::Run(
 
         if (step % parsed.output_interval_steps == 0 || time + 1.0e-12 >= parsed.t_final)
         {
+            ProfiledPhase output_phase(context.profiler, "output");
             save_step(step, time);
         }
     }
+    phase.End();
+    context.profiler.SetCounter("time_steps", step);
 
-    std::ofstream vtk_stub(context.vtk_path);
-    vtk_stub << "# compressible Euler fields written to " << collection_name << ".pvd\n";
+    if (context.probes.FieldOutput())
+    {
+        std::ofstream vtk_stub(context.vtk_path);
+        vtk_stub << "# compressible Euler fields written to " << collection_name << ".pvd\n";
+    }
 
     mfem::ConstantCoefficient one(1.0);
     mfem::LinearForm domain_integral(&scalar_fespace);
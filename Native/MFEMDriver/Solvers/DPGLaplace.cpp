@@ -169,7 +169,8 @@ SolveSummary DPGLaplaceSolver::Run(
     const ParsedConfig parsed = ParseConfig(config, max_boundary_attribute);
 
 #if defined(MFEM_USE_MPI)
-    mfem::ParMesh pmesh(MPI_COMM_WORLD, mesh);
+    ProfiledPhase phase(context.profiler, "fe_space_setup");
+    mfem::ParMesh &pmesh = context.mesh_distributor.Distribute(mesh);
 
     const unsigned int trial_order = static_cast<unsigned int>(parsed.order);
     const unsigned int trace_order = trial_order > 0 ? (trial_order - 1u) : 0u;
@@ -187,7 +188,11 @@ SolveSummary DPGLaplaceSolver::Run(
     mfem::ParFiniteElementSpace x0_space(&pmesh, &x0_fec);
     mfem::ParFiniteElementSpace xhat_space(&pmesh, &xhat_fec);
     mfem::ParFiniteElementSpace test_space(&pmesh, &test_fec);
+    context.profiler.RecordDofs("trial", x0_space.GlobalTrueVSize());
+    context.profiler.RecordDofs("trace", xhat_space.GlobalTrueVSize());
+    context.profiler.RecordDofs("test", test_space.GlobalTrueVSize());
 
+    phase.Switch("assembly");
     mfem::ConstantCoefficient diffusion_coeff(parsed.coefficient);
     mfem::ConstantCoefficient source_coeff(parsed.source_term);
     mfem::ConstantCoefficient one_coeff(1.0);
@@ -291,6 +296,7 @@ SolveSummary DPGLaplaceSolver::Run(
         B.MultTranspose(sinv_f, b);
     }
 
+    phase.Switch("preconditioner_setup");
     std::unique_ptr<mfem::HypreBoomerAMG> s0_inverse =
         std::make_unique<mfem::HypreBoomerAMG>(*matS0);
     s0_inverse->SetPrintLevel(0);
@@ -318,6 +324,7 @@ SolveSummary DPGLaplaceSolver::Run(
     preconditioner.SetDiagonalBlock(0, s0_inverse.get());
     preconditioner.SetDiagonalBlock(1, shat_inverse.get());
 
+    phase.Switch("solve");
     mfem::CGSolver pcg(MPI_COMM_WORLD);
     pcg.SetOperator(A);
     pcg.SetPreconditioner(preconditioner);
@@ -326,6 +333,7 @@ SolveSummary DPGLaplaceSolver::Run(
     pcg.SetMaxIter(500);
     pcg.SetPrintLevel(0);
     pcg.Mult(b, x);
+    context.profiler.RecordLinearSolve("cg", pcg.GetNumIterations());
 
     mfem::HypreParVector residual(&test_space);
     mfem::HypreParVector weighted_residual(&test_space);
@@ -342,6 +350,7 @@ SolveSummary DPGLaplaceSolver::Run(
 
     x0.Distribute(x.GetBlock(x0_var));
 
+    phase.Switch("output");
     const fs::path vtk_path(context.vtk_path);
     const std::string collection_name = vtk_path.stem().empty() ? "solution" : vtk_path.stem().string();
     const std::string output_dir = vtk_path.has_parent_path()
@@ -349,7 +358,7 @@ SolveSummary DPGLaplaceSolver::Run(
         : context.working_directory;
     fs::create_directories(output_dir);
 
-    mfem::ParaViewDataCollection paraview(collection_name, &pmesh);
+    ProbedDataCollection paraview(collection_name, &pmesh, context.probes);
     paraview.SetPrefixPath(output_dir);
     paraview.SetLevelsOfDetail(1);
     paraview.SetDataFormat(mfem::VTKFormat::ASCII);
@@ -358,12 +367,16 @@ SolveSummary DPGLaplaceSolver::Run(
     paraview.SetTime(0.0);
     paraview.Save();
 
-    std::ofstream vtk_stub(context.vtk_path);
-    if (!vtk_stub)
+    if (context.probes.FieldOutput())
     {
-        throw std::runtime_error("Unable to write solution.vtk stub for DPGLaplace.");
+        std::ofstream vtk_stub(context.vtk_path);
+        if (!vtk_stub)
+        {
+            throw std::runtime_error("Unable to write solution.vtk stub for DPGLaplace.");
+        }
+        vtk_stub << "# DPG Laplace field written to " << collection_name << ".pvd\n";
     }
-    vtk_stub << "# DPG Laplace field written to " << collection_name << ".pvd\n";
+    phase.End();
 
     SolveSummary summary;
     summary.energy = 0.5 * mfem::InnerProduct(x, b);
@@ -4,6 +4,8 @@
 
 #include "DarcyFlow.hpp"
 
+#include "DarcyHybridization.hpp"
+
 #include <algorithm>
 #include <cctype>
 #include <cmath>
@@ -119,6 +121,19 @@ DarcyFlowSolver::DarcyConfig DarcyFlowSolver::ParseConfig(
         throw std::runtime_error("config.bcs must include at least one fixed_pressure boundary condition.");
     }
 
+    if (config.contains("formulation"))
+    {
+        if (!config["formulation"].is_string())
+        {
+            throw std::runtime_error("config.formulation must be a string when provided.");
+        }
+        parsed.formulation = to_lower(config["formulation"].get<std::string>());
+        if (parsed.formulation != "mixed" && parsed.formulation != "hybridized")
+        {
+            throw std::runtime_error("config.formulation must be mixed or hybridized.");
+        }
+    }
+
     return parsed;
 }
 
@@ -131,13 +146,16 @@ SolveSummary DarcyFlowSolver::Run(
     const int max_boundary_attribute = mesh.bdr_attributes.Size() > 0 ? mesh.bdr_attributes.Max() : 0;
 
 #if defined(MFEM_USE_MPI)
-    mfem::ParMesh pmesh(MPI_COMM_WORLD, mesh);
+    ProfiledPhase phase(context.profiler, "fe_space_setup");
+    mfem::ParMesh &pmesh = context.mesh_distributor.Distribute(mesh);
     const DarcyConfig parsed = ParseConfig(config, max_boundary_attribute);
 
     mfem::RT_FECollection velocity_collection(1, dim);
     mfem::L2_FECollection pressure_collection(1, dim);
     mfem::ParFiniteElementSpace velocity_space(&pmesh, &velocity_collection);
     mfem::ParFiniteElementSpace pressure_space(&pmesh, &pressure_collection);
+    context.profiler.RecordDofs("velocity", velocity_space.GlobalTrueVSize());
+    context.profiler.RecordDofs("pressure", pressure_space.GlobalTrueVSize());
 
     mfem::Array<int> velocity_ess_bdr(max_boundary_attribute);
     velocity_ess_bdr = 0;
@@ -151,6 +169,7 @@ SolveSummary DarcyFlowSolver::Run(
         velocity_space.GetEssentialTrueDofs(velocity_ess_bdr, velocity_ess_tdof_list);
     }
 
+    phase.Switch("assembly");
     mfem::ParBilinearForm mass_form(&velocity_space);
     mfem::ConstantCoefficient inv_permeability_coeff(1.0 / parsed.permeability);
     mass_form.AddDomainIntegrator(new mfem::VectorFEMassIntegrator(inv_permeability_coeff));
@@ -228,46 +247,88 @@ SolveSummary DarcyFlowSolver::Run(
     darcy_operator.SetBlock(0, 1, transpose_b);
     darcy_operator.SetBlock(1, 0, divergence_matrix);
 
-    mfem::Vector mass_diag(mass_matrix->GetNumRows());
-    mass_matrix->GetDiag(mass_diag);
-
-    auto *minv_bt = divergence_matrix->Transpose();
-    minv_bt->InvScaleRows(mass_diag);
-    auto *schur_approx = mfem::ParMult(divergence_matrix, minv_bt);
-    schur_approx->EliminateZeroRows();
-
-    mfem::Vector schur_diag(schur_approx->GetNumRows());
-    schur_approx->GetDiag(schur_diag);
-    const mfem::Array<int> empty_schur_tdof_list;
-
-    auto *inv_mass = new mfem::OperatorJacobiSmoother(mass_diag, velocity_ess_tdof_list);
-    auto *inv_schur = new mfem::OperatorJacobiSmoother(schur_diag, empty_schur_tdof_list);
-    inv_mass->iterative_mode = false;
-    inv_schur->iterative_mode = false;
-
-    mfem::BlockDiagonalPreconditioner darcy_preconditioner(block_true_offsets);
-    darcy_preconditioner.SetDiagonalBlock(0, inv_mass);
-    darcy_preconditioner.SetDiagonalBlock(1, inv_schur);
-
     mfem::BlockVector true_solution(block_true_offsets);
     true_solution = 0.0;
-
-    mfem::MINRESSolver solver(MPI_COMM_WORLD);
-    solver.SetAbsTol(1.0e-10);
-    solver.SetRelTol(1.0e-6);
-    solver.SetMaxIter(500);
-    solver.SetPrintLevel(0);
-    solver.SetOperator(darcy_operator);
-    solver.SetPreconditioner(darcy_preconditioner);
-    solver.Mult(true_rhs, true_solution);
-
     mfem::ParGridFunction velocity(&velocity_space);
     mfem::ParGridFunction pressure(&pressure_space);
     velocity = 0.0;
     pressure = 0.0;
-    velocity.Distribute(&(true_solution.GetBlock(0)));
-    pressure.Distribute(&(true_solution.GetBlock(1)));
 
+    const bool hybridized = parsed.formulation == "hybridized";
+    int iterations = 0;
+    bool converged = false;
+    HYPRE_BigInt trace_true_dofs = 0;
+    if (hybridized)
+    {
+        // The mixed blocks above are kept to report the residual of the
+        // original saddle-point system for the recovered solution.
+        std::vector<double> boundary_pressure(max_boundary_attribute, 0.0);
+        for (const PressureBoundary &boundary : parsed.fixed_pressure_boundaries)
+        {
+            boundary_pressure[boundary.attribute - 1] = boundary.value;
+        }
+
+        DarcyHybridization hybridization(pmesh, velocity_space, pressure_space, 1);
+        hybridization.Assemble(
+            inv_permeability_coeff,
+            pressure_rhs_form,
+            parsed.no_flow_marker,
+            boundary_pressure);
+        trace_true_dofs = hybridization.GlobalTraceSize();
+        context.profiler.RecordDofs("trace", trace_true_dofs);
+
+        phase.Switch("solve");
+        converged = hybridization.Solve(1.0e-8, 1.0e-12, 500);
+        iterations = hybridization.Iterations();
+        context.profiler.RecordLinearSolve("hybridized_cg", iterations);
+
+        phase.Switch("local_recovery");
+        hybridization.RecoverSolution(velocity, pressure);
+        velocity.ParallelProject(true_solution.GetBlock(0));
+        pressure.ParallelProject(true_solution.GetBlock(1));
+    }
+    else
+    {
+        phase.Switch("preconditioner_setup");
+        mfem::Vector mass_diag(mass_matrix->GetNumRows());
+        mass_matrix->GetDiag(mass_diag);
+
+        std::unique_ptr<mfem::HypreParMatrix> minv_bt(divergence_matrix->Transpose());
+        minv_bt->InvScaleRows(mass_diag);
+        std::unique_ptr<mfem::HypreParMatrix> schur_approx(mfem::ParMult(divergence_matrix, minv_bt.get()));
+        schur_approx->EliminateZeroRows();
+
+        mfem::Vector schur_diag(schur_approx->GetNumRows());
+        schur_approx->GetDiag(schur_diag);
+        const mfem::Array<int> empty_schur_tdof_list;
+
+        mfem::OperatorJacobiSmoother inv_mass(mass_diag, velocity_ess_tdof_list);
+        mfem::OperatorJacobiSmoother inv_schur(schur_diag, empty_schur_tdof_list);
+        inv_mass.iterative_mode = false;
+        inv_schur.iterative_mode = false;
+
+        mfem::BlockDiagonalPreconditioner darcy_preconditioner(block_true_offsets);
+        darcy_preconditioner.SetDiagonalBlock(0, &inv_mass);
+        darcy_preconditioner.SetDiagonalBlock(1, &inv_schur);
+
+        phase.Switch("solve");
+        mfem::MINRESSolver solver(MPI_COMM_WORLD);
+        solver.SetAbsTol(1.0e-10);
+        solver.SetRelTol(1.0e-6);
+        solver.SetMaxIter(500);
+        solver.SetPrintLevel(0);
+        solver.SetOperator(darcy_operator);
+        solver.SetPreconditioner(darcy_preconditioner);
+        solver.Mult(true_rhs, true_solution);
+        iterations = solver.GetNumIterations();
+        converged = solver.GetConverged();
+        context.profiler.RecordLinearSolve("minres", iterations);
+
+        velocity.Distribute(&(true_solution.GetBlock(0)));
+        pressure.Distribute(&(true_solution.GetBlock(1)));
+    }
+
+    phase.Switch("output");
     const fs::path vtk_path(context.vtk_path);
     const std::string collection_name = vtk_path.stem().empty() ? "solution" : vtk_path.stem().string();
     const std::string output_dir = vtk_path.has_parent_path()
@@ -275,7 +336,7 @@ SolveSummary DarcyFlowSolver::Run(
         : context.working_directory;
     fs::create_directories(output_dir);
 
-    mfem::ParaViewDataCollection paraview(collection_name, &pmesh);
+    ProbedDataCollection paraview(collection_name, &pmesh, context.probes);
     paraview.SetPrefixPath(output_dir);
     paraview.SetLevelsOfDetail(1);
     paraview.SetDataFormat(mfem::VTKFormat::ASCII);
@@ -285,8 +346,12 @@ SolveSummary DarcyFlowSolver::Run(
     paraview.SetTime(0.0);
     paraview.Save();
 
-    std::ofstream vtk_stub(context.vtk_path);
-    vtk_stub << "# Darcy velocity/pressure written to " << collection_name << ".pvd\n";
+    if (context.probes.FieldOutput())
+    {
+        std::ofstream vtk_stub(context.vtk_path);
+        vtk_stub << "# Darcy velocity/pressure written to " << collection_name << ".pvd\n";
+    }
+    phase.End();
 
     mfem::Vector residual(true_rhs.Size());
     darcy_operator.Mult(true_solution, residual);
@@ -294,16 +359,36 @@ SolveSummary DarcyFlowSolver::Run(
 
     SolveSummary summary;
     summary.energy = 0.5 * mfem::InnerProduct(true_solution, true_rhs);
-    summary.iterations = solver.GetNumIterations();
+    summary.iterations = iterations;
     summary.error_norm = residual.Norml2();
     summary.dimension = dim;
 
-    delete inv_schur;
-    delete inv_mass;
-    delete schur_approx;
-    delete minv_bt;
     delete transpose_b;
 
+    const fs::path metadata_path = fs::path(context.working_directory) / "darcy_flow.json";
+    json metadata = {
+        {"solver_class", "DarcyFlow"},
+        {"solver_backend", hybridized ? "hybridized_cg_amg" : "minres_block_jacobi"},
+        {"formulation", parsed.formulation},
+        {"permeability", parsed.permeability},
+        {"source_term", parsed.source_term},
+        {"velocity_true_dofs", velocity_space.GlobalTrueVSize()},
+        {"pressure_true_dofs", pressure_space.GlobalTrueVSize()},
+        {"iterations", summary.iterations},
+        {"converged", converged},
+        {"residual_norm", summary.error_norm}
+    };
+    if (hybridized)
+    {
+        metadata["trace_true_dofs"] = trace_true_dofs;
+    }
+    std::ofstream metadata_out(metadata_path);
+    if (!metadata_out)
+    {
+        throw std::runtime_error("Unable to write darcy_flow.json.");
+    }
+    metadata_out << metadata.dump(2);
+
     return summary;
 #else
     (void)mesh;
@@ -35,6 +35,7 @@ private:
         double source_term = 0.0;
         std::vector<int> no_flow_marker;
         std::vector<PressureBoundary> fixed_pressure_boundaries;
+        std::string formulation = "mixed";
     };
 
     DarcyConfig ParseConfig(const nlohmann::json &config, int max_boundary_attribute) const;
@@ -0,0 +1,273 @@
+// SPDX-License-Identifier: MIT
+// AutoSage MFEM driver extension.
+// Uses MFEM (BSD-3-Clause). See THIRD_PARTY_NOTICES.md.
+
+#include "DarcyHybridization.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace autosage
+{
+#if defined(MFEM_USE_MPI)
+DarcyHybridization::DarcyHybridization(
+    mfem::ParMesh &mesh,
+    mfem::ParFiniteElementSpace &velocity_space,
+    mfem::ParFiniteElementSpace &pressure_space,
+    int order)
+    : mesh_(mesh),
+      velocity_space_(velocity_space),
+      pressure_space_(pressure_space),
+      trace_collection_(order, mesh.Dimension()),
+      trace_space_(&mesh, &trace_collection_),
+      trace_matrix_(mfem::Operator::Hypre_ParCSR)
+{
+    // Shared-face transformations need the neighbor element data.
+    mesh_.ExchangeFaceNbrData();
+}
+
+void DarcyHybridization::AddFaceCoupling(
+    int element,
+    int face,
+    int row_offset,
+    const mfem::FiniteElement &velocity_fe,
+    mfem::DenseMatrix &coupling)
+{
+    mfem::FaceElementTransformations *face_transformation = mesh_.GetFaceElementTransformations(face);
+    // The face normal points out of Elem1; shared faces always have the local
+    // element on that side.
+    const bool first_side = face_transformation->Elem1No == element;
+    mfem::ElementTransformation &element_transformation =
+        first_side ? *face_transformation->Elem1 : *face_transformation->Elem2;
+    const double normal_sign = first_side ? 1.0 : -1.0;
+
+    const mfem::FiniteElement &trace_fe = *trace_space_.GetFaceElement(face);
+    const int trace_dofs = trace_fe.GetDof();
+    const int velocity_dofs = velocity_fe.GetDof();
+    const int dim = mesh_.Dimension();
+
+    mfem::Vector trace_shape(trace_dofs);
+    mfem::DenseMatrix velocity_shape(velocity_dofs, dim);
+    mfem::Vector normal(dim);
+    mfem::Vector normal_flux(velocity_dofs);
+
+    const int order = trace_fe.GetOrder() + velocity_fe.GetOrder() + face_transformation->OrderW();
+    const mfem::IntegrationRule &rule = mfem::IntRules.Get(face_transformation->GetGeometryType(), order);
+    for (int q = 0; q < rule.GetNPoints(); ++q)
+    {
+        const mfem::IntegrationPoint &ip = rule.IntPoint(q);
+        face_transformation->SetAllIntPoints(&ip);
+
+        trace_fe.CalcShape(ip, trace_shape);
+        velocity_fe.CalcVShape(element_transformation, velocity_shape);
+        // CalcOrtho scales the normal by the face Jacobian determinant.
+        mfem::CalcOrtho(face_transformation->Jacobian(), normal);
+        velocity_shape.Mult(normal, normal_flux);
+
+        const double weight = normal_sign * ip.weight;
+        for (int j = 0; j < velocity_dofs; ++j)
+        {
+            for (int i = 0; i < trace_dofs; ++i)
+            {
+                coupling(row_offset + i, j) += weight * trace_shape(i) * normal_flux(j);
+            }
+        }
+    }
+}
+
+void DarcyHybridization::Assemble(
+    mfem::Coefficient &inverse_permeability,
+    const mfem::Vector &pressure_rhs,
+    const std::vector<int> &no_flow_marker,
+    const std::vector<double> &boundary_pressure)
+{
+    const int element_count = mesh_.GetNE();
+    std::vector<std::vector<int>> element_faces(element_count);
+    for (int face = 0; face < mesh_.GetNumFaces(); ++face)
+    {
+        int first = -1;
+        int second = -1;
+        mesh_.GetFaceElements(face, &first, &second);
+        if (first >= 0)
+        {
+            element_faces[first].push_back(face);
+        }
+        if (second >= 0)
+        {
+            element_faces[second].push_back(face);
+        }
+    }
+
+    mfem::VectorFEMassIntegrator mass_integrator(inverse_permeability);
+    mfem::VectorFEDivergenceIntegrator divergence_integrator;
+
+    mfem::SparseMatrix trace_matrix_local(trace_space_.GetVSize());
+    mfem::Vector trace_rhs_local(trace_space_.GetVSize());
+    trace_rhs_local = 0.0;
+
+    blocks_.assign(element_count, ElementBlock());
+    mfem::DenseMatrix mass;
+    mfem::DenseMatrix divergence;
+    mfem::Array<int> face_dofs;
+    mfem::Array<int> pressure_dofs;
+    mfem::Vector element_pressure_rhs;
+    for (int element = 0; element < element_count; ++element)
+    {
+        const mfem::FiniteElement &velocity_fe = *velocity_space_.GetFE(element);
+        const mfem::FiniteElement &pressure_fe = *pressure_space_.GetFE(element);
+        mfem::ElementTransformation &transformation = *mesh_.GetElementTransformation(element);
+        mass_integrator.AssembleElementMatrix(velocity_fe, transformation, mass);
+        divergence_integrator.AssembleElementMatrix2(velocity_fe, pressure_fe, transformation, divergence);
+        divergence.Neg();
+
+        const int velocity_dofs = velocity_fe.GetDof();
+        const int local_size = velocity_dofs + pressure_fe.GetDof();
+        mfem::DenseMatrix local_inverse(local_size);
+        local_inverse = 0.0;
+        local_inverse.CopyMN(mass, 0, 0);
+        local_inverse.CopyMN(divergence, velocity_dofs, 0);
+        local_inverse.CopyMNt(divergence, 0, velocity_dofs);
+        local_inverse.Invert();
+
+        ElementBlock &block = blocks_[element];
+        for (const int face : element_faces[element])
+        {
+            trace_space_.GetFaceVDofs(face, face_dofs);
+            block.trace_dofs.Append(face_dofs);
+        }
+
+        // C_e acts on the velocity part only; its pressure columns stay zero.
+        const int trace_size = block.trace_dofs.Size();
+        mfem::DenseMatrix coupling(trace_size, local_size);
+        coupling = 0.0;
+        int row_offset = 0;
+        for (const int face : element_faces[element])
+        {
+            AddFaceCoupling(element, face, row_offset, velocity_fe, coupling);
+            row_offset += trace_space_.GetFaceElement(face)->GetDof();
+        }
+
+        block.trace_response.SetSize(local_size, trace_size);
+        mfem::MultABt(local_inverse, coupling, block.trace_response);
+
+        pressure_space_.GetElementVDofs(element, pressure_dofs);
+        pressure_rhs.GetSubVector(pressure_dofs, element_pressure_rhs);
+        mfem::Vector element_rhs(local_size);
+        element_rhs = 0.0;
+        element_rhs.SetVector(element_pressure_rhs, velocity_dofs);
+        block.load_response.SetSize(local_size);
+        local_inverse.Mult(element_rhs, block.load_response);
+
+        mfem::DenseMatrix element_trace_matrix(trace_size);
+        mfem::Mult(coupling, block.trace_response, element_trace_matrix);
+        trace_matrix_local.AddSubMatrix(block.trace_dofs, block.trace_dofs, element_trace_matrix, 0);
+
+        mfem::Vector element_trace_rhs(trace_size);
+        coupling.Mult(block.load_response, element_trace_rhs);
+        trace_rhs_local.AddElementVector(block.trace_dofs, element_trace_rhs);
+    }
+    trace_matrix_local.Finalize(0);
+
+    mfem::OperatorHandle block_diagonal(mfem::Operator::Hypre_ParCSR);
+    mfem::OperatorHandle prolongation(mfem::Operator::Hypre_ParCSR);
+    block_diagonal.MakeSquareBlockDiag(
+        trace_space_.GetComm(),
+        trace_space_.GlobalVSize(),
+        trace_space_.GetDofOffsets(),
+        &trace_matrix_local);
+    prolongation.ConvertFrom(trace_space_.Dof_TrueDof_Matrix());
+    trace_matrix_.MakePtAP(block_diagonal, prolongation);
+
+    // Boundary faces are never shared, so their trace dofs are owned locally.
+    mfem::Vector trace_values(trace_space_.GetVSize());
+    trace_values = 0.0;
+    mfem::Array<int> ess_dof_marker(trace_space_.GetVSize());
+    ess_dof_marker = 0;
+    for (int boundary_element = 0; boundary_element < mesh_.GetNBE(); ++boundary_element)
+    {
+        const int attribute = mesh_.GetBdrAttribute(boundary_element);
+        if (attribute <= 0 || attribute > static_cast<int>(no_flow_marker.size()) ||
+            no_flow_marker[attribute - 1] != 0)
+        {
+            continue;
+        }
+        trace_space_.GetFaceVDofs(mesh_.GetBdrElementFaceIndex(boundary_element), face_dofs);
+        for (int i = 0; i < face_dofs.Size(); ++i)
+        {
+            // The face basis is nodal, so a constant trace has equal coefficients.
+            trace_values[face_dofs[i]] = boundary_pressure[attribute - 1];
+            ess_dof_marker[face_dofs[i]] = 1;
+        }
+    }
+    mfem::Array<int> ess_tdof_marker;
+    trace_space_.GetRestrictionMatrix()->BooleanMult(ess_dof_marker, ess_tdof_marker);
+    mfem::FiniteElementSpace::MarkerToList(ess_tdof_marker, ess_trace_tdofs_);
+
+    trace_true_solution_.SetSize(trace_space_.GetTrueVSize());
+    trace_space_.GetRestrictionMatrix()->Mult(trace_values, trace_true_solution_);
+    trace_true_rhs_.SetSize(trace_space_.GetTrueVSize());
+    trace_space_.GetProlongationMatrix()->MultTranspose(trace_rhs_local, trace_true_rhs_);
+
+    auto *trace_matrix = trace_matrix_.As<mfem::HypreParMatrix>();
+    std::unique_ptr<mfem::HypreParMatrix> eliminated(trace_matrix->EliminateRowsCols(ess_trace_tdofs_));
+    trace_matrix->EliminateBC(*eliminated, ess_trace_tdofs_, trace_true_solution_, trace_true_rhs_);
+}
+
+bool DarcyHybridization::Solve(double rel_tol, double abs_tol, int max_iterations)
+{
+    auto *trace_matrix = trace_matrix_.As<mfem::HypreParMatrix>();
+    if (trace_matrix == nullptr)
+    {
+        throw std::runtime_error("DarcyHybridization::Solve called before Assemble.");
+    }
+
+    mfem::HypreBoomerAMG amg(*trace_matrix);
+    amg.SetPrintLevel(0);
+
+    mfem::CGSolver cg(trace_space_.GetComm());
+    cg.SetRelTol(rel_tol);
+    cg.SetAbsTol(abs_tol);
+    cg.SetMaxIter(max_iterations);
+    cg.SetPrintLevel(0);
+    cg.SetOperator(*trace_matrix);
+    cg.SetPreconditioner(amg);
+    cg.iterative_mode = true;
+    cg.Mult(trace_true_rhs_, trace_true_solution_);
+
+    iterations_ = cg.GetNumIterations();
+    final_norm_ = cg.GetFinalNorm();
+    return cg.GetConverged();
+}
+
+void DarcyHybridization::RecoverSolution(
+    mfem::ParGridFunction &velocity,
+    mfem::ParGridFunction &pressure) const
+{
+    mfem::Vector trace_values(trace_space_.GetVSize());
+    trace_space_.GetProlongationMatrix()->Mult(trace_true_solution_, trace_values);
+
+    mfem::Array<int> velocity_dofs;
+    mfem::Array<int> pressure_dofs;
+    mfem::Vector element_trace;
+    mfem::Vector element_solution;
+    for (int element = 0; element < static_cast<int>(blocks_.size()); ++element)
+    {
+        const ElementBlock &block = blocks_[element];
+        trace_values.GetSubVector(block.trace_dofs, element_trace);
+        element_solution = block.load_response;
+        block.trace_response.AddMult_a(-1.0, element_trace, element_solution);
+
+        // Interior RT dofs are written by both neighbors with the same value;
+        // GetElementVDofs signs map the local orientation to the global one.
+        velocity_space_.GetElementVDofs(element, velocity_dofs);
+        pressure_space_.GetElementVDofs(element, pressure_dofs);
+        const int velocity_size = velocity_dofs.Size();
+        mfem::Vector element_velocity(element_solution.GetData(), velocity_size);
+        mfem::Vector element_pressure(element_solution.GetData() + velocity_size, pressure_dofs.Size());
+        velocity.SetSubVector(velocity_dofs, element_velocity);
+        pressure.SetSubVector(pressure_dofs, element_pressure);
+    }
+}
+#endif
+} // namespace autosage
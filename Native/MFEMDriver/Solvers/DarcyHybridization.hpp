@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: MIT
+// AutoSage MFEM driver extension.
+// Uses MFEM (BSD-3-Clause). See THIRD_PARTY_NOTICES.md.
+
+#pragma once
+
+#include <mfem.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace autosage
+{
+#if defined(MFEM_USE_MPI)
+// Mixed-hybrid reduction of the RT/L2 Darcy system
+//
+//   [ M  -B^T ] [u]   [0]
+//   [-B   0   ] [p] = [g]
+//
+// The velocity is broken across element faces and normal continuity is
+// restored by a face multiplier lambda (the pressure trace). Eliminating the
+// element unknowns leaves H lambda = r with H = sum_e C_e A_e^{-1} C_e^T,
+// which is SPD and is solved with BoomerAMG-preconditioned CG. Velocity and
+// pressure are then recovered element by element without communication.
+//
+// Fixed-pressure boundary faces carry lambda = p_D as essential trace dofs,
+// which replaces the boundary flux term of the mixed right-hand side.
+// No-flow faces keep an unknown multiplier that enforces u.n = 0 weakly.
+class DarcyHybridization
+{
+public:
+    // order is the RT_FECollection order of velocity_space; the trace space
+    // uses the same polynomial degree as the RT normal components.
+    DarcyHybridization(
+        mfem::ParMesh &mesh,
+        mfem::ParFiniteElementSpace &velocity_space,
+        mfem::ParFiniteElementSpace &pressure_space,
+        int order);
+
+    // pressure_rhs is the local (unassembled) pressure load vector.
+    // boundary_pressure[attribute - 1] is the trace value prescribed on every
+    // boundary attribute whose no_flow_marker entry is 0.
+    void Assemble(
+        mfem::Coefficient &inverse_permeability,
+        const mfem::Vector &pressure_rhs,
+        const std::vector<int> &no_flow_marker,
+        const std::vector<double> &boundary_pressure);
+
+    // Returns false when CG stops before reaching rel_tol.
+    bool Solve(double rel_tol, double abs_tol, int max_iterations);
+
+    void RecoverSolution(mfem::ParGridFunction &velocity, mfem::ParGridFunction &pressure) const;
+
+    HYPRE_BigInt GlobalTraceSize() const { return trace_space_.GlobalTrueVSize(); }
+    int Iterations() const { return iterations_; }
+    double FinalNorm() const { return final_norm_; }
+
+private:
+    struct ElementBlock
+    {
+        mfem::Array<int> trace_dofs;
+        // A_e^{-1} C_e^T and A_e^{-1} F_e over the local [u; p] unknowns.
+        mfem::DenseMatrix trace_response;
+        mfem::Vector load_response;
+    };
+
+    void AddFaceCoupling(
+        int element,
+        int face,
+        int row_offset,
+        const mfem::FiniteElement &velocity_fe,
+        mfem::DenseMatrix &coupling);
+
+    mfem::ParMesh &mesh_;
+    mfem::ParFiniteElementSpace &velocity_space_;
+    mfem::ParFiniteElementSpace &pressure_space_;
+    mfem::DG_Interface_FECollection trace_collection_;
+    mfem::ParFiniteElementSpace trace_space_;
+
+    std::vector<ElementBlock> blocks_;
+    mfem::OperatorHandle trace_matrix_;
+    mfem::Array<int> ess_trace_tdofs_;
+    mfem::Vector trace_true_rhs_;
+    mfem::Vector trace_true_solution_;
+    int iterations_ = 0;
+    double final_norm_ = 0.0;
+};
+#endif
+} // namespace autosage
@@ -131,9 +131,11 @@ SolveSummary EigenvalueSolver::Run(
     const EigenvalueConfig parsed = ParseConfig(config, max_boundary_attribute);
 
 #if defined(MFEM_USE_MPI)
-    mfem::ParMesh pmesh(MPI_COMM_WORLD, mesh);
+    ProfiledPhase phase(context.profiler, "fe_space_setup");
+    mfem::ParMesh &pmesh = context.mesh_distributor.Distribute(mesh);
     mfem::H1_FECollection fec(1, dim);
     mfem::ParFiniteElementSpace fespace(&pmesh, &fec);
+    context.profiler.RecordDofs("mode", fespace.GlobalTrueVSize());
 
     mfem::Array<int> ess_bdr(max_boundary_attribute);
     ess_bdr = 0;
@@ -142,6 +144,7 @@ SolveSummary EigenvalueSolver::Run(
         ess_bdr[i] = parsed.fixed_marker[i];
     }
 
+    phase.Switch("assembly");
     mfem::ConstantCoefficient one(1.0);
     mfem::ConstantCoefficient kappa(parsed.material_coefficient);
 
@@ -165,9 +168,11 @@ SolveSummary EigenvalueSolver::Run(
     mass_form.Finalize();
     std::unique_ptr<mfem::HypreParMatrix> mass(mass_form.ParallelAssemble());
 
+    phase.Switch("preconditioner_setup");
     mfem::HypreBoomerAMG amg(*stiffness);
     amg.SetPrintLevel(0);
 
+    phase.Switch("solve");
     mfem::HypreLOBPCG lobpcg(MPI_COMM_WORLD);
     lobpcg.SetNumModes(parsed.num_eigenmodes);
     lobpcg.SetRandomSeed(75);
@@ -197,6 +202,9 @@ SolveSummary EigenvalueSolver::Run(
         }
     }
 
+    context.profiler.SetCounter("eigenmodes", eigenvalues.Size());
+
+    phase.Switch("output");
     mfem::ParGridFunction first_mode(&fespace);
     first_mode = lobpcg.GetEigenvector(0);
 
@@ -207,7 +215,7 @@ SolveSummary EigenvalueSolver::Run(
         : context.working_directory;
     fs::create_directories(output_dir);
 
-    mfem::ParaViewDataCollection paraview(collection_name, &pmesh);
+    ProbedDataCollection paraview(collection_name, &pmesh, context.probes);
     paraview.SetPrefixPath(output_dir);
     paraview.SetLevelsOfDetail(1);
     paraview.SetDataFormat(mfem::VTKFormat::ASCII);
@@ -216,8 +224,11 @@ SolveSummary EigenvalueSolver::Run(
     paraview.SetTime(0.0);
     paraview.Save();
 
-    std::ofstream vtk_stub(context.vtk_path);
-    vtk_stub << "# eigenmode fields written to " << collection_name << ".pvd\n";
+    if (context.probes.FieldOutput())
+    {
+        std::ofstream vtk_stub(context.vtk_path);
+        vtk_stub << "# eigenmode fields written to " << collection_name << ".pvd\n";
+    }
 
     const fs::path eigenvalues_path = fs::path(context.working_directory) / "eigenvalues.json";
     json eigenvalues_json;
@@ -234,6 +245,7 @@ SolveSummary EigenvalueSolver::Run(
         throw std::runtime_error("Unable to write eigenvalues.json.");
     }
     eigenvalues_out << eigenvalues_json.dump(2);
+    phase.End();
 
     mfem::Vector r_data(stiffness->GetNumRows());
     mfem::HypreParVector residual(
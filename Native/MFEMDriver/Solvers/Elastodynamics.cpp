@@ -217,8 +217,9 @@ public:
         mfem::Vector kv(kvx.GetData() + 0, sc);
         mfem::Vector ku(kvx.GetData() + sc, sc);
 
+        // The time integrator has already moved t to the end of the step.
         EnsureImplicitSystem(dt);
-        AssembleLoadVector(this->t + dt, load_true_);
+        AssembleLoadVector(this->t, load_true_);
 
         stiffness_matrix_.Mult(u, rhs_);
         rhs_.Neg();
@@ -421,6 +422,8 @@ ElastodynamicsSolver::ElastodynamicsConfig ElastodynamicsSolver::ParseConfig(
     {
         throw std::runtime_error("config.output_interval_steps must be > 0.");
     }
+    parsed.output_interval_time = ParseOutputIntervalTime(config);
+    parsed.time_stepping = ParseTimeStepSettings(config);
 
     if (!config.contains("initial_condition") || !config["initial_condition"].is_object())
     {
@@ -522,9 +525,12 @@ SolveSummary ElastodynamicsSolver::Run(
     const auto [lambda, mu] = lame_from_young_poisson(parsed.youngs_modulus, parsed.poisson_ratio);
 
 #if defined(MFEM_USE_MPI)
-    mfem::ParMesh pmesh(MPI_COMM_WORLD, mesh);
+    ProfiledPhase phase(context.profiler, "fe_space_setup");
+    mfem::ParMesh &pmesh = context.mesh_distributor.Distribute(mesh);
     mfem::H1_FECollection fec(parsed.order, dim);
     mfem::ParFiniteElementSpace fespace(&pmesh, &fec, dim);
+    context.profiler.RecordDofs("displacement", fespace.GlobalTrueVSize());
+    context.profiler.RecordDofs("velocity", fespace.GlobalTrueVSize());
 
     mfem::Array<int> ess_bdr(max_boundary_attribute);
     ess_bdr = 0;
@@ -550,6 +556,7 @@ SolveSummary ElastodynamicsSolver::Run(
         load_boundaries.push_back(std::move(mapped));
     }
 
+    phase.Switch("assembly");
     DynamicOperator dynamic_operator(
         fespace,
         ess_tdof_list,
@@ -559,8 +566,9 @@ SolveSummary ElastodynamicsSolver::Run(
         lambda,
         mu
     );
-    mfem::BackwardEulerSolver ode_solver;
-    ode_solver.Init(dynamic_operator);
+    AdaptiveBackwardEuler stepper(fespace.GetComm(), parsed.time_stepping, parsed.dt, parsed.t_final);
+    stepper.Init(dynamic_operator);
+    OutputCadence output_cadence(parsed.output_interval_steps, parsed.output_interval_time);
 
     mfem::ParGridFunction displacement(&fespace);
     mfem::ParGridFunction velocity(&fespace);
@@ -596,6 +604,7 @@ SolveSummary ElastodynamicsSolver::Run(
     }
     dynamic_operator.ApplyEssentialBCs(state);
 
+    phase.Switch("output");
     const fs::path vtk_path(context.vtk_path);
     const std::string collection_name = vtk_path.stem().empty() ? "solution" : vtk_path.stem().string();
     const std::string output_dir = vtk_path.has_parent_path()
@@ -603,7 +612,7 @@ SolveSummary ElastodynamicsSolver::Run(
         : context.working_directory;
     fs::create_directories(output_dir);
 
-    mfem::ParaViewDataCollection paraview(collection_name, &pmesh);
+    ProbedDataCollection paraview(collection_name, &pmesh, context.probes);
     paraview.SetPrefixPath(output_dir);
     paraview.SetLevelsOfDetail(1);
     paraview.SetDataFormat(mfem::VTKFormat::ASCII);
@@ -624,20 +633,32 @@ SolveSummary ElastodynamicsSolver::Run(
     int step = 0;
     save_step(step, time);
 
+    phase.Switch("solve");
     while (time + 1.0e-12 < parsed.t_final)
     {
-        mfem::real_t step_dt = std::min(parsed.dt, parsed.t_final - time);
-        ode_solver.Step(state, time, step_dt);
+        const int implicit_iterations_before = dynamic_operator.TotalImplicitIterations();
+        stepper.Step(state, time, parsed.t_final);
+        context.profiler.RecordLinearSolve(
+            "implicit_cg",
+            dynamic_operator.TotalImplicitIterations() - implicit_iterations_before);
         dynamic_operator.ApplyEssentialBCs(state);
         ++step;
-        if (step % parsed.output_interval_steps == 0 || time + 1.0e-12 >= parsed.t_final)
+        if (output_cadence.Due(step, time, parsed.t_final))
         {
+            ProfiledPhase output_phase(context.profiler, "output");
             save_step(step, time);
         }
     }
+    phase.End();
+    context.profiler.SetCounter("time_steps", step);
+    RecordTimeStepStatistics(context.profiler, stepper.Statistics());
+    context.profiler.SetCounter("mass_solve_iterations", dynamic_operator.TotalMassIterations());
 
-    std::ofstream vtk_stub(context.vtk_path);
-    vtk_stub << "# elastodynamics fields written to " << collection_name << ".pvd\n";
+    if (context.probes.FieldOutput())
+    {
+        std::ofstream vtk_stub(context.vtk_path);
+        vtk_stub << "# elastodynamics fields written to " << collection_name << ".pvd\n";
+    }
 
     mfem::Vector final_v(state.GetData() + 0, true_size);
     mfem::Vector final_u(state.GetData() + true_size, true_size);
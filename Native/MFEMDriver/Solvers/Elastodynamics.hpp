@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "AdaptiveTimeStepper.hpp"
 #include "NavierStokes.hpp"
 
 #include <nlohmann/json.hpp>
@@ -45,6 +46,8 @@ private:
         double t_final = 0.1;
         int order = 1;
         int output_interval_steps = 1;
+        double output_interval_time = 0.0;
+        TimeStepSettings time_stepping;
         InitialCondition initial_condition;
         std::vector<int> fixed_boundary_marker;
         std::vector<TimeVaryingLoadBoundary> loads;
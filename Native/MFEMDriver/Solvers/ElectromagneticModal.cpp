@@ -140,11 +140,13 @@ SolveSummary ElectromagneticModalSolver::Run(
     const int max_boundary_attribute = mesh.bdr_attributes.Size() > 0 ? mesh.bdr_attributes.Max() : 0;
 
 #if defined(MFEM_USE_MPI)
-    mfem::ParMesh pmesh(MPI_COMM_WORLD, mesh);
+    ProfiledPhase phase(context.profiler, "fe_space_setup");
+    mfem::ParMesh &pmesh = context.mesh_distributor.Distribute(mesh);
     const ElectromagneticModalConfig parsed = ParseConfig(config, max_boundary_attribute);
 
     mfem::ND_FECollection fec(1, dim);
     mfem::ParFiniteElementSpace fespace(&pmesh, &fec);
+    context.profiler.RecordDofs("electric_field", fespace.GlobalTrueVSize());
 
     mfem::Array<int> ess_bdr(max_boundary_attribute);
     ess_bdr = 0;
@@ -153,6 +155,7 @@ SolveSummary ElectromagneticModalSolver::Run(
         ess_bdr[i] = parsed.perfect_conductor_marker[i];
     }
 
+    phase.Switch("assembly");
     mfem::ConstantCoefficient mu_inverse_coeff(1.0 / parsed.permeability);
     mfem::ConstantCoefficient epsilon_coeff(parsed.permittivity);
 
@@ -170,6 +173,7 @@ SolveSummary ElectromagneticModalSolver::Run(
     mass_form.Finalize();
     std::unique_ptr<mfem::HypreParMatrix> mass(mass_form.ParallelAssemble());
 
+    phase.Switch("preconditioner_setup");
     mfem::HypreAMS ams(*stiffness, &fespace);
     ams.SetPrintLevel(0);
     ams.SetSingularProblem();
@@ -184,6 +188,7 @@ SolveSummary ElectromagneticModalSolver::Run(
     lobpcg.SetPrintLevel(0);
     lobpcg.SetMassMatrix(*mass);
     lobpcg.SetOperator(*stiffness);
+    phase.Switch("solve");
     lobpcg.Solve();
 
     mfem::Array<mfem::real_t> eigenvalues;
@@ -204,7 +209,9 @@ SolveSummary ElectromagneticModalSolver::Run(
 
     mfem::ParGridFunction first_mode(&fespace);
     first_mode = lobpcg.GetEigenvector(0);
+    context.profiler.SetCounter("eigenmodes", eigenvalues.Size());
 
+    phase.Switch("output");
     const fs::path vtk_path(context.vtk_path);
     const std::string collection_name = vtk_path.stem().empty() ? "solution" : vtk_path.stem().string();
     const std::string output_dir = vtk_path.has_parent_path()
@@ -212,7 +219,7 @@ SolveSummary ElectromagneticModalSolver::Run(
         : context.working_directory;
     fs::create_directories(output_dir);
 
-    mfem::ParaViewDataCollection paraview(collection_name, &pmesh);
+    ProbedDataCollection paraview(collection_name, &pmesh, context.probes);
     paraview.SetPrefixPath(output_dir);
     paraview.SetLevelsOfDetail(1);
     paraview.SetDataFormat(mfem::VTKFormat::ASCII);
@@ -221,8 +228,11 @@ SolveSummary ElectromagneticModalSolver::Run(
     paraview.SetTime(0.0);
     paraview.Save();
 
-    std::ofstream vtk_stub(context.vtk_path);
-    vtk_stub << "# electromagnetic mode fields written to " << collection_name << ".pvd\n";
+    if (context.probes.FieldOutput())
+    {
+        std::ofstream vtk_stub(context.vtk_path);
+        vtk_stub << "# electromagnetic mode fields written to " << collection_name << ".pvd\n";
+    }
 
     const fs::path modes_path = fs::path(context.working_directory) / "electromagnetic_modes.json";
     json modes_data;
@@ -244,6 +254,7 @@ SolveSummary ElectromagneticModalSolver::Run(
         throw std::runtime_error("Unable to write electromagnetic_modes.json.");
     }
     modes_out << modes_data.dump(2);
+    phase.End();
 
     mfem::Vector residual_data(stiffness->GetNumRows());
     mfem::HypreParVector residual(
@@ -286,12 +286,15 @@ SolveSummary ElectromagneticScatteringSolver::Run(
     const int max_boundary_attribute = mesh.bdr_attributes.Size() > 0 ? mesh.bdr_attributes.Max() : 0;
 
 #if defined(MFEM_USE_MPI)
-    mfem::ParMesh pmesh(MPI_COMM_WORLD, mesh);
+    ProfiledPhase phase(context.profiler, "fe_space_setup");
+    mfem::ParMesh &pmesh = context.mesh_distributor.Distribute(mesh);
     const ScatteringConfig parsed = ParseConfig(config, dim, max_element_attribute, max_boundary_attribute);
     PMLRegion pml(max_element_attribute, parsed.pml_attributes);
 
     mfem::ND_FECollection fec(1, dim);
     mfem::ParFiniteElementSpace fespace(&pmesh, &fec);
+    context.profiler.RecordDofs("electric_field_real", fespace.GlobalTrueVSize());
+    context.profiler.RecordDofs("electric_field_imag", fespace.GlobalTrueVSize());
 
     mfem::Array<int> ess_bdr(max_boundary_attribute);
     ess_bdr = 0;
@@ -305,6 +308,7 @@ SolveSummary ElectromagneticScatteringSolver::Run(
         fespace.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
     }
 
+    phase.Switch("assembly");
     const mfem::ComplexOperator::Convention convention = mfem::ComplexOperator::HERMITIAN;
 
     mfem::ParComplexLinearForm rhs(&fespace, convention);
@@ -388,6 +392,7 @@ SolveSummary ElectromagneticScatteringSolver::Run(
     mfem::Vector true_rhs;
     system_form.FormLinearSystem(ess_tdof_list, electric_field, rhs, system_operator, true_solution, true_rhs);
 
+    phase.Switch("preconditioner_setup");
     mfem::ParBilinearForm preconditioner_form(&fespace);
     preconditioner_form.AddDomainIntegrator(new mfem::CurlCurlIntegrator(mu_inverse_coeff));
     preconditioner_form.AddDomainIntegrator(new mfem::VectorFEMassIntegrator(pos_mass_coeff));
@@ -428,8 +433,11 @@ SolveSummary ElectromagneticScatteringSolver::Run(
     solver.SetPrintLevel(0);
     solver.SetOperator(*system_operator.Ptr());
     solver.SetPreconditioner(block_preconditioner);
+    phase.Switch("solve");
     solver.Mult(true_rhs, true_solution);
+    context.profiler.RecordLinearSolve("fgmres", solver.GetNumIterations());
 
+    phase.Switch("output");
     system_form.RecoverFEMSolution(true_solution, rhs, electric_field);
 
     const fs::path vtk_path(context.vtk_path);
@@ -439,7 +447,7 @@ SolveSummary ElectromagneticScatteringSolver::Run(
         : context.working_directory;
     fs::create_directories(output_dir);
 
-    mfem::ParaViewDataCollection paraview(collection_name, &pmesh);
+    ProbedDataCollection paraview(collection_name, &pmesh, context.probes);
     paraview.SetPrefixPath(output_dir);
     paraview.SetLevelsOfDetail(1);
     paraview.SetDataFormat(mfem::VTKFormat::ASCII);
@@ -449,8 +457,12 @@ SolveSummary ElectromagneticScatteringSolver::Run(
     paraview.SetTime(0.0);
     paraview.Save();
 
-    std::ofstream vtk_stub(context.vtk_path);
-    vtk_stub << "# electromagnetic scattering fields written to " << collection_name << ".pvd\n";
+    if (context.probes.FieldOutput())
+    {
+        std::ofstream vtk_stub(context.vtk_path);
+        vtk_stub << "# electromagnetic scattering fields written to " << collection_name << ".pvd\n";
+    }
+    phase.End();
 
     mfem::Vector residual(true_rhs.Size());
     system_operator.Ptr()->Mult(true_solution, residual);
@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: MIT
+// AutoSage MFEM driver extension.
+// Uses MFEM (BSD-3-Clause). See THIRD_PARTY_NOTICES.md.
+
+#include "ExplicitNewmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace autosage
+{
+#if defined(MFEM_USE_MPI)
+ExplicitNewmarkSolver::ExplicitNewmarkSolver(
+    const mfem::HypreParMatrix &stiffness,
+    const mfem::Vector &lumped_mass,
+    const mfem::Vector &lumped_damping,
+    const mfem::Array<int> &ess_tdof_list)
+    : stiffness_(stiffness),
+      mass_(lumped_mass),
+      damping_(lumped_damping),
+      ess_tdof_list_(ess_tdof_list),
+      acceleration_(lumped_mass.Size()),
+      force_(lumped_mass.Size())
+{
+    for (int i = 0; i < mass_.Size(); ++i)
+    {
+        if (!(mass_[i] > 0.0))
+        {
+            throw std::runtime_error("Lumped mass matrix has a non-positive diagonal entry.");
+        }
+    }
+    // Constrained entries never move; a unit mass keeps the divisions safe.
+    for (int i = 0; i < ess_tdof_list_.Size(); ++i)
+    {
+        mass_[ess_tdof_list_[i]] = 1.0;
+    }
+    acceleration_ = 0.0;
+}
+
+double ExplicitNewmarkSolver::MaxFrequencyBound()
+{
+    if (max_frequency_ >= 0.0)
+    {
+        return max_frequency_;
+    }
+
+    // Rows of the local diagonal block and of the off-processor block
+    // together hold every entry of the locally owned rows of K.
+    mfem::SparseMatrix diag;
+    mfem::SparseMatrix offd;
+    HYPRE_BigInt *offd_columns = nullptr;
+    stiffness_.GetDiag(diag);
+    stiffness_.GetOffd(offd, offd_columns);
+
+    std::vector<bool> constrained(static_cast<std::size_t>(mass_.Size()), false);
+    for (int i = 0; i < ess_tdof_list_.Size(); ++i)
+    {
+        const int tdof = ess_tdof_list_[i];
+        if (tdof >= 0 && tdof < mass_.Size())
+        {
+            constrained[static_cast<std::size_t>(tdof)] = true;
+        }
+    }
+
+    auto absolute_row_sum = [](const mfem::SparseMatrix &matrix, int row)
+    {
+        if (row >= matrix.Height())
+        {
+            return 0.0;
+        }
+        const int *offsets = matrix.GetI();
+        const double *values = matrix.GetData();
+        double sum = 0.0;
+        for (int k = offsets[row]; k < offsets[row + 1]; ++k)
+        {
+            sum += std::abs(values[k]);
+        }
+        return sum;
+    };
+
+    double lambda_bound = 0.0;
+    for (int i = 0; i < mass_.Size(); ++i)
+    {
+        if (constrained[static_cast<std::size_t>(i)])
+        {
+            continue;
+        }
+        const double row_sum = absolute_row_sum(diag, i) + absolute_row_sum(offd, i);
+        lambda_bound = std::max(lambda_bound, row_sum / mass_[i]);
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &lambda_bound, 1, MPI_DOUBLE, MPI_MAX, stiffness_.GetComm());
+
+    max_frequency_ = std::sqrt(lambda_bound);
+    return max_frequency_;
+}
+
+double ExplicitNewmarkSolver::StableTimeStep(double cfl)
+{
+    const double omega = MaxFrequencyBound();
+    return omega > 0.0 ? cfl * 2.0 / omega : 0.0;
+}
+
+void ExplicitNewmarkSolver::Init(const mfem::Vector &u, const mfem::Vector &v)
+{
+    ComputeAcceleration(u, v, 0.0);
+}
+
+void ExplicitNewmarkSolver::Step(mfem::Vector &u, mfem::Vector &v, double dt)
+{
+    // u+ = u + dt v + dt^2/2 a, then v+ = v + dt/2 (a + a+) with a+ taken
+    // from the new displacement and the predicted velocity v + dt/2 a.
+    u.Add(dt, v);
+    u.Add(0.5 * dt * dt, acceleration_);
+    v.Add(0.5 * dt, acceleration_);
+    ComputeAcceleration(u, v, dt);
+    v.Add(0.5 * dt, acceleration_);
+    ZeroEssentialEntries(u);
+    ZeroEssentialEntries(v);
+}
+
+void ExplicitNewmarkSolver::ComputeAcceleration(const mfem::Vector &u, const mfem::Vector &v_predicted, double dt)
+{
+    stiffness_.Mult(u, force_);
+    ++matvecs_;
+    const bool damped = damping_.Size() == force_.Size();
+    for (int i = 0; i < force_.Size(); ++i)
+    {
+        double force = -force_[i];
+        double mass = mass_[i];
+        if (damped)
+        {
+            force -= damping_[i] * v_predicted[i];
+            mass += 0.5 * dt * damping_[i];
+        }
+        acceleration_[i] = force / mass;
+    }
+    ZeroEssentialEntries(acceleration_);
+}
+
+void ExplicitNewmarkSolver::ZeroEssentialEntries(mfem::Vector &vector) const
+{
+    for (int i = 0; i < ess_tdof_list_.Size(); ++i)
+    {
+        const int tdof = ess_tdof_list_[i];
+        if (tdof >= 0 && tdof < vector.Size())
+        {
+            vector[tdof] = 0.0;
+        }
+    }
+}
+#endif
+} // namespace autosage
@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: MIT
+// AutoSage MFEM driver extension.
+// Uses MFEM (BSD-3-Clause). See THIRD_PARTY_NOTICES.md.
+
+#pragma once
+
+#include <mfem.hpp>
+
+namespace autosage
+{
+#if defined(MFEM_USE_MPI)
+// Explicit Newmark (beta = 0, gamma = 1/2, i.e. central differences /
+// velocity Verlet) for M a + C v + K u = 0 with lumped, diagonal M and C.
+// A step is one stiffness matvec plus vector updates; no linear solves.
+// It is stable for dt < 2 / omega_max, where omega_max^2 is the largest
+// eigenvalue of M^-1 K.
+class ExplicitNewmarkSolver
+{
+public:
+    // `damping` may be empty for an undamped system. Entries listed in
+    // `ess_tdof_list` are held at zero.
+    ExplicitNewmarkSolver(
+        const mfem::HypreParMatrix &stiffness,
+        const mfem::Vector &lumped_mass,
+        const mfem::Vector &lumped_damping,
+        const mfem::Array<int> &ess_tdof_list);
+
+    // Upper bound on omega_max from Gershgorin's theorem: the largest
+    // absolute row sum of M^-1 K over unconstrained rows. Unlike a
+    // power-iteration estimate it never falls below the true value, so a
+    // step derived from it is always inside the stability limit.
+    double MaxFrequencyBound();
+
+    // 2 / MaxFrequencyBound() times `cfl` (in (0, 1)).
+    double StableTimeStep(double cfl);
+
+    // Evaluates the initial acceleration for (u, v).
+    void Init(const mfem::Vector &u, const mfem::Vector &v);
+
+    void Step(mfem::Vector &u, mfem::Vector &v, double dt);
+
+    const mfem::Vector &Acceleration() const { return acceleration_; }
+    int StiffnessMatVecs() const { return matvecs_; }
+
+private:
+    // a = (M + dt/2 C)^-1 (-K u - C v_predicted)
+    void ComputeAcceleration(const mfem::Vector &u, const mfem::Vector &v_predicted, double dt);
+    void ZeroEssentialEntries(mfem::Vector &vector) const;
+
+    const mfem::HypreParMatrix &stiffness_;
+    mfem::Vector mass_;
+    mfem::Vector damping_;
+    mfem::Array<int> ess_tdof_list_;
+    mfem::Vector acceleration_;
+    mfem::Vector force_;
+    double max_frequency_ = -1.0;
+    int matvecs_ = 0;
+};
+#endif
+} // namespace autosage
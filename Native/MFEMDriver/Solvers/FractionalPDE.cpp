@@ -484,9 +484,11 @@ SolveSummary FractionalPDESolver::Run(
     const ParsedConfig parsed = ParseConfig(config, max_boundary_attribute);
 
 #if defined(MFEM_USE_MPI)
-    mfem::ParMesh pmesh(MPI_COMM_WORLD, mesh);
+    ProfiledPhase phase(context.profiler, "fe_space_setup");
+    mfem::ParMesh &pmesh = context.mesh_distributor.Distribute(mesh);
     mfem::H1_FECollection fec(1, dim);
     mfem::ParFiniteElementSpace fespace(&pmesh, &fec);
+    context.profiler.RecordDofs("solution", fespace.GlobalTrueVSize());
 
     mfem::Array<int> ess_bdr(max_boundary_attribute);
     ess_bdr = 0;
@@ -508,6 +510,7 @@ SolveSummary FractionalPDESolver::Run(
         fespace.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
     }
 
+    phase.Switch("rational_approximation");
     mfem::ParLinearForm b(&fespace);
     mfem::ConstantCoefficient source_coeff(parsed.source_term);
     b.AddDomainIntegrator(new mfem::DomainLFIntegrator(source_coeff));
@@ -544,11 +547,15 @@ SolveSummary FractionalPDESolver::Run(
         u.ProjectBdrCoefficient(fixed_coeff, ess_bdr);
     }
 
+    phase.End();
+    context.profiler.SetCounter("poles", poles_used);
+
     int total_iterations = 0;
     double max_shift_residual = 0.0;
 
     for (int i = 0; i < poles_used; ++i)
     {
+        ProfiledPhase pole_phase(context.profiler, "assembly");
         mfem::ParGridFunction x(&fespace);
         x = 0.0;
         if (max_boundary_attribute > 0)
@@ -585,6 +592,7 @@ SolveSummary FractionalPDESolver::Run(
         );
         X_hypre = 0.0;
 
+        pole_phase.Switch("preconditioner_setup");
         mfem::HypreBoomerAMG amg(A_hypre);
         amg.SetPrintLevel(0);
 
@@ -594,11 +602,13 @@ SolveSummary FractionalPDESolver::Run(
         pcg.SetMaxIter(2000);
         pcg.SetPrintLevel(0);
         pcg.SetPreconditioner(amg);
+        pole_phase.Switch("solve");
         pcg.Mult(B_hypre, X_hypre);
 
         int shift_iterations = 0;
         pcg.GetNumIterations(shift_iterations);
         total_iterations += shift_iterations;
+        context.profiler.RecordLinearSolve("pcg", shift_iterations);
 
         mfem::Vector residual(B.Size());
         mfem::HypreParVector residual_hypre(
@@ -637,6 +647,7 @@ SolveSummary FractionalPDESolver::Run(
         u.ProjectBdrCoefficient(fixed_coeff, ess_bdr);
     }
 
+    phase.Switch("output");
     const fs::path vtk_path(context.vtk_path);
     const std::string collection_name = vtk_path.stem().empty() ? "solution" : vtk_path.stem().string();
     const std::string output_dir = vtk_path.has_parent_path()
@@ -644,7 +655,7 @@ SolveSummary FractionalPDESolver::Run(
         : context.working_directory;
     fs::create_directories(output_dir);
 
-    mfem::ParaViewDataCollection paraview(collection_name, &pmesh);
+    ProbedDataCollection paraview(collection_name, &pmesh, context.probes);
     paraview.SetPrefixPath(output_dir);
     paraview.SetLevelsOfDetail(1);
     paraview.SetDataFormat(mfem::VTKFormat::ASCII);
@@ -653,12 +664,16 @@ SolveSummary FractionalPDESolver::Run(
     paraview.SetTime(0.0);
     paraview.Save();
 
-    std::ofstream vtk_stub(context.vtk_path);
-    if (!vtk_stub)
+    if (context.probes.FieldOutput())
     {
-        throw std::runtime_error("Unable to write solution.vtk stub for FractionalPDE.");
+        std::ofstream vtk_stub(context.vtk_path);
+        if (!vtk_stub)
+        {
+            throw std::runtime_error("Unable to write solution.vtk stub for FractionalPDE.");
+        }
+        vtk_stub << "# fractional PDE field written to " << collection_name << ".pvd\n";
     }
-    vtk_stub << "# fractional PDE field written to " << collection_name << ".pvd\n";
+    phase.End();
 
     SolveSummary summary;
     summary.energy = u.Norml2();
@@ -75,7 +75,8 @@ public:
         double specific_heat,
         double conductivity,
         double source,
-        const mfem::Vector &heat_flux_values)
+        const mfem::Vector &heat_flux_values,
+        autosage::OperatorCache &operator_cache)
         : mfem::TimeDependentOperator(fespace.GetTrueVSize(), 0.0),
           fespace_(fespace),
           ess_tdof_list_(ess_tdof_list),
@@ -89,13 +90,23 @@ public:
     {
         const mfem::real_t rel_tol = 1.0e-10;
 
-        mfem::ConstantCoefficient cp_coeff(specific_heat);
-        mass_form_ = std::make_unique<mfem::ParBilinearForm>(&fespace_);
-        mass_form_->AddDomainIntegrator(new mfem::MassIntegrator(cp_coeff));
-        mass_form_->Assemble(0);
-        mass_form_->FormSystemMatrix(mfem::Array<int>(), mass_matrix_);
-
-        mass_matrix_solver_ = std::make_unique<mfem::HypreParMatrix>(mass_matrix_);
+        // Mass and stiffness depend only on the mesh and the two material
+        // constants, so repeated jobs can reuse them from the operator cache.
+        const int order = fespace_.GetMaxElementOrder();
+        mass_matrix_ = operator_cache.LoadOrAssemble(
+            autosage::OperatorCache::Key("heat_transfer.mass", order, {specific_heat}),
+            fespace_,
+            fespace_,
+            [&]() {
+                mfem::ConstantCoefficient cp_coeff(specific_heat);
+                mfem::ParBilinearForm mass_form(&fespace_);
+                mass_form.AddDomainIntegrator(new mfem::MassIntegrator(cp_coeff));
+                mass_form.Assemble(0);
+                mass_form.Finalize(0);
+                return std::unique_ptr<mfem::HypreParMatrix>(mass_form.ParallelAssemble());
+            });
+
+        mass_matrix_solver_ = std::make_unique<mfem::HypreParMatrix>(*mass_matrix_);
         if (ess_tdof_list_.Size() > 0)
         {
             mass_matrix_solver_->EliminateBC(ess_tdof_list_, mfem::Operator::DIAG_ONE);
@@ -110,11 +121,18 @@ public:
         mass_solver_.SetPreconditioner(mass_prec_);
         mass_solver_.SetOperator(*mass_matrix_solver_);
 
-        mfem::ConstantCoefficient conductivity_coeff(conductivity);
-        stiffness_form_ = std::make_unique<mfem::ParBilinearForm>(&fespace_);
-        stiffness_form_->AddDomainIntegrator(new mfem::DiffusionIntegrator(conductivity_coeff));
-        stiffness_form_->Assemble(0);
-        stiffness_form_->FormSystemMatrix(mfem::Array<int>(), stiffness_matrix_);
+        stiffness_matrix_ = operator_cache.LoadOrAssemble(
+            autosage::OperatorCache::Key("heat_transfer.stiffness", order, {conductivity}),
+            fespace_,
+            fespace_,
+            [&]() {
+                mfem::ConstantCoefficient conductivity_coeff(conductivity);
+                mfem::ParBilinearForm stiffness_form(&fespace_);
+                stiffness_form.AddDomainIntegrator(new mfem::DiffusionIntegrator(conductivity_coeff));
+                stiffness_form.Assemble(0);
+                stiffness_form.Finalize(0);
+                return std::unique_ptr<mfem::HypreParMatrix>(stiffness_form.ParallelAssemble());
+            });
 
         rhs_form_ = std::make_unique<mfem::ParLinearForm>(&fespace_);
         std::unique_ptr<mfem::ConstantCoefficient> source_coeff;
@@ -150,7 +168,7 @@ public:
     void Mult(const mfem::Vector &u, mfem::Vector &du_dt) const override
     {
         // cp*M*du_dt = rhs - K*u
-        stiffness_matrix_.Mult(u, z_);
+        stiffness_matrix_->Mult(u, z_);
         z_.Neg();
         rhs_ = rhs_true_;
         rhs_ += z_;
@@ -164,7 +182,7 @@ public:
         if (implicit_matrix_ == nullptr || std::abs(dt - current_dt_) > 1.0e-15)
         {
             delete implicit_matrix_;
-            implicit_matrix_ = mfem::Add(1.0, mass_matrix_, dt, stiffness_matrix_);
+            implicit_matrix_ = mfem::Add(1.0, *mass_matrix_, dt, *stiffness_matrix_);
             current_dt_ = dt;
             if (ess_tdof_list_.Size() > 0)
             {
@@ -173,15 +191,14 @@ public:
             implicit_solver_.SetOperator(*implicit_matrix_);
         }
 
-        stiffness_matrix_.Mult(u, z_);
+        stiffness_matrix_->Mult(u, z_);
         z_.Neg();
         rhs_ = rhs_true_;
         rhs_ += z_;
         zero_essential_entries(rhs_);
 
         implicit_solver_.Mult(rhs_, k);
-        last_implicit_iterations_ = implicit_solver_.GetNumIterations();
-        total_implicit_iterations_ += last_implicit_iterations_;
+        total_implicit_iterations_ += implicit_solver_.GetNumIterations();
     }
 
     int TotalImplicitIterations() const
@@ -191,12 +208,12 @@ public:
 
     const mfem::HypreParMatrix &MassMatrix() const
     {
-        return mass_matrix_;
+        return *mass_matrix_;
     }
 
     const mfem::HypreParMatrix &StiffnessMatrix() const
     {
-        return stiffness_matrix_;
+        return *stiffness_matrix_;
     }
 
     const mfem::Vector &RHSVector() const
@@ -220,12 +237,10 @@ private:
     mfem::ParFiniteElementSpace &fespace_;
     mfem::Array<int> ess_tdof_list_;
 
-    std::unique_ptr<mfem::ParBilinearForm> mass_form_;
-    std::unique_ptr<mfem::ParBilinearForm> stiffness_form_;
     std::unique_ptr<mfem::ParLinearForm> rhs_form_;
 
-    mfem::HypreParMatrix mass_matrix_;
-    mfem::HypreParMatrix stiffness_matrix_;
+    std::unique_ptr<mfem::HypreParMatrix> mass_matrix_;
+    std::unique_ptr<mfem::HypreParMatrix> stiffness_matrix_;
     std::unique_ptr<mfem::HypreParMatrix> mass_matrix_solver_;
     mfem::HypreParMatrix *implicit_matrix_;
     mfem::real_t current_dt_;
@@ -239,7 +254,6 @@ private:
     mutable mfem::Vector rhs_;
     mfem::Vector rhs_true_;
     int total_implicit_iterations_ = 0;
-    int last_implicit_iterations_ = 0;
 };
 #endif
 } // namespace
@@ -283,6 +297,8 @@ HeatTransferSolver::HeatConfig HeatTransferSolver::ParseConfig(
             throw std::runtime_error("config.output_interval_steps must be > 0.");
         }
     }
+    parsed.output_interval_time = ParseOutputIntervalTime(config);
+    parsed.time_stepping = ParseTimeStepSettings(config);
 
     if (!config.contains("bcs") || !config["bcs"].is_array())
     {
@@ -353,9 +369,11 @@ SolveSummary HeatTransferSolver::Run(
     const HeatConfig parsed = ParseConfig(config, max_boundary_attribute);
 
 #if defined(MFEM_USE_MPI)
-    mfem::ParMesh pmesh(MPI_COMM_WORLD, mesh);
+    ProfiledPhase phase(context.profiler, "fe_space_setup");
+    mfem::ParMesh &pmesh = context.mesh_distributor.Distribute(mesh);
     mfem::H1_FECollection fec(1, dim);
     mfem::ParFiniteElementSpace fespace(&pmesh, &fec);
+    context.profiler.RecordDofs("temperature", fespace.GlobalTrueVSize());
 
     mfem::Array<int> ess_bdr(max_boundary_attribute);
     ess_bdr = 0;
@@ -393,18 +411,22 @@ SolveSummary HeatTransferSolver::Run(
         heat_flux_values[i] = parsed.heat_flux_values[i];
     }
 
+    phase.Switch("assembly");
     ConductionOperator conduction(
         fespace,
         ess_tdof_list,
         parsed.specific_heat,
         parsed.conductivity,
         parsed.source,
-        heat_flux_values
+        heat_flux_values,
+        context.operator_cache
     );
 
-    mfem::BackwardEulerSolver ode_solver;
-    ode_solver.Init(conduction);
+    AdaptiveBackwardEuler stepper(fespace.GetComm(), parsed.time_stepping, parsed.dt, parsed.t_final);
+    stepper.Init(conduction);
+    OutputCadence output_cadence(parsed.output_interval_steps, parsed.output_interval_time);
 
+    phase.Switch("output");
     const fs::path vtk_path(context.vtk_path);
     const std::string collection_name = vtk_path.stem().empty() ? "solution" : vtk_path.stem().string();
     const std::string output_dir = vtk_path.has_parent_path()
@@ -412,7 +434,7 @@ SolveSummary HeatTransferSolver::Run(
         : context.working_directory;
     fs::create_directories(output_dir);
 
-    mfem::ParaViewDataCollection paraview(collection_name, &pmesh);
+    ProbedDataCollection paraview(collection_name, &pmesh, context.probes);
     paraview.SetPrefixPath(output_dir);
     paraview.SetLevelsOfDetail(1);
     paraview.SetDataFormat(mfem::VTKFormat::ASCII);
@@ -429,10 +451,14 @@ SolveSummary HeatTransferSolver::Run(
     temperature.SetFromTrueDofs(temperature_true);
     save_step(step, time);
 
+    phase.Switch("solve");
     while (time + 1.0e-12 < parsed.t_final)
     {
-        mfem::real_t step_dt = std::min(parsed.dt, parsed.t_final - time);
-        ode_solver.Step(temperature_true, time, step_dt);
+        const int implicit_iterations_before = conduction.TotalImplicitIterations();
+        stepper.Step(temperature_true, time, parsed.t_final);
+        context.profiler.RecordLinearSolve(
+            "implicit_cg",
+            conduction.TotalImplicitIterations() - implicit_iterations_before);
 
         temperature.SetFromTrueDofs(temperature_true);
         if (max_boundary_attribute > 0)
@@ -442,14 +468,21 @@ SolveSummary HeatTransferSolver::Run(
         }
 
         ++step;
-        if (step % parsed.output_interval_steps == 0 || time + 1.0e-12 >= parsed.t_final)
+        if (output_cadence.Due(step, time, parsed.t_final))
         {
+            ProfiledPhase output_phase(context.profiler, "output");
             save_step(step, time);
         }
     }
+    phase.End();
+    context.profiler.SetCounter("time_steps", step);
+    RecordTimeStepStatistics(context.profiler, stepper.Statistics());
 
-    std::ofstream vtk_stub(context.vtk_path);
-    vtk_stub << "# temperature field written to " << collection_name << ".pvd\n";
+    if (context.probes.FieldOutput())
+    {
+        std::ofstream vtk_stub(context.vtk_path);
+        vtk_stub << "# temperature field written to " << collection_name << ".pvd\n";
+    }
 
     mfem::Vector mass_times_temperature(temperature_true.Size());
     conduction.MassMatrix().Mult(temperature_true, mass_times_temperature);
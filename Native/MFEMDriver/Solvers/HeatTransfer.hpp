@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "AdaptiveTimeStepper.hpp"
 #include "NavierStokes.hpp"
 
 #include <nlohmann/json.hpp>
@@ -39,6 +40,8 @@ private:
         double dt = 0.01;
         double t_final = 1.0;
         int output_interval_steps = 10;
+        double output_interval_time = 0.0;
+        TimeStepSettings time_stepping;
         std::vector<int> fixed_temperature_marker;
         std::vector<double> fixed_temperature_values;
         std::vector<double> heat_flux_values;
@@ -172,6 +172,8 @@ HyperelasticSolver::HyperelasticConfig HyperelasticSolver::ParseConfig(
         }
     }
 
+    parsed.newton = ParseNewtonSettings(config, parsed.newton);
+
     return parsed;
 }
 
@@ -185,9 +187,11 @@ SolveSummary HyperelasticSolver::Run(
     const HyperelasticConfig parsed = ParseConfig(config, dimension, max_boundary_attribute);
 
 #if defined(MFEM_USE_MPI)
-    mfem::ParMesh pmesh(MPI_COMM_WORLD, mesh);
+    ProfiledPhase phase(context.profiler, "fe_space_setup");
+    mfem::ParMesh &pmesh = context.mesh_distributor.Distribute(mesh);
     mfem::H1_FECollection fec(1, dimension);
-    mfem::ParFiniteElementSpace fespace(&pmesh, &fec, dimension);
+    mfem::ParFiniteElementSpace fespace(&pmesh, &fec, dimension, mfem::Ordering::byVDIM);
+    context.profiler.RecordDofs("displacement", fespace.GlobalTrueVSize());
     mfem::ParGridFunction displacement(&fespace);
     displacement = 0.0;
 
@@ -204,6 +208,7 @@ SolveSummary HyperelasticSolver::Run(
         fespace.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
     }
 
+    phase.Switch("assembly");
     auto material = std::make_unique<mfem::NeoHookeanModel>(parsed.shear_modulus, parsed.bulk_modulus);
     mfem::ParNonlinearForm nonlinear_form(&fespace);
     nonlinear_form.AddDomainIntegrator(new mfem::HyperelasticNLFIntegrator(material.get()));
@@ -249,27 +254,26 @@ SolveSummary HyperelasticSolver::Run(
     mfem::Vector displacement_true(fespace.GetTrueVSize());
     displacement_true = 0.0;
 
-    mfem::HypreSmoother jacobi;
-    jacobi.SetType(mfem::HypreSmoother::Jacobi);
+    LaggedBoomerAMG amg(&fespace);
 
     mfem::CGSolver linear_solver(MPI_COMM_WORLD);
-    linear_solver.iterative_mode = false;
-    linear_solver.SetRelTol(1.0e-8);
-    linear_solver.SetAbsTol(0.0);
-    linear_solver.SetMaxIter(500);
     linear_solver.SetPrintLevel(0);
-    linear_solver.SetPreconditioner(jacobi);
+    linear_solver.SetPreconditioner(amg);
 
-    mfem::NewtonSolver newton_solver(MPI_COMM_WORLD);
-    newton_solver.iterative_mode = false;
-    newton_solver.SetSolver(linear_solver);
+    InexactNewtonSolver newton_solver(MPI_COMM_WORLD, parsed.newton);
     newton_solver.SetOperator(nonlinear_form);
-    newton_solver.SetRelTol(1.0e-8);
-    newton_solver.SetAbsTol(1.0e-10);
-    newton_solver.SetMaxIter(50);
-    newton_solver.SetPrintLevel(0);
-    newton_solver.Mult(rhs_true, displacement_true);
+    newton_solver.SetLinearSolver(linear_solver);
+    newton_solver.SetLaggedPreconditioner(amg);
+    newton_solver.SetProfiler(context.profiler, "newton_cg");
+    phase.Switch("solve");
+    if (!newton_solver.Solve(rhs_true, displacement_true))
+    {
+        throw std::runtime_error("Hyperelasticity Newton solver did not converge.");
+    }
+    const NewtonStatistics &newton_stats = newton_solver.Statistics();
+    RecordNewtonStatistics(context.profiler, newton_stats);
 
+    phase.Switch("output");
     displacement.SetFromTrueDofs(displacement_true);
 
     const fs::path vtk_path(context.vtk_path);
@@ -279,7 +283,7 @@ SolveSummary HyperelasticSolver::Run(
         : context.working_directory;
     fs::create_directories(output_dir);
 
-    mfem::ParaViewDataCollection paraview(collection_name, &pmesh);
+    ProbedDataCollection paraview(collection_name, &pmesh, context.probes);
     paraview.SetPrefixPath(output_dir);
     paraview.SetLevelsOfDetail(1);
     paraview.SetDataFormat(mfem::VTKFormat::ASCII);
@@ -288,8 +292,12 @@ SolveSummary HyperelasticSolver::Run(
     paraview.SetTime(0.0);
     paraview.Save();
 
-    std::ofstream vtk_stub(context.vtk_path);
-    vtk_stub << "# displacement field written to " << collection_name << ".pvd\n";
+    if (context.probes.FieldOutput())
+    {
+        std::ofstream vtk_stub(context.vtk_path);
+        vtk_stub << "# displacement field written to " << collection_name << ".pvd\n";
+    }
+    phase.End();
 
     mfem::Vector residual(rhs_true.Size());
     nonlinear_form.Mult(displacement_true, residual);
@@ -297,7 +305,7 @@ SolveSummary HyperelasticSolver::Run(
 
     SolveSummary summary;
     summary.energy = nonlinear_form.GetEnergy(displacement_true);
-    summary.iterations = newton_solver.GetNumIterations();
+    summary.iterations = newton_stats.newton_iterations;
     summary.error_norm = std::sqrt(mfem::InnerProduct(fespace.GetComm(), residual, residual));
     summary.dimension = dimension;
     return summary;
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "InexactNewton.hpp"
 #include "NavierStokes.hpp"
 
 #include <nlohmann/json.hpp>
@@ -35,6 +36,7 @@ private:
         std::vector<int> essential_boundary_marker;
         std::vector<TractionBoundary> tractions;
         std::vector<double> body_force;
+        NewtonSettings newton;
     };
 
     HyperelasticConfig ParseConfig(
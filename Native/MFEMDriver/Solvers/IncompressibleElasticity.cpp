@@ -83,7 +83,8 @@ public:
           spaces_(spaces),
           block_true_offsets_(block_true_offsets),
           pressure_mass_(pressure_mass),
-          pressure_scale_(pressure_scale)
+          pressure_scale_(pressure_scale),
+          displacement_amg_(spaces[0])
     {
         block_diagonal_ = std::make_unique<mfem::BlockDiagonalPreconditioner>(block_true_offsets_);
 
@@ -111,20 +112,18 @@ public:
         {
             throw std::runtime_error("Incompressible elasticity displacement Jacobian block is not HypreParMatrix.");
         }
-        auto *displacement_block = const_cast<mfem::HypreParMatrix *>(displacement_block_const);
 
-        displacement_amg_ = std::make_unique<mfem::HypreBoomerAMG>(*displacement_block);
-        displacement_amg_->SetPrintLevel(0);
-        if (!spaces_[0]->GetParMesh()->Nonconforming())
-        {
-#if !defined(HYPRE_USING_GPU)
-            displacement_amg_->SetElasticityOptions(spaces_[0]);
-#endif
-        }
-        block_diagonal_->SetDiagonalBlock(0, displacement_amg_.get());
+        // The AMG hierarchy is only rebuilt when the Newton driver asks for it.
+        displacement_amg_.SetOperator(*displacement_block_const);
+        block_diagonal_->SetDiagonalBlock(0, &displacement_amg_);
         block_diagonal_->SetDiagonalBlock(1, pressure_jacobi_.get());
     }
 
+    LaggedBoomerAMG &DisplacementAMG()
+    {
+        return displacement_amg_;
+    }
+
     void Mult(const mfem::Vector &x, mfem::Vector &y) const override
     {
         if (jacobian_ == nullptr || block_diagonal_ == nullptr)
@@ -143,7 +142,7 @@ private:
     const mfem::BlockOperator *jacobian_ = nullptr;
 
     mutable std::unique_ptr<mfem::BlockDiagonalPreconditioner> block_diagonal_;
-    mutable std::unique_ptr<mfem::HypreBoomerAMG> displacement_amg_;
+    LaggedBoomerAMG displacement_amg_;
     mutable std::unique_ptr<mfem::OperatorJacobiSmoother> pressure_jacobi_;
 };
 
@@ -157,11 +156,12 @@ public:
         mfem::Coefficient &shear_modulus,
         mfem::Vector displacement_rhs,
         mfem::Vector pressure_rhs,
-        double bulk_modulus)
+        double bulk_modulus,
+        const NewtonSettings &newton_settings)
         : mfem::Operator(block_true_offsets[block_true_offsets.Size() - 1]),
           block_true_offsets_(block_true_offsets),
           rhs_true_(height),
-          newton_solver_(spaces[0]->GetComm()),
+          newton_solver_(spaces[0]->GetComm(), newton_settings),
           linear_solver_(spaces[0]->GetComm())
     {
         spaces.Copy(spaces_);
@@ -219,27 +219,24 @@ public:
             pressure_scale
         );
 
-        linear_solver_.iterative_mode = false;
-        linear_solver_.SetRelTol(1.0e-10);
-        linear_solver_.SetAbsTol(0.0);
-        linear_solver_.SetMaxIter(400);
         linear_solver_.SetPrintLevel(0);
         linear_solver_.SetPreconditioner(*preconditioner_);
 
-        newton_solver_.iterative_mode = true;
-        newton_solver_.SetSolver(linear_solver_);
         newton_solver_.SetOperator(*this);
-        newton_solver_.SetRelTol(1.0e-8);
-        newton_solver_.SetAbsTol(1.0e-10);
-        newton_solver_.SetMaxIter(60);
-        newton_solver_.SetPrintLevel(0);
+        newton_solver_.SetLinearSolver(linear_solver_);
+        newton_solver_.SetLaggedPreconditioner(preconditioner_->DisplacementAMG());
     }
 
-    void Solve(mfem::Vector &state) const
+    void SetProfiler(SolverProfiler &profiler)
     {
-        mfem::Vector zero;
-        newton_solver_.Mult(zero, state);
-        if (!newton_solver_.GetConverged())
+        newton_solver_.SetProfiler(profiler, "newton_minres");
+    }
+
+    void Solve(mfem::Vector &state)
+    {
+        // Tractions are ramped in by the Newton driver's load stepping, so
+        // the operator itself only evaluates the internal forces.
+        if (!newton_solver_.Solve(rhs_true_, state))
         {
             throw std::runtime_error("IncompressibleElasticity Newton solver did not converge.");
         }
@@ -248,22 +245,23 @@ public:
     void Mult(const mfem::Vector &x, mfem::Vector &y) const override
     {
         h_form_->Mult(x, y);
-        y -= rhs_true_;
     }
 
-    mfem::Operator &GetGradient(const mfem::Vector &x) const override
+    // Residual of the full-load problem, for reporting.
+    void FullLoadResidual(const mfem::Vector &x, mfem::Vector &y) const
     {
-        return h_form_->GetGradient(x);
+        h_form_->Mult(x, y);
+        y -= rhs_true_;
     }
 
-    int NewtonIterations() const
+    mfem::Operator &GetGradient(const mfem::Vector &x) const override
     {
-        return newton_solver_.GetNumIterations();
+        return h_form_->GetGradient(x);
     }
 
-    int LinearIterations() const
+    const NewtonStatistics &Statistics() const
     {
-        return linear_solver_.GetNumIterations();
+        return newton_solver_.Statistics();
     }
 
     bool PressureGaugeFixApplied() const
@@ -279,13 +277,13 @@ public:
 private:
     mfem::Array<mfem::ParFiniteElementSpace *> spaces_;
     mfem::Array<int> block_true_offsets_;
-    mutable mfem::Vector rhs_true_;
+    mfem::Vector rhs_true_;
 
     std::unique_ptr<mfem::ParBlockNonlinearForm> h_form_;
     std::unique_ptr<mfem::HypreParMatrix> pressure_mass_;
 
-    mutable mfem::NewtonSolver newton_solver_;
-    mutable mfem::MINRESSolver linear_solver_;
+    InexactNewtonSolver newton_solver_;
+    mfem::MINRESSolver linear_solver_;
     std::unique_ptr<IncompressibleElasticityPreconditioner> preconditioner_;
     mfem::Array<int> displacement_ess_tdof_;
     mfem::Array<int> pressure_ess_tdof_;
@@ -407,6 +405,11 @@ IncompressibleElasticitySolver::IncompressibleElasticityConfig IncompressibleEla
         }
     }
 
+    NewtonSettings newton_defaults;
+    newton_defaults.max_iterations = 60;
+    newton_defaults.max_linear_iterations = 400;
+    parsed.newton = ParseNewtonSettings(config, newton_defaults);
+
     return parsed;
 }
 
@@ -425,7 +428,8 @@ SolveSummary IncompressibleElasticitySolver::Run(
     const IncompressibleElasticityConfig parsed = ParseConfig(config, dimension, max_boundary_attribute);
 
 #if defined(MFEM_USE_MPI)
-    mfem::ParMesh pmesh(MPI_COMM_WORLD, mesh);
+    ProfiledPhase phase(context.profiler, "fe_space_setup");
+    mfem::ParMesh &pmesh = context.mesh_distributor.Distribute(mesh);
 
     const int pressure_order = std::max(0, parsed.order - 1);
     mfem::H1_FECollection displacement_fec(parsed.order, dimension);
@@ -438,6 +442,8 @@ SolveSummary IncompressibleElasticitySolver::Run(
         mfem::Ordering::byVDIM
     );
     mfem::ParFiniteElementSpace pressure_space(&pmesh, &pressure_fec);
+    context.profiler.RecordDofs("displacement", displacement_space.GlobalTrueVSize());
+    context.profiler.RecordDofs("pressure", pressure_space.GlobalTrueVSize());
 
     mfem::Array<mfem::ParFiniteElementSpace *> spaces(2);
     spaces[0] = &displacement_space;
@@ -471,6 +477,7 @@ SolveSummary IncompressibleElasticitySolver::Run(
     reference_configuration_gf.ProjectCoefficient(reference_coeff);
     pressure = 0.0;
 
+    phase.Switch("assembly");
     mfem::ParLinearForm displacement_rhs_form(&displacement_space);
     std::vector<std::unique_ptr<mfem::VectorConstantCoefficient>> traction_coeffs;
     std::vector<mfem::Array<int>> traction_markers;
@@ -509,11 +516,16 @@ SolveSummary IncompressibleElasticitySolver::Run(
         shear_modulus_coeff,
         displacement_rhs_true,
         pressure_rhs_true,
-        parsed.bulk_modulus
+        parsed.bulk_modulus,
+        parsed.newton
     );
+    oper.SetProfiler(context.profiler);
 
+    phase.Switch("solve");
     oper.Solve(state);
+    RecordNewtonStatistics(context.profiler, oper.Statistics());
 
+    phase.Switch("output");
     configuration.Distribute(&(state.GetBlock(0)));
     pressure.Distribute(&(state.GetBlock(1)));
     subtract(configuration, reference_configuration_gf, displacement);
@@ -525,7 +537,7 @@ SolveSummary IncompressibleElasticitySolver::Run(
         : context.working_directory;
     fs::create_directories(output_dir);
 
-    mfem::ParaViewDataCollection paraview(collection_name, &pmesh);
+    ProbedDataCollection paraview(collection_name, &pmesh, context.probes);
     paraview.SetPrefixPath(output_dir);
     paraview.SetLevelsOfDetail(1);
     paraview.SetDataFormat(mfem::VTKFormat::ASCII);
@@ -535,15 +547,19 @@ SolveSummary IncompressibleElasticitySolver::Run(
     paraview.SetTime(0.0);
     paraview.Save();
 
-    std::ofstream vtk_stub(context.vtk_path);
-    vtk_stub << "# incompressible elasticity displacement/pressure written to " << collection_name << ".pvd\n";
+    if (context.probes.FieldOutput())
+    {
+        std::ofstream vtk_stub(context.vtk_path);
+        vtk_stub << "# incompressible elasticity displacement/pressure written to " << collection_name << ".pvd\n";
+    }
+    phase.End();
 
     mfem::Vector residual(state.Size());
-    oper.Mult(state, residual);
+    oper.FullLoadResidual(state, residual);
 
     SolveSummary summary;
     summary.energy = oper.Energy(state);
-    summary.iterations = oper.NewtonIterations();
+    summary.iterations = oper.Statistics().newton_iterations;
     summary.error_norm = std::sqrt(mfem::InnerProduct(displacement_space.GetComm(), residual, residual));
     summary.dimension = dimension;
     if (!std::isfinite(summary.error_norm))
@@ -562,8 +578,9 @@ SolveSummary IncompressibleElasticitySolver::Run(
         {"bulk_modulus", parsed.bulk_modulus},
         {"traction_boundaries", static_cast<int>(parsed.tractions.size())},
         {"pressure_gauge_fix_applied", oper.PressureGaugeFixApplied()},
-        {"newton_iterations", oper.NewtonIterations()},
-        {"linear_iterations", oper.LinearIterations()},
+        {"newton_iterations", oper.Statistics().newton_iterations},
+        {"linear_iterations", oper.Statistics().linear_iterations},
+        {"nonlinear_solver", NewtonStatisticsToJson(oper.Statistics())},
         {"residual_norm", summary.error_norm}
     };
     std::ofstream metadata_out(metadata_path);
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "InexactNewton.hpp"
 #include "NavierStokes.hpp"
 
 #include <nlohmann/json.hpp>
@@ -35,6 +36,7 @@ private:
         int order = 2;
         std::vector<int> essential_boundary_marker;
         std::vector<TractionBoundary> tractions;
+        NewtonSettings newton;
     };
 
     IncompressibleElasticityConfig ParseConfig(
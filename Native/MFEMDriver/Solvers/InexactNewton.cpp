@@ -0,0 +1,386 @@
+// SPDX-License-Identifier: MIT
+// AutoSage MFEM driver extension.
+// Uses MFEM (BSD-3-Clause). See THIRD_PARTY_NOTICES.md.
+
+#include "InexactNewton.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using json = nlohmann::json;
+
+namespace
+{
+// Eisenstat-Walker "choice 2" constants.
+constexpr double kForcingGamma = 0.9;
+constexpr double kForcingAlpha = 2.0;
+// Armijo constant for the inexact-Newton sufficient decrease test.
+constexpr double kSufficientDecrease = 1.0e-4;
+
+void read_number(const json &nonlinear, const char *key, double lower_bound, bool inclusive, double &value)
+{
+    if (!nonlinear.contains(key))
+    {
+        return;
+    }
+    const std::string field = std::string("config.nonlinear.") + key;
+    if (!nonlinear[key].is_number())
+    {
+        throw std::runtime_error(field + " must be numeric.");
+    }
+    const double parsed = nonlinear[key].get<double>();
+    if (!std::isfinite(parsed) || (inclusive ? parsed < lower_bound : parsed <= lower_bound))
+    {
+        std::ostringstream message;
+        message << field << " must be " << (inclusive ? ">= " : "> ") << lower_bound << ".";
+        throw std::runtime_error(message.str());
+    }
+    value = parsed;
+}
+
+void read_integer(const json &nonlinear, const char *key, int lower_bound, int &value)
+{
+    if (!nonlinear.contains(key))
+    {
+        return;
+    }
+    const std::string field = std::string("config.nonlinear.") + key;
+    if (!nonlinear[key].is_number_integer())
+    {
+        throw std::runtime_error(field + " must be an integer.");
+    }
+    const int parsed = nonlinear[key].get<int>();
+    if (parsed < lower_bound)
+    {
+        throw std::runtime_error(field + " must be >= " + std::to_string(lower_bound) + ".");
+    }
+    value = parsed;
+}
+} // namespace
+
+namespace autosage
+{
+NewtonSettings ParseNewtonSettings(const json &config, NewtonSettings defaults)
+{
+    if (!config.contains("nonlinear"))
+    {
+        return defaults;
+    }
+    const json &nonlinear = config["nonlinear"];
+    if (!nonlinear.is_object())
+    {
+        throw std::runtime_error("config.nonlinear must be an object when provided.");
+    }
+
+    NewtonSettings settings = defaults;
+    read_number(nonlinear, "rel_tol", 0.0, false, settings.rel_tol);
+    read_number(nonlinear, "abs_tol", 0.0, true, settings.abs_tol);
+    read_integer(nonlinear, "max_iterations", 1, settings.max_iterations);
+    if (nonlinear.contains("adaptive_linear_tolerance"))
+    {
+        if (!nonlinear["adaptive_linear_tolerance"].is_boolean())
+        {
+            throw std::runtime_error("config.nonlinear.adaptive_linear_tolerance must be a boolean.");
+        }
+        settings.adaptive_linear_tolerance = nonlinear["adaptive_linear_tolerance"].get<bool>();
+    }
+    read_number(nonlinear, "initial_linear_rel_tol", 0.0, false, settings.initial_linear_rel_tol);
+    read_number(nonlinear, "max_linear_rel_tol", 0.0, false, settings.max_linear_rel_tol);
+    read_number(nonlinear, "min_linear_rel_tol", 0.0, false, settings.min_linear_rel_tol);
+    read_integer(nonlinear, "max_linear_iterations", 1, settings.max_linear_iterations);
+    read_number(nonlinear, "preconditioner_rebuild_ratio", 1.0, true, settings.preconditioner_rebuild_ratio);
+    read_integer(nonlinear, "max_line_search_backtracks", 0, settings.max_line_search_backtracks);
+    read_integer(nonlinear, "load_steps", 1, settings.load_steps);
+    read_integer(nonlinear, "max_load_step_cuts", 0, settings.max_load_step_cuts);
+
+    if (settings.max_linear_rel_tol >= 1.0 || settings.initial_linear_rel_tol >= 1.0)
+    {
+        throw std::runtime_error("config.nonlinear linear tolerances must be < 1.");
+    }
+    if (settings.min_linear_rel_tol > settings.max_linear_rel_tol)
+    {
+        throw std::runtime_error("config.nonlinear.min_linear_rel_tol must not exceed max_linear_rel_tol.");
+    }
+    return settings;
+}
+
+void RecordNewtonStatistics(SolverProfiler &profiler, const NewtonStatistics &statistics)
+{
+    profiler.SetCounter("newton_iterations", statistics.newton_iterations);
+    profiler.SetCounter("linear_iterations", statistics.linear_iterations);
+    profiler.SetCounter("preconditioner_setups", statistics.preconditioner_setups);
+    profiler.SetCounter("line_search_backtracks", statistics.line_search_backtracks);
+    profiler.SetCounter("load_steps", statistics.load_steps);
+    profiler.SetCounter("load_step_cuts", statistics.load_step_cuts);
+}
+
+json NewtonStatisticsToJson(const NewtonStatistics &statistics)
+{
+    return json{
+        {"newton_iterations", statistics.newton_iterations},
+        {"linear_iterations", statistics.linear_iterations},
+        {"preconditioner_setups", statistics.preconditioner_setups},
+        {"line_search_backtracks", statistics.line_search_backtracks},
+        {"load_steps", statistics.load_steps},
+        {"load_step_cuts", statistics.load_step_cuts},
+        {"converged", statistics.converged},
+        {"residual_norm", statistics.residual_norm}
+    };
+}
+
+#if defined(MFEM_USE_MPI)
+LaggedBoomerAMG::LaggedBoomerAMG(mfem::ParFiniteElementSpace *elasticity_space)
+    : elasticity_space_(elasticity_space)
+{
+}
+
+void LaggedBoomerAMG::SetOperator(const mfem::Operator &op)
+{
+    const auto *matrix = dynamic_cast<const mfem::HypreParMatrix *>(&op);
+    if (matrix == nullptr)
+    {
+        throw std::runtime_error("LaggedBoomerAMG requires a HypreParMatrix operator.");
+    }
+    height = matrix->Height();
+    width = matrix->Width();
+    if (amg_ != nullptr && !rebuild_requested_)
+    {
+        return;
+    }
+
+    amg_.reset();
+    frozen_matrix_ = std::make_unique<mfem::HypreParMatrix>(*matrix);
+    amg_ = std::make_unique<mfem::HypreBoomerAMG>(*frozen_matrix_);
+    amg_->SetPrintLevel(0);
+    if (elasticity_space_ != nullptr && !elasticity_space_->GetParMesh()->Nonconforming())
+    {
+#if !defined(HYPRE_USING_GPU)
+        amg_->SetElasticityOptions(elasticity_space_);
+#endif
+    }
+    rebuild_requested_ = false;
+    ++setups_;
+}
+
+void LaggedBoomerAMG::Mult(const mfem::Vector &x, mfem::Vector &y) const
+{
+    if (amg_ == nullptr)
+    {
+        throw std::runtime_error("LaggedBoomerAMG used before SetOperator.");
+    }
+    amg_->Mult(x, y);
+}
+
+InexactNewtonSolver::InexactNewtonSolver(MPI_Comm comm, const NewtonSettings &settings)
+    : comm_(comm),
+      settings_(settings)
+{
+}
+
+void InexactNewtonSolver::SetProfiler(SolverProfiler &profiler, const std::string &linear_solver_name)
+{
+    profiler_ = &profiler;
+    linear_solver_name_ = linear_solver_name;
+}
+
+bool InexactNewtonSolver::Solve(const mfem::Vector &rhs, mfem::Vector &x)
+{
+    if (residual_ == nullptr || linear_solver_ == nullptr)
+    {
+        throw std::runtime_error("InexactNewtonSolver requires an operator and a linear solver.");
+    }
+
+    statistics_ = NewtonStatistics{};
+    const int setups_before = lagged_amg_ != nullptr ? lagged_amg_->Setups() : 0;
+
+    mfem::Vector converged_state(x);
+    mfem::Vector step_rhs(rhs.Size());
+    const double nominal_increment = 1.0 / settings_.load_steps;
+    double increment = nominal_increment;
+    double load = 0.0;
+    bool converged = true;
+
+    while (load < 1.0 - 1.0e-12)
+    {
+        const double target = std::min(1.0, load + increment);
+        step_rhs = rhs;
+        step_rhs *= target;
+        if (SolveLoadStep(step_rhs, x))
+        {
+            load = target;
+            converged_state = x;
+            ++statistics_.load_steps;
+            increment = std::min(2.0 * increment, nominal_increment);
+            continue;
+        }
+
+        if (statistics_.load_step_cuts >= settings_.max_load_step_cuts)
+        {
+            converged = false;
+            break;
+        }
+        ++statistics_.load_step_cuts;
+        increment *= 0.5;
+        x = converged_state;
+        if (lagged_amg_ != nullptr)
+        {
+            lagged_amg_->RequestRebuild();
+        }
+    }
+
+    statistics_.converged = converged;
+    statistics_.preconditioner_setups = lagged_amg_ != nullptr ? lagged_amg_->Setups() - setups_before : 0;
+    return converged;
+}
+
+bool InexactNewtonSolver::SolveLoadStep(const mfem::Vector &rhs, mfem::Vector &x)
+{
+    mfem::Vector residual(x.Size());
+    mfem::Vector correction(x.Size());
+    mfem::Vector trial(x.Size());
+
+    double norm = ResidualNorm(x, rhs, residual);
+    if (!std::isfinite(norm))
+    {
+        return false;
+    }
+    const double norm_goal = std::max(settings_.rel_tol * norm, settings_.abs_tol);
+    double eta = settings_.adaptive_linear_tolerance ? settings_.initial_linear_rel_tol : settings_.min_linear_rel_tol;
+
+    for (int iteration = 0;; ++iteration)
+    {
+        statistics_.residual_norm = norm;
+        if (norm <= norm_goal)
+        {
+            return true;
+        }
+        if (iteration >= settings_.max_iterations)
+        {
+            return false;
+        }
+
+        SolveLinearized(residual_->GetGradient(x), residual, correction, eta);
+        ++statistics_.newton_iterations;
+
+        // Backtrack on ||F|| until the inexact-Newton sufficient decrease
+        // condition holds; a step that cannot be rescued fails the load step.
+        double scale = 1.0;
+        double trial_norm = 0.0;
+        for (int backtrack = 0;; ++backtrack)
+        {
+            mfem::add(x, -scale, correction, trial);
+            trial_norm = ResidualNorm(trial, rhs, residual);
+            if (std::isfinite(trial_norm) &&
+                trial_norm <= (1.0 - kSufficientDecrease * scale * (1.0 - eta)) * norm)
+            {
+                break;
+            }
+            if (backtrack >= settings_.max_line_search_backtracks)
+            {
+                return false;
+            }
+            scale *= 0.5;
+            ++statistics_.line_search_backtracks;
+        }
+
+        x = trial;
+        const double previous_norm = norm;
+        norm = trial_norm;
+        if (settings_.adaptive_linear_tolerance)
+        {
+            eta = NextForcingTerm(eta, norm, previous_norm, norm_goal);
+        }
+    }
+}
+
+void InexactNewtonSolver::SolveLinearized(
+    const mfem::Operator &jacobian,
+    const mfem::Vector &residual,
+    mfem::Vector &correction,
+    double linear_rel_tol)
+{
+    const int setups_before = lagged_amg_ != nullptr ? lagged_amg_->Setups() : 0;
+    linear_solver_->iterative_mode = false;
+    linear_solver_->SetRelTol(linear_rel_tol);
+    linear_solver_->SetAbsTol(0.0);
+    linear_solver_->SetMaxIter(settings_.max_linear_iterations);
+    linear_solver_->SetOperator(jacobian);
+    linear_solver_->Mult(residual, correction);
+
+    int iterations = linear_solver_->GetNumIterations();
+    statistics_.linear_iterations += iterations;
+    if (profiler_ != nullptr)
+    {
+        profiler_->RecordLinearSolve(linear_solver_name_, iterations);
+    }
+    if (lagged_amg_ == nullptr)
+    {
+        return;
+    }
+
+    bool fresh = lagged_amg_->Setups() != setups_before;
+    if (!linear_solver_->GetConverged() && !fresh)
+    {
+        // A stale hierarchy is the usual reason for a failed Krylov solve;
+        // rebuild it and try once more before handing the step to the line search.
+        lagged_amg_->RequestRebuild();
+        linear_solver_->SetOperator(jacobian);
+        linear_solver_->Mult(residual, correction);
+        iterations = linear_solver_->GetNumIterations();
+        statistics_.linear_iterations += iterations;
+        if (profiler_ != nullptr)
+        {
+            profiler_->RecordLinearSolve(linear_solver_name_, iterations);
+        }
+        fresh = true;
+    }
+
+    const double digits = std::max(1.0, -std::log10(linear_rel_tol));
+    const double cost_per_digit = iterations / digits;
+    if (fresh)
+    {
+        baseline_cost_per_digit_ = cost_per_digit;
+    }
+    else if (cost_per_digit > settings_.preconditioner_rebuild_ratio * std::max(1.0, baseline_cost_per_digit_))
+    {
+        lagged_amg_->RequestRebuild();
+    }
+}
+
+double InexactNewtonSolver::ResidualNorm(
+    const mfem::Vector &x,
+    const mfem::Vector &rhs,
+    mfem::Vector &residual) const
+{
+    residual_->Mult(x, residual);
+    residual -= rhs;
+    return std::sqrt(mfem::InnerProduct(comm_, residual, residual));
+}
+
+double InexactNewtonSolver::NextForcingTerm(
+    double eta,
+    double norm,
+    double previous_norm,
+    double norm_goal) const
+{
+    const double ratio = previous_norm > 0.0 ? norm / previous_norm : 0.0;
+    double next = kForcingGamma * std::pow(ratio, kForcingAlpha);
+    // Safeguard from Eisenstat-Walker: do not let eta collapse while the
+    // previous forcing term was still large.
+    const double safeguard = kForcingGamma * std::pow(eta, kForcingAlpha);
+    if (safeguard > 0.1)
+    {
+        next = std::max(next, safeguard);
+    }
+    // Solving much below the remaining Newton goal is wasted work.
+    if (norm > 0.0)
+    {
+        next = std::max(next, 0.5 * norm_goal / norm);
+    }
+    return std::clamp(next, settings_.min_linear_rel_tol, settings_.max_linear_rel_tol);
+}
+#endif
+} // namespace autosage
@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: MIT
+// AutoSage MFEM driver extension.
+// Uses MFEM (BSD-3-Clause). See THIRD_PARTY_NOTICES.md.
+
+#pragma once
+
+#include "SolverProfiler.hpp"
+
+#include <mfem.hpp>
+#include <nlohmann/json.hpp>
+
+#include <memory>
+#include <string>
+
+namespace autosage
+{
+// Controls for InexactNewtonSolver. Solvers start from their own defaults and
+// let the optional config.nonlinear object override individual fields.
+struct NewtonSettings
+{
+    double rel_tol = 1.0e-8;
+    double abs_tol = 1.0e-10;
+    int max_iterations = 50;
+
+    // Eisenstat-Walker forcing terms. When disabled every linear solve runs
+    // to min_linear_rel_tol.
+    bool adaptive_linear_tolerance = true;
+    double initial_linear_rel_tol = 1.0e-2;
+    double max_linear_rel_tol = 0.5;
+    double min_linear_rel_tol = 1.0e-10;
+    int max_linear_iterations = 500;
+
+    // A lagged AMG hierarchy is rebuilt once the Krylov iterations spent per
+    // digit of residual reduction exceed this multiple of the cost measured
+    // right after the last rebuild.
+    double preconditioner_rebuild_ratio = 1.5;
+
+    int max_line_search_backtracks = 6;
+    int load_steps = 1;
+    int max_load_step_cuts = 4;
+};
+
+NewtonSettings ParseNewtonSettings(const nlohmann::json &config, NewtonSettings defaults);
+
+struct NewtonStatistics
+{
+    int newton_iterations = 0;
+    int linear_iterations = 0;
+    int preconditioner_setups = 0;
+    int line_search_backtracks = 0;
+    int load_steps = 0;
+    int load_step_cuts = 0;
+    double residual_norm = 0.0;
+    bool converged = false;
+};
+
+void RecordNewtonStatistics(SolverProfiler &profiler, const NewtonStatistics &statistics);
+nlohmann::json NewtonStatisticsToJson(const NewtonStatistics &statistics);
+
+#if defined(MFEM_USE_MPI)
+// BoomerAMG that keeps its hierarchy across SetOperator calls until
+// RequestRebuild() is called. The matrix it was built from is copied because
+// nonlinear forms free the previous gradient on every GetGradient call.
+class LaggedBoomerAMG final : public mfem::Solver
+{
+public:
+    // A non-null space enables the elasticity AMG options; it must use
+    // Ordering::byVDIM.
+    explicit LaggedBoomerAMG(mfem::ParFiniteElementSpace *elasticity_space = nullptr);
+
+    void SetOperator(const mfem::Operator &op) override;
+    void Mult(const mfem::Vector &x, mfem::Vector &y) const override;
+
+    void RequestRebuild() { rebuild_requested_ = true; }
+    int Setups() const { return setups_; }
+
+private:
+    mfem::ParFiniteElementSpace *elasticity_space_ = nullptr;
+    std::unique_ptr<mfem::HypreParMatrix> frozen_matrix_;
+    std::unique_ptr<mfem::HypreBoomerAMG> amg_;
+    bool rebuild_requested_ = true;
+    int setups_ = 0;
+};
+
+// Newton-Krylov driver for F(x) = b with Eisenstat-Walker linear tolerances,
+// backtracking line search and load continuation: b is applied in
+// settings.load_steps increments, and a load step that fails is retried
+// from the last converged state with half the increment.
+class InexactNewtonSolver
+{
+public:
+    InexactNewtonSolver(MPI_Comm comm, const NewtonSettings &settings);
+
+    // F must implement GetGradient; the linear solver's preconditioner is
+    // updated through IterativeSolver::SetOperator on every Newton step.
+    void SetOperator(const mfem::Operator &residual) { residual_ = &residual; }
+    void SetLinearSolver(mfem::IterativeSolver &solver) { linear_solver_ = &solver; }
+    void SetLaggedPreconditioner(LaggedBoomerAMG &amg) { lagged_amg_ = &amg; }
+    void SetProfiler(SolverProfiler &profiler, const std::string &linear_solver_name);
+
+    // x holds the initial guess on entry. Returns false when the last load
+    // step could not be completed; x then holds the final Newton iterate.
+    bool Solve(const mfem::Vector &rhs, mfem::Vector &x);
+
+    const NewtonStatistics &Statistics() const { return statistics_; }
+
+private:
+    bool SolveLoadStep(const mfem::Vector &rhs, mfem::Vector &x);
+    void SolveLinearized(
+        const mfem::Operator &jacobian,
+        const mfem::Vector &residual,
+        mfem::Vector &correction,
+        double linear_rel_tol);
+    double ResidualNorm(const mfem::Vector &x, const mfem::Vector &rhs, mfem::Vector &residual) const;
+    double NextForcingTerm(double eta, double norm, double previous_norm, double norm_goal) const;
+
+    MPI_Comm comm_;
+    NewtonSettings settings_;
+    const mfem::Operator *residual_ = nullptr;
+    mfem::IterativeSolver *linear_solver_ = nullptr;
+    LaggedBoomerAMG *lagged_amg_ = nullptr;
+    SolverProfiler *profiler_ = nullptr;
+    std::string linear_solver_name_;
+    double baseline_cost_per_digit_ = 0.0;
+    NewtonStatistics statistics_;
+};
+#endif
+} // namespace autosage
@@ -43,11 +43,61 @@ double require_positive_number(const json &config, const char *field_name)
     return value;
 }
 
+double optional_number(const json &config, const char *field_name, double fallback)
+{
+    if (!config.contains(field_name)) { return fallback; }
+    if (!config[field_name].is_number())
+    {
+        throw std::runtime_error(std::string("config.") + field_name + " must be numeric.");
+    }
+    return config[field_name].get<double>();
+}
+
 #if defined(MFEM_USE_MPI)
+// Linear resistivity model, sigma(T) = sigma_0 / (1 + alpha (T - T_ref)).
+// The denominator is floored so a large negative alpha cannot flip the sign.
+class ElectricalConductivityCoefficient final : public mfem::Coefficient
+{
+public:
+    ElectricalConductivityCoefficient(
+        const mfem::ParGridFunction &temperature,
+        double reference_conductivity,
+        double temperature_coefficient,
+        double reference_temperature)
+        : temperature_(temperature),
+          reference_conductivity_(reference_conductivity),
+          temperature_coefficient_(temperature_coefficient),
+          reference_temperature_(reference_temperature)
+    {
+    }
+
+    bool TemperatureDependent() const
+    {
+        return temperature_coefficient_ != 0.0;
+    }
+
+    mfem::real_t Eval(mfem::ElementTransformation &T, const mfem::IntegrationPoint &ip) override
+    {
+        if (!TemperatureDependent())
+        {
+            return reference_conductivity_;
+        }
+        const double temperature = temperature_.GetValue(T, ip);
+        const double resistivity_ratio = 1.0 + temperature_coefficient_ * (temperature - reference_temperature_);
+        return reference_conductivity_ / std::max(resistivity_ratio, 1.0e-3);
+    }
+
+private:
+    const mfem::ParGridFunction &temperature_;
+    double reference_conductivity_;
+    double temperature_coefficient_;
+    double reference_temperature_;
+};
+
 class JouleSourceCoefficient final : public mfem::Coefficient
 {
 public:
-    JouleSourceCoefficient(const mfem::ParGridFunction &potential, double conductivity, int dimension)
+    JouleSourceCoefficient(const mfem::ParGridFunction &potential, mfem::Coefficient &conductivity, int dimension)
         : potential_(potential),
           conductivity_(conductivity),
           gradient_(dimension)
@@ -58,12 +108,12 @@ public:
     {
         T.SetIntPoint(&ip);
         potential_.GetGradient(T, gradient_);
-        return conductivity_ * (gradient_ * gradient_);
+        return conductivity_.Eval(T, ip) * (gradient_ * gradient_);
     }
 
 private:
     const mfem::ParGridFunction &potential_;
-    double conductivity_;
+    mfem::Coefficient &conductivity_;
     mfem::Vector gradient_;
 };
 
@@ -83,7 +133,7 @@ public:
         mfem::ParGridFunction &electric_potential,
         double heat_capacity,
         double thermal_conductivity,
-        double electrical_conductivity
+        ElectricalConductivityCoefficient &electrical_conductivity
     )
         : mfem::TimeDependentOperator(thermal_fespace.GetTrueVSize(), 0.0),
           thermal_fespace_(thermal_fespace),
@@ -97,7 +147,7 @@ public:
           temperature_(temperature),
           electric_potential_(electric_potential),
           electrical_conductivity_(electrical_conductivity),
-          joule_source_coefficient_(electric_potential_, electrical_conductivity, thermal_fespace.GetMesh()->Dimension()),
+          joule_source_coefficient_(electric_potential_, electrical_conductivity_, thermal_fespace.GetMesh()->Dimension()),
           implicit_matrix_(nullptr),
           current_dt_(-1.0),
           mass_solver_(thermal_fespace.GetComm()),
@@ -138,11 +188,6 @@ public:
         thermal_rhs_form_ = std::make_unique<mfem::ParLinearForm>(&thermal_fespace_);
         thermal_rhs_form_->AddDomainIntegrator(new mfem::DomainLFIntegrator(joule_source_coefficient_));
 
-        mfem::ConstantCoefficient electrical_conductivity_coeff(electrical_conductivity_);
-        electric_form_ = std::make_unique<mfem::ParBilinearForm>(&electric_fespace_);
-        electric_form_->AddDomainIntegrator(new mfem::DiffusionIntegrator(electrical_conductivity_coeff));
-        electric_form_->Assemble(0);
-
         electric_solver_.iterative_mode = false;
         electric_solver_.SetRelTol(1.0e-12);
         electric_solver_.SetAbsTol(0.0);
@@ -157,7 +202,7 @@ public:
         implicit_prec_.SetType(mfem::HypreSmoother::Jacobi);
         implicit_solver_.SetPreconditioner(implicit_prec_);
 
-        UpdateElectricPotentialAndJouleSource();
+        SolveElectric();
     }
 
     ~JouleHeatingOperator() override
@@ -175,10 +220,10 @@ public:
         mass_solver_.Mult(thermal_rhs_, du_dt);
     }
 
+    // The Joule load is whatever the last SolveElectric() produced; the
+    // caller decides when the electric problem is worth re-solving.
     void ImplicitSolve(const mfem::real_t dt, const mfem::Vector &u, mfem::Vector &k) override
     {
-        UpdateElectricPotentialAndJouleSource();
-
         if (implicit_matrix_ == nullptr || std::abs(dt - current_dt_) > 1.0e-15)
         {
             delete implicit_matrix_;
@@ -211,6 +256,11 @@ public:
         return total_electric_iterations_;
     }
 
+    int ElectricSolves() const
+    {
+        return electric_solves_;
+    }
+
     const mfem::HypreParMatrix &ThermalMassMatrix() const
     {
         return thermal_mass_matrix_;
@@ -226,9 +276,20 @@ public:
         return thermal_rhs_true_;
     }
 
-private:
-    void UpdateElectricPotentialAndJouleSource()
+    // Solves for the potential with the conductivity at the current
+    // temperature field and rebuilds the Joule heat load. Returns the
+    // relative change of the load, i.e. the error the previous load carried
+    // while it was being reused (0 for the first solve).
+    double SolveElectric()
     {
+        // A temperature-independent operator only needs assembling once.
+        if (!electric_form_ || electrical_conductivity_.TemperatureDependent())
+        {
+            electric_form_ = std::make_unique<mfem::ParBilinearForm>(&electric_fespace_);
+            electric_form_->AddDomainIntegrator(new mfem::DiffusionIntegrator(electrical_conductivity_));
+            electric_form_->Assemble(0);
+        }
+
         if (electric_ess_bdr_.Size() > 0)
         {
             electric_potential_.ProjectBdrCoefficient(electric_fixed_coeff_, electric_ess_bdr_);
@@ -278,11 +339,25 @@ private:
 
         electric_form_->RecoverFEMSolution(electric_X, electric_rhs, electric_potential_);
 
+        const mfem::Vector previous_load(thermal_rhs_true_);
         thermal_rhs_form_->Assemble();
         thermal_rhs_form_->ParallelAssemble(thermal_rhs_true_);
         zero_thermal_essential_entries(thermal_rhs_true_);
+
+        ++electric_solves_;
+        if (electric_solves_ == 1)
+        {
+            return 0.0;
+        }
+        mfem::Vector load_change(thermal_rhs_true_);
+        load_change -= previous_load;
+        const MPI_Comm comm = thermal_fespace_.GetComm();
+        const double load_norm = std::sqrt(mfem::InnerProduct(comm, thermal_rhs_true_, thermal_rhs_true_));
+        const double change_norm = std::sqrt(mfem::InnerProduct(comm, load_change, load_change));
+        return load_norm > 0.0 ? change_norm / load_norm : change_norm;
     }
 
+private:
     void zero_thermal_essential_entries(mfem::Vector &vector) const
     {
         for (int i = 0; i < thermal_ess_tdof_list_.Size(); ++i)
@@ -305,7 +380,7 @@ private:
     mfem::PWConstCoefficient &electric_fixed_coeff_;
     mfem::ParGridFunction &temperature_;
     mfem::ParGridFunction &electric_potential_;
-    double electrical_conductivity_;
+    ElectricalConductivityCoefficient &electrical_conductivity_;
 
     JouleSourceCoefficient joule_source_coefficient_;
 
@@ -332,6 +407,7 @@ private:
 
     int total_implicit_iterations_ = 0;
     int total_electric_iterations_ = 0;
+    int electric_solves_ = 0;
 };
 #endif
 } // namespace
@@ -366,6 +442,55 @@ JouleHeatingSolver::ParsedConfig JouleHeatingSolver::ParseConfig(
             throw std::runtime_error("config.output_interval_steps must be > 0.");
         }
     }
+    parsed.output_interval_time = ParseOutputIntervalTime(config);
+    parsed.time_stepping = ParseTimeStepSettings(config);
+
+    parsed.temperature_coefficient = optional_number(config, "temperature_coefficient", parsed.temperature_coefficient);
+    parsed.reference_temperature = optional_number(config, "reference_temperature", parsed.reference_temperature);
+
+    if (config.contains("coupling"))
+    {
+        const json &coupling = config["coupling"];
+        if (!coupling.is_object())
+        {
+            throw std::runtime_error("config.coupling must be an object.");
+        }
+        if (coupling.contains("electric_interval_steps"))
+        {
+            if (!coupling["electric_interval_steps"].is_number_integer() ||
+                coupling["electric_interval_steps"].get<int>() <= 0)
+            {
+                throw std::runtime_error("config.coupling.electric_interval_steps must be an integer > 0.");
+            }
+            parsed.electric_interval_steps = coupling["electric_interval_steps"].get<int>();
+        }
+        if (coupling.contains("temperature_change_tolerance"))
+        {
+            if (!coupling["temperature_change_tolerance"].is_number() ||
+                coupling["temperature_change_tolerance"].get<double>() < 0.0)
+            {
+                throw std::runtime_error("config.coupling.temperature_change_tolerance must be a number >= 0.");
+            }
+            parsed.temperature_change_tolerance = coupling["temperature_change_tolerance"].get<double>();
+        }
+        if (coupling.contains("picard_max_iterations"))
+        {
+            if (!coupling["picard_max_iterations"].is_number_integer() ||
+                coupling["picard_max_iterations"].get<int>() <= 0)
+            {
+                throw std::runtime_error("config.coupling.picard_max_iterations must be an integer > 0.");
+            }
+            parsed.picard_max_iterations = coupling["picard_max_iterations"].get<int>();
+        }
+        if (coupling.contains("picard_tolerance"))
+        {
+            if (!coupling["picard_tolerance"].is_number() || !(coupling["picard_tolerance"].get<double>() > 0.0))
+            {
+                throw std::runtime_error("config.coupling.picard_tolerance must be > 0.");
+            }
+            parsed.picard_tolerance = coupling["picard_tolerance"].get<double>();
+        }
+    }
 
     if (!config.contains("bcs") || !config["bcs"].is_array())
     {
@@ -457,7 +582,8 @@ SolveSummary JouleHeatingSolver::Run(
     const ParsedConfig parsed = ParseConfig(config, max_boundary_attribute);
 
 #if defined(MFEM_USE_MPI)
-    mfem::ParMesh pmesh(MPI_COMM_WORLD, mesh);
+    ProfiledPhase phase(context.profiler, "fe_space_setup");
+    mfem::ParMesh &pmesh = context.mesh_distributor.Distribute(mesh);
 
     mfem::H1_FECollection thermal_fec(1, dim);
     mfem::ParFiniteElementSpace thermal_fespace(&pmesh, &thermal_fec);
@@ -468,6 +594,8 @@ SolveSummary JouleHeatingSolver::Run(
     mfem::ParFiniteElementSpace electric_fespace(&pmesh, &electric_fec);
     mfem::ParGridFunction electric_potential(&electric_fespace);
     electric_potential = 0.0;
+    context.profiler.RecordDofs("temperature", thermal_fespace.GlobalTrueVSize());
+    context.profiler.RecordDofs("electric_potential", electric_fespace.GlobalTrueVSize());
 
     mfem::Array<int> thermal_ess_bdr(max_boundary_attribute);
     mfem::Array<int> electric_ess_bdr(max_boundary_attribute);
@@ -506,6 +634,13 @@ SolveSummary JouleHeatingSolver::Run(
     mfem::Vector temperature_true(thermal_fespace.GetTrueVSize());
     temperature.GetTrueDofs(temperature_true);
 
+    phase.Switch("assembly");
+    ElectricalConductivityCoefficient electrical_conductivity(
+        temperature,
+        parsed.electrical_conductivity,
+        parsed.temperature_coefficient,
+        parsed.reference_temperature
+    );
     JouleHeatingOperator coupled_operator(
         thermal_fespace,
         electric_fespace,
@@ -519,12 +654,14 @@ SolveSummary JouleHeatingSolver::Run(
         electric_potential,
         parsed.heat_capacity,
         parsed.thermal_conductivity,
-        parsed.electrical_conductivity
+        electrical_conductivity
     );
 
-    mfem::BackwardEulerSolver ode_solver;
-    ode_solver.Init(coupled_operator);
+    AdaptiveBackwardEuler stepper(thermal_fespace.GetComm(), parsed.time_stepping, parsed.dt, parsed.t_final);
+    stepper.Init(coupled_operator);
+    OutputCadence output_cadence(parsed.output_interval_steps, parsed.output_interval_time);
 
+    phase.Switch("output");
     const fs::path vtk_path(context.vtk_path);
     const std::string collection_name = vtk_path.stem().empty() ? "solution" : vtk_path.stem().string();
     const std::string output_dir = vtk_path.has_parent_path()
@@ -532,7 +669,7 @@ SolveSummary JouleHeatingSolver::Run(
         : context.working_directory;
     fs::create_directories(output_dir);
 
-    mfem::ParaViewDataCollection paraview(collection_name, &pmesh);
+    ProbedDataCollection paraview(collection_name, &pmesh, context.probes);
     paraview.SetPrefixPath(output_dir);
     paraview.SetLevelsOfDetail(1);
     paraview.SetDataFormat(mfem::VTKFormat::ASCII);
@@ -550,10 +687,103 @@ SolveSummary JouleHeatingSolver::Run(
     temperature.SetFromTrueDofs(temperature_true);
     save_step(step, time);
 
+    const MPI_Comm comm = thermal_fespace.GetComm();
+    auto solve_electric = [&]() {
+        const int electric_iterations_before = coupled_operator.TotalElectricIterations();
+        const double load_change = coupled_operator.SolveElectric();
+        context.profiler.RecordLinearSolve(
+            "electric_cg",
+            coupled_operator.TotalElectricIterations() - electric_iterations_before);
+        return load_change;
+    };
+    auto thermal_step = [&](bool repeat) {
+        const int thermal_iterations_before = coupled_operator.TotalImplicitIterations();
+        if (repeat)
+        {
+            stepper.Repeat(temperature_true, time);
+        }
+        else
+        {
+            stepper.Step(temperature_true, time, parsed.t_final);
+        }
+        context.profiler.RecordLinearSolve(
+            "thermal_cg",
+            coupled_operator.TotalImplicitIterations() - thermal_iterations_before);
+    };
+    auto max_abs_difference = [&](const mfem::Vector &a, const mfem::Vector &b) {
+        double local = 0.0;
+        for (int i = 0; i < a.Size(); ++i)
+        {
+            local = std::max(local, std::abs(a[i] - b[i]));
+        }
+        double global = 0.0;
+        MPI_Allreduce(&local, &global, 1, MPI_DOUBLE, MPI_MAX, comm);
+        return global;
+    };
+
+    // With a constant conductivity the potential never changes, so the
+    // solve done at construction is exact for the whole run.
+    const bool temperature_dependent = electrical_conductivity.TemperatureDependent();
+    const bool picard = temperature_dependent && parsed.picard_max_iterations > 1;
+    int steps_since_electric = 0;
+    int picard_iterations = 0;
+    // Largest relative change of the Joule load seen at a re-solve: the
+    // error a lagged (or not fully converged) load carried into the steps.
+    double coupling_error_estimate = 0.0;
+    mfem::Vector temperature_at_electric(temperature_true);
+    mfem::Vector step_start(temperature_true.Size());
+    mfem::Vector previous_iterate(temperature_true.Size());
+
+    phase.Switch("solve");
     while (time + 1.0e-12 < parsed.t_final)
     {
-        mfem::real_t step_dt = std::min(parsed.dt, parsed.t_final - time);
-        ode_solver.Step(temperature_true, time, step_dt);
+        if (temperature_dependent && !picard)
+        {
+            bool resolve = steps_since_electric >= parsed.electric_interval_steps;
+            if (!resolve && parsed.temperature_change_tolerance > 0.0)
+            {
+                resolve = max_abs_difference(temperature_true, temperature_at_electric) >
+                    parsed.temperature_change_tolerance;
+            }
+            if (resolve)
+            {
+                coupling_error_estimate = std::max(coupling_error_estimate, solve_electric());
+                stepper.InvalidateSlope();
+                temperature_at_electric = temperature_true;
+                steps_since_electric = 0;
+            }
+        }
+
+        const double step_start_time = time;
+        step_start = temperature_true;
+        thermal_step(false);
+        ++steps_since_electric;
+
+        if (picard)
+        {
+            // Fixed-point iteration: re-solve the potential at the latest
+            // end-of-step temperature and redo the step until it settles.
+            double load_change = 0.0;
+            for (int iteration = 1; iteration < parsed.picard_max_iterations; ++iteration)
+            {
+                previous_iterate = temperature_true;
+                temperature.SetFromTrueDofs(temperature_true);
+                load_change = solve_electric();
+                temperature_true = step_start;
+                time = step_start_time;
+                thermal_step(true);
+                ++picard_iterations;
+
+                previous_iterate -= temperature_true;
+                const double update_norm = std::sqrt(mfem::InnerProduct(comm, previous_iterate, previous_iterate));
+                const double state_norm = std::sqrt(mfem::InnerProduct(comm, temperature_true, temperature_true));
+                if (update_norm <= parsed.picard_tolerance * std::max(state_norm, 1.0e-30))
+                {
+                    break;
+                }
+            }
+            coupling_error_estimate = std::max(coupling_error_estimate, load_change);
+        }
 
         temperature.SetFromTrueDofs(temperature_true);
         if (max_boundary_attribute > 0)
@@ -563,14 +793,22 @@ SolveSummary JouleHeatingSolver::Run(
         }
 
         ++step;
-        if (step % parsed.output_interval_steps == 0 || time + 1.0e-12 >= parsed.t_final)
+        if (output_cadence.Due(step, time, parsed.t_final))
         {
+            ProfiledPhase output_phase(context.profiler, "output");
             save_step(step, time);
         }
     }
+    phase.End();
+    context.profiler.SetCounter("time_steps", step);
+    context.profiler.SetCounter("electric_solves", coupled_operator.ElectricSolves());
+    RecordTimeStepStatistics(context.profiler, stepper.Statistics());
 
-    std::ofstream vtk_stub(context.vtk_path);
-    vtk_stub << "# Joule heating fields written to " << collection_name << ".pvd\n";
+    if (context.probes.FieldOutput())
+    {
+        std::ofstream vtk_stub(context.vtk_path);
+        vtk_stub << "# Joule heating fields written to " << collection_name << ".pvd\n";
+    }
 
     mfem::Vector mass_times_temperature(temperature_true.Size());
     coupled_operator.ThermalMassMatrix().Mult(temperature_true, mass_times_temperature);
@@ -599,7 +837,15 @@ SolveSummary JouleHeatingSolver::Run(
         {"t_final", parsed.t_final},
         {"time_steps", step},
         {"thermal_iterations", coupled_operator.TotalImplicitIterations()},
-        {"electric_iterations", coupled_operator.TotalElectricIterations()}
+        {"electric_iterations", coupled_operator.TotalElectricIterations()},
+        {"temperature_coefficient", parsed.temperature_coefficient},
+        {"coupling_scheme", picard ? "picard" : "staggered"},
+        {"electric_interval_steps", parsed.electric_interval_steps},
+        {"temperature_change_tolerance", parsed.temperature_change_tolerance},
+        {"electric_solves", coupled_operator.ElectricSolves()},
+        {"picard_iterations", picard_iterations},
+        {"coupling_error_estimate", coupling_error_estimate},
+        {"time_stepping", TimeStepStatisticsToJson(parsed.time_stepping, stepper.Statistics())}
     };
     std::ofstream metadata_out(metadata_path);
     if (!metadata_out)
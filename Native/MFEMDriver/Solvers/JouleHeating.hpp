@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "AdaptiveTimeStepper.hpp"
 #include "NavierStokes.hpp"
 
 #include <nlohmann/json.hpp>
@@ -31,6 +32,21 @@ private:
         double dt = 0.0;
         double t_final = 0.0;
         int output_interval_steps = 1;
+        double output_interval_time = 0.0;
+        TimeStepSettings time_stepping;
+        // sigma(T) = electrical_conductivity / (1 + temperature_coefficient
+        // * (T - reference_temperature)); 0 keeps the conductivity constant.
+        double temperature_coefficient = 0.0;
+        double reference_temperature = 293.15;
+        // Coupling schedule: re-solve the electric problem every
+        // electric_interval_steps thermal steps, or earlier once the
+        // temperature moved by more than temperature_change_tolerance
+        // (0 disables that trigger). picard_max_iterations > 1 instead
+        // iterates electric and thermal solves within every step.
+        int electric_interval_steps = 1;
+        double temperature_change_tolerance = 0.0;
+        int picard_max_iterations = 1;
+        double picard_tolerance = 1.0e-6;
         std::vector<int> electric_marker;
         std::vector<double> electric_values;
         std::vector<int> thermal_marker;
@@ -236,10 +236,12 @@ SolveSummary LinearElasticitySolver::Run(
     const int max_boundary_attribute = mesh.bdr_attributes.Size() > 0 ? mesh.bdr_attributes.Max() : 0;
     const ParsedConfig parsed = ParseConfig(config, dimension, max_domain_attribute, max_boundary_attribute);
 
+    ProfiledPhase phase(context.profiler, "fe_space_setup");
 #if defined(MFEM_USE_MPI)
-    mfem::ParMesh pmesh(MPI_COMM_WORLD, mesh);
+    mfem::ParMesh &pmesh = context.mesh_distributor.Distribute(mesh);
     mfem::H1_FECollection fec(1, dimension);
     mfem::ParFiniteElementSpace fespace(&pmesh, &fec, dimension);
+    context.profiler.RecordDofs("displacement", fespace.GlobalTrueVSize());
     mfem::ParGridFunction displacement(&fespace);
     displacement = 0.0;
 
@@ -253,6 +255,7 @@ SolveSummary LinearElasticitySolver::Run(
     mfem::PWConstCoefficient lambda_coeff(lambda_values);
     mfem::PWConstCoefficient mu_coeff(mu_values);
 
+    phase.Switch("assembly");
     mfem::ParBilinearForm stiffness(&fespace);
     stiffness.AddDomainIntegrator(new mfem::ElasticityIntegrator(lambda_coeff, mu_coeff));
     stiffness.Assemble();
@@ -302,11 +305,13 @@ SolveSummary LinearElasticitySolver::Run(
     mfem::Vector X;
     stiffness.FormLinearSystem(ess_tdof_list, displacement, rhs, A, X, B);
 
+    phase.Switch("preconditioner_setup");
     auto &A_hypre = dynamic_cast<mfem::HypreParMatrix &>(*A.Ptr());
     mfem::HypreBoomerAMG amg(A_hypre);
     amg.SetElasticityOptions(&fespace);
     amg.SetPrintLevel(0);
 
+    phase.Switch("solve");
     mfem::CGSolver solver(MPI_COMM_WORLD);
     solver.SetRelTol(1.0e-12);
     solver.SetAbsTol(0.0);
@@ -315,16 +320,18 @@ SolveSummary LinearElasticitySolver::Run(
     solver.SetOperator(A_hypre);
     solver.SetPreconditioner(amg);
     solver.Mult(B, X);
+    context.profiler.RecordLinearSolve("cg", solver.GetNumIterations());
 
     mfem::Vector residual(B.Size());
     A_hypre.Mult(X, residual);
     residual -= B;
 
     stiffness.RecoverFEMSolution(X, rhs, displacement);
+    phase.Switch("output");
     const fs::path vtk_path(context.vtk_path);
     const std::string collection_name = vtk_path.stem().empty() ? "solution" : vtk_path.stem().string();
     const std::string output_dir = vtk_path.has_parent_path() ? vtk_path.parent_path().string() : context.working_directory;
-    mfem::ParaViewDataCollection paraview(collection_name, &pmesh);
+    ProbedDataCollection paraview(collection_name, &pmesh, context.probes);
     paraview.SetPrefixPath(output_dir);
     paraview.SetLevelsOfDetail(1);
     paraview.SetDataFormat(mfem::VTKFormat::ASCII);
@@ -333,8 +340,12 @@ SolveSummary LinearElasticitySolver::Run(
     paraview.SetTime(0.0);
     paraview.Save();
     // Keep deterministic artifact expected by current Swift tooling.
-    std::ofstream vtk_stub(context.vtk_path);
-    vtk_stub << "# displacement field written to " << collection_name << ".pvd\n";
+    if (context.probes.FieldOutput())
+    {
+        std::ofstream vtk_stub(context.vtk_path);
+        vtk_stub << "# displacement field written to " << collection_name << ".pvd\n";
+    }
+    phase.End();
 
     SolveSummary summary;
     summary.energy = 0.5 * mfem::InnerProduct(X, B);
@@ -345,6 +356,7 @@ SolveSummary LinearElasticitySolver::Run(
 #else
     mfem::H1_FECollection fec(1, dimension);
     mfem::FiniteElementSpace fespace(&mesh, &fec, dimension);
+    context.profiler.RecordDofs("displacement", fespace.GetTrueVSize());
     mfem::GridFunction displacement(&fespace);
     displacement = 0.0;
 
@@ -358,6 +370,7 @@ SolveSummary LinearElasticitySolver::Run(
     mfem::PWConstCoefficient lambda_coeff(lambda_values);
     mfem::PWConstCoefficient mu_coeff(mu_values);
 
+    phase.Switch("assembly");
     mfem::BilinearForm stiffness(&fespace);
     stiffness.AddDomainIntegrator(new mfem::ElasticityIntegrator(lambda_coeff, mu_coeff));
 
@@ -408,8 +421,11 @@ SolveSummary LinearElasticitySolver::Run(
     mfem::Vector X;
     stiffness.FormLinearSystem(ess_tdof_list, displacement, rhs, A, X, B);
 
+    phase.Switch("preconditioner_setup");
     auto &A_sparse = dynamic_cast<mfem::SparseMatrix &>(*A.Ptr());
     mfem::GSSmoother preconditioner(A_sparse);
+
+    phase.Switch("solve");
     mfem::CGSolver solver;
     solver.SetRelTol(1.0e-12);
     solver.SetAbsTol(0.0);
@@ -418,12 +434,14 @@ SolveSummary LinearElasticitySolver::Run(
     solver.SetOperator(A_sparse);
     solver.SetPreconditioner(preconditioner);
     solver.Mult(B, X);
+    context.profiler.RecordLinearSolve("cg", solver.GetNumIterations());
 
     mfem::Vector residual(B.Size());
     A_sparse.Mult(X, residual);
     residual -= B;
 
     stiffness.RecoverFEMSolution(X, rhs, displacement);
+    phase.Switch("output");
     std::ofstream out(context.vtk_path);
     if (!out)
     {
@@ -431,6 +449,7 @@ SolveSummary LinearElasticitySolver::Run(
     }
     mesh.PrintVTK(out, 1);
     displacement.SaveVTK(out, "displacement", 1);
+    phase.End();
 
     SolveSummary summary;
     summary.energy = 0.5 * mfem::InnerProduct(X, B);
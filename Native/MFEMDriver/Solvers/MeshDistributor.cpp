@@ -0,0 +1,280 @@
+// SPDX-License-Identifier: MIT
+// AutoSage MFEM driver extension.
+// Uses MFEM (BSD-3-Clause). See THIRD_PARTY_NOTICES.md.
+
+#include "MeshDistributor.hpp"
+
+#if defined(MFEM_USE_MPI)
+#include <mpi.h>
+#endif
+
+#include <unistd.h>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+constexpr const char *kCompleteMarker = "complete";
+
+constexpr std::uint64_t kFnvOffsetBasis = 14695981039346656037ull;
+
+std::uint64_t fnv1a(const unsigned char *data, std::size_t size, std::uint64_t hash)
+{
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::string hex_digest(std::uint64_t hash)
+{
+    std::ostringstream key;
+    key << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return key.str();
+}
+
+std::string hash_file_contents(const std::string &path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        throw std::runtime_error("Unable to open mesh file for hashing: " + path);
+    }
+
+    std::uint64_t hash = kFnvOffsetBasis;
+    std::array<char, 1 << 16> buffer{};
+    while (in)
+    {
+        in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        hash = fnv1a(
+            reinterpret_cast<const unsigned char *>(buffer.data()),
+            static_cast<std::size_t>(in.gcount()),
+            hash);
+    }
+    return hex_digest(hash);
+}
+
+#if defined(MFEM_USE_MPI)
+int world_rank()
+{
+    int rank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    return rank;
+}
+
+int world_size()
+{
+    int size = 1;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    return size;
+}
+
+std::string piece_path(const std::string &prefix, int rank)
+{
+    std::ostringstream path;
+    path << prefix << '.' << std::setw(6) << std::setfill('0') << rank;
+    return path.str();
+}
+
+bool all_ranks(bool local)
+{
+    int value = local ? 1 : 0;
+    int global = 0;
+    MPI_Allreduce(&value, &global, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    return global != 0;
+}
+
+bool broadcast_from_root(bool value)
+{
+    int flag = value ? 1 : 0;
+    MPI_Bcast(&flag, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    return flag != 0;
+}
+#endif
+} // namespace
+
+namespace autosage
+{
+std::string ContentHash(const void *data, std::size_t size)
+{
+    // Collisions only cost a wrong cache hit between inputs of identical
+    // shape, which is not a concern for a per-site job cache.
+    return hex_digest(fnv1a(static_cast<const unsigned char *>(data), size, kFnvOffsetBasis));
+}
+
+std::string StagingPath(const std::string &path)
+{
+    thread_local std::mt19937_64 generator(std::random_device{}());
+    std::ostringstream staging;
+    staging << path << ".tmp." << ::getpid() << '.' << hex_digest(generator());
+    return staging.str();
+}
+
+std::string MeshDistributor::MeshFileKey(const std::string &mesh_path)
+{
+#if defined(MFEM_USE_MPI)
+    std::string key;
+    std::string error;
+    if (world_rank() == 0)
+    {
+        try
+        {
+            key = hash_file_contents(mesh_path);
+        }
+        catch (const std::exception &ex)
+        {
+            error = ex.what();
+        }
+    }
+    if (!broadcast_from_root(error.empty()))
+    {
+        throw std::runtime_error(error.empty() ? "Unable to hash mesh file on rank 0." : error);
+    }
+    key.resize(16);
+    MPI_Bcast(key.data(), static_cast<int>(key.size()), MPI_CHAR, 0, MPI_COMM_WORLD);
+    return key;
+#else
+    return hash_file_contents(mesh_path);
+#endif
+}
+
+void MeshDistributor::LoadPartitioned(const std::string &prefix)
+{
+#if defined(MFEM_USE_MPI)
+    const int rank = world_rank();
+    const int size = world_size();
+    const std::string path = piece_path(prefix, rank);
+
+    // Validate collectively so that no rank is left waiting in the ParMesh
+    // constructor when another one cannot read its piece.
+    std::ifstream in(path);
+    const bool extra_pieces = rank == 0 && fs::exists(piece_path(prefix, size));
+    if (!all_ranks(static_cast<bool>(in)))
+    {
+        throw std::runtime_error("Partitioned mesh is missing a piece for some rank; expected " + path + ".");
+    }
+    if (broadcast_from_root(extra_pieces))
+    {
+        throw std::runtime_error("Partitioned mesh has more pieces than MPI ranks.");
+    }
+
+    pmesh_ = std::make_unique<mfem::ParMesh>(MPI_COMM_WORLD, in);
+    pmesh_->EnsureNodes();
+    adopted_ = true;
+#else
+    (void)prefix;
+    throw std::runtime_error("mesh.type=partitioned requires MFEM built with MPI.");
+#endif
+}
+
+bool MeshDistributor::UseCache(const std::string &cache_directory, const std::string &mesh_path)
+{
+#if defined(MFEM_USE_MPI)
+    const fs::path entry = fs::path(cache_directory) /
+        (MeshFileKey(mesh_path) + "-np" + std::to_string(world_size()));
+
+    // Rank 0 decides, so that a job finishing its write concurrently cannot
+    // make the ranks disagree.
+    const bool hit = broadcast_from_root(world_rank() == 0 && fs::exists(entry / kCompleteMarker));
+    cache_entry_ = entry.string();
+    if (hit)
+    {
+        LoadPartitioned((entry / "mesh").string());
+        cache_hit_ = true;
+        if (world_rank() == 0)
+        {
+            // The marker's mtime records the last use for eviction.
+            std::error_code ec;
+            fs::last_write_time(entry / kCompleteMarker, fs::file_time_type::clock::now(), ec);
+        }
+        return true;
+    }
+    return false;
+#else
+    (void)cache_directory;
+    (void)mesh_path;
+    return false;
+#endif
+}
+
+mfem::Mesh *MeshDistributor::AdoptedMesh()
+{
+#if defined(MFEM_USE_MPI)
+    return adopted_ ? pmesh_.get() : nullptr;
+#else
+    return nullptr;
+#endif
+}
+
+#if defined(MFEM_USE_MPI)
+mfem::ParMesh &MeshDistributor::Distribute(mfem::Mesh &mesh)
+{
+    if (!pmesh_)
+    {
+        pmesh_ = std::make_unique<mfem::ParMesh>(MPI_COMM_WORLD, mesh);
+        if (!cache_entry_.empty() && !cache_hit_)
+        {
+            StorePieces();
+        }
+    }
+    return *pmesh_;
+}
+
+void MeshDistributor::StorePieces() const
+{
+    // ParPrint cannot round-trip nonconforming or NURBS meshes. Those jobs
+    // still run; they just never populate the cache.
+    if (pmesh_->Nonconforming() || pmesh_->NURBSext != nullptr)
+    {
+        return;
+    }
+
+    // A cache that cannot be written only costs the next job a partition,
+    // so failures here are not reported as job errors.
+    const fs::path entry(cache_entry_);
+    std::error_code ec;
+    fs::create_directories(entry, ec);
+
+    const std::string path = piece_path((entry / "mesh").string(), world_rank());
+    const std::string staging = StagingPath(path);
+    bool written = false;
+    {
+        std::ofstream out(staging);
+        if (out)
+        {
+            out.precision(16);
+            pmesh_->ParPrint(out);
+            written = static_cast<bool>(out);
+        }
+    }
+    if (written)
+    {
+        fs::rename(staging, path, ec);
+        written = !ec;
+    }
+    else
+    {
+        fs::remove(staging, ec);
+    }
+
+    if (all_ranks(written) && world_rank() == 0)
+    {
+        std::ofstream marker(entry / kCompleteMarker);
+        marker << "ranks " << world_size() << "\n";
+    }
+}
+#endif
+} // namespace autosage
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: MIT
+// AutoSage MFEM driver extension.
+// Uses MFEM (BSD-3-Clause). See THIRD_PARTY_NOTICES.md.
+
+#pragma once
+
+#include <mfem.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace autosage
+{
+// 64-bit FNV-1a of `size` bytes, as 16 hex digits. Used for cache keys.
+std::string ContentHash(const void *data, std::size_t size);
+
+// A sibling of `path` that is unique to this process and call, for writing a
+// cache file before renaming it onto `path`. Concurrent jobs filling the same
+// entry then never write into each other's partial file.
+std::string StagingPath(const std::string &path);
+
+// Owns the distributed mesh that MPI solvers work on.
+//
+// By default a solver's serial mesh is partitioned the first time it asks for
+// it. mfem-driver can instead adopt a mesh that is already distributed:
+// pieces written by ParMesh::ParPrint (mesh.type=partitioned) or a hit in the
+// mesh cache. Then no rank reads the full mesh and METIS is skipped. On a
+// cache miss the new partition is written back, so the next job on the same
+// geometry and rank count hits.
+class MeshDistributor
+{
+public:
+    // Content key of a serial mesh file, computed on rank 0 and broadcast.
+    static std::string MeshFileKey(const std::string &mesh_path);
+
+    // Adopts this rank's piece, read from `<prefix>.<rank as 6 digits>`.
+    void LoadPartitioned(const std::string &prefix);
+
+    // Looks up `mesh_path` under `cache_directory` for the current rank
+    // count. On a hit the cached pieces are adopted and true is returned;
+    // on a miss the partition built by Distribute() is stored there.
+    bool UseCache(const std::string &cache_directory, const std::string &mesh_path);
+
+    // The adopted distributed mesh, or nullptr when solvers partition a
+    // serial mesh themselves.
+    mfem::Mesh *AdoptedMesh();
+
+    // Cache entry directory chosen by UseCache(), empty without a cache.
+    const std::string &CacheEntry() const { return cache_entry_; }
+    bool CacheHit() const { return cache_hit_; }
+
+#if defined(MFEM_USE_MPI)
+    // Returns the adopted mesh, or `mesh` partitioned across MPI_COMM_WORLD.
+    mfem::ParMesh &Distribute(mfem::Mesh &mesh);
+#endif
+
+private:
+#if defined(MFEM_USE_MPI)
+    void StorePieces() const;
+
+    std::unique_ptr<mfem::ParMesh> pmesh_;
+#endif
+    bool adopted_ = false;
+    bool cache_hit_ = false;
+    std::string cache_entry_;
+};
+} // namespace autosage
@@ -8,6 +8,7 @@
 #include <cctype>
 #include <cmath>
 #include <filesystem>
+#include <fstream>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -111,6 +112,18 @@ NavierStokesSolver::NavierConfig NavierStokesSolver::ParseConfig(
     parsed.t_final = number_or_default(config, "t_final", parsed.t_final);
     parsed.dt = number_or_default(config, "dt", parsed.dt);
     parsed.output_interval_steps = int_or_default(config, "output_interval_steps", parsed.output_interval_steps);
+    if (config.contains("time_scheme"))
+    {
+        if (!config["time_scheme"].is_string())
+        {
+            throw std::runtime_error("time_scheme must be a string.");
+        }
+        parsed.time_scheme = to_lower(config["time_scheme"].get<std::string>());
+        if (parsed.time_scheme != "bdf1" && parsed.time_scheme != "bdf2")
+        {
+            throw std::runtime_error("time_scheme must be bdf1 or bdf2.");
+        }
+    }
 
     if (parsed.viscosity <= 0.0) { throw std::runtime_error("viscosity must be > 0."); }
     if (parsed.density <= 0.0) { throw std::runtime_error("density must be > 0."); }
@@ -200,20 +213,19 @@ SolveSummary NavierStokesSolver::Run(
     const int max_boundary_attribute = mesh.bdr_attributes.Size() > 0 ? mesh.bdr_attributes.Max() : 0;
     const NavierConfig cfg = ParseConfig(config, dim, max_boundary_attribute);
 
+#if defined(MFEM_USE_MPI)
+    ProfiledPhase phase(context.profiler, "fe_space_setup");
+    mfem::ParMesh &pmesh = context.mesh_distributor.Distribute(mesh);
     mfem::H1_FECollection fec(1, dim);
-    mfem::FiniteElementSpace velocity_fespace(&mesh, &fec, dim);
-    mfem::FiniteElementSpace pressure_fespace(&mesh, &fec);
-
-    mfem::GridFunction u_n(&velocity_fespace);
-    mfem::GridFunction u_star(&velocity_fespace);
-    mfem::GridFunction u_np1(&velocity_fespace);
-    mfem::GridFunction p_n(&pressure_fespace);
-    mfem::GridFunction p_np1(&pressure_fespace);
+    mfem::ParFiniteElementSpace velocity_fespace(&pmesh, &fec, dim);
+    mfem::ParFiniteElementSpace pressure_fespace(&pmesh, &fec);
+    context.profiler.RecordDofs("velocity", velocity_fespace.GlobalTrueVSize());
+    context.profiler.RecordDofs("pressure", pressure_fespace.GlobalTrueVSize());
+
+    mfem::ParGridFunction u_n(&velocity_fespace);
+    mfem::ParGridFunction p_n(&pressure_fespace);
     u_n = 0.0;
-    u_star = 0.0;
-    u_np1 = 0.0;
     p_n = 0.0;
-    p_np1 = 0.0;
 
     mfem::Array<int> velocity_ess_bdr(max_boundary_attribute);
     mfem::Array<int> pressure_ess_bdr(max_boundary_attribute);
@@ -270,57 +282,120 @@ SolveSummary NavierStokesSolver::Run(
         pressure_fespace.GetEssentialTrueDofs(pressure_ess_bdr, pressure_ess_tdofs);
     }
 
+    // Without an outlet the pressure is only defined up to a constant; pin
+    // the first true dof owned by rank 0.
+    int local_pressure_ess = pressure_ess_tdofs.Size();
+    int global_pressure_ess = 0;
+    MPI_Allreduce(&local_pressure_ess, &global_pressure_ess, 1, MPI_INT, MPI_SUM, pmesh.GetComm());
+    if (global_pressure_ess == 0 && pmesh.GetMyRank() == 0 && pressure_fespace.GetTrueVSize() > 0)
+    {
+        pressure_ess_tdofs.Append(0);
+    }
+
+    phase.Switch("assembly");
     mfem::ConstantCoefficient one(1.0);
-    mfem::BilinearForm mass_form(&velocity_fespace);
+    mfem::ParBilinearForm mass_form(&velocity_fespace);
     mass_form.AddDomainIntegrator(new mfem::VectorMassIntegrator(one));
     mass_form.Assemble();
     mass_form.Finalize();
-    mfem::SparseMatrix mass_matrix(mass_form.SpMat());
+    std::unique_ptr<mfem::HypreParMatrix> mass_matrix(mass_form.ParallelAssemble());
 
-    mfem::BilinearForm diffusion_form(&velocity_fespace);
+    mfem::ParBilinearForm diffusion_form(&velocity_fespace);
     diffusion_form.AddDomainIntegrator(new mfem::VectorDiffusionIntegrator(one));
     diffusion_form.Assemble();
     diffusion_form.Finalize();
-    mfem::SparseMatrix diffusion_matrix(diffusion_form.SpMat());
+    std::unique_ptr<mfem::HypreParMatrix> diffusion_matrix(diffusion_form.ParallelAssemble());
 
-    mfem::BilinearForm pressure_form(&pressure_fespace);
+    mfem::ParBilinearForm pressure_form(&pressure_fespace);
     pressure_form.AddDomainIntegrator(new mfem::DiffusionIntegrator(one));
     pressure_form.Assemble();
     pressure_form.Finalize();
-    mfem::SparseMatrix pressure_matrix_base(pressure_form.SpMat());
+    std::unique_ptr<mfem::HypreParMatrix> pressure_matrix(pressure_form.ParallelAssemble());
 
-    mfem::MixedBilinearForm divergence_form(&velocity_fespace, &pressure_fespace);
+    mfem::ParMixedBilinearForm divergence_form(&velocity_fespace, &pressure_fespace);
     divergence_form.AddDomainIntegrator(new mfem::VectorDivergenceIntegrator(one));
     divergence_form.Assemble();
     divergence_form.Finalize();
-    mfem::SparseMatrix divergence_matrix(divergence_form.SpMat());
+    std::unique_ptr<mfem::HypreParMatrix> divergence_matrix(divergence_form.ParallelAssemble());
 
-    mfem::MixedBilinearForm gradient_form(&pressure_fespace, &velocity_fespace);
+    mfem::ParMixedBilinearForm gradient_form(&pressure_fespace, &velocity_fespace);
     gradient_form.AddDomainIntegrator(new mfem::GradientIntegrator(one));
     gradient_form.Assemble();
     gradient_form.Finalize();
-    mfem::SparseMatrix gradient_matrix(gradient_form.SpMat());
+    std::unique_ptr<mfem::HypreParMatrix> gradient_matrix(gradient_form.ParallelAssemble());
 
-    mfem::NonlinearForm convection_form(&velocity_fespace);
+    mfem::ParNonlinearForm convection_form(&velocity_fespace);
     convection_form.AddDomainIntegrator(new mfem::VectorConvectionNLFIntegrator(one));
 
+    const int velocity_true_size = velocity_fespace.GetTrueVSize();
+    const int pressure_true_size = pressure_fespace.GetTrueVSize();
     const mfem::Vector body_force = build_body_force(cfg.body_force, dim);
     mfem::VectorConstantCoefficient body_force_coeff(body_force);
-    mfem::LinearForm body_force_form(&velocity_fespace);
+    mfem::ParLinearForm body_force_form(&velocity_fespace);
     body_force_form.AddDomainIntegrator(new mfem::VectorDomainLFIntegrator(body_force_coeff));
     body_force_form.Assemble();
-    const int velocity_true_size = velocity_fespace.GetTrueVSize();
-    const int pressure_true_size = pressure_fespace.GetTrueVSize();
     mfem::Vector body_force_true(velocity_true_size);
-    if (body_force_form.Size() == body_force_true.Size())
+    body_force_form.ParallelAssemble(body_force_true);
+
+    // Row-sum lumped mass, used to turn the gradient load into nodal
+    // velocity corrections.
+    mfem::Vector lumped_mass(velocity_true_size);
     {
-        body_force_true = body_force_form;
+        mfem::Vector ones(velocity_true_size);
+        ones = 1.0;
+        mass_matrix->Mult(ones, lumped_mass);
     }
-    else
+
+    phase.Switch("preconditioner_setup");
+    // The pressure Laplacian does not change in time: eliminate it and build
+    // its AMG hierarchy once.
+    std::unique_ptr<mfem::HypreParMatrix> pressure_eliminated(pressure_matrix->EliminateRowsCols(pressure_ess_tdofs));
+    mfem::HypreBoomerAMG pressure_amg(*pressure_matrix);
+    pressure_amg.SetPrintLevel(0);
+    mfem::CGSolver pressure_solver(MPI_COMM_WORLD);
+    pressure_solver.SetRelTol(1.0e-10);
+    pressure_solver.SetAbsTol(0.0);
+    pressure_solver.SetMaxIter(400);
+    pressure_solver.SetPrintLevel(0);
+    pressure_solver.SetOperator(*pressure_matrix);
+    pressure_solver.SetPreconditioner(pressure_amg);
+    pressure_solver.iterative_mode = true;
+
+    // (lead * density / dt) M + viscosity K only changes with the BDF
+    // startup step or a shortened final step, so it is rebuilt on demand.
+    std::unique_ptr<mfem::HypreParMatrix> predictor_matrix;
+    std::unique_ptr<mfem::HypreParMatrix> predictor_eliminated;
+    std::unique_ptr<mfem::HypreBoomerAMG> predictor_amg;
+    mfem::CGSolver predictor_solver(MPI_COMM_WORLD);
+    predictor_solver.SetRelTol(1.0e-8);
+    predictor_solver.SetAbsTol(0.0);
+    predictor_solver.SetMaxIter(400);
+    predictor_solver.SetPrintLevel(0);
+    predictor_solver.iterative_mode = true;
+    double predictor_coefficient = 0.0;
+    int predictor_setups = 0;
+    auto update_predictor = [&](double coefficient)
     {
-        body_force_true = 0.0;
-    }
+        if (predictor_matrix && std::abs(coefficient - predictor_coefficient) <= 1.0e-12 * coefficient)
+        {
+            return;
+        }
+        ProfiledPhase setup_phase(context.profiler, "preconditioner_setup");
+        predictor_matrix.reset(mfem::Add(coefficient, *mass_matrix, cfg.viscosity, *diffusion_matrix));
+        if (!predictor_matrix)
+        {
+            throw std::runtime_error("Failed to assemble tentative velocity matrix.");
+        }
+        predictor_eliminated.reset(predictor_matrix->EliminateRowsCols(velocity_ess_tdofs));
+        predictor_amg = std::make_unique<mfem::HypreBoomerAMG>(*predictor_matrix);
+        predictor_amg->SetPrintLevel(0);
+        predictor_solver.SetPreconditioner(*predictor_amg);
+        predictor_solver.SetOperator(*predictor_matrix);
+        predictor_coefficient = coefficient;
+        ++predictor_setups;
+    };
 
+    phase.Switch("output");
     const fs::path vtk_path(context.vtk_path);
     const std::string collection_name = vtk_path.stem().empty() ? "solution" : vtk_path.stem().string();
     const std::string output_dir = vtk_path.has_parent_path()
@@ -328,7 +403,7 @@ SolveSummary NavierStokesSolver::Run(
         : context.working_directory;
     fs::create_directories(output_dir);
 
-    mfem::ParaViewDataCollection paraview(collection_name, &mesh);
+    ProbedDataCollection paraview(collection_name, &pmesh, context.probes);
     paraview.SetPrefixPath(output_dir);
     paraview.SetLevelsOfDetail(1);
     paraview.SetDataFormat(mfem::VTKFormat::ASCII);
@@ -336,160 +411,155 @@ SolveSummary NavierStokesSolver::Run(
     paraview.RegisterField("velocity", &u_n);
     paraview.RegisterField("pressure", &p_n);
 
-    auto save_step = [&](int step, double time) {
-        paraview.SetCycle(step);
-        paraview.SetTime(time);
-        paraview.Save();
-    };
-
     mfem::Vector u_n_true(velocity_true_size);
+    mfem::Vector u_prev_true(velocity_true_size);
     mfem::Vector u_star_true(velocity_true_size);
-    mfem::Vector u_np1_true(velocity_true_size);
     mfem::Vector u_bc_true(velocity_true_size);
-    mfem::Vector p_n_true(pressure_true_size);
-    mfem::Vector p_np1_true(pressure_true_size);
+    mfem::Vector p_true(pressure_true_size);
     mfem::Vector p_bc_true(pressure_true_size);
+    mfem::Vector convection_n(velocity_true_size);
+    mfem::Vector convection_prev(velocity_true_size);
+    mfem::Vector extrapolated_convection(velocity_true_size);
+    mfem::Vector velocity_history(velocity_true_size);
+    mfem::Vector predictor_rhs(velocity_true_size);
+    mfem::Vector pressure_rhs(pressure_true_size);
+    mfem::Vector grad_pressure_true(velocity_true_size);
 
     u_n.GetTrueDofs(u_n_true);
-    p_n.GetTrueDofs(p_n_true);
-    if (max_boundary_attribute > 0)
-    {
-        u_n.GetTrueDofs(u_bc_true);
-        p_n.GetTrueDofs(p_bc_true);
-    }
-    else
-    {
-        u_bc_true = 0.0;
-        p_bc_true = 0.0;
-    }
+    p_n.GetTrueDofs(p_true);
+    u_bc_true = u_n_true;
+    p_bc_true = p_true;
+    u_prev_true = u_n_true;
+    convection_prev = 0.0;
+
+    auto save_step = [&](int step, double time) {
+        u_n.SetFromTrueDofs(u_n_true);
+        p_n.SetFromTrueDofs(p_true);
+        paraview.SetCycle(step);
+        paraview.SetTime(time);
+        paraview.Save();
+    };
 
-    int total_iterations = 0;
+    const bool bdf2 = cfg.time_scheme == "bdf2";
+    int predictor_iterations = 0;
+    int pressure_iterations = 0;
     int step = 0;
     double time = 0.0;
+    double previous_dt = 0.0;
     save_step(step, time);
 
+    phase.Switch("solve");
     while (time + 1.0e-12 < cfg.t_final)
     {
         const double current_dt = std::min(cfg.dt, cfg.t_final - time);
-
-        // Step 1: tentative velocity solve.
-        mfem::Vector convection_dofs(velocity_fespace.GetVSize());
-        convection_form.Mult(u_n, convection_dofs);
-        mfem::Vector convection_true(velocity_true_size);
-        if (convection_true.Size() == convection_dofs.Size())
+        // BDF2/EXT2 needs one step of history at the same step size; the
+        // first and any shortened step fall back to BDF1.
+        const bool second_order = bdf2 && step > 0 && std::abs(current_dt - previous_dt) <= 1.0e-12 * cfg.dt;
+        const double lead = second_order ? 1.5 : 1.0;
+        update_predictor(lead * cfg.density / current_dt);
+
+        // Step 1: tentative velocity with explicit (extrapolated) convection.
+        convection_form.Mult(u_n_true, convection_n);
+        if (second_order)
         {
-            convection_true = convection_dofs;
+            mfem::add(2.0, u_n_true, -0.5, u_prev_true, velocity_history);
+            mfem::add(2.0, convection_n, -1.0, convection_prev, extrapolated_convection);
         }
         else
         {
-            convection_true = 0.0;
-        }
-
-        std::unique_ptr<mfem::SparseMatrix> predictor_matrix(
-            mfem::Add(cfg.density / current_dt, mass_matrix, cfg.viscosity, diffusion_matrix));
-        if (!predictor_matrix)
-        {
-            throw std::runtime_error("Failed to assemble tentative velocity matrix.");
+            velocity_history = u_n_true;
+            extrapolated_convection = convection_n;
         }
 
-        mfem::Vector predictor_rhs(velocity_true_size);
-        mass_matrix.Mult(u_n_true, predictor_rhs);
+        mass_matrix->Mult(velocity_history, predictor_rhs);
         predictor_rhs *= (cfg.density / current_dt);
-        predictor_rhs -= convection_true;
+        predictor_rhs.Add(-cfg.density, extrapolated_convection);
         predictor_rhs += body_force_true;
+        predictor_matrix->EliminateBC(*predictor_eliminated, velocity_ess_tdofs, u_bc_true, predictor_rhs);
 
-        for (int i = 0; i < velocity_ess_tdofs.Size(); ++i)
-        {
-            const int tdof = velocity_ess_tdofs[i];
-            predictor_matrix->EliminateRowCol(
-                tdof,
-                u_bc_true[tdof],
-                predictor_rhs,
-                mfem::Operator::DIAG_ONE
-            );
-        }
-
-        mfem::GSSmoother predictor_preconditioner(*predictor_matrix);
-        mfem::CGSolver predictor_solver;
-        predictor_solver.SetRelTol(1.0e-8);
-        predictor_solver.SetAbsTol(0.0);
-        predictor_solver.SetMaxIter(400);
-        predictor_solver.SetPrintLevel(0);
-        predictor_solver.SetOperator(*predictor_matrix);
-        predictor_solver.SetPreconditioner(predictor_preconditioner);
+        u_star_true = u_n_true;
         predictor_solver.Mult(predictor_rhs, u_star_true);
-        total_iterations += predictor_solver.GetNumIterations();
-
-        u_star.SetFromTrueDofs(u_star_true);
-
-        // Step 2: pressure Poisson solve.
-        mfem::SparseMatrix pressure_matrix(pressure_matrix_base);
-        mfem::Vector pressure_rhs(pressure_true_size);
-        divergence_matrix.Mult(u_star_true, pressure_rhs);
-        pressure_rhs *= (cfg.density / current_dt);
-
-        for (int i = 0; i < pressure_ess_tdofs.Size(); ++i)
-        {
-            const int tdof = pressure_ess_tdofs[i];
-            pressure_matrix.EliminateRowCol(
-                tdof,
-                p_bc_true[tdof],
-                pressure_rhs,
-                mfem::Operator::DIAG_ONE
-            );
-        }
-        if (pressure_ess_tdofs.Size() == 0 && pressure_rhs.Size() > 0)
+        predictor_iterations += predictor_solver.GetNumIterations();
+        context.profiler.RecordLinearSolve("predictor_cg", predictor_solver.GetNumIterations());
+
+        // Step 2: pressure Poisson solve, -lap p = -(lead * density / dt) div u*.
+        divergence_matrix->Mult(u_star_true, pressure_rhs);
+        pressure_rhs *= -(lead * cfg.density / current_dt);
+        pressure_matrix->EliminateBC(*pressure_eliminated, pressure_ess_tdofs, p_bc_true, pressure_rhs);
+
+        pressure_solver.Mult(pressure_rhs, p_true);
+        pressure_iterations += pressure_solver.GetNumIterations();
+        context.profiler.RecordLinearSolve("pressure_cg", pressure_solver.GetNumIterations());
+
+        // Step 3: velocity correction u = u* - dt / (lead * density) grad p.
+        gradient_matrix->Mult(p_true, grad_pressure_true);
+        const double correction_scale = current_dt / (lead * cfg.density);
+        u_prev_true = u_n_true;
+        for (int i = 0; i < velocity_true_size; ++i)
         {
-            pressure_matrix.EliminateRowCol(0, 0.0, pressure_rhs, mfem::Operator::DIAG_ONE);
+            u_n_true[i] = u_star_true[i] - correction_scale * grad_pressure_true[i] / lumped_mass[i];
         }
-
-        mfem::GSSmoother pressure_preconditioner(pressure_matrix);
-        mfem::CGSolver pressure_solver;
-        pressure_solver.SetRelTol(1.0e-10);
-        pressure_solver.SetAbsTol(0.0);
-        pressure_solver.SetMaxIter(400);
-        pressure_solver.SetPrintLevel(0);
-        pressure_solver.SetOperator(pressure_matrix);
-        pressure_solver.SetPreconditioner(pressure_preconditioner);
-        pressure_solver.Mult(pressure_rhs, p_np1_true);
-        total_iterations += pressure_solver.GetNumIterations();
-
-        p_np1.SetFromTrueDofs(p_np1_true);
-
-        // Step 3: velocity correction.
-        mfem::Vector grad_pressure_true(velocity_true_size);
-        gradient_matrix.Mult(p_np1_true, grad_pressure_true);
-        u_np1_true = u_star_true;
-        u_np1_true.Add(-current_dt / cfg.density, grad_pressure_true);
         for (int i = 0; i < velocity_ess_tdofs.Size(); ++i)
         {
             const int tdof = velocity_ess_tdofs[i];
-            u_np1_true[tdof] = u_bc_true[tdof];
+            u_n_true[tdof] = u_bc_true[tdof];
         }
-        u_np1.SetFromTrueDofs(u_np1_true);
-
-        // Advance state.
-        u_n = u_np1;
-        p_n = p_np1;
-        u_n.GetTrueDofs(u_n_true);
-        p_n.GetTrueDofs(p_n_true);
+        convection_prev = convection_n;
+        previous_dt = current_dt;
 
         ++step;
         time += current_dt;
         if (step % cfg.output_interval_steps == 0 || time + 1.0e-12 >= cfg.t_final)
         {
+            ProfiledPhase output_phase(context.profiler, "output");
             save_step(step, time);
         }
     }
+    phase.End();
+    context.profiler.SetCounter("time_steps", step);
+    context.profiler.SetCounter("predictor_setups", predictor_setups);
 
     mfem::Vector kinetic_tmp(velocity_true_size);
-    mass_matrix.Mult(u_n_true, kinetic_tmp);
+    mass_matrix->Mult(u_n_true, kinetic_tmp);
+    mfem::Vector divergence_true(pressure_true_size);
+    divergence_matrix->Mult(u_n_true, divergence_true);
 
     SolveSummary summary;
-    summary.energy = 0.5 * cfg.density * mfem::InnerProduct(u_n_true, kinetic_tmp);
-    summary.iterations = total_iterations;
-    summary.error_norm = 0.0;
+    summary.energy = 0.5 * cfg.density * mfem::InnerProduct(pmesh.GetComm(), u_n_true, kinetic_tmp);
+    summary.iterations = predictor_iterations + pressure_iterations;
+    summary.error_norm = std::sqrt(mfem::InnerProduct(pmesh.GetComm(), divergence_true, divergence_true));
     summary.dimension = dim;
+
+    const fs::path metadata_path = fs::path(context.working_directory) / "navier_stokes.json";
+    json metadata = {
+        {"solver_class", "NavierStokes"},
+        {"solver_backend", "projection_cg_boomeramg"},
+        {"time_scheme", cfg.time_scheme},
+        {"dt", cfg.dt},
+        {"time_steps", step},
+        {"mpi_ranks", pmesh.GetNRanks()},
+        {"velocity_true_dofs", velocity_fespace.GlobalTrueVSize()},
+        {"pressure_true_dofs", pressure_fespace.GlobalTrueVSize()},
+        {"predictor_iterations", predictor_iterations},
+        {"pressure_iterations", pressure_iterations},
+        {"predictor_setups", predictor_setups},
+        {"divergence_norm", summary.error_norm},
+        {"kinetic_energy", summary.energy}
+    };
+    std::ofstream metadata_out(metadata_path);
+    if (!metadata_out)
+    {
+        throw std::runtime_error("Unable to write navier_stokes.json.");
+    }
+    metadata_out << metadata.dump(2);
+
     return summary;
+#else
+    (void)cfg;
+    (void)mesh;
+    (void)config;
+    (void)context;
+    throw std::runtime_error("NavierStokes solver requires MFEM built with MPI.");
+#endif
 }
 } // namespace autosage
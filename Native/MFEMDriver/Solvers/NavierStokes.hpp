@@ -4,6 +4,11 @@
 
 #pragma once
 
+#include "MeshDistributor.hpp"
+#include "OperatorCache.hpp"
+#include "Probes.hpp"
+#include "SolverProfiler.hpp"
+
 #include <mfem.hpp>
 #include <nlohmann/json.hpp>
 
@@ -25,6 +30,10 @@ struct SolverExecutionContext
 {
     std::string working_directory;
     std::string vtk_path;
+    SolverProfiler &profiler;
+    MeshDistributor &mesh_distributor;
+    OperatorCache &operator_cache;
+    ProbeRecorder &probes;
 };
 
 class PhysicsSolver
@@ -64,6 +73,9 @@ private:
         double t_final = 0.1;
         double dt = 0.01;
         int output_interval_steps = 1;
+        // bdf1: backward Euler with explicit convection. bdf2: BDF2 with
+        // second-order extrapolated convection.
+        std::string time_scheme = "bdf1";
         std::vector<double> body_force;
         std::vector<BoundaryCondition> bcs;
     };
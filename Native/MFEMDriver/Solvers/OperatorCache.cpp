@@ -0,0 +1,388 @@
+// SPDX-License-Identifier: MIT
+// AutoSage MFEM driver extension.
+// Uses MFEM (BSD-3-Clause). See THIRD_PARTY_NOTICES.md.
+
+#include "OperatorCache.hpp"
+
+#include "MeshDistributor.hpp"
+
+#if defined(MFEM_USE_MPI)
+#include <mpi.h>
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <system_error>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+#if defined(MFEM_USE_MPI)
+// Raw CSR image of one rank's rows, with global column indices. The arrays
+// follow the header in the order I, J, data, each padded to 8 bytes, so a
+// mapped file can be handed to the HypreParMatrix constructor in place.
+struct CsrImageHeader
+{
+    char magic[8];
+    std::int32_t int_size;
+    std::int32_t big_int_size;
+    std::int32_t real_size;
+    std::int32_t reserved;
+    std::int64_t local_rows;
+    std::int64_t nnz;
+    std::int64_t global_rows;
+    std::int64_t global_cols;
+    std::int64_t row_starts[2];
+    std::int64_t col_starts[2];
+};
+
+constexpr char kCsrMagic[8] = {'A', 'S', 'C', 'S', 'R', '0', '0', '1'};
+
+std::size_t padded(std::size_t bytes)
+{
+    return (bytes + 7) & ~static_cast<std::size_t>(7);
+}
+
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string &path)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) { return; }
+        struct stat info {};
+        if (::fstat(fd, &info) == 0 && info.st_size > 0)
+        {
+            // Private and writable so the pointers can be passed to hypre's
+            // non-const constructor arguments; nothing is written back.
+            void *mapped = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED)
+            {
+                data_ = static_cast<char *>(mapped);
+                size_ = static_cast<std::size_t>(info.st_size);
+            }
+        }
+        ::close(fd);
+    }
+
+    ~MappedFile()
+    {
+        if (data_ != nullptr) { ::munmap(data_, size_); }
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    char *data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    char *data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+std::string piece_path(const std::string &directory, const std::string &key, int rank)
+{
+    std::ostringstream path;
+    path << (fs::path(directory) / key).string() << '.' << std::setw(6) << std::setfill('0') << rank;
+    return path.str();
+}
+#endif
+
+// Entries used more recently than this are treated as in use by another job.
+constexpr std::chrono::minutes kInUseGrace{5};
+
+int current_rank()
+{
+#if defined(MFEM_USE_MPI)
+    int initialized = 0;
+    if (MPI_Initialized(&initialized) == MPI_SUCCESS && initialized)
+    {
+        int rank = 0;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        return rank;
+    }
+#endif
+    return 0;
+}
+} // namespace
+
+namespace autosage
+{
+OperatorCache::OperatorCache(SolverProfiler &profiler)
+    : profiler_(profiler)
+{
+}
+
+void OperatorCache::Open(const std::string &entry_directory)
+{
+    directory_ = (fs::path(entry_directory) / "operators").string();
+    std::error_code ec;
+    fs::create_directories(directory_, ec);
+    profiler_.SetCounter("operator_cache_hits", 0.0);
+    profiler_.SetCounter("operator_cache_misses", 0.0);
+}
+
+std::string OperatorCache::Key(const std::string &tag, int order, const std::vector<double> &coefficients)
+{
+    std::ostringstream description;
+    description << tag << "|p" << order;
+    description << std::setprecision(17);
+    for (double value : coefficients)
+    {
+        description << '|' << value;
+    }
+    const std::string text = description.str();
+    return ContentHash(text.data(), text.size());
+}
+
+#if defined(MFEM_USE_MPI)
+std::unique_ptr<mfem::HypreParMatrix> OperatorCache::LoadOrAssemble(
+    const std::string &key,
+    const mfem::ParFiniteElementSpace &test_space,
+    const mfem::ParFiniteElementSpace &trial_space,
+    const std::function<std::unique_ptr<mfem::HypreParMatrix>()> &assemble)
+{
+    // Stored pieces carry only this rank's [begin, end) row and column range.
+    if (!Enabled() || !mfem::HYPRE_AssumedPartitionCheck())
+    {
+        return assemble();
+    }
+
+    const std::string path = piece_path(directory_, key, test_space.GetMyRank());
+    std::unique_ptr<mfem::HypreParMatrix> loaded = Load(path, test_space, trial_space);
+    int local_hit = loaded ? 1 : 0;
+    int global_hit = 0;
+    MPI_Allreduce(&local_hit, &global_hit, 1, MPI_INT, MPI_MIN, test_space.GetComm());
+    if (global_hit != 0)
+    {
+        profiler_.AddToCounter("operator_cache_hits", 1.0);
+        return loaded;
+    }
+
+    profiler_.AddToCounter("operator_cache_misses", 1.0);
+    std::unique_ptr<mfem::HypreParMatrix> assembled = assemble();
+    // A piece that cannot be written only means a miss next time.
+    Store(path, *assembled);
+    return assembled;
+}
+
+std::unique_ptr<mfem::HypreParMatrix> OperatorCache::Load(
+    const std::string &path,
+    const mfem::ParFiniteElementSpace &test_space,
+    const mfem::ParFiniteElementSpace &trial_space)
+{
+    MappedFile file(path);
+    if (file.data() == nullptr || file.size() < sizeof(CsrImageHeader))
+    {
+        return nullptr;
+    }
+
+    CsrImageHeader header{};
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, kCsrMagic, sizeof(kCsrMagic)) != 0 ||
+        header.int_size != static_cast<std::int32_t>(sizeof(int)) ||
+        header.big_int_size != static_cast<std::int32_t>(sizeof(HYPRE_BigInt)) ||
+        header.real_size != static_cast<std::int32_t>(sizeof(mfem::real_t)))
+    {
+        return nullptr;
+    }
+
+    const HYPRE_BigInt *row_offsets = test_space.GetTrueDofOffsets();
+    const HYPRE_BigInt *col_offsets = trial_space.GetTrueDofOffsets();
+    if (header.local_rows != test_space.GetTrueVSize() ||
+        header.global_rows != test_space.GlobalTrueVSize() ||
+        header.global_cols != trial_space.GlobalTrueVSize() ||
+        header.row_starts[0] != row_offsets[0] || header.row_starts[1] != row_offsets[1] ||
+        header.col_starts[0] != col_offsets[0] || header.col_starts[1] != col_offsets[1] ||
+        header.nnz < 0)
+    {
+        return nullptr;
+    }
+
+    const std::size_t rows = static_cast<std::size_t>(header.local_rows);
+    const std::size_t nnz = static_cast<std::size_t>(header.nnz);
+    const std::size_t i_offset = sizeof(CsrImageHeader);
+    const std::size_t j_offset = i_offset + padded((rows + 1) * sizeof(int));
+    const std::size_t data_offset = j_offset + padded(nnz * sizeof(HYPRE_BigInt));
+    const std::size_t end = data_offset + nnz * sizeof(mfem::real_t);
+    if (file.size() != end)
+    {
+        return nullptr;
+    }
+
+    std::array<HYPRE_BigInt, 2> row_starts = {
+        static_cast<HYPRE_BigInt>(header.row_starts[0]),
+        static_cast<HYPRE_BigInt>(header.row_starts[1])
+    };
+    std::array<HYPRE_BigInt, 2> col_starts = {
+        static_cast<HYPRE_BigInt>(header.col_starts[0]),
+        static_cast<HYPRE_BigInt>(header.col_starts[1])
+    };
+    // This constructor copies every array, so the mapping can be released
+    // right after.
+    return std::make_unique<mfem::HypreParMatrix>(
+        test_space.GetComm(),
+        static_cast<int>(rows),
+        static_cast<HYPRE_BigInt>(header.global_rows),
+        static_cast<HYPRE_BigInt>(header.global_cols),
+        reinterpret_cast<int *>(file.data() + i_offset),
+        reinterpret_cast<HYPRE_BigInt *>(file.data() + j_offset),
+        reinterpret_cast<mfem::real_t *>(file.data() + data_offset),
+        row_starts.data(),
+        col_starts.data());
+}
+
+bool OperatorCache::Store(const std::string &path, const mfem::HypreParMatrix &matrix)
+{
+    mfem::SparseMatrix diag;
+    mfem::SparseMatrix offd;
+    HYPRE_BigInt *offd_columns = nullptr;
+    matrix.GetDiag(diag);
+    matrix.GetOffd(offd, offd_columns);
+
+    const int rows = diag.Height();
+    const HYPRE_BigInt first_column = matrix.ColPart()[0];
+    const bool has_offd = offd.Height() == rows && offd.NumNonZeroElems() > 0;
+
+    std::vector<int> row_ptr(static_cast<std::size_t>(rows) + 1, 0);
+    std::vector<HYPRE_BigInt> columns;
+    std::vector<mfem::real_t> values;
+    columns.reserve(static_cast<std::size_t>(diag.NumNonZeroElems() + (has_offd ? offd.NumNonZeroElems() : 0)));
+    values.reserve(columns.capacity());
+    for (int row = 0; row < rows; ++row)
+    {
+        for (int k = diag.GetI()[row]; k < diag.GetI()[row + 1]; ++k)
+        {
+            columns.push_back(first_column + diag.GetJ()[k]);
+            values.push_back(diag.GetData()[k]);
+        }
+        if (has_offd)
+        {
+            for (int k = offd.GetI()[row]; k < offd.GetI()[row + 1]; ++k)
+            {
+                columns.push_back(offd_columns[offd.GetJ()[k]]);
+                values.push_back(offd.GetData()[k]);
+            }
+        }
+        row_ptr[static_cast<std::size_t>(row) + 1] = static_cast<int>(columns.size());
+    }
+
+    CsrImageHeader header{};
+    std::memcpy(header.magic, kCsrMagic, sizeof(kCsrMagic));
+    header.int_size = static_cast<std::int32_t>(sizeof(int));
+    header.big_int_size = static_cast<std::int32_t>(sizeof(HYPRE_BigInt));
+    header.real_size = static_cast<std::int32_t>(sizeof(mfem::real_t));
+    header.local_rows = rows;
+    header.nnz = static_cast<std::int64_t>(columns.size());
+    header.global_rows = matrix.GetGlobalNumRows();
+    header.global_cols = matrix.GetGlobalNumCols();
+    header.row_starts[0] = matrix.RowPart()[0];
+    header.row_starts[1] = matrix.RowPart()[1];
+    header.col_starts[0] = matrix.ColPart()[0];
+    header.col_starts[1] = matrix.ColPart()[1];
+
+    const std::string staging = StagingPath(path);
+    std::error_code ec;
+    {
+        std::ofstream out(staging, std::ios::binary);
+        if (!out) { return false; }
+        const char zeros[8] = {};
+        auto write_padded = [&](const void *data, std::size_t bytes) {
+            out.write(static_cast<const char *>(data), static_cast<std::streamsize>(bytes));
+            out.write(zeros, static_cast<std::streamsize>(padded(bytes) - bytes));
+        };
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        write_padded(row_ptr.data(), row_ptr.size() * sizeof(int));
+        write_padded(columns.data(), columns.size() * sizeof(HYPRE_BigInt));
+        out.write(reinterpret_cast<const char *>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(mfem::real_t)));
+        if (!out)
+        {
+            out.close();
+            fs::remove(staging, ec);
+            return false;
+        }
+    }
+    fs::rename(staging, path, ec);
+    if (ec)
+    {
+        fs::remove(staging, ec);
+        return false;
+    }
+    return true;
+}
+#endif
+
+int EvictCacheEntries(const std::string &cache_directory, const CacheLimits &limits, const std::string &keep)
+{
+    if (current_rank() != 0)
+    {
+        return 0;
+    }
+
+    struct CacheEntry
+    {
+        fs::path path;
+        std::uintmax_t bytes = 0;
+        fs::file_time_type last_use;
+    };
+
+    std::error_code ec;
+    std::vector<CacheEntry> entries;
+    std::uintmax_t total_bytes = 0;
+    for (const fs::directory_entry &item : fs::directory_iterator(cache_directory, ec))
+    {
+        if (!item.is_directory(ec)) { continue; }
+        CacheEntry entry;
+        entry.path = item.path();
+        entry.last_use = item.last_write_time(ec);
+        // Hits touch a file inside the entry, so the newest file time is the
+        // last use.
+        for (const fs::directory_entry &file : fs::recursive_directory_iterator(item.path(), ec))
+        {
+            if (!file.is_regular_file(ec)) { continue; }
+            entry.bytes += file.file_size(ec);
+            entry.last_use = std::max(entry.last_use, file.last_write_time(ec));
+        }
+        total_bytes += entry.bytes;
+        entries.push_back(std::move(entry));
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const CacheEntry &a, const CacheEntry &b) {
+        return a.last_use < b.last_use;
+    });
+
+    const fs::file_time_type now = fs::file_time_type::clock::now();
+    const fs::path keep_name = fs::path(keep).filename();
+    int removed = 0;
+    for (const CacheEntry &entry : entries)
+    {
+        const auto idle = now - entry.last_use;
+        const bool expired = limits.max_age && idle > *limits.max_age;
+        const bool over_budget = limits.max_bytes && total_bytes > *limits.max_bytes;
+        if (!expired && !over_budget) { continue; }
+        if (!keep_name.empty() && entry.path.filename() == keep_name) { continue; }
+        // A concurrent job may still be reading or filling a recent entry.
+        if (idle < kInUseGrace) { continue; }
+        fs::remove_all(entry.path, ec);
+        if (!ec)
+        {
+            total_bytes -= entry.bytes;
+            ++removed;
+        }
+    }
+    return removed;
+}
+} // namespace autosage
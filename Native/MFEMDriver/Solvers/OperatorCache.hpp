@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: MIT
+// AutoSage MFEM driver extension.
+// Uses MFEM (BSD-3-Clause). See THIRD_PARTY_NOTICES.md.
+
+#pragma once
+
+#include "SolverProfiler.hpp"
+
+#include <mfem.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace autosage
+{
+// On-disk cache of assembled constant operators, shared across jobs.
+//
+// Operators live in the mesh-cache entry of the distributed mesh they were
+// assembled on (<cache>/<mesh hash>-np<ranks>/operators). They are keyed by a
+// content hash of the solver tag, FE order and coefficients. Each rank stores
+// its rows as a raw CSR image and maps it back with mmap. The cache is only
+// opened when the mesh itself came from the cache: the dof numbering then
+// matches the stored operators exactly.
+class OperatorCache
+{
+public:
+    explicit OperatorCache(SolverProfiler &profiler);
+
+    void Open(const std::string &entry_directory);
+    bool Enabled() const { return !directory_.empty(); }
+
+    // Content key of an operator: what it discretizes and every value that
+    // changes its entries.
+    static std::string Key(const std::string &tag, int order, const std::vector<double> &coefficients);
+
+#if defined(MFEM_USE_MPI)
+    // Returns the operator stored under `key` when every rank has a piece
+    // whose row and column partition matches `test_space` x `trial_space`.
+    // Otherwise it calls `assemble` and stores the result. Collective.
+    std::unique_ptr<mfem::HypreParMatrix> LoadOrAssemble(
+        const std::string &key,
+        const mfem::ParFiniteElementSpace &test_space,
+        const mfem::ParFiniteElementSpace &trial_space,
+        const std::function<std::unique_ptr<mfem::HypreParMatrix>()> &assemble);
+#endif
+
+private:
+#if defined(MFEM_USE_MPI)
+    std::unique_ptr<mfem::HypreParMatrix> Load(
+        const std::string &path,
+        const mfem::ParFiniteElementSpace &test_space,
+        const mfem::ParFiniteElementSpace &trial_space);
+    bool Store(const std::string &path, const mfem::HypreParMatrix &matrix);
+#endif
+
+    SolverProfiler &profiler_;
+    std::string directory_;
+};
+
+// From --mesh-cache-max-mb and --mesh-cache-max-age-hours; unset limits do
+// not apply.
+struct CacheLimits
+{
+    std::optional<std::uintmax_t> max_bytes;
+    std::optional<std::chrono::seconds> max_age;
+};
+
+// Removes entries below `cache_directory` that have not been used for longer
+// than `limits.max_age`, then the least recently used ones until the cache
+// holds at most `limits.max_bytes`. The entry in use (`keep`) and entries
+// another job used within the last few minutes are never removed, so the
+// cache can stay above its budget while they are active. Runs on rank 0;
+// returns the number of entries removed there.
+int EvictCacheEntries(const std::string &cache_directory, const CacheLimits &limits, const std::string &keep);
+} // namespace autosage
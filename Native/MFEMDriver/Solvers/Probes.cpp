@@ -0,0 +1,661 @@
+// SPDX-License-Identifier: MIT
+// AutoSage MFEM driver extension.
+// Uses MFEM (BSD-3-Clause). See THIRD_PARTY_NOTICES.md.
+
+#include "Probes.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace
+{
+int current_rank()
+{
+#if defined(MFEM_USE_MPI)
+    int initialized = 0;
+    if (MPI_Initialized(&initialized) == MPI_SUCCESS && initialized)
+    {
+        int rank = 0;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        return rank;
+    }
+#endif
+    return 0;
+}
+
+bool little_endian()
+{
+    const std::uint16_t one = 1;
+    return *reinterpret_cast<const unsigned char *>(&one) == 1;
+}
+
+std::string probe_path(const char *list, std::size_t index)
+{
+    return std::string("config.probes.") + list + "[" + std::to_string(index) + "]";
+}
+
+const json &probe_list(const json &probes, const char *key)
+{
+    const json &list = probes[key];
+    if (!list.is_array())
+    {
+        throw std::runtime_error(std::string("config.probes.") + key + " must be an array when provided.");
+    }
+    return list;
+}
+
+std::string read_name(const json &probe, const std::string &path, const std::string &fallback)
+{
+    if (!probe.contains("name"))
+    {
+        return fallback;
+    }
+    if (!probe["name"].is_string() || probe["name"].get<std::string>().empty())
+    {
+        throw std::runtime_error(path + ".name must be a non-empty string when provided.");
+    }
+    return probe["name"].get<std::string>();
+}
+
+std::string read_field(const json &probe, const std::string &path)
+{
+    if (!probe.contains("field") || !probe["field"].is_string() || probe["field"].get<std::string>().empty())
+    {
+        throw std::runtime_error(path + ".field must be a non-empty string.");
+    }
+    return probe["field"].get<std::string>();
+}
+
+// Nedelec and Raviart-Thomas spaces have vector-valued basis functions with
+// one component per space dimension; otherwise each vdim is a component.
+int field_components(const mfem::FiniteElementSpace &fes)
+{
+    const mfem::Mesh &mesh = *fes.GetMesh();
+    return fes.FEColl()->GetRangeType(mesh.Dimension()) == mfem::FiniteElement::VECTOR
+        ? mesh.SpaceDimension()
+        : fes.GetVDim();
+}
+} // namespace
+
+namespace autosage
+{
+ProbeSettings ParseProbeSettings(const json &config)
+{
+    ProbeSettings settings;
+    if (config.contains("field_output"))
+    {
+        if (!config["field_output"].is_boolean())
+        {
+            throw std::runtime_error("config.field_output must be a boolean.");
+        }
+        settings.field_output = config["field_output"].get<bool>();
+    }
+    if (!config.contains("probes"))
+    {
+        return settings;
+    }
+    const json &probes = config["probes"];
+    if (!probes.is_object())
+    {
+        throw std::runtime_error("config.probes must be an object when provided.");
+    }
+
+    if (probes.contains("format"))
+    {
+        if (!probes["format"].is_string())
+        {
+            throw std::runtime_error("config.probes.format must be a string.");
+        }
+        settings.format = probes["format"].get<std::string>();
+        if (settings.format != "csv" && settings.format != "binary")
+        {
+            throw std::runtime_error("config.probes.format must be csv or binary.");
+        }
+    }
+
+    if (probes.contains("points"))
+    {
+        const json &points = probe_list(probes, "points");
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            const std::string path = probe_path("points", i);
+            const json &point = points[i];
+            if (!point.is_object())
+            {
+                throw std::runtime_error(path + " must be an object.");
+            }
+            PointProbe probe;
+            probe.name = read_name(point, path, "point_" + std::to_string(i));
+            probe.field = read_field(point, path);
+            if (!point.contains("position") || !point["position"].is_array() || point["position"].empty() ||
+                point["position"].size() > 3)
+            {
+                throw std::runtime_error(path + ".position must be an array of 1 to 3 coordinates.");
+            }
+            for (const json &coordinate : point["position"])
+            {
+                if (!coordinate.is_number() || !std::isfinite(coordinate.get<double>()))
+                {
+                    throw std::runtime_error(path + ".position must contain finite numbers.");
+                }
+                probe.position.push_back(coordinate.get<double>());
+            }
+            settings.points.push_back(std::move(probe));
+        }
+    }
+
+    if (probes.contains("boundary"))
+    {
+        const json &boundary = probe_list(probes, "boundary");
+        for (std::size_t i = 0; i < boundary.size(); ++i)
+        {
+            const std::string path = probe_path("boundary", i);
+            const json &entry = boundary[i];
+            if (!entry.is_object())
+            {
+                throw std::runtime_error(path + " must be an object.");
+            }
+            BoundaryProbe probe;
+            probe.name = read_name(entry, path, "boundary_" + std::to_string(i));
+            probe.field = read_field(entry, path);
+            if (!entry.contains("attribute") || !entry["attribute"].is_number_integer() ||
+                entry["attribute"].get<int>() < 1)
+            {
+                throw std::runtime_error(path + ".attribute must be an integer >= 1.");
+            }
+            probe.attribute = entry["attribute"].get<int>();
+            if (entry.contains("quantity"))
+            {
+                if (!entry["quantity"].is_string())
+                {
+                    throw std::runtime_error(path + ".quantity must be a string.");
+                }
+                probe.quantity = entry["quantity"].get<std::string>();
+            }
+            if (probe.quantity != "integral" && probe.quantity != "average" && probe.quantity != "flux")
+            {
+                throw std::runtime_error(path + ".quantity must be integral, average, or flux.");
+            }
+            settings.boundary.push_back(std::move(probe));
+        }
+    }
+
+    if (!settings.Enabled())
+    {
+        throw std::runtime_error("config.probes must list at least one point or boundary probe.");
+    }
+    std::set<std::string> names;
+    for (const PointProbe &probe : settings.points)
+    {
+        if (!names.insert(probe.name).second)
+        {
+            throw std::runtime_error("config.probes names must be unique; '" + probe.name + "' is repeated.");
+        }
+    }
+    for (const BoundaryProbe &probe : settings.boundary)
+    {
+        if (!names.insert(probe.name).second)
+        {
+            throw std::runtime_error("config.probes names must be unique; '" + probe.name + "' is repeated.");
+        }
+    }
+    return settings;
+}
+
+ProbeRecorder::ProbeRecorder(ProbeSettings settings)
+    : settings_(std::move(settings))
+{
+}
+
+void ProbeRecorder::Sample(mfem::Mesh &mesh, const FieldLookup &find_field, int cycle, double time)
+{
+    if (!Enabled())
+    {
+        return;
+    }
+    if (NeedsBind(mesh))
+    {
+        Bind(mesh, find_field);
+    }
+
+    mfem::Vector row(static_cast<int>(columns_.size()));
+    row = 0.0;
+    for (const FieldSampler &sampler : samplers_)
+    {
+        sampler.matrix->AddMult(*sampler.function, row);
+    }
+    // Each point has a single owning rank and each boundary face lives on
+    // one rank, so the sum assembles the full row everywhere.
+    SumOverRanks(row.GetData(), row.Size());
+
+    cycles_.push_back(cycle);
+    times_.push_back(time);
+    values_.insert(values_.end(), row.GetData(), row.GetData() + row.Size());
+}
+
+json ProbeRecorder::Write(const std::string &directory) const
+{
+    const bool binary = settings_.format == "binary";
+    const fs::path path = fs::path(directory) / (binary ? "probes.bin" : "probes.csv");
+    const fs::path header_path = fs::path(directory) / "probes.json";
+
+    std::vector<std::string> columns{"cycle", "time"};
+    columns.insert(columns.end(), columns_.begin(), columns_.end());
+    json description{
+        {"format", settings_.format},
+        {"file", path.string()},
+        {"columns", columns},
+        {"samples", Samples()},
+        {"field_output", settings_.field_output}
+    };
+    if (binary)
+    {
+        description["header_file"] = header_path.string();
+    }
+    if (current_rank() != 0)
+    {
+        return description;
+    }
+
+    const std::size_t width = columns_.size();
+    if (binary)
+    {
+        std::ofstream out(path, std::ios::binary);
+        if (!out)
+        {
+            throw std::runtime_error("Unable to write probe output: " + path.string());
+        }
+        for (std::size_t row = 0; row < times_.size(); ++row)
+        {
+            const double cycle = static_cast<double>(cycles_[row]);
+            out.write(reinterpret_cast<const char *>(&cycle), sizeof(double));
+            out.write(reinterpret_cast<const char *>(&times_[row]), sizeof(double));
+            out.write(
+                reinterpret_cast<const char *>(values_.data() + row * width),
+                static_cast<std::streamsize>(width * sizeof(double)));
+        }
+
+        std::ofstream header(header_path);
+        if (!header)
+        {
+            throw std::runtime_error("Unable to write probe output: " + header_path.string());
+        }
+        header << json{
+            {"columns", columns},
+            {"samples", Samples()},
+            {"dtype", "float64"},
+            {"byte_order", little_endian() ? "little" : "big"},
+            {"layout", "row_major"}
+        }.dump(2) << "\n";
+    }
+    else
+    {
+        std::ofstream out(path);
+        if (!out)
+        {
+            throw std::runtime_error("Unable to write probe output: " + path.string());
+        }
+        out << std::setprecision(std::numeric_limits<double>::max_digits10);
+        for (std::size_t i = 0; i < columns.size(); ++i)
+        {
+            out << (i == 0 ? "" : ",") << columns[i];
+        }
+        out << "\n";
+        for (std::size_t row = 0; row < times_.size(); ++row)
+        {
+            out << cycles_[row] << "," << times_[row];
+            for (std::size_t column = 0; column < width; ++column)
+            {
+                out << "," << values_[row * width + column];
+            }
+            out << "\n";
+        }
+    }
+    return description;
+}
+
+bool ProbeRecorder::NeedsBind(const mfem::Mesh &mesh) const
+{
+    // Refinement bumps the sequence and renumbers dofs, so the stored
+    // weights are rebuilt; both are identical on all ranks.
+    return bound_mesh_ != &mesh || bound_sequence_ != mesh.GetSequence();
+}
+
+void ProbeRecorder::Bind(mfem::Mesh &mesh, const FieldLookup &find_field)
+{
+    samplers_.clear();
+    columns_.clear();
+#if defined(MFEM_USE_MPI)
+    // A serial mesh is replicated on every rank, so its samples must not be
+    // summed across ranks.
+    const auto *pmesh = dynamic_cast<const mfem::ParMesh *>(&mesh);
+    parallel_ = pmesh != nullptr;
+    comm_ = parallel_ ? pmesh->GetComm() : MPI_COMM_NULL;
+#endif
+
+    BindPoints(mesh, find_field);
+    BindBoundary(mesh, find_field);
+
+    const int height = static_cast<int>(columns_.size());
+    for (FieldSampler &sampler : samplers_)
+    {
+        sampler.matrix = std::make_unique<mfem::SparseMatrix>(height, sampler.function->Size());
+        for (const Entry &entry : sampler.entries)
+        {
+            sampler.matrix->Add(entry.column, entry.dof, entry.weight);
+        }
+        sampler.matrix->Finalize();
+        sampler.entries.clear();
+        sampler.entries.shrink_to_fit();
+    }
+    bound_mesh_ = &mesh;
+    bound_sequence_ = mesh.GetSequence();
+}
+
+int ProbeRecorder::SamplerFor(const std::string &field, const std::string &probe, const FieldLookup &find_field)
+{
+    for (std::size_t i = 0; i < samplers_.size(); ++i)
+    {
+        if (samplers_[i].field == field)
+        {
+            return static_cast<int>(i);
+        }
+    }
+    mfem::GridFunction *function = find_field(field);
+    if (function == nullptr)
+    {
+        throw std::runtime_error(probe + ".field '" + field + "' is not an output field of this solver.");
+    }
+    samplers_.emplace_back();
+    samplers_.back().field = field;
+    samplers_.back().function = function;
+    return static_cast<int>(samplers_.size()) - 1;
+}
+
+void ProbeRecorder::AddColumns(const std::string &name, int components, int space_dimension)
+{
+    if (components == 1)
+    {
+        columns_.push_back(name);
+        return;
+    }
+    static const char *axes[] = {"x", "y", "z"};
+    for (int c = 0; c < components; ++c)
+    {
+        const bool spatial = components == space_dimension && c < 3;
+        columns_.push_back(name + "_" + (spatial ? std::string(axes[c]) : std::to_string(c)));
+    }
+}
+
+void ProbeRecorder::AddElementWeights(
+    FieldSampler &sampler,
+    const mfem::FiniteElement &fe,
+    mfem::ElementTransformation &transformation,
+    const mfem::Array<int> &vdofs,
+    int column,
+    double scale,
+    const mfem::Vector *normal)
+{
+    auto add = [&sampler](int target, int vdof, double weight) {
+        if (weight == 0.0)
+        {
+            return;
+        }
+        // Negative vdofs mark basis functions with flipped orientation.
+        if (vdof < 0)
+        {
+            vdof = -1 - vdof;
+            weight = -weight;
+        }
+        sampler.entries.push_back(Entry{target, vdof, weight});
+    };
+
+    const int dof = fe.GetDof();
+    if (fe.GetRangeType() == mfem::FiniteElement::VECTOR)
+    {
+        const int sdim = transformation.GetSpaceDim();
+        mfem::DenseMatrix vshape(dof, sdim);
+        fe.CalcPhysVShape(transformation, vshape);
+        for (int j = 0; j < dof; ++j)
+        {
+            if (normal != nullptr)
+            {
+                double normal_component = 0.0;
+                for (int c = 0; c < sdim; ++c)
+                {
+                    normal_component += vshape(j, c) * (*normal)(c);
+                }
+                add(column, vdofs[j], scale * normal_component);
+                continue;
+            }
+            for (int c = 0; c < sdim; ++c)
+            {
+                add(column + c, vdofs[j], scale * vshape(j, c));
+            }
+        }
+        return;
+    }
+
+    mfem::Vector shape(dof);
+    fe.CalcPhysShape(transformation, shape);
+    const int vdim = vdofs.Size() / dof;
+    for (int c = 0; c < vdim; ++c)
+    {
+        for (int j = 0; j < dof; ++j)
+        {
+            const int vdof = vdofs[c * dof + j];
+            if (normal != nullptr)
+            {
+                add(column, vdof, scale * shape(j) * (*normal)(c));
+            }
+            else
+            {
+                add(column + c, vdof, scale * shape(j));
+            }
+        }
+    }
+}
+
+void ProbeRecorder::BindPoints(mfem::Mesh &mesh, const FieldLookup &find_field)
+{
+    const int count = static_cast<int>(settings_.points.size());
+    if (count == 0)
+    {
+        return;
+    }
+    const int sdim = mesh.SpaceDimension();
+    mfem::DenseMatrix coordinates(sdim, count);
+    for (int i = 0; i < count; ++i)
+    {
+        const PointProbe &probe = settings_.points[i];
+        if (static_cast<int>(probe.position.size()) != sdim)
+        {
+            throw std::runtime_error(
+                probe_path("points", i) + ".position must have " + std::to_string(sdim) +
+                " coordinates for this mesh.");
+        }
+        for (int d = 0; d < sdim; ++d)
+        {
+            coordinates(d, i) = probe.position[d];
+        }
+    }
+
+    // The only point search of the run; on a ParMesh each point is assigned
+    // to exactly one rank.
+    mfem::Array<int> elements;
+    mfem::Array<mfem::IntegrationPoint> points;
+    mesh.FindPoints(coordinates, elements, points, false);
+
+    std::vector<double> found(count);
+    for (int i = 0; i < count; ++i)
+    {
+        found[i] = elements[i] >= 0 ? 1.0 : 0.0;
+    }
+    SumOverRanks(found.data(), count);
+
+    mfem::Array<int> vdofs;
+    for (int i = 0; i < count; ++i)
+    {
+        const PointProbe &probe = settings_.points[i];
+        const std::string path = probe_path("points", i);
+        if (!(found[i] > 0.0))
+        {
+            throw std::runtime_error(path + ".position lies outside the mesh.");
+        }
+        const int sampler = SamplerFor(probe.field, path, find_field);
+        mfem::FiniteElementSpace &fes = *samplers_[sampler].function->FESpace();
+        const int column = static_cast<int>(columns_.size());
+        AddColumns(probe.name, field_components(fes), sdim);
+        if (elements[i] < 0)
+        {
+            continue;
+        }
+        fes.GetElementVDofs(elements[i], vdofs);
+        mfem::ElementTransformation *transformation = fes.GetElementTransformation(elements[i]);
+        transformation->SetIntPoint(&points[i]);
+        AddElementWeights(samplers_[sampler], *fes.GetFE(elements[i]), *transformation, vdofs, column, 1.0, nullptr);
+    }
+}
+
+void ProbeRecorder::BindBoundary(mfem::Mesh &mesh, const FieldLookup &find_field)
+{
+    const int count = static_cast<int>(settings_.boundary.size());
+    if (count == 0)
+    {
+        return;
+    }
+    const int sdim = mesh.SpaceDimension();
+    std::vector<int> sampler_of(count);
+    std::vector<std::pair<std::size_t, std::size_t>> entry_range(count);
+    std::vector<double> areas(count, 0.0);
+
+    mfem::Array<int> vdofs;
+    mfem::Vector normal(sdim);
+    for (int i = 0; i < count; ++i)
+    {
+        const BoundaryProbe &probe = settings_.boundary[i];
+        const std::string path = probe_path("boundary", i);
+        const int sampler = SamplerFor(probe.field, path, find_field);
+        mfem::FiniteElementSpace &fes = *samplers_[sampler].function->FESpace();
+        const int components = field_components(fes);
+        const bool flux = probe.quantity == "flux";
+        if (flux && components != sdim)
+        {
+            throw std::runtime_error(path + ".quantity=flux requires a vector-valued field.");
+        }
+        if (flux && mesh.Dimension() != sdim)
+        {
+            throw std::runtime_error(path + ".quantity=flux is not supported on surface meshes.");
+        }
+        const int column = static_cast<int>(columns_.size());
+        AddColumns(probe.name, flux ? 1 : components, sdim);
+
+        // The functional is assembled through the adjacent element's basis,
+        // so H1, L2 (DG), Nedelec and Raviart-Thomas fields all work.
+        FieldSampler &target = samplers_[sampler];
+        sampler_of[i] = sampler;
+        entry_range[i].first = target.entries.size();
+        for (int b = 0; b < mesh.GetNBE(); ++b)
+        {
+            if (mesh.GetBdrAttribute(b) != probe.attribute)
+            {
+                continue;
+            }
+            mfem::FaceElementTransformations *face = mesh.GetBdrFaceTransformations(b);
+            if (face == nullptr)
+            {
+                continue;
+            }
+            const int element = face->Elem1No;
+            const mfem::FiniteElement &fe = *fes.GetFE(element);
+            fes.GetElementVDofs(element, vdofs);
+            const mfem::IntegrationRule &rule =
+                mfem::IntRules.Get(face->GetGeometryType(), 2 * fe.GetOrder() + face->OrderW());
+            for (int q = 0; q < rule.GetNPoints(); ++q)
+            {
+                const mfem::IntegrationPoint &ip = rule.IntPoint(q);
+                face->SetAllIntPoints(&ip);
+                areas[i] += ip.weight * face->Weight();
+                if (flux)
+                {
+                    // The unnormalized normal already carries the face
+                    // Jacobian determinant.
+                    mfem::CalcOrtho(face->Jacobian(), normal);
+                    AddElementWeights(target, fe, *face->Elem1, vdofs, column, ip.weight, &normal);
+                }
+                else
+                {
+                    AddElementWeights(target, fe, *face->Elem1, vdofs, column, ip.weight * face->Weight(), nullptr);
+                }
+            }
+        }
+        entry_range[i].second = target.entries.size();
+    }
+
+    SumOverRanks(areas.data(), count);
+    for (int i = 0; i < count; ++i)
+    {
+        const BoundaryProbe &probe = settings_.boundary[i];
+        if (!(areas[i] > 0.0))
+        {
+            throw std::runtime_error(
+                probe_path("boundary", i) + ".attribute " + std::to_string(probe.attribute) +
+                " has no boundary faces.");
+        }
+        if (probe.quantity != "average")
+        {
+            continue;
+        }
+        std::vector<Entry> &entries = samplers_[sampler_of[i]].entries;
+        for (std::size_t e = entry_range[i].first; e < entry_range[i].second; ++e)
+        {
+            entries[e].weight /= areas[i];
+        }
+    }
+}
+
+void ProbeRecorder::SumOverRanks(double *values, int count) const
+{
+#if defined(MFEM_USE_MPI)
+    if (parallel_ && count > 0)
+    {
+        MPI_Allreduce(MPI_IN_PLACE, values, count, MPI_DOUBLE, MPI_SUM, comm_);
+    }
+#else
+    (void)values;
+    (void)count;
+#endif
+}
+
+ProbedDataCollection::ProbedDataCollection(
+    const std::string &collection_name,
+    mfem::Mesh *mesh,
+    ProbeRecorder &probes)
+    : mfem::ParaViewDataCollection(collection_name, mesh), probes_(probes)
+{
+}
+
+void ProbedDataCollection::Save()
+{
+    probes_.Sample(
+        *GetMesh(),
+        [this](const std::string &name) { return GetField(name); },
+        GetCycle(),
+        GetTime());
+    if (probes_.FieldOutput())
+    {
+        mfem::ParaViewDataCollection::Save();
+    }
+}
+} // namespace autosage
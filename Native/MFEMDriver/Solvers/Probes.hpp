@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: MIT
+// AutoSage MFEM driver extension.
+// Uses MFEM (BSD-3-Clause). See THIRD_PARTY_NOTICES.md.
+
+#pragma once
+
+#include <mfem.hpp>
+#include <nlohmann/json.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace autosage
+{
+struct PointProbe
+{
+    std::string name;
+    std::string field;
+    std::vector<double> position;
+};
+
+// quantity is "integral", "average" (integral over the boundary area) or
+// "flux" (integral of the normal component of a vector-valued field).
+struct BoundaryProbe
+{
+    std::string name;
+    std::string field;
+    int attribute = 0;
+    std::string quantity = "integral";
+};
+
+// Read from the optional config.probes object and config.field_output flag.
+struct ProbeSettings
+{
+    std::vector<PointProbe> points;
+    std::vector<BoundaryProbe> boundary;
+    // "csv" or "binary" (row-major float64 with a JSON column header).
+    std::string format = "csv";
+    // Without full-field output solvers skip their ParaView collections and
+    // only the probe time series is written.
+    bool field_output = true;
+
+    bool Enabled() const { return !points.empty() || !boundary.empty(); }
+};
+
+ProbeSettings ParseProbeSettings(const nlohmann::json &config);
+
+// Samples point values and boundary functionals of output fields into a time
+// series. On first use (and whenever the mesh changes) every probe is turned
+// into rows of one sparse matrix per field: the shape functions of the
+// element that contains a point, or the quadrature weights of a boundary
+// integral. A sample is then one matvec per field and a single reduction,
+// with no point search or boundary loop after setup.
+class ProbeRecorder
+{
+public:
+    using FieldLookup = std::function<mfem::GridFunction *(const std::string &)>;
+
+    explicit ProbeRecorder(ProbeSettings settings);
+
+    bool Enabled() const { return settings_.Enabled(); }
+    bool FieldOutput() const { return settings_.field_output; }
+    int Samples() const { return static_cast<int>(times_.size()); }
+
+    // Appends one row for (cycle, time). Collective over the mesh's
+    // communicator when it is a ParMesh.
+    void Sample(mfem::Mesh &mesh, const FieldLookup &find_field, int cycle, double time);
+
+    // Writes probes.csv, or probes.bin plus probes.json, into `directory`
+    // from rank 0 and returns a description for the job summary.
+    nlohmann::json Write(const std::string &directory) const;
+
+private:
+    // Weight of local dof `dof` in output column `column`.
+    struct Entry
+    {
+        int column = 0;
+        int dof = 0;
+        double weight = 0.0;
+    };
+
+    struct FieldSampler
+    {
+        std::string field;
+        mfem::GridFunction *function = nullptr;
+        std::vector<Entry> entries;
+        std::unique_ptr<mfem::SparseMatrix> matrix;
+    };
+
+    void Bind(mfem::Mesh &mesh, const FieldLookup &find_field);
+    int SamplerFor(const std::string &field, const std::string &probe, const FieldLookup &find_field);
+    void AddColumns(const std::string &name, int components, int space_dimension);
+    // Appends the weights that map one element's dofs to the field value at
+    // the transformation's integration point times `scale`, in consecutive
+    // columns from `column`, or with `normal` to its normal component.
+    void AddElementWeights(
+        FieldSampler &sampler,
+        const mfem::FiniteElement &fe,
+        mfem::ElementTransformation &transformation,
+        const mfem::Array<int> &vdofs,
+        int column,
+        double scale,
+        const mfem::Vector *normal);
+    void BindPoints(mfem::Mesh &mesh, const FieldLookup &find_field);
+    void BindBoundary(mfem::Mesh &mesh, const FieldLookup &find_field);
+    bool NeedsBind(const mfem::Mesh &mesh) const;
+    void SumOverRanks(double *values, int count) const;
+
+    ProbeSettings settings_;
+    const mfem::Mesh *bound_mesh_ = nullptr;
+    long bound_sequence_ = -1;
+    bool parallel_ = false;
+#if defined(MFEM_USE_MPI)
+    MPI_Comm comm_ = MPI_COMM_NULL;
+#endif
+    std::vector<FieldSampler> samplers_;
+    std::vector<std::string> columns_;
+    std::vector<int> cycles_;
+    std::vector<double> times_;
+    std::vector<double> values_;
+};
+
+// ParaView output that also feeds config.probes. It replaces
+// mfem::ParaViewDataCollection in the solvers: every Save() samples the
+// registered fields, and the VTU files are only written when
+// config.field_output is not false.
+class ProbedDataCollection : public mfem::ParaViewDataCollection
+{
+public:
+    ProbedDataCollection(const std::string &collection_name, mfem::Mesh *mesh, ProbeRecorder &probes);
+
+    void Save() override;
+
+private:
+    ProbeRecorder &probes_;
+};
+} // namespace autosage
@@ -0,0 +1,329 @@
+// SPDX-License-Identifier: MIT
+// AutoSage MFEM driver extension.
+// Uses MFEM (BSD-3-Clause). See THIRD_PARTY_NOTICES.md.
+
+#include "SolverProfiler.hpp"
+
+#include <mfem.hpp>
+
+#if defined(MFEM_USE_MPI)
+#include <mpi.h>
+#endif
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace
+{
+// Long transient runs keep exact totals but only the first entries of the
+// per-solve history, which is enough to spot convergence regressions.
+constexpr std::size_t kMaxHistoryEntries = 65536;
+
+int current_rank()
+{
+#if defined(MFEM_USE_MPI)
+    int initialized = 0;
+    if (MPI_Initialized(&initialized) == MPI_SUCCESS && initialized)
+    {
+        int rank = 0;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        return rank;
+    }
+#endif
+    return 0;
+}
+
+std::int64_t max_over_ranks(std::int64_t value)
+{
+#if defined(MFEM_USE_MPI)
+    int initialized = 0;
+    int finalized = 0;
+    if (MPI_Initialized(&initialized) == MPI_SUCCESS && initialized &&
+        MPI_Finalized(&finalized) == MPI_SUCCESS && !finalized)
+    {
+        long long local = static_cast<long long>(value);
+        long long global = local;
+        MPI_Allreduce(&local, &global, 1, MPI_LONG_LONG, MPI_MAX, MPI_COMM_WORLD);
+        return static_cast<std::int64_t>(global);
+    }
+#endif
+    return value;
+}
+} // namespace
+
+namespace autosage
+{
+std::int64_t peak_resident_set_bytes()
+{
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#if defined(__APPLE__)
+    return static_cast<std::int64_t>(usage.ru_maxrss);
+#else
+    return static_cast<std::int64_t>(usage.ru_maxrss) * 1024;
+#endif
+}
+
+SolverProfiler::SolverProfiler(bool record_trace)
+    : start_(Clock::now()),
+      record_trace_(record_trace),
+      rank_(current_rank())
+{
+}
+
+double SolverProfiler::MicrosecondsSinceStart(Clock::time_point when) const
+{
+    return std::chrono::duration<double, std::micro>(when - start_).count();
+}
+
+void SolverProfiler::BeginPhase(const std::string &name)
+{
+    auto it = phase_index_.find(name);
+    if (it == phase_index_.end())
+    {
+        it = phase_index_.emplace(name, phases_.size()).first;
+        phases_.push_back(PhaseTotals{name});
+    }
+    open_phases_.push_back(OpenPhase{it->second, Clock::now()});
+}
+
+void SolverProfiler::EndPhase()
+{
+    if (open_phases_.empty())
+    {
+        return;
+    }
+    const Clock::time_point end = Clock::now();
+    const OpenPhase open = open_phases_.back();
+    open_phases_.pop_back();
+
+    PhaseTotals &totals = phases_[open.totals_index];
+    totals.seconds += std::chrono::duration<double>(end - open.start).count();
+    totals.calls += 1;
+    totals.peak_rss_bytes = std::max(totals.peak_rss_bytes, peak_resident_set_bytes());
+
+    if (record_trace_)
+    {
+        trace_.push_back(TraceEvent{
+            open.totals_index,
+            MicrosecondsSinceStart(open.start),
+            std::chrono::duration<double, std::micro>(end - open.start).count(),
+            static_cast<int>(open_phases_.size())
+        });
+    }
+}
+
+void SolverProfiler::SetCounter(const std::string &name, double value)
+{
+    for (auto &counter : counters_)
+    {
+        if (counter.first == name)
+        {
+            counter.second = value;
+            return;
+        }
+    }
+    counters_.emplace_back(name, value);
+}
+
+void SolverProfiler::AddToCounter(const std::string &name, double delta)
+{
+    for (auto &counter : counters_)
+    {
+        if (counter.first == name)
+        {
+            counter.second += delta;
+            return;
+        }
+    }
+    counters_.emplace_back(name, delta);
+}
+
+void SolverProfiler::RecordDofs(const std::string &field, long long count)
+{
+    for (auto &entry : dofs_)
+    {
+        if (entry.first == field)
+        {
+            entry.second = count;
+            return;
+        }
+    }
+    dofs_.emplace_back(field, count);
+}
+
+void SolverProfiler::RecordLinearSolve(const std::string &solver, int iterations)
+{
+    auto it = std::find_if(
+        linear_solves_.begin(),
+        linear_solves_.end(),
+        [&](const LinearSolveHistory &history) { return history.solver == solver; });
+    if (it == linear_solves_.end())
+    {
+        LinearSolveHistory history;
+        history.solver = solver;
+        linear_solves_.push_back(std::move(history));
+        it = std::prev(linear_solves_.end());
+    }
+
+    it->solves += 1;
+    it->total_iterations += iterations;
+    it->max_iterations = std::max(it->max_iterations, iterations);
+    if (it->iterations.size() < kMaxHistoryEntries)
+    {
+        it->iterations.push_back(iterations);
+        if (record_trace_)
+        {
+            it->timestamps_us.push_back(MicrosecondsSinceStart(Clock::now()));
+        }
+    }
+}
+
+json SolverProfiler::ToJson() const
+{
+    json phases = json::array();
+    for (const auto &phase : phases_)
+    {
+        phases.push_back(json{
+            {"name", phase.name},
+            {"seconds", phase.seconds},
+            {"calls", phase.calls},
+            {"peak_rss_bytes", phase.peak_rss_bytes}
+        });
+    }
+
+    json counters = json::object();
+    for (const auto &counter : counters_)
+    {
+        counters[counter.first] = counter.second;
+    }
+
+    json dofs = json::object();
+    long long total_dofs = 0;
+    for (const auto &entry : dofs_)
+    {
+        dofs[entry.first] = entry.second;
+        total_dofs += entry.second;
+    }
+    if (!dofs_.empty())
+    {
+        dofs["total"] = total_dofs;
+    }
+
+    json linear_solves = json::array();
+    for (const auto &history : linear_solves_)
+    {
+        linear_solves.push_back(json{
+            {"solver", history.solver},
+            {"solves", history.solves},
+            {"total_iterations", history.total_iterations},
+            {"max_iterations", history.max_iterations},
+            {"iterations", history.iterations},
+            {"truncated", static_cast<std::size_t>(history.solves) > history.iterations.size()}
+        });
+    }
+
+    return json{
+        {"wall_seconds", std::chrono::duration<double>(Clock::now() - start_).count()},
+        {"peak_rss_bytes", max_over_ranks(peak_resident_set_bytes())},
+        {"phases", phases},
+        {"counters", counters},
+        {"dofs", dofs},
+        {"linear_solves", linear_solves}
+    };
+}
+
+void SolverProfiler::WriteChromeTrace(const std::string &path) const
+{
+    if (rank_ != 0)
+    {
+        return;
+    }
+
+    json events = json::array();
+    events.push_back(json{
+        {"name", "process_name"},
+        {"ph", "M"},
+        {"pid", rank_},
+        {"args", {{"name", "mfem-driver"}}}
+    });
+    for (const auto &event : trace_)
+    {
+        events.push_back(json{
+            {"name", phases_[event.totals_index].name},
+            {"cat", "phase"},
+            {"ph", "X"},
+            {"ts", event.start_us},
+            {"dur", event.duration_us},
+            {"pid", rank_},
+            {"tid", 0},
+            {"args", {{"depth", event.depth}}}
+        });
+    }
+    for (const auto &history : linear_solves_)
+    {
+        for (std::size_t i = 0; i < history.timestamps_us.size(); ++i)
+        {
+            events.push_back(json{
+                {"name", "linear_iterations"},
+                {"ph", "C"},
+                {"ts", history.timestamps_us[i]},
+                {"pid", rank_},
+                {"args", {{history.solver, history.iterations[i]}}}
+            });
+        }
+    }
+
+    const fs::path trace_path(path);
+    if (trace_path.has_parent_path())
+    {
+        fs::create_directories(trace_path.parent_path());
+    }
+    std::ofstream out(trace_path, std::ios::binary);
+    if (!out)
+    {
+        throw std::runtime_error("Unable to write trace file: " + path);
+    }
+    out << json{{"traceEvents", events}, {"displayTimeUnit", "ms"}}.dump();
+}
+
+ProfiledPhase::ProfiledPhase(SolverProfiler &profiler, const std::string &name)
+    : profiler_(profiler)
+{
+    Switch(name);
+}
+
+ProfiledPhase::~ProfiledPhase()
+{
+    End();
+}
+
+void ProfiledPhase::Switch(const std::string &name)
+{
+    End();
+    profiler_.BeginPhase(name);
+    open_ = true;
+}
+
+void ProfiledPhase::End()
+{
+    if (open_)
+    {
+        profiler_.EndPhase();
+        open_ = false;
+    }
+}
+} // namespace autosage
@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: MIT
+// AutoSage MFEM driver extension.
+// Uses MFEM (BSD-3-Clause). See THIRD_PARTY_NOTICES.md.
+
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace autosage
+{
+// Collects per-phase wall times, counters, DOF counts and linear-solve
+// iteration histories for one driver run. Timings are local to the calling
+// rank; DOF counts are whatever the solver reports (global true DOFs).
+class SolverProfiler
+{
+public:
+    explicit SolverProfiler(bool record_trace = false);
+
+    void BeginPhase(const std::string &name);
+    void EndPhase();
+
+    void SetCounter(const std::string &name, double value);
+    void AddToCounter(const std::string &name, double delta);
+    void RecordDofs(const std::string &field, long long count);
+    void RecordLinearSolve(const std::string &solver, int iterations);
+
+    nlohmann::json ToJson() const;
+    void WriteChromeTrace(const std::string &path) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct PhaseTotals
+    {
+        std::string name;
+        double seconds = 0.0;
+        int calls = 0;
+        std::int64_t peak_rss_bytes = 0;
+    };
+
+    struct OpenPhase
+    {
+        std::size_t totals_index = 0;
+        Clock::time_point start;
+    };
+
+    struct TraceEvent
+    {
+        std::size_t totals_index = 0;
+        double start_us = 0.0;
+        double duration_us = 0.0;
+        int depth = 0;
+    };
+
+    struct LinearSolveHistory
+    {
+        std::string solver;
+        long long solves = 0;
+        long long total_iterations = 0;
+        int max_iterations = 0;
+        std::vector<int> iterations;
+        std::vector<double> timestamps_us;
+    };
+
+    double MicrosecondsSinceStart(Clock::time_point when) const;
+
+    Clock::time_point start_;
+    bool record_trace_ = false;
+    int rank_ = 0;
+    std::vector<PhaseTotals> phases_;
+    std::unordered_map<std::string, std::size_t> phase_index_;
+    std::vector<OpenPhase> open_phases_;
+    std::vector<TraceEvent> trace_;
+    std::vector<std::pair<std::string, double>> counters_;
+    std::vector<std::pair<std::string, long long>> dofs_;
+    std::vector<LinearSolveHistory> linear_solves_;
+};
+
+// RAII phase marker. Switch() closes the current phase and opens the next,
+// so a solver can walk setup -> assembly -> solve -> output without adding
+// scopes around existing code.
+class ProfiledPhase
+{
+public:
+    ProfiledPhase(SolverProfiler &profiler, const std::string &name);
+    ~ProfiledPhase();
+
+    ProfiledPhase(const ProfiledPhase &) = delete;
+    ProfiledPhase &operator=(const ProfiledPhase &) = delete;
+
+    void Switch(const std::string &name);
+    void End();
+
+private:
+    SolverProfiler &profiler_;
+    bool open_ = false;
+};
+
+std::int64_t peak_resident_set_bytes();
+} // namespace autosage
@@ -144,6 +144,77 @@ StokesFlowSolver::StokesConfig StokesFlowSolver::ParseConfig(
         throw std::runtime_error("config.bcs[].type must be no_slip or inflow.");
     }
 
+    if (config.contains("block_preconditioner"))
+    {
+        if (!config["block_preconditioner"].is_string())
+        {
+            throw std::runtime_error("config.block_preconditioner must be a string when provided.");
+        }
+        const std::string block_preconditioner = to_lower(config["block_preconditioner"].get<std::string>());
+        if (block_preconditioner != "diagonal" && block_preconditioner != "triangular")
+        {
+            throw std::runtime_error("config.block_preconditioner must be diagonal or triangular.");
+        }
+        parsed.triangular_preconditioner = block_preconditioner == "triangular";
+    }
+
+    if (config.contains("schur_complement"))
+    {
+        if (!config["schur_complement"].is_string())
+        {
+            throw std::runtime_error("config.schur_complement must be a string when provided.");
+        }
+        try
+        {
+            parsed.schur_approximation = ParseSchurApproximation(config["schur_complement"].get<std::string>());
+        }
+        catch (const std::runtime_error &)
+        {
+            throw std::runtime_error("config.schur_complement must be mass_jacobi, mass_amg, mass_chebyshev or lsc.");
+        }
+    }
+    if (parsed.schur_approximation == SchurApproximation::LeastSquaresCommutator && !parsed.triangular_preconditioner)
+    {
+        throw std::runtime_error("config.schur_complement lsc requires config.block_preconditioner triangular.");
+    }
+
+    if (config.contains("inflow_cases"))
+    {
+        if (!config["inflow_cases"].is_array())
+        {
+            throw std::runtime_error("config.inflow_cases must be an array.");
+        }
+        for (const auto &inflow_case : config["inflow_cases"])
+        {
+            if (!inflow_case.is_array())
+            {
+                throw std::runtime_error("config.inflow_cases entries must be arrays.");
+            }
+            std::vector<InflowBoundary> overrides;
+            for (const auto &entry : inflow_case)
+            {
+                if (!entry.is_object() || !entry.contains("attribute") || !entry["attribute"].is_number_integer())
+                {
+                    throw std::runtime_error("config.inflow_cases[][].attribute is required and must be an integer.");
+                }
+                InflowBoundary inflow;
+                inflow.attribute = entry["attribute"].get<int>();
+                const bool declared = std::any_of(
+                    parsed.inflow_boundaries.begin(),
+                    parsed.inflow_boundaries.end(),
+                    [&](const InflowBoundary &boundary) { return boundary.attribute == inflow.attribute; }
+                );
+                if (!declared)
+                {
+                    throw std::runtime_error("config.inflow_cases[][].attribute must name an inflow boundary from config.bcs.");
+                }
+                inflow.velocity = parse_vector_components(entry, "velocity", dimension, true);
+                overrides.push_back(inflow);
+            }
+            parsed.inflow_cases.push_back(overrides);
+        }
+    }
+
     if (boundary_slots > 0)
     {
         const bool has_essential = std::any_of(
@@ -169,7 +240,8 @@ SolveSummary StokesFlowSolver::Run(
     const int max_boundary_attribute = mesh.bdr_attributes.Size() > 0 ? mesh.bdr_attributes.Max() : 0;
 
 #if defined(MFEM_USE_MPI)
-    mfem::ParMesh pmesh(MPI_COMM_WORLD, mesh);
+    ProfiledPhase phase(context.profiler, "fe_space_setup");
+    mfem::ParMesh &pmesh = context.mesh_distributor.Distribute(mesh);
     const StokesConfig parsed = ParseConfig(config, dim, max_boundary_attribute);
 
     const int pressure_order = 1;
@@ -178,6 +250,8 @@ SolveSummary StokesFlowSolver::Run(
     mfem::H1_FECollection pressure_collection(pressure_order, dim);
     mfem::ParFiniteElementSpace velocity_space(&pmesh, &velocity_collection, dim);
     mfem::ParFiniteElementSpace pressure_space(&pmesh, &pressure_collection);
+    context.profiler.RecordDofs("velocity", velocity_space.GlobalTrueVSize());
+    context.profiler.RecordDofs("pressure", pressure_space.GlobalTrueVSize());
 
     mfem::ParGridFunction velocity(&velocity_space);
     mfem::ParGridFunction pressure(&pressure_space);
@@ -191,39 +265,66 @@ SolveSummary StokesFlowSolver::Run(
         velocity_ess_bdr[i] = parsed.essential_marker[i];
     }
 
-    const int boundary_slots = std::max(1, max_boundary_attribute);
-    std::vector<mfem::Vector> velocity_components;
-    velocity_components.reserve(dim);
-    for (int d = 0; d < dim; ++d)
+    mfem::Array<int> velocity_ess_tdof_list;
+    if (max_boundary_attribute > 0)
     {
-        velocity_components.emplace_back(boundary_slots);
-        velocity_components.back() = 0.0;
+        velocity_space.GetEssentialTrueDofs(velocity_ess_bdr, velocity_ess_tdof_list);
     }
-    for (const InflowBoundary &inflow : parsed.inflow_boundaries)
+
+    // Case 0 uses the inflow velocities from bcs; each entry of inflow_cases
+    // overrides some of them. The essential set is the same for all cases, so
+    // operators and preconditioners are built once.
+    std::vector<std::vector<InflowBoundary>> cases;
+    cases.push_back(parsed.inflow_boundaries);
+    for (const std::vector<InflowBoundary> &overrides : parsed.inflow_cases)
     {
-        const int idx = inflow.attribute - 1;
-        for (int d = 0; d < dim; ++d)
+        std::vector<InflowBoundary> inflows = parsed.inflow_boundaries;
+        for (const InflowBoundary &override_inflow : overrides)
         {
-            velocity_components[d][idx] = inflow.velocity[d];
+            for (InflowBoundary &inflow : inflows)
+            {
+                if (inflow.attribute == override_inflow.attribute)
+                {
+                    inflow.velocity = override_inflow.velocity;
+                }
+            }
         }
+        cases.push_back(inflows);
     }
 
-    if (max_boundary_attribute > 0)
+    const int boundary_slots = std::max(1, max_boundary_attribute);
+    auto project_inflow = [&](const std::vector<InflowBoundary> &inflows)
     {
+        if (max_boundary_attribute == 0)
+        {
+            return;
+        }
+        std::vector<mfem::Vector> velocity_components;
+        velocity_components.reserve(dim);
+        for (int d = 0; d < dim; ++d)
+        {
+            velocity_components.emplace_back(boundary_slots);
+            velocity_components.back() = 0.0;
+        }
+        for (const InflowBoundary &inflow : inflows)
+        {
+            const int idx = inflow.attribute - 1;
+            for (int d = 0; d < dim; ++d)
+            {
+                velocity_components[d][idx] = inflow.velocity[d];
+            }
+        }
+
         mfem::VectorArrayCoefficient velocity_bdr_coeff(dim);
         for (int d = 0; d < dim; ++d)
         {
             velocity_bdr_coeff.Set(d, new mfem::PWConstCoefficient(velocity_components[d]), true);
         }
         velocity.ProjectBdrCoefficient(velocity_bdr_coeff, velocity_ess_bdr);
-    }
-
-    mfem::Array<int> velocity_ess_tdof_list;
-    if (max_boundary_attribute > 0)
-    {
-        velocity_space.GetEssentialTrueDofs(velocity_ess_bdr, velocity_ess_tdof_list);
-    }
+    };
+    project_inflow(cases.front());
 
+    phase.Switch("assembly");
     mfem::ConstantCoefficient viscosity_coeff(parsed.dynamic_viscosity);
     mfem::ParBilinearForm velocity_form(&velocity_space);
     velocity_form.AddDomainIntegrator(new mfem::VectorDiffusionIntegrator(viscosity_coeff));
@@ -265,7 +366,6 @@ SolveSummary StokesFlowSolver::Run(
     {
         throw std::runtime_error("Failed to assemble Stokes velocity block as HypreParMatrix.");
     }
-    const mfem::Vector velocity_bc_true = velocity_true;
 
     mfem::ParMixedBilinearForm divergence_form(&velocity_space, &pressure_space);
     divergence_form.AddDomainIntegrator(new mfem::VectorDivergenceIntegrator());
@@ -283,74 +383,83 @@ SolveSummary StokesFlowSolver::Run(
         throw std::runtime_error("Failed to assemble Stokes divergence block as HypreParMatrix.");
     }
 
-    mfem::Vector pressure_rhs_true(pressure_space.TrueVSize());
-    pressure_rhs_true = 0.0;
-    if (divergence_full != nullptr && velocity_bc_true.Size() == velocity_space.TrueVSize())
-    {
-        divergence_full->Mult(velocity_bc_true, pressure_rhs_true);
-        pressure_rhs_true *= -1.0;
-    }
-
     mfem::Array<int> block_true_offsets(3);
     block_true_offsets[0] = 0;
     block_true_offsets[1] = velocity_space.TrueVSize();
     block_true_offsets[2] = pressure_space.TrueVSize();
     block_true_offsets.PartialSum();
 
-    mfem::BlockVector rhs(block_true_offsets);
-    rhs = 0.0;
-    rhs.GetBlock(0) = velocity_rhs_true;
-    rhs.GetBlock(1) = pressure_rhs_true;
-
-    mfem::BlockVector solution(block_true_offsets);
-    solution = 0.0;
-    solution.GetBlock(0) = velocity_true;
-
-    auto *gradient_operator = new mfem::TransposeOperator(divergence_matrix);
+    mfem::TransposeOperator gradient_operator(divergence_matrix);
     mfem::BlockOperator stokes_operator(block_true_offsets);
     stokes_operator.SetBlock(0, 0, velocity_matrix);
-    stokes_operator.SetBlock(0, 1, gradient_operator);
+    stokes_operator.SetBlock(0, 1, &gradient_operator);
     stokes_operator.SetBlock(1, 0, divergence_matrix);
 
-    auto *velocity_preconditioner = new mfem::HypreBoomerAMG(*velocity_matrix);
-    velocity_preconditioner->SetPrintLevel(0);
+    phase.Switch("preconditioner_setup");
+    mfem::HypreBoomerAMG velocity_preconditioner(*velocity_matrix);
+    velocity_preconditioner.SetPrintLevel(0);
 
     mfem::ParBilinearForm pressure_mass_form(&pressure_space);
     mfem::ConstantCoefficient inv_viscosity_coeff(1.0 / parsed.dynamic_viscosity);
-    pressure_mass_form.AddDomainIntegrator(new mfem::MassIntegrator(inv_viscosity_coeff));
-    pressure_mass_form.Assemble();
-    pressure_mass_form.Finalize();
-
-    mfem::OperatorHandle pressure_mass_handle(mfem::Operator::Hypre_ParCSR);
-    pressure_mass_form.FormSystemMatrix(empty_tdof_list, pressure_mass_handle);
-    auto *pressure_mass_matrix = dynamic_cast<mfem::HypreParMatrix *>(pressure_mass_handle.Ptr());
-    if (pressure_mass_matrix == nullptr)
+    std::unique_ptr<mfem::Solver> schur_inverse;
+    if (parsed.schur_approximation == SchurApproximation::LeastSquaresCommutator)
     {
-        delete velocity_preconditioner;
-        delete gradient_operator;
-        throw std::runtime_error("Failed to assemble Stokes pressure mass preconditioner matrix.");
+        mfem::ParBilinearForm velocity_mass_form(&velocity_space);
+        velocity_mass_form.AddDomainIntegrator(new mfem::VectorMassIntegrator());
+        velocity_mass_form.Assemble();
+        velocity_mass_form.Finalize();
+        std::unique_ptr<mfem::HypreParMatrix> velocity_mass(velocity_mass_form.ParallelAssemble());
+        mfem::Vector velocity_mass_diag(velocity_mass->GetNumRows());
+        velocity_mass->GetDiag(velocity_mass_diag);
+        schur_inverse = std::make_unique<LeastSquaresCommutatorInverse>(
+            *divergence_matrix,
+            *velocity_matrix,
+            velocity_mass_diag);
+    }
+    else
+    {
+        pressure_mass_form.AddDomainIntegrator(new mfem::MassIntegrator(inv_viscosity_coeff));
+        pressure_mass_form.Assemble();
+        pressure_mass_form.Finalize();
+
+        mfem::OperatorHandle pressure_mass_handle(mfem::Operator::Hypre_ParCSR);
+        pressure_mass_form.FormSystemMatrix(empty_tdof_list, pressure_mass_handle);
+        auto *pressure_mass_matrix = dynamic_cast<mfem::HypreParMatrix *>(pressure_mass_handle.Ptr());
+        if (pressure_mass_matrix == nullptr)
+        {
+            throw std::runtime_error("Failed to assemble Stokes pressure mass preconditioner matrix.");
+        }
+        schur_inverse = MakePressureMassSchurInverse(parsed.schur_approximation, *pressure_mass_matrix);
     }
 
-    mfem::Vector pressure_diag(pressure_mass_matrix->GetNumRows());
-    pressure_mass_matrix->GetDiag(pressure_diag);
-    auto *pressure_preconditioner = new mfem::OperatorJacobiSmoother(pressure_diag, empty_tdof_list);
-    pressure_preconditioner->iterative_mode = false;
-
-    mfem::BlockDiagonalPreconditioner preconditioner(block_true_offsets);
-    preconditioner.SetDiagonalBlock(0, velocity_preconditioner);
-    preconditioner.SetDiagonalBlock(1, pressure_preconditioner);
-
-    mfem::MINRESSolver solver(MPI_COMM_WORLD);
-    solver.SetAbsTol(1.0e-10);
-    solver.SetRelTol(1.0e-8);
-    solver.SetMaxIter(500);
-    solver.SetPrintLevel(0);
-    solver.SetOperator(stokes_operator);
-    solver.SetPreconditioner(preconditioner);
-    solver.Mult(rhs, solution);
-
-    velocity_form.RecoverFEMSolution(solution.GetBlock(0), velocity_rhs_form, velocity);
-    pressure.Distribute(&(solution.GetBlock(1)));
+    std::unique_ptr<mfem::Solver> preconditioner;
+    std::unique_ptr<mfem::IterativeSolver> solver;
+    if (parsed.triangular_preconditioner)
+    {
+        preconditioner = std::make_unique<BlockUpperTriangularPreconditioner>(
+            block_true_offsets,
+            gradient_operator,
+            velocity_preconditioner,
+            *schur_inverse);
+        auto gmres = std::make_unique<mfem::GMRESSolver>(MPI_COMM_WORLD);
+        gmres->SetKDim(100);
+        solver = std::move(gmres);
+    }
+    else
+    {
+        auto block_diagonal = std::make_unique<mfem::BlockDiagonalPreconditioner>(block_true_offsets);
+        block_diagonal->SetDiagonalBlock(0, &velocity_preconditioner);
+        block_diagonal->SetDiagonalBlock(1, schur_inverse.get());
+        preconditioner = std::move(block_diagonal);
+        solver = std::make_unique<mfem::MINRESSolver>(MPI_COMM_WORLD);
+    }
+    const char *krylov_name = parsed.triangular_preconditioner ? "gmres" : "minres";
+    solver->SetAbsTol(1.0e-10);
+    solver->SetRelTol(1.0e-8);
+    solver->SetMaxIter(500);
+    solver->SetPrintLevel(0);
+    solver->SetOperator(stokes_operator);
+    solver->SetPreconditioner(*preconditioner);
 
     const fs::path vtk_path(context.vtk_path);
     const std::string collection_name = vtk_path.stem().empty() ? "solution" : vtk_path.stem().string();
@@ -359,32 +468,111 @@ SolveSummary StokesFlowSolver::Run(
         : context.working_directory;
     fs::create_directories(output_dir);
 
-    mfem::ParaViewDataCollection paraview(collection_name, &pmesh);
+    ProbedDataCollection paraview(collection_name, &pmesh, context.probes);
     paraview.SetPrefixPath(output_dir);
     paraview.SetLevelsOfDetail(1);
     paraview.SetDataFormat(mfem::VTKFormat::ASCII);
     paraview.RegisterField("velocity", &velocity);
     paraview.RegisterField("pressure", &pressure);
-    paraview.SetCycle(0);
-    paraview.SetTime(0.0);
-    paraview.Save();
-
-    std::ofstream vtk_stub(context.vtk_path);
-    vtk_stub << "# Stokes velocity/pressure written to " << collection_name << ".pvd\n";
 
+    mfem::BlockVector rhs(block_true_offsets);
+    mfem::BlockVector solution(block_true_offsets);
+    solution = 0.0;
+    mfem::Vector velocity_bc_true(velocity_space.TrueVSize());
     mfem::Vector residual(rhs.Size());
-    stokes_operator.Mult(solution, residual);
-    residual -= rhs;
 
     SolveSummary summary;
-    summary.energy = 0.5 * mfem::InnerProduct(solution.GetBlock(0), rhs.GetBlock(0));
-    summary.iterations = solver.GetNumIterations();
-    summary.error_norm = residual.Norml2();
+    summary.iterations = 0;
+    summary.error_norm = 0.0;
     summary.dimension = dim;
+    json case_results = json::array();
+    for (std::size_t case_index = 0; case_index < cases.size(); ++case_index)
+    {
+        if (case_index > 0)
+        {
+            phase.Switch("assembly");
+            // Interior values of the previous case remain as the initial guess.
+            project_inflow(cases[case_index]);
+            velocity_form.FormLinearSystem(
+                velocity_ess_tdof_list,
+                velocity,
+                velocity_rhs_form,
+                velocity_operator,
+                velocity_true,
+                velocity_rhs_true
+            );
+        }
+
+        velocity_bc_true = 0.0;
+        for (int i = 0; i < velocity_ess_tdof_list.Size(); ++i)
+        {
+            velocity_bc_true[velocity_ess_tdof_list[i]] = velocity_true[velocity_ess_tdof_list[i]];
+        }
+        rhs.GetBlock(0) = velocity_rhs_true;
+        rhs.GetBlock(1) = 0.0;
+        if (divergence_full != nullptr)
+        {
+            divergence_full->Mult(velocity_bc_true, rhs.GetBlock(1));
+            rhs.GetBlock(1) *= -1.0;
+        }
+        solution.GetBlock(0) = velocity_true;
+
+        phase.Switch("solve");
+        solver->iterative_mode = case_index > 0;
+        solver->Mult(rhs, solution);
+        context.profiler.RecordLinearSolve(krylov_name, solver->GetNumIterations());
+
+        velocity_form.RecoverFEMSolution(solution.GetBlock(0), velocity_rhs_form, velocity);
+        pressure.Distribute(&(solution.GetBlock(1)));
+
+        stokes_operator.Mult(solution, residual);
+        residual -= rhs;
+        const double residual_norm = residual.Norml2();
+
+        phase.Switch("output");
+        paraview.SetCycle(static_cast<int>(case_index));
+        paraview.SetTime(static_cast<double>(case_index));
+        paraview.Save();
+
+        if (case_index == 0)
+        {
+            summary.energy = 0.5 * mfem::InnerProduct(solution.GetBlock(0), rhs.GetBlock(0));
+        }
+        summary.iterations += solver->GetNumIterations();
+        summary.error_norm = std::max(summary.error_norm, residual_norm);
+        case_results.push_back({
+            {"case", case_index},
+            {"iterations", solver->GetNumIterations()},
+            {"converged", solver->GetConverged()},
+            {"residual_norm", residual_norm}
+        });
+    }
+    context.profiler.SetCounter("inflow_cases", static_cast<double>(cases.size()));
+
+    if (context.probes.FieldOutput())
+    {
+        std::ofstream vtk_stub(context.vtk_path);
+        vtk_stub << "# Stokes velocity/pressure written to " << collection_name << ".pvd\n";
+    }
+    phase.End();
+
+    const fs::path metadata_path = fs::path(context.working_directory) / "stokes_flow.json";
+    json metadata = {
+        {"solver_class", "StokesFlow"},
+        {"solver_backend", parsed.triangular_preconditioner ? "gmres_block_triangular" : "minres_block_diagonal"},
+        {"schur_complement", SchurApproximationName(parsed.schur_approximation)},
+        {"velocity_true_dofs", velocity_space.GlobalTrueVSize()},
+        {"pressure_true_dofs", pressure_space.GlobalTrueVSize()},
+        {"preconditioner_setups", 1},
+        {"cases", case_results}
+    };
+    std::ofstream metadata_out(metadata_path);
+    if (!metadata_out)
+    {
+        throw std::runtime_error("Unable to write stokes_flow.json.");
+    }
+    metadata_out << metadata.dump(2);
 
-    delete pressure_preconditioner;
-    delete velocity_preconditioner;
-    delete gradient_operator;
     return summary;
 #else
     (void)mesh;
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "BlockPreconditioners.hpp"
 #include "NavierStokes.hpp"
 
 #include <nlohmann/json.hpp>
@@ -35,6 +36,11 @@ private:
         std::vector<double> body_force;
         std::vector<int> essential_marker;
         std::vector<InflowBoundary> inflow_boundaries;
+        // Extra inflow velocity sets solved with the same operator and
+        // preconditioner after the base case given by bcs.
+        std::vector<std::vector<InflowBoundary>> inflow_cases;
+        bool triangular_preconditioner = false;
+        SchurApproximation schur_approximation = SchurApproximation::MassJacobi;
     };
 
     StokesConfig ParseConfig(
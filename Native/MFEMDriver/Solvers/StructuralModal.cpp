@@ -190,9 +190,11 @@ SolveSummary StructuralModalSolver::Run(
     const double lame_mu = lame.second;
 
 #if defined(MFEM_USE_MPI)
-    mfem::ParMesh pmesh(MPI_COMM_WORLD, mesh);
+    ProfiledPhase phase(context.profiler, "fe_space_setup");
+    mfem::ParMesh &pmesh = context.mesh_distributor.Distribute(mesh);
     mfem::H1_FECollection fec(1, dim);
     mfem::ParFiniteElementSpace fespace(&pmesh, &fec, dim, mfem::Ordering::byVDIM);
+    context.profiler.RecordDofs("displacement", fespace.GlobalTrueVSize());
 
     mfem::Array<int> ess_bdr(max_boundary_attribute);
     ess_bdr = 0;
@@ -201,6 +203,7 @@ SolveSummary StructuralModalSolver::Run(
         ess_bdr[i] = parsed.fixed_marker[i];
     }
 
+    phase.Switch("assembly");
     mfem::ConstantCoefficient lambda_coeff(lame_lambda);
     mfem::ConstantCoefficient mu_coeff(lame_mu);
     mfem::ConstantCoefficient density_coeff(parsed.density);
@@ -220,12 +223,14 @@ SolveSummary StructuralModalSolver::Run(
     mass_form.Finalize();
     std::unique_ptr<mfem::HypreParMatrix> mass(mass_form.ParallelAssemble());
 
+    phase.Switch("preconditioner_setup");
     mfem::HypreBoomerAMG amg(*stiffness);
     amg.SetPrintLevel(0);
     amg.SetElasticityOptions(&fespace);
 
     auto solve_with_inverse_iteration_fallback = [&](const std::string &failure_reason) -> SolveSummary
     {
+        phase.Switch("fallback_solve");
         mfem::CGSolver cg(stiffness->GetComm());
         cg.SetRelTol(1.0e-10);
         cg.SetAbsTol(0.0);
@@ -313,6 +318,7 @@ SolveSummary StructuralModalSolver::Run(
                 mass->Mult(mode, rhs);
                 next_mode = 0.0;
                 cg.Mult(rhs, next_mode);
+                context.profiler.RecordLinearSolve("fallback_cg", cg.GetNumIterations());
 
                 orthogonalize_against_modes(next_mode, modes);
                 normalize_m(next_mode);
@@ -363,6 +369,9 @@ SolveSummary StructuralModalSolver::Run(
             throw std::runtime_error("Inverse-iteration fallback did not produce any modes.");
         }
 
+        context.profiler.SetCounter("eigenmodes", static_cast<double>(modes.size()));
+
+        phase.Switch("output");
         mfem::ParGridFunction first_mode(&fespace);
         first_mode = modes.front();
 
@@ -373,7 +382,7 @@ SolveSummary StructuralModalSolver::Run(
             : context.working_directory;
         fs::create_directories(output_dir);
 
-        mfem::ParaViewDataCollection paraview(collection_name, &pmesh);
+        ProbedDataCollection paraview(collection_name, &pmesh, context.probes);
         paraview.SetPrefixPath(output_dir);
         paraview.SetLevelsOfDetail(1);
         paraview.SetDataFormat(mfem::VTKFormat::ASCII);
@@ -382,9 +391,12 @@ SolveSummary StructuralModalSolver::Run(
         paraview.SetTime(0.0);
         paraview.Save();
 
-        std::ofstream vtk_stub(context.vtk_path);
-        vtk_stub << "# structural mode fields written to " << collection_name
-                 << ".pvd (inverse-iteration fallback)\n";
+        if (context.probes.FieldOutput())
+        {
+            std::ofstream vtk_stub(context.vtk_path);
+            vtk_stub << "# structural mode fields written to " << collection_name
+                     << ".pvd (inverse-iteration fallback)\n";
+        }
 
         const fs::path eigenvalues_path = fs::path(context.working_directory) / "structural_modes.json";
         json modal_data;
@@ -407,6 +419,7 @@ SolveSummary StructuralModalSolver::Run(
             throw std::runtime_error("Unable to write structural_modes.json.");
         }
         modal_out << modal_data.dump(2);
+        phase.End();
 
         mfem::Vector residual_data(stiffness->GetNumRows());
         mfem::HypreParVector residual(
@@ -462,6 +475,7 @@ SolveSummary StructuralModalSolver::Run(
 
     mfem::Array<mfem::real_t> eigenvalues;
     std::string lobpcg_failure_reason;
+    phase.Switch("solve");
     try
     {
         lobpcg.Solve();
@@ -491,6 +505,9 @@ SolveSummary StructuralModalSolver::Run(
         return solve_with_inverse_iteration_fallback(lobpcg_failure_reason);
     }
 
+    context.profiler.SetCounter("eigenmodes", eigenvalues.Size());
+
+    phase.Switch("output");
     mfem::ParGridFunction first_mode(&fespace);
     first_mode = lobpcg.GetEigenvector(0);
 
@@ -501,7 +518,7 @@ SolveSummary StructuralModalSolver::Run(
         : context.working_directory;
     fs::create_directories(output_dir);
 
-    mfem::ParaViewDataCollection paraview(collection_name, &pmesh);
+    ProbedDataCollection paraview(collection_name, &pmesh, context.probes);
     paraview.SetPrefixPath(output_dir);
     paraview.SetLevelsOfDetail(1);
     paraview.SetDataFormat(mfem::VTKFormat::ASCII);
@@ -510,8 +527,11 @@ SolveSummary StructuralModalSolver::Run(
     paraview.SetTime(0.0);
     paraview.Save();
 
-    std::ofstream vtk_stub(context.vtk_path);
-    vtk_stub << "# structural mode fields written to " << collection_name << ".pvd\n";
+    if (context.probes.FieldOutput())
+    {
+        std::ofstream vtk_stub(context.vtk_path);
+        vtk_stub << "# structural mode fields written to " << collection_name << ".pvd\n";
+    }
 
     const fs::path eigenvalues_path = fs::path(context.working_directory) / "structural_modes.json";
     json modal_data;
@@ -533,6 +553,7 @@ SolveSummary StructuralModalSolver::Run(
         throw std::runtime_error("Unable to write structural_modes.json.");
     }
     modal_out << modal_data.dump(2);
+    phase.End();
 
     mfem::Vector r_data(stiffness->GetNumRows());
     mfem::HypreParVector residual(
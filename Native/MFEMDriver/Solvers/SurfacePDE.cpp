@@ -158,9 +158,11 @@ SolveSummary SurfacePDESolver::Run(
     const SurfacePDEConfig parsed = ParseConfig(config, max_boundary_attribute);
 
 #if defined(MFEM_USE_MPI)
-    mfem::ParMesh pmesh(MPI_COMM_WORLD, mesh);
+    ProfiledPhase phase(context.profiler, "fe_space_setup");
+    mfem::ParMesh &pmesh = context.mesh_distributor.Distribute(mesh);
     mfem::H1_FECollection fec(1, dim);
     mfem::ParFiniteElementSpace fespace(&pmesh, &fec);
+    context.profiler.RecordDofs("solution", fespace.GlobalTrueVSize());
     mfem::ParGridFunction solution(&fespace);
     solution = 0.0;
 
@@ -200,6 +202,7 @@ SolveSummary SurfacePDESolver::Run(
         gauge_fix_applied = true;
     }
 
+    phase.Switch("assembly");
     mfem::ConstantCoefficient diffusion_coeff(parsed.diffusion_coefficient);
     mfem::ParBilinearForm stiffness(&fespace);
     stiffness.AddDomainIntegrator(new mfem::DiffusionIntegrator(diffusion_coeff));
@@ -237,6 +240,7 @@ SolveSummary SurfacePDESolver::Run(
     );
     X_hypre = 0.0;
 
+    phase.Switch("preconditioner_setup");
     mfem::HypreBoomerAMG amg(A_hypre);
     amg.SetPrintLevel(0);
 
@@ -246,6 +250,7 @@ SolveSummary SurfacePDESolver::Run(
     pcg.SetMaxIter(2000);
     pcg.SetPrintLevel(0);
     pcg.SetPreconditioner(amg);
+    phase.Switch("solve");
     pcg.Mult(B_hypre, X_hypre);
 
     mfem::Vector residual(B.Size());
@@ -267,6 +272,7 @@ SolveSummary SurfacePDESolver::Run(
         }
     }
 
+    phase.Switch("output");
     stiffness.RecoverFEMSolution(X, rhs, solution);
 
     const fs::path vtk_path(context.vtk_path);
@@ -276,7 +282,7 @@ SolveSummary SurfacePDESolver::Run(
         : context.working_directory;
     fs::create_directories(output_dir);
 
-    mfem::ParaViewDataCollection paraview(collection_name, &pmesh);
+    ProbedDataCollection paraview(collection_name, &pmesh, context.probes);
     paraview.SetPrefixPath(output_dir);
     paraview.SetLevelsOfDetail(1);
     paraview.SetDataFormat(mfem::VTKFormat::ASCII);
@@ -285,11 +291,16 @@ SolveSummary SurfacePDESolver::Run(
     paraview.SetTime(0.0);
     paraview.Save();
 
-    std::ofstream vtk_stub(context.vtk_path);
-    vtk_stub << "# surface PDE field written to " << collection_name << ".pvd\n";
+    if (context.probes.FieldOutput())
+    {
+        std::ofstream vtk_stub(context.vtk_path);
+        vtk_stub << "# surface PDE field written to " << collection_name << ".pvd\n";
+    }
+    phase.End();
 
     int num_iterations = 0;
     pcg.GetNumIterations(num_iterations);
+    context.profiler.RecordLinearSolve("pcg", num_iterations);
 
     SolveSummary summary;
     summary.energy = 0.5 * mfem::InnerProduct(fespace.GetComm(), X, B);
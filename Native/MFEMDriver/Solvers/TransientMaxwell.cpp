@@ -3,6 +3,7 @@
 // Uses MFEM (BSD-3-Clause). See THIRD_PARTY_NOTICES.md.
 
 #include "TransientMaxwell.hpp"
+#include "ExplicitNewmark.hpp"
 
 #include <algorithm>
 #include <cctype>
@@ -100,6 +101,45 @@ double l2_norm(const std::vector<double> &values)
 }
 
 #if defined(MFEM_USE_MPI)
+// Mass lumping for lowest-order Nedelec elements on quadrilaterals and
+// hexahedra: integrating at the element vertices only couples edges that
+// meet at a vertex, and those are orthogonal on affine elements, so the
+// assembled matrix is diagonal there. On distorted elements its diagonal is
+// kept.
+mfem::Vector assemble_lumped_edge_mass(mfem::ParFiniteElementSpace &fespace, double coefficient)
+{
+    const int dim = fespace.GetParMesh()->Dimension();
+    const mfem::Geometry::Type geometry = dim == 2 ? mfem::Geometry::SQUARE : mfem::Geometry::CUBE;
+    mfem::IntegrationRules vertex_rules(0, mfem::Quadrature1D::GaussLobatto);
+
+    mfem::ConstantCoefficient coeff(coefficient);
+    auto *integrator = new mfem::VectorFEMassIntegrator(coeff);
+    integrator->SetIntRule(&vertex_rules.Get(geometry, 1));
+
+    mfem::ParBilinearForm lumped_form(&fespace);
+    lumped_form.AddDomainIntegrator(integrator);
+    lumped_form.Assemble(0);
+    lumped_form.Finalize(0);
+    std::unique_ptr<mfem::HypreParMatrix> lumped(lumped_form.ParallelAssemble());
+    mfem::Vector diagonal(fespace.GetTrueVSize());
+    lumped->GetDiag(diagonal);
+    return diagonal;
+}
+
+bool all_tensor_product_elements(mfem::ParMesh &pmesh)
+{
+    const int dim = pmesh.Dimension();
+    const mfem::Geometry::Type geometry = dim == 2 ? mfem::Geometry::SQUARE : mfem::Geometry::CUBE;
+    int local_ok = dim == 2 || dim == 3 ? 1 : 0;
+    for (int i = 0; i < pmesh.GetNE() && local_ok != 0; ++i)
+    {
+        local_ok = pmesh.GetElementBaseGeometry(i) == geometry ? 1 : 0;
+    }
+    int global_ok = 0;
+    MPI_Allreduce(&local_ok, &global_ok, 1, MPI_INT, MPI_MIN, pmesh.GetComm());
+    return global_ok != 0;
+}
+
 class DipolePulseCoefficient final : public mfem::VectorCoefficient
 {
 public:
@@ -414,6 +454,34 @@ TransientMaxwellSolver::TransientMaxwellConfig TransientMaxwellSolver::ParseConf
     {
         throw std::runtime_error("config.output_interval_steps must be > 0.");
     }
+    if (config.contains("time_integration"))
+    {
+        if (!config["time_integration"].is_string())
+        {
+            throw std::runtime_error("config.time_integration must be a string.");
+        }
+        parsed.time_integration = to_lower(config["time_integration"].get<std::string>());
+        if (parsed.time_integration != "implicit" && parsed.time_integration != "explicit")
+        {
+            throw std::runtime_error("config.time_integration must be implicit or explicit.");
+        }
+    }
+    if (config.contains("cfl"))
+    {
+        if (!config["cfl"].is_number())
+        {
+            throw std::runtime_error("config.cfl must be numeric.");
+        }
+        parsed.cfl = config["cfl"].get<double>();
+        if (!(parsed.cfl > 0.0 && parsed.cfl < 1.0))
+        {
+            throw std::runtime_error("config.cfl must be in (0, 1).");
+        }
+    }
+    if (parsed.time_integration == "explicit" && parsed.order != 1)
+    {
+        throw std::runtime_error("config.time_integration=explicit requires config.order=1.");
+    }
 
     if (!config.contains("initial_condition") || !config["initial_condition"].is_object())
     {
@@ -496,12 +564,21 @@ SolveSummary TransientMaxwellSolver::Run(
     const int max_boundary_attribute = mesh.bdr_attributes.Size() > 0 ? mesh.bdr_attributes.Max() : 0;
 
 #if defined(MFEM_USE_MPI)
-    mfem::ParMesh pmesh(MPI_COMM_WORLD, mesh);
+    ProfiledPhase phase(context.profiler, "fe_space_setup");
+    mfem::ParMesh &pmesh = context.mesh_distributor.Distribute(mesh);
     const int space_dimension = pmesh.SpaceDimension();
     const TransientMaxwellConfig parsed = ParseConfig(config, space_dimension, max_boundary_attribute);
+    const bool explicit_stepping = parsed.time_integration == "explicit";
+    if (explicit_stepping && !all_tensor_product_elements(pmesh))
+    {
+        throw std::runtime_error(
+            "config.time_integration=explicit requires a quadrilateral or hexahedral mesh.");
+    }
 
     mfem::ND_FECollection fec(parsed.order, dim);
     mfem::ParFiniteElementSpace fespace(&pmesh, &fec);
+    context.profiler.RecordDofs("electric_field", fespace.GlobalTrueVSize());
+    context.profiler.RecordDofs("electric_rate", fespace.GlobalTrueVSize());
 
     mfem::Array<int> ess_bdr(max_boundary_attribute);
     ess_bdr = 0;
@@ -541,6 +618,7 @@ SolveSummary TransientMaxwellSolver::Run(
         state_e = electric_true;
     }
 
+    phase.Switch("assembly");
     MaxwellOperator operator_impl(
         fespace,
         ess_tdof_list,
@@ -553,6 +631,37 @@ SolveSummary TransientMaxwellSolver::Run(
     mfem::SDIRK34Solver ode_solver;
     ode_solver.Init(operator_impl);
 
+    mfem::Vector state_rate(state.GetData() + 0, true_size);
+    mfem::Vector state_field(state.GetData() + true_size, true_size);
+    std::unique_ptr<ExplicitNewmarkSolver> explicit_solver;
+    double stable_dt = 0.0;
+    if (explicit_stepping)
+    {
+        const mfem::Vector lumped_mass = assemble_lumped_edge_mass(fespace, parsed.permittivity);
+        // Both coefficients are constant, so the lumped conductivity term is
+        // the lumped mass scaled by sigma / epsilon.
+        mfem::Vector lumped_damping;
+        if (parsed.conductivity > 0.0)
+        {
+            lumped_damping = lumped_mass;
+            lumped_damping *= parsed.conductivity / parsed.permittivity;
+        }
+        explicit_solver = std::make_unique<ExplicitNewmarkSolver>(
+            operator_impl.StiffnessMatrix(),
+            lumped_mass,
+            lumped_damping,
+            ess_tdof_list);
+        stable_dt = explicit_solver->StableTimeStep(parsed.cfl);
+        if (!(stable_dt > 0.0))
+        {
+            throw std::runtime_error("Unable to estimate a stable explicit time step.");
+        }
+        explicit_solver->Init(state_field, state_rate);
+        context.profiler.SetCounter("cfl_dt", stable_dt);
+    }
+    long long explicit_substeps = 0;
+
+    phase.Switch("output");
     const fs::path vtk_path(context.vtk_path);
     const std::string collection_name = vtk_path.stem().empty() ? "solution" : vtk_path.stem().string();
     const std::string output_dir = vtk_path.has_parent_path()
@@ -560,7 +669,7 @@ SolveSummary TransientMaxwellSolver::Run(
         : context.working_directory;
     fs::create_directories(output_dir);
 
-    mfem::ParaViewDataCollection paraview(collection_name, &pmesh);
+    ProbedDataCollection paraview(collection_name, &pmesh, context.probes);
     paraview.SetPrefixPath(output_dir);
     paraview.SetLevelsOfDetail(1);
     paraview.SetDataFormat(mfem::VTKFormat::ASCII);
@@ -581,20 +690,51 @@ SolveSummary TransientMaxwellSolver::Run(
     int step = 0;
     save_step(step, time);
 
+    phase.Switch("solve");
     while (time + 1.0e-12 < parsed.t_final)
     {
         mfem::real_t step_dt = std::min(parsed.dt, parsed.t_final - time);
-        ode_solver.Step(state, time, step_dt);
+        if (explicit_stepping)
+        {
+            const int substeps = std::max(1, static_cast<int>(std::ceil(step_dt / stable_dt - 1.0e-12)));
+            const double substep_dt = step_dt / substeps;
+            for (int substep = 0; substep < substeps; ++substep)
+            {
+                explicit_solver->Step(state_field, state_rate, substep_dt);
+            }
+            explicit_substeps += substeps;
+            time += step_dt;
+        }
+        else
+        {
+            const int implicit_iterations_before = operator_impl.TotalImplicitIterations();
+            ode_solver.Step(state, time, step_dt);
+            context.profiler.RecordLinearSolve(
+                "implicit_cg",
+                operator_impl.TotalImplicitIterations() - implicit_iterations_before);
+        }
         operator_impl.ApplyEssentialBCs(state);
         ++step;
         if (step % parsed.output_interval_steps == 0 || time + 1.0e-12 >= parsed.t_final)
         {
+            ProfiledPhase output_phase(context.profiler, "output");
             save_step(step, time);
         }
     }
+    phase.End();
+    context.profiler.SetCounter("time_steps", step);
+    context.profiler.SetCounter("mass_solve_iterations", operator_impl.TotalMassIterations());
+    if (explicit_stepping)
+    {
+        context.profiler.SetCounter("explicit_substeps", static_cast<double>(explicit_substeps));
+        context.profiler.SetCounter("stiffness_matvecs", explicit_solver->StiffnessMatVecs());
+    }
 
-    std::ofstream vtk_stub(context.vtk_path);
-    vtk_stub << "# transient electromagnetic fields written to " << collection_name << ".pvd\n";
+    if (context.probes.FieldOutput())
+    {
+        std::ofstream vtk_stub(context.vtk_path);
+        vtk_stub << "# transient electromagnetic fields written to " << collection_name << ".pvd\n";
+    }
 
     mfem::Vector final_rate(state.GetData() + 0, true_size);
     mfem::Vector final_field(state.GetData() + true_size, true_size);
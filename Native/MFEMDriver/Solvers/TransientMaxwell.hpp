@@ -38,6 +38,11 @@ private:
         double t_final = 1.0e-9;
         int order = 1;
         int output_interval_steps = 10;
+        // implicit: SDIRK34 with AMS. explicit: central differences on a
+        // vertex-quadrature lumped mass, sub-stepped at cfl times the
+        // stability limit within each dt.
+        std::string time_integration = "implicit";
+        double cfl = 0.8;
         InitialCondition initial_condition;
         std::vector<int> perfect_conductor_marker;
     };
@@ -33,6 +33,8 @@
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <functional>
@@ -56,6 +58,10 @@ struct DriverArgs
     std::string result_path;
     std::string summary_path;
     std::string vtk_path;
+    std::string trace_path;
+    std::string mesh_cache_path;
+    std::string mesh_cache_max_mb;
+    std::string mesh_cache_max_age_hours;
 };
 
 using autosage::SolveSummary;
@@ -104,16 +110,39 @@ std::string require_flag_value(int argc, char **argv, const std::string &flag)
     throw std::runtime_error("Missing required flag: " + flag);
 }
 
+std::string optional_flag_value(int argc, char **argv, const std::string &flag)
+{
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (flag == argv[i]) { return argv[i + 1]; }
+    }
+    return {};
+}
+
 DriverArgs parse_args(int argc, char **argv)
 {
     return DriverArgs{
         require_flag_value(argc, argv, "--input"),
         require_flag_value(argc, argv, "--result"),
         require_flag_value(argc, argv, "--summary"),
-        require_flag_value(argc, argv, "--vtk")
+        require_flag_value(argc, argv, "--vtk"),
+        optional_flag_value(argc, argv, "--trace"),
+        optional_flag_value(argc, argv, "--mesh-cache"),
+        optional_flag_value(argc, argv, "--mesh-cache-max-mb"),
+        optional_flag_value(argc, argv, "--mesh-cache-max-age-hours")
     };
 }
 
+std::uintmax_t parse_cache_limit(const std::string &value, const char *flag)
+{
+    if (value.empty() ||
+        !std::all_of(value.begin(), value.end(), [](unsigned char c) { return std::isdigit(c) != 0; }))
+    {
+        throw std::runtime_error(std::string(flag) + " must be a non-negative integer.");
+    }
+    return static_cast<std::uintmax_t>(std::stoull(value));
+}
+
 std::string read_text(const std::string &path)
 {
     std::ifstream in(path, std::ios::binary);
@@ -345,7 +374,7 @@ std::string prepare_mesh_file(const json &mesh, const fs::path &working_dir)
         return mesh_path.string();
     }
 
-    throw std::runtime_error("mesh.type must be inline_mfem or file.");
+    throw std::runtime_error("mesh.type must be inline_mfem, file, or partitioned.");
 }
 
 const json *analysis_opts_or_null(const json &config)
@@ -473,13 +502,20 @@ void write_solution_vtk(const std::string &vtk_path, mfem::Mesh &mesh, mfem::Gri
     solution.SaveVTK(out, field_name.c_str(), 1);
 }
 
-SolveSummary solve_poisson(const json &config, mfem::Mesh &mesh, const std::string &vtk_path)
+SolveSummary solve_poisson(
+    const json &config,
+    mfem::Mesh &mesh,
+    const std::string &vtk_path,
+    autosage::SolverProfiler &profiler,
+    autosage::ProbeRecorder &probes)
 {
     const int dim = mesh.Dimension();
     const int order = 1;
 
+    autosage::ProfiledPhase phase(profiler, "fe_space_setup");
     mfem::H1_FECollection fec(order, dim);
     mfem::FiniteElementSpace fespace(&mesh, &fec);
+    profiler.RecordDofs("solution", fespace.GetTrueVSize());
 
     mfem::Array<int> ess_tdof_list;
     if (mesh.bdr_attributes.Size() > 0)
@@ -496,6 +532,7 @@ SolveSummary solve_poisson(const json &config, mfem::Mesh &mesh, const std::stri
     mfem::GridFunction x(&fespace);
     x = 0.0;
 
+    phase.Switch("assembly");
     mfem::ConstantCoefficient one(1.0);
     a.AddDomainIntegrator(new mfem::DiffusionIntegrator(one));
     b.AddDomainIntegrator(new mfem::DomainLFIntegrator(rhs_coeff));
@@ -506,8 +543,11 @@ SolveSummary solve_poisson(const json &config, mfem::Mesh &mesh, const std::stri
     mfem::Vector B, X;
     a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
 
+    phase.Switch("preconditioner_setup");
     auto &A_sparse = dynamic_cast<mfem::SparseMatrix &>(*A);
     mfem::GSSmoother M(A_sparse);
+
+    phase.Switch("solve");
     mfem::CGSolver cg;
     cg.SetRelTol(analysis_rel_tol(config, 1e-12));
     cg.SetAbsTol(0.0);
@@ -516,13 +556,24 @@ SolveSummary solve_poisson(const json &config, mfem::Mesh &mesh, const std::stri
     cg.SetOperator(A_sparse);
     cg.SetPreconditioner(M);
     cg.Mult(B, X);
+    profiler.RecordLinearSolve("cg", cg.GetNumIterations());
 
     mfem::Vector residual(B.Size());
     A_sparse.Mult(X, residual);
     residual -= B;
 
     a.RecoverFEMSolution(X, b, x);
-    write_solution_vtk(vtk_path, mesh, x, "solution");
+    phase.Switch("output");
+    probes.Sample(
+        mesh,
+        [&x](const std::string &name) { return name == "solution" ? &x : nullptr; },
+        0,
+        0.0);
+    if (probes.FieldOutput())
+    {
+        write_solution_vtk(vtk_path, mesh, x, "solution");
+    }
+    phase.End();
 
     SolveSummary summary;
     summary.energy = 0.5 * mfem::InnerProduct(X, B);
@@ -542,10 +593,18 @@ public:
         const json &config,
         const autosage::SolverExecutionContext &context) override
     {
-        return solve_poisson(config, mesh, context.vtk_path);
+        return solve_poisson(config, mesh, context.vtk_path, context.profiler, context.probes);
     }
 };
 
+// Solvers that work on the serial mesh directly, or modify it before
+// partitioning, cannot take an already distributed mesh.
+bool requires_serial_mesh(const std::string &solver_class)
+{
+    return solver_class == "Poisson" || solver_class == "Advection" || solver_class == "CompressibleEuler" ||
+        solver_class == "AMRLaplace";
+}
+
 using SolverFactory = std::function<std::unique_ptr<autosage::PhysicsSolver>()>;
 
 const std::unordered_map<std::string, SolverFactory> &solver_factories()
@@ -592,7 +651,33 @@ std::unique_ptr<autosage::PhysicsSolver> create_solver(const std::string &solver
     return it->second();
 }
 
-json build_summary_json(const SolveSummary &summary, const std::string &solver_class)
+// Vertex count of the whole mesh. A distributed piece also holds the vertices
+// it shares with neighbours, so only those in groups this rank owns count.
+double global_vertex_count(mfem::Mesh &mesh)
+{
+#if defined(MFEM_USE_MPI)
+    if (auto *pmesh = dynamic_cast<mfem::ParMesh *>(&mesh))
+    {
+        long long owned = pmesh->GetNV();
+        for (int group = 1; group < pmesh->GetNGroups(); ++group)
+        {
+            if (!pmesh->gtopo.IAmMaster(group))
+            {
+                owned -= pmesh->GroupNVertices(group);
+            }
+        }
+        long long total = 0;
+        MPI_Allreduce(&owned, &total, 1, MPI_LONG_LONG, MPI_SUM, pmesh->GetComm());
+        return static_cast<double>(total);
+    }
+#endif
+    return mesh.GetNV();
+}
+
+json build_summary_json(
+    const SolveSummary &summary,
+    const std::string &solver_class,
+    const autosage::SolverProfiler &profiler)
 {
     return json{
         {"status", "ok"},
@@ -601,6 +686,7 @@ json build_summary_json(const SolveSummary &summary, const std::string &solver_c
         {"iterations", summary.iterations},
         {"error_norm", summary.error_norm},
         {"dimension", summary.dimension},
+        {"profile", profiler.ToJson()},
         {"summary", solver_class + " solve completed."}
     };
 }
@@ -627,28 +713,109 @@ int main(int argc, char **argv)
         mfem::Hypre::Init();
 #endif
         const DriverArgs args = parse_args(argc, argv);
+        autosage::CacheLimits cache_limits;
+        if (!args.mesh_cache_max_mb.empty())
+        {
+            cache_limits.max_bytes = parse_cache_limit(args.mesh_cache_max_mb, "--mesh-cache-max-mb") << 20;
+        }
+        if (!args.mesh_cache_max_age_hours.empty())
+        {
+            cache_limits.max_age = std::chrono::hours(
+                parse_cache_limit(args.mesh_cache_max_age_hours, "--mesh-cache-max-age-hours"));
+        }
         const fs::path working_dir = fs::absolute(fs::path(args.input_path)).parent_path();
 
         const json input = load_input_json(args.input_path);
         const std::string solver_class = normalize_solver_class(input.value("solver_class", ""));
         const json &mesh_input = require_object_field(input, "mesh");
         const json &config = require_object_field(input, "config");
-        const std::string mesh_path = prepare_mesh_file(mesh_input, working_dir);
 
-        mfem::Mesh mesh(mesh_path.c_str(), 1, 1);
-        mesh.EnsureNodes();
+        autosage::SolverProfiler profiler(!args.trace_path.empty());
+        autosage::MeshDistributor mesh_distributor;
+        std::unique_ptr<mfem::Mesh> serial_mesh;
+        autosage::ProfiledPhase mesh_phase(profiler, "mesh_load");
+        const bool serial_only = requires_serial_mesh(solver_class);
+        if (to_lower(mesh_input.value("type", "")) == "partitioned")
+        {
+            if (serial_only)
+            {
+                throw std::runtime_error(solver_class + " requires a serial mesh; mesh.type=partitioned is not supported.");
+            }
+            const std::string prefix = mesh_input.value("prefix", "");
+            if (prefix.empty()) { throw std::runtime_error("mesh.prefix is required when mesh.type=partitioned."); }
+            mesh_distributor.LoadPartitioned(prefix);
+        }
+        else
+        {
+            const std::string mesh_path = prepare_mesh_file(mesh_input, working_dir);
+            if (!serial_only && !args.mesh_cache_path.empty())
+            {
+                const bool hit = mesh_distributor.UseCache(args.mesh_cache_path, mesh_path);
+                profiler.SetCounter("mesh_cache_hit", hit ? 1.0 : 0.0);
+            }
+            if (mesh_distributor.AdoptedMesh() == nullptr)
+            {
+                serial_mesh = std::make_unique<mfem::Mesh>(mesh_path.c_str(), 1, 1);
+                serial_mesh->EnsureNodes();
+            }
+        }
+        mfem::Mesh &mesh = mesh_distributor.AdoptedMesh() != nullptr ? *mesh_distributor.AdoptedMesh() : *serial_mesh;
+        profiler.SetCounter("mesh_elements", static_cast<double>(mesh.GetGlobalNE()));
+        profiler.SetCounter("mesh_vertices", global_vertex_count(mesh));
+        mesh_phase.End();
+
+        // Stored operators are only valid for the dof numbering of a mesh
+        // that was itself loaded from the cache.
+        autosage::OperatorCache operator_cache(profiler);
+        if (mesh_distributor.CacheHit())
+        {
+            operator_cache.Open(mesh_distributor.CacheEntry());
+        }
+
+        autosage::ProbeRecorder probes(autosage::ParseProbeSettings(config));
 
         const std::unique_ptr<autosage::PhysicsSolver> solver = create_solver(solver_class);
         const autosage::SolverExecutionContext context{
             working_dir.string(),
-            args.vtk_path
+            args.vtk_path,
+            profiler,
+            mesh_distributor,
+            operator_cache,
+            probes
         };
         const SolveSummary summary = solver->Run(mesh, config, context);
 
-        const json summary_json = build_summary_json(summary, solver_class);
+        json probe_output;
+        if (probes.Enabled())
+        {
+            autosage::ProfiledPhase probe_phase(profiler, "probe_output");
+            probe_output = probes.Write(working_dir.string());
+            profiler.SetCounter("probe_samples", probes.Samples());
+        }
+
+        if (!args.mesh_cache_path.empty() && (cache_limits.max_bytes || cache_limits.max_age))
+        {
+            const int evicted =
+                autosage::EvictCacheEntries(args.mesh_cache_path, cache_limits, mesh_distributor.CacheEntry());
+            profiler.SetCounter("cache_evictions", evicted);
+        }
+
+        json summary_json = build_summary_json(summary, solver_class, profiler);
+        if (!probe_output.is_null())
+        {
+            summary_json["probes"] = probe_output;
+        }
         json result_json = summary_json;
         result_json["summary_file"] = args.summary_path;
-        result_json["vtk_file"] = args.vtk_path;
+        if (probes.FieldOutput())
+        {
+            result_json["vtk_file"] = args.vtk_path;
+        }
+        if (!args.trace_path.empty())
+        {
+            result_json["trace_file"] = args.trace_path;
+            profiler.WriteChromeTrace(args.trace_path);
+        }
 
         write_json(args.summary_path, summary_json);
         write_json(args.result_path, result_json);
@@ -0,0 +1,336 @@
+// SPDX-License-Identifier: MIT
+// AutoSage MFEM driver integration test.
+// Uses MFEM (BSD-3-Clause). See THIRD_PARTY_NOTICES.md.
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace
+{
+constexpr int kSkipReturnCode = 77;
+constexpr int kGridCells = 8;
+constexpr double kDt = 0.05;
+constexpr double kFinalTime = 0.5;
+constexpr double kAmplitude = 1.0;
+
+std::string shell_quote(const fs::path &path)
+{
+    const std::string raw = path.string();
+    std::string quoted = "'";
+    for (char c : raw)
+    {
+        if (c == '\'')
+        {
+            quoted += "'\\''";
+        }
+        else
+        {
+            quoted += c;
+        }
+    }
+    quoted += "'";
+    return quoted;
+}
+
+void write_text(const fs::path &path, const std::string &text)
+{
+    fs::create_directories(path.parent_path());
+    std::ofstream out(path, std::ios::binary);
+    if (!out)
+    {
+        throw std::runtime_error("Unable to write file: " + path.string());
+    }
+    out << text;
+}
+
+std::string read_text(const fs::path &path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        return {};
+    }
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+json load_json(const fs::path &path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        throw std::runtime_error("Unable to read JSON file: " + path.string());
+    }
+    return json::parse(in);
+}
+
+void require(bool condition, const std::string &message)
+{
+    if (!condition)
+    {
+        throw std::runtime_error(message);
+    }
+}
+
+fs::path make_temp_dir()
+{
+    const fs::path base = fs::temp_directory_path();
+    std::mt19937_64 rng(343);
+    for (int i = 0; i < 64; ++i)
+    {
+        const fs::path candidate = base / ("autosage-acoustic-wave-" + std::to_string(rng()));
+        std::error_code ec;
+        if (fs::create_directory(candidate, ec))
+        {
+            return candidate;
+        }
+    }
+    throw std::runtime_error("Unable to create a temporary test directory.");
+}
+
+bool is_expected_skip_error(const std::string &stderr_text)
+{
+    return stderr_text.find("AcousticWave solver requires MFEM built with MPI.") != std::string::npos;
+}
+
+// Unit square split into kGridCells x kGridCells quadrilaterals, with one
+// boundary attribute on the whole outline.
+std::string make_square_mesh()
+{
+    const int n = kGridCells;
+    auto vertex = [n](int i, int j) { return j * (n + 1) + i; };
+
+    std::ostringstream mesh;
+    mesh << "MFEM mesh v1.0\n\ndimension\n2\n\nelements\n" << n * n << "\n";
+    for (int j = 0; j < n; ++j)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            mesh << "1 3 " << vertex(i, j) << ' ' << vertex(i + 1, j) << ' ' << vertex(i + 1, j + 1) << ' '
+                 << vertex(i, j + 1) << "\n";
+        }
+    }
+    mesh << "\nboundary\n" << 4 * n << "\n";
+    for (int k = 0; k < n; ++k)
+    {
+        mesh << "1 1 " << vertex(k, 0) << ' ' << vertex(k + 1, 0) << "\n";
+        mesh << "1 1 " << vertex(n, k) << ' ' << vertex(n, k + 1) << "\n";
+        mesh << "1 1 " << vertex(k + 1, n) << ' ' << vertex(k, n) << "\n";
+        mesh << "1 1 " << vertex(0, k + 1) << ' ' << vertex(0, k) << "\n";
+    }
+    mesh << "\nvertices\n" << (n + 1) * (n + 1) << "\n2\n";
+    for (int j = 0; j <= n; ++j)
+    {
+        for (int i = 0; i <= n; ++i)
+        {
+            mesh << static_cast<double>(i) / n << ' ' << static_cast<double>(j) / n << "\n";
+        }
+    }
+    return mesh.str();
+}
+
+json make_input(const std::string &time_integration, double cfl)
+{
+    return json{
+        {"solver_class", "AcousticWave"},
+        {"mesh",
+         {
+             {"type", "inline_mfem"},
+             {"data", make_square_mesh()}
+         }},
+        {"config",
+         {
+             {"wave_speed", 1.0},
+             {"dt", kDt},
+             {"t_final", kFinalTime},
+             {"time_integration", time_integration},
+             {"cfl", cfl},
+             {"initial_condition",
+              {
+                  {"type", "gaussian_pulse"},
+                  {"amplitude", kAmplitude},
+                  {"center", {0.5, 0.5}}
+              }},
+             {"probes",
+              {
+                  {"points",
+                   json::array({
+                       {
+                           {"name", "center"},
+                           {"field", "acoustic_potential"},
+                           {"position", {0.5, 0.5}}
+                       }
+                   })}
+              }},
+             {"bcs",
+              json::array({
+                  {
+                      {"attribute", 1},
+                      {"type", "rigid_wall"}
+                  }
+              })}
+         }}
+    };
+}
+
+// Runs the driver on `input` in a fresh subdirectory. Returns the exit status
+// and fills `stderr_text`.
+int run_driver(const fs::path &driver_binary, const fs::path &case_dir, const json &input, std::string &stderr_text)
+{
+    const fs::path input_path = case_dir / "job_input.json";
+    const fs::path stderr_path = case_dir / "driver.stderr.log";
+    write_text(input_path, input.dump(2));
+
+    const std::string command =
+        shell_quote(driver_binary) + " --input " + shell_quote(input_path) + " --result " +
+        shell_quote(case_dir / "job_result.json") + " --summary " + shell_quote(case_dir / "job_summary.json") +
+        " --vtk " + shell_quote(case_dir / "solution.vtk") + " > " + shell_quote(case_dir / "driver.stdout.log") +
+        " 2> " + shell_quote(stderr_path);
+    const int status = std::system(command.c_str());
+    stderr_text = read_text(stderr_path);
+    return status;
+}
+
+double counter(const json &summary, const std::string &name)
+{
+    const json &counters = summary["profile"]["counters"];
+    require(counters.contains(name) && counters[name].is_number(), "Expected profile.counters." + name + ".");
+    return counters[name].get<double>();
+}
+
+double max_abs_probe(const fs::path &probes_path, int &rows)
+{
+    std::ifstream in(probes_path);
+    require(static_cast<bool>(in), "Expected probes.csv artifact is missing.");
+    std::string header;
+    std::getline(in, header);
+    require(header == "cycle,time,center", "Unexpected probes.csv header: " + header);
+    double max_abs = 0.0;
+    rows = 0;
+    for (std::string line; std::getline(in, line);)
+    {
+        ++rows;
+        const std::size_t last_comma = line.rfind(',');
+        require(last_comma != std::string::npos, "Malformed probes.csv row: " + line);
+        const double value = std::stod(line.substr(last_comma + 1));
+        require(std::isfinite(value), "Non-finite probe value: " + line);
+        max_abs = std::max(max_abs, std::abs(value));
+    }
+    return max_abs;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        require(argc >= 2, "Usage: AcousticWaveIntegrationTest <path-to-mfem-driver>");
+
+        const fs::path driver_binary = fs::absolute(argv[1]);
+        require(fs::exists(driver_binary), "mfem-driver binary does not exist: " + driver_binary.string());
+
+        const fs::path run_dir = make_temp_dir();
+        const int expected_steps = static_cast<int>(std::lround(kFinalTime / kDt));
+
+        // A cfl of one sits on the stability limit and must be rejected.
+        std::string stderr_text;
+        const fs::path rejected_dir = run_dir / "cfl_one";
+        require(
+            run_driver(driver_binary, rejected_dir, make_input("explicit", 1.0), stderr_text) != 0,
+            "Expected config.cfl = 1 to be rejected."
+        );
+        require(
+            stderr_text.find("config.cfl must be in (0, 1).") != std::string::npos,
+            "Unexpected error for config.cfl = 1:\n" + stderr_text
+        );
+
+        const fs::path implicit_dir = run_dir / "implicit";
+        if (run_driver(driver_binary, implicit_dir, make_input("implicit", 0.8), stderr_text) != 0)
+        {
+            if (is_expected_skip_error(stderr_text))
+            {
+                std::cout << "AcousticWave integration test skipped: " << stderr_text << std::endl;
+                std::error_code cleanup_error;
+                fs::remove_all(run_dir, cleanup_error);
+                return kSkipReturnCode;
+            }
+            throw std::runtime_error("mfem-driver returned non-zero status for the implicit run:\n" + stderr_text);
+        }
+
+        const fs::path explicit_dir = run_dir / "explicit";
+        if (run_driver(driver_binary, explicit_dir, make_input("explicit", 0.8), stderr_text) != 0)
+        {
+            throw std::runtime_error("mfem-driver returned non-zero status for the explicit run:\n" + stderr_text);
+        }
+
+        const json implicit_summary = load_json(implicit_dir / "job_summary.json");
+        const json explicit_summary = load_json(explicit_dir / "job_summary.json");
+        require(explicit_summary.value("status", "") == "ok", "job_summary.json status was not ok.");
+
+        require(
+            static_cast<int>(counter(implicit_summary, "time_steps")) == expected_steps &&
+                static_cast<int>(counter(explicit_summary, "time_steps")) == expected_steps,
+            "Expected both runs to take one output step per config.dt."
+        );
+
+        // Every substep must stay within cfl_dt, and each substep costs one
+        // stiffness matvec after the initial acceleration.
+        const double cfl_dt = counter(explicit_summary, "cfl_dt");
+        const double substeps = counter(explicit_summary, "explicit_substeps");
+        require(cfl_dt > 0.0 && std::isfinite(cfl_dt), "Expected a positive cfl_dt.");
+        require(substeps >= expected_steps, "Expected at least one explicit substep per output step.");
+        require(
+            kFinalTime / substeps <= cfl_dt * (1.0 + 1.0e-9),
+            "Explicit substeps exceed the reported stable step."
+        );
+        require(
+            counter(explicit_summary, "stiffness_matvecs") == substeps + 1.0,
+            "Expected one stiffness matvec per substep plus the initial acceleration."
+        );
+
+        // Both schemes are non-dissipative; an unstable explicit step would
+        // grow the energy and the field without bound.
+        const double implicit_energy = implicit_summary.value("energy", 0.0);
+        const double explicit_energy = explicit_summary.value("energy", 0.0);
+        require(
+            std::isfinite(explicit_energy) && explicit_energy > 0.0,
+            "Expected a positive, finite explicit energy."
+        );
+        require(
+            explicit_energy < 1.5 * implicit_energy,
+            "Explicit energy " + std::to_string(explicit_energy) + " grew past the implicit run's " +
+                std::to_string(implicit_energy) + "."
+        );
+
+        int probe_rows = 0;
+        const double max_potential = max_abs_probe(explicit_dir / "probes.csv", probe_rows);
+        require(probe_rows == expected_steps + 1, "Expected one probe row for the initial state and each step.");
+        require(
+            max_potential <= 2.0 * kAmplitude,
+            "Explicit acoustic potential is unbounded: " + std::to_string(max_potential)
+        );
+
+        std::cout << "AcousticWave integration test passed. Run dir: " << run_dir << std::endl;
+
+        std::error_code cleanup_error;
+        fs::remove_all(run_dir, cleanup_error);
+        return 0;
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << "AcousticWave integration test failed: " << ex.what() << std::endl;
+        return 1;
+    }
+}
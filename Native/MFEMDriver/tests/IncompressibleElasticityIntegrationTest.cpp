@@ -168,6 +168,7 @@ vertices
              {
                  {"shear_modulus", 50000.0},
                  {"bulk_modulus", 1.0e7},
+                 {"nonlinear", {{"load_steps", 2}}},
                  {"bcs",
                   json::array({
                       {
@@ -231,6 +232,17 @@ vertices
                 metadata_json["newton_iterations"].get<int>() >= 0,
             "Expected non-negative newton_iterations."
         );
+        require(
+            metadata_json.contains("nonlinear_solver") && metadata_json["nonlinear_solver"].is_object(),
+            "Expected nonlinear_solver statistics."
+        );
+        const json &nonlinear_json = metadata_json["nonlinear_solver"];
+        require(nonlinear_json.value("converged", false), "Expected nonlinear_solver.converged=true.");
+        require(nonlinear_json.value("load_steps", 0) == 2, "Expected nonlinear_solver.load_steps=2.");
+        require(
+            nonlinear_json.value("linear_iterations", -1) >= 0,
+            "Expected non-negative nonlinear_solver.linear_iterations."
+        );
         require(
             metadata_json.contains("pressure_gauge_fix_applied") &&
                 metadata_json["pressure_gauge_fix_applied"].is_boolean() &&
@@ -106,15 +106,64 @@ int run_driver(
     const fs::path &result_path,
     const fs::path &summary_path,
     const fs::path &vtk_path,
+    const fs::path &trace_path,
     const fs::path &stdout_path,
     const fs::path &stderr_path)
 {
     const std::string command =
         shell_quote(driver_binary) + " --input " + shell_quote(input_path) + " --result " +
         shell_quote(result_path) + " --summary " + shell_quote(summary_path) + " --vtk " +
-        shell_quote(vtk_path) + " > " + shell_quote(stdout_path) + " 2> " + shell_quote(stderr_path);
+        shell_quote(vtk_path) + " --trace " + shell_quote(trace_path) + " > " + shell_quote(stdout_path) +
+        " 2> " + shell_quote(stderr_path);
     return std::system(command.c_str());
 }
+
+// Runs `input` in its own subdirectory of the test directory and returns the
+// variant's joule_heating.json.
+json run_variant(const fs::path &driver_binary, const fs::path &variant_dir, const json &input)
+{
+    const fs::path input_path = variant_dir / "job_input.json";
+    const fs::path stderr_path = variant_dir / "driver.stderr.log";
+    write_text(input_path, input.dump(2));
+    const int exit_status = run_driver(
+        driver_binary,
+        input_path,
+        variant_dir / "job_result.json",
+        variant_dir / "job_summary.json",
+        variant_dir / "solution.vtk",
+        variant_dir / "trace.json",
+        variant_dir / "driver.stdout.log",
+        stderr_path
+    );
+    if (exit_status != 0)
+    {
+        throw std::runtime_error(
+            "mfem-driver returned non-zero status for " + variant_dir.filename().string() + ":\n" +
+            read_text(stderr_path));
+    }
+    return load_json(variant_dir / "joule_heating.json");
+}
+
+// Column `column` of the last probes.csv row, i.e. of the final output
+// (1 is the time, 2 the center temperature).
+double last_probe_value(const fs::path &probes_path, int column)
+{
+    std::ifstream in(probes_path);
+    require(static_cast<bool>(in), "Expected probes.csv artifact is missing: " + probes_path.string());
+    std::string last;
+    for (std::string line; std::getline(in, line);)
+    {
+        last = line;
+    }
+    std::size_t begin = 0;
+    for (int skipped = 0; skipped < column; ++skipped)
+    {
+        begin = last.find(',', begin);
+        require(begin != std::string::npos, "Malformed probes.csv row: " + last);
+        ++begin;
+    }
+    return std::stod(last.substr(begin, last.find(',', begin) - begin));
+}
 } // namespace
 
 int main(int argc, char **argv)
@@ -131,6 +180,7 @@ int main(int argc, char **argv)
         const fs::path result_path = run_dir / "job_result.json";
         const fs::path summary_path = run_dir / "job_summary.json";
         const fs::path vtk_path = run_dir / "solution.vtk";
+        const fs::path trace_path = run_dir / "trace.json";
         const fs::path stdout_path = run_dir / "driver.stdout.log";
         const fs::path stderr_path = run_dir / "driver.stderr.log";
         const fs::path pvd_path = run_dir / "solution" / "solution.pvd";
@@ -173,6 +223,26 @@ vertices
                  {"dt", 0.1},
                  {"t_final", 0.2},
                  {"output_interval_steps", 1},
+                 {"probes",
+                  {
+                      {"points",
+                       json::array({
+                           {
+                               {"name", "center"},
+                               {"field", "temperature"},
+                               {"position", {0.25, 0.25}}
+                           }
+                       })},
+                      {"boundary",
+                       json::array({
+                           {
+                               {"name", "cooled_edge"},
+                               {"field", "temperature"},
+                               {"attribute", 3},
+                               {"quantity", "average"}
+                           }
+                       })}
+                  }},
                  {"bcs",
                   json::array({
                       {
@@ -196,7 +266,16 @@ vertices
 
         write_text(input_path, input_json.dump(2));
         const int exit_status =
-            run_driver(driver_binary, input_path, result_path, summary_path, vtk_path, stdout_path, stderr_path);
+            run_driver(
+            driver_binary,
+            input_path,
+            result_path,
+            summary_path,
+            vtk_path,
+            trace_path,
+            stdout_path,
+            stderr_path
+        );
 
         if (exit_status != 0)
         {
@@ -213,10 +292,55 @@ vertices
 
         const json result_json = load_json(result_path);
         require(result_json.value("status", "") == "ok", "job_result.json status was not ok.");
+        require(
+            result_json.value("vtk_file", "") == vtk_path.string(),
+            "Expected vtk_file in job_result.json with field output on."
+        );
 
         const json summary_json = load_json(summary_path);
         require(summary_json.value("status", "") == "ok", "job_summary.json status was not ok.");
 
+        require(
+            summary_json.contains("profile") && summary_json["profile"].is_object(),
+            "Expected profile section in job_summary.json."
+        );
+        const json &profile = summary_json["profile"];
+        require(
+            profile.contains("phases") && profile["phases"].is_array() && !profile["phases"].empty(),
+            "Expected non-empty profile.phases."
+        );
+        bool has_solve_phase = false;
+        for (const auto &phase : profile["phases"])
+        {
+            require(
+                phase.contains("seconds") && phase["seconds"].is_number() && phase["seconds"].get<double>() >= 0.0,
+                "Expected non-negative seconds for every profile phase."
+            );
+            has_solve_phase = has_solve_phase || phase.value("name", "") == "solve";
+        }
+        require(has_solve_phase, "Expected a solve phase in profile.phases.");
+        require(
+            profile.contains("dofs") && profile["dofs"].value("temperature", 0LL) > 0,
+            "Expected positive temperature DOF count in profile.dofs."
+        );
+        require(
+            profile.contains("counters") && profile["counters"].value("time_steps", 0.0) > 0.0,
+            "Expected positive time_steps counter in profile.counters."
+        );
+        require(
+            profile.contains("linear_solves") && profile["linear_solves"].is_array() &&
+                !profile["linear_solves"].empty(),
+            "Expected linear solve history in profile.linear_solves."
+        );
+
+        require(fs::exists(trace_path), "Expected trace.json artifact is missing.");
+        const json trace_json = load_json(trace_path);
+        require(
+            trace_json.contains("traceEvents") && trace_json["traceEvents"].is_array() &&
+                trace_json["traceEvents"].size() > 1,
+            "Expected traceEvents in trace.json."
+        );
+
         const fs::path metadata_path = run_dir / "joule_heating.json";
         require(fs::exists(metadata_path), "Expected joule_heating.json artifact is missing.");
 
@@ -249,10 +373,182 @@ vertices
                 metadata_json["electric_iterations"].get<int>() >= 0,
             "Expected non-negative electric_iterations in joule_heating.json."
         );
+        require(
+            metadata_json.value("electric_solves", 0) == 1,
+            "Expected a single electric solve for a temperature-independent conductivity."
+        );
+        require(
+            metadata_json.contains("coupling_error_estimate") &&
+                metadata_json["coupling_error_estimate"].is_number() &&
+                std::isfinite(metadata_json["coupling_error_estimate"].get<double>()),
+            "Expected finite coupling_error_estimate in joule_heating.json."
+        );
+        require(
+            metadata_json.contains("time_stepping") && metadata_json["time_stepping"].is_object(),
+            "Expected a time_stepping object in joule_heating.json."
+        );
+        const json &time_stepping = metadata_json["time_stepping"];
+        require(
+            time_stepping.value("accepted_steps", -1) == metadata_json["time_steps"].get<int>() &&
+                time_stepping.value("rejected_steps", -1) == 0,
+            "Expected fixed time stepping to accept every step."
+        );
+        require(
+            time_stepping.value("operator_setups", 0) >= 1,
+            "Expected at least one implicit operator setup."
+        );
 
         require(fs::exists(vtk_path), "Expected solution.vtk artifact is missing.");
         require(fs::exists(pvd_path), "Expected solution.pvd artifact is missing.");
 
+        require(
+            summary_json.contains("probes") && summary_json["probes"].is_object(),
+            "Expected a probes section in job_summary.json."
+        );
+        const int probe_samples = summary_json["probes"].value("samples", 0);
+        require(
+            probe_samples == metadata_json["time_steps"].get<int>() + 1,
+            "Expected one probe sample for the initial state and each output step."
+        );
+        const fs::path probes_path = run_dir / "probes.csv";
+        require(fs::exists(probes_path), "Expected probes.csv artifact is missing.");
+        std::ifstream probes_in(probes_path);
+        std::string header;
+        std::getline(probes_in, header);
+        require(header == "cycle,time,center,cooled_edge", "Unexpected probes.csv header: " + header);
+        int probe_rows = 0;
+        for (std::string line; std::getline(probes_in, line);)
+        {
+            ++probe_rows;
+            const std::size_t last_comma = line.rfind(',');
+            require(last_comma != std::string::npos, "Malformed probes.csv row: " + line);
+            const double edge_temperature = std::stod(line.substr(last_comma + 1));
+            require(
+                std::abs(edge_temperature - 293.15) < 1.0e-6 * 293.15,
+                "Expected the cooled edge to average the fixed temperature, got " + std::to_string(edge_temperature)
+            );
+        }
+        require(probe_rows == probe_samples, "Expected one probes.csv row per sample.");
+
+        // Probes only: no ParaView collection, no stub at the --vtk path and
+        // no vtk_file pointing at either.
+        json probes_only_input = input_json;
+        probes_only_input["config"]["field_output"] = false;
+        const fs::path probes_only_dir = run_dir / "probes_only";
+        run_variant(driver_binary, probes_only_dir, probes_only_input);
+        require(fs::exists(probes_only_dir / "probes.csv"), "Expected probes.csv without field output.");
+        require(!fs::exists(probes_only_dir / "solution.vtk"), "Expected no solution.vtk without field output.");
+        require(
+            !fs::exists(probes_only_dir / "solution" / "solution.pvd"),
+            "Expected no solution.pvd without field output."
+        );
+        require(
+            !load_json(probes_only_dir / "job_result.json").contains("vtk_file"),
+            "Expected no vtk_file in job_result.json without field output."
+        );
+
+        // Adaptive stepping on a longer run: the heating is nearly linear in
+        // time, so the controller should grow the step up to dt_max and
+        // finish in far fewer steps than config.dt would take.
+        constexpr double kLongFinalTime = 2.0;
+        constexpr double kAdaptiveMaxDt = 0.5;
+        json fixed_input = input_json;
+        fixed_input["config"]["t_final"] = kLongFinalTime;
+        const json fixed_metadata = run_variant(driver_binary, run_dir / "fixed_long", fixed_input);
+
+        json adaptive_input = fixed_input;
+        adaptive_input["config"]["time_stepping"] = {
+            {"adaptive", true},
+            {"dt_max", kAdaptiveMaxDt}
+        };
+        const json adaptive_metadata = run_variant(driver_binary, run_dir / "adaptive", adaptive_input);
+        const json &adaptive_stepping = adaptive_metadata["time_stepping"];
+        const int fixed_steps = fixed_metadata.value("time_steps", 0);
+        const int adaptive_steps = adaptive_metadata.value("time_steps", 0);
+        require(fixed_steps == 20, "Expected the fixed-step run to take t_final / dt steps.");
+        require(
+            adaptive_stepping.value("accepted_steps", -1) == adaptive_steps &&
+                adaptive_stepping.contains("rejected_steps") && adaptive_stepping["rejected_steps"].is_number_integer() &&
+                adaptive_stepping["rejected_steps"].get<int>() >= 0,
+            "Expected adaptive stepping to report its accepted and rejected steps."
+        );
+        require(
+            adaptive_steps > 0 && adaptive_steps < fixed_steps,
+            "Expected adaptive stepping to take fewer steps than the fixed-step run, got " +
+                std::to_string(adaptive_steps) + "."
+        );
+        require(
+            adaptive_stepping.value("max_dt", 0.0) <= kAdaptiveMaxDt * (1.0 + 1.0e-12),
+            "Adaptive step exceeded config.time_stepping.dt_max."
+        );
+        require(
+            std::abs(last_probe_value(run_dir / "adaptive" / "probes.csv", 1) - kLongFinalTime) < 1.0e-9,
+            "Expected the adaptive run to end exactly at t_final."
+        );
+
+        // Temperature-dependent conductivity: the Joule load now changes
+        // with the temperature, so the potential is re-solved during the run.
+        // Subcycling it and iterating it to convergence (Picard) must both
+        // stay close to re-solving once per step.
+        constexpr int kCoupledSteps = 10;
+        json coupled_input = input_json;
+        coupled_input["config"]["t_final"] = kCoupledSteps * 0.1;
+        coupled_input["config"]["temperature_coefficient"] = 1.0e-3;
+        const json tight_metadata = run_variant(driver_binary, run_dir / "coupled_tight", coupled_input);
+
+        json subcycled_input = coupled_input;
+        subcycled_input["config"]["coupling"] = {{"electric_interval_steps", 2}};
+        const json subcycled_metadata = run_variant(driver_binary, run_dir / "coupled_subcycled", subcycled_input);
+
+        constexpr int kPicardMaxIterations = 5;
+        json picard_input = coupled_input;
+        picard_input["config"]["coupling"] = {
+            {"picard_max_iterations", kPicardMaxIterations},
+            {"picard_tolerance", 1.0e-8}
+        };
+        const json picard_metadata = run_variant(driver_binary, run_dir / "coupled_picard", picard_input);
+
+        for (const json *metadata : {&tight_metadata, &subcycled_metadata, &picard_metadata})
+        {
+            require(
+                metadata->value("time_steps", 0) == kCoupledSteps,
+                "Expected every coupled run to take t_final / dt steps."
+            );
+        }
+        // One solve at setup, then one before every step after the first
+        // that is due for a refresh.
+        require(
+            tight_metadata.value("electric_solves", 0) == kCoupledSteps &&
+                tight_metadata.value("coupling_scheme", "") == "staggered",
+            "Expected one electric solve per step for the tightly coupled run."
+        );
+        require(
+            subcycled_metadata.value("electric_solves", 0) == 1 + (kCoupledSteps - 1) / 2,
+            "Expected one electric solve every two steps for the subcycled run, got " +
+                std::to_string(subcycled_metadata.value("electric_solves", 0)) + "."
+        );
+        const int picard_iterations = picard_metadata.value("picard_iterations", 0);
+        require(
+            picard_metadata.value("coupling_scheme", "") == "picard" &&
+                picard_iterations >= kCoupledSteps &&
+                picard_iterations <= kCoupledSteps * (kPicardMaxIterations - 1) &&
+                picard_metadata.value("electric_solves", 0) == 1 + picard_iterations,
+            "Expected one electric solve per Picard iteration, with at least one per step."
+        );
+
+        const double tight_temperature = last_probe_value(run_dir / "coupled_tight" / "probes.csv", 2);
+        const double tight_rise = tight_temperature - 293.15;
+        require(tight_rise > 0.0, "Expected Joule heating to raise the center temperature.");
+        for (const char *variant : {"coupled_subcycled", "coupled_picard"})
+        {
+            const double temperature = last_probe_value(run_dir / variant / "probes.csv", 2);
+            require(
+                std::abs(temperature - tight_temperature) <= 0.05 * tight_rise,
+                std::string("Center temperature of ") + variant + " (" + std::to_string(temperature) +
+                    ") differs from the tightly coupled run (" + std::to_string(tight_temperature) + ")."
+            );
+        }
+
         std::cout << "JouleHeating integration test passed. Run dir: " << run_dir << std::endl;
 
         std::error_code cleanup_error;
@@ -0,0 +1,300 @@
+// SPDX-License-Identifier: MIT
+// AutoSage MFEM driver integration test.
+// Uses MFEM (BSD-3-Clause). See THIRD_PARTY_NOTICES.md.
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace
+{
+constexpr int kSkipReturnCode = 77;
+constexpr int kGridCells = 4;
+
+std::string shell_quote(const fs::path &path)
+{
+    const std::string raw = path.string();
+    std::string quoted = "'";
+    for (char c : raw)
+    {
+        if (c == '\'')
+        {
+            quoted += "'\\''";
+        }
+        else
+        {
+            quoted += c;
+        }
+    }
+    quoted += "'";
+    return quoted;
+}
+
+void write_text(const fs::path &path, const std::string &text)
+{
+    fs::create_directories(path.parent_path());
+    std::ofstream out(path, std::ios::binary);
+    if (!out)
+    {
+        throw std::runtime_error("Unable to write file: " + path.string());
+    }
+    out << text;
+}
+
+std::string read_text(const fs::path &path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        return {};
+    }
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+json load_json(const fs::path &path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        throw std::runtime_error("Unable to read JSON file: " + path.string());
+    }
+    return json::parse(in);
+}
+
+void require(bool condition, const std::string &message)
+{
+    if (!condition)
+    {
+        throw std::runtime_error(message);
+    }
+}
+
+fs::path make_temp_dir()
+{
+    const fs::path base = fs::temp_directory_path();
+    std::mt19937_64 rng(271828);
+    for (int i = 0; i < 64; ++i)
+    {
+        const fs::path candidate = base / ("autosage-operator-cache-" + std::to_string(rng()));
+        std::error_code ec;
+        if (fs::create_directory(candidate, ec))
+        {
+            return candidate;
+        }
+    }
+    throw std::runtime_error("Unable to create a temporary test directory.");
+}
+
+bool is_expected_skip_error(const std::string &stderr_text)
+{
+    return stderr_text.find("HeatTransfer solver requires MFEM built with MPI.") != std::string::npos;
+}
+
+// Unit square split into kGridCells x kGridCells quadrilaterals, with one
+// boundary attribute on the whole outline.
+std::string make_square_mesh()
+{
+    const int n = kGridCells;
+    auto vertex = [n](int i, int j) { return j * (n + 1) + i; };
+
+    std::ostringstream mesh;
+    mesh << "MFEM mesh v1.0\n\ndimension\n2\n\nelements\n" << n * n << "\n";
+    for (int j = 0; j < n; ++j)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            mesh << "1 3 " << vertex(i, j) << ' ' << vertex(i + 1, j) << ' ' << vertex(i + 1, j + 1) << ' '
+                 << vertex(i, j + 1) << "\n";
+        }
+    }
+    mesh << "\nboundary\n" << 4 * n << "\n";
+    for (int k = 0; k < n; ++k)
+    {
+        mesh << "1 1 " << vertex(k, 0) << ' ' << vertex(k + 1, 0) << "\n";
+        mesh << "1 1 " << vertex(n, k) << ' ' << vertex(n, k + 1) << "\n";
+        mesh << "1 1 " << vertex(k + 1, n) << ' ' << vertex(k, n) << "\n";
+        mesh << "1 1 " << vertex(0, k + 1) << ' ' << vertex(0, k) << "\n";
+    }
+    mesh << "\nvertices\n" << (n + 1) * (n + 1) << "\n2\n";
+    for (int j = 0; j <= n; ++j)
+    {
+        for (int i = 0; i <= n; ++i)
+        {
+            mesh << static_cast<double>(i) / n << ' ' << static_cast<double>(j) / n << "\n";
+        }
+    }
+    return mesh.str();
+}
+
+// Runs the HeatTransfer job in `run_dir` against the shared cache and returns
+// job_summary.json. `extra_flags` is appended to the command line.
+json run_job(
+    const fs::path &driver_binary,
+    const fs::path &run_dir,
+    const fs::path &cache_dir,
+    const json &input,
+    const std::string &extra_flags,
+    bool &skipped)
+{
+    const fs::path input_path = run_dir / "job_input.json";
+    const fs::path summary_path = run_dir / "job_summary.json";
+    const fs::path stderr_path = run_dir / "driver.stderr.log";
+    write_text(input_path, input.dump(2));
+
+    const std::string command =
+        shell_quote(driver_binary) + " --input " + shell_quote(input_path) + " --result " +
+        shell_quote(run_dir / "job_result.json") + " --summary " + shell_quote(summary_path) + " --vtk " +
+        shell_quote(run_dir / "solution.vtk") + " --mesh-cache " + shell_quote(cache_dir) + extra_flags + " > " +
+        shell_quote(run_dir / "driver.stdout.log") + " 2> " + shell_quote(stderr_path);
+    if (std::system(command.c_str()) != 0)
+    {
+        const std::string stderr_text = read_text(stderr_path);
+        if (is_expected_skip_error(stderr_text))
+        {
+            std::cout << "Operator cache integration test skipped: " << stderr_text << std::endl;
+            skipped = true;
+            return json();
+        }
+        throw std::runtime_error("mfem-driver returned non-zero status:\n" + stderr_text);
+    }
+    return load_json(summary_path);
+}
+
+double counter(const json &summary, const std::string &name, double fallback)
+{
+    return summary["profile"]["counters"].value(name, fallback);
+}
+
+bool same_result(const json &a, const json &b)
+{
+    for (const char *field : {"energy", "error_norm"})
+    {
+        const double x = a.value(field, std::nan(""));
+        const double y = b.value(field, std::nan(""));
+        if (!(std::abs(x - y) <= 1.0e-10 * std::max(std::abs(x), std::abs(y)) + 1.0e-14))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        require(argc >= 2, "Usage: OperatorCacheIntegrationTest <path-to-mfem-driver>");
+
+        const fs::path driver_binary = fs::absolute(argv[1]);
+        require(fs::exists(driver_binary), "mfem-driver binary does not exist: " + driver_binary.string());
+
+        const fs::path run_dir = make_temp_dir();
+        const fs::path cache_dir = run_dir / "cache";
+        const json input_json = {
+            {"solver_class", "HeatTransfer"},
+            {"mesh",
+             {
+                 {"type", "inline_mfem"},
+                 {"data", make_square_mesh()}
+             }},
+            {"config",
+             {
+                 {"conductivity", 1.0},
+                 {"specific_heat", 1.0},
+                 {"initial_temperature", 293.15},
+                 {"source", 1000.0},
+                 {"dt", 0.01},
+                 {"t_final", 0.05},
+                 {"bcs",
+                  json::array({
+                      {
+                          {"attribute", 1},
+                          {"type", "fixed_temp"},
+                          {"value", 293.15}
+                      }
+                  })}
+             }}
+        };
+
+        bool skipped = false;
+        auto cleanup_and_skip = [&]() {
+            std::error_code cleanup_error;
+            fs::remove_all(run_dir, cleanup_error);
+            return kSkipReturnCode;
+        };
+
+        // First job: partitions the mesh and stores it. The operator cache
+        // only opens on a mesh cache hit, so nothing is assembled from it.
+        const json first = run_job(driver_binary, run_dir / "first", cache_dir, input_json, "", skipped);
+        if (skipped)
+        {
+            return cleanup_and_skip();
+        }
+        require(counter(first, "mesh_cache_hit", -1.0) == 0.0, "Expected a mesh cache miss on the first job.");
+
+        // Second job: the mesh hits and the operators are assembled and stored.
+        const json second = run_job(driver_binary, run_dir / "second", cache_dir, input_json, "", skipped);
+        require(counter(second, "mesh_cache_hit", -1.0) == 1.0, "Expected a mesh cache hit on the second job.");
+        require(
+            counter(second, "operator_cache_hits", -1.0) == 0.0 &&
+                counter(second, "operator_cache_misses", 0.0) > 0.0,
+            "Expected the second job to assemble and store its operators."
+        );
+
+        // Third job: every operator comes from the cache.
+        const json third = run_job(driver_binary, run_dir / "third", cache_dir, input_json, "", skipped);
+        require(counter(third, "mesh_cache_hit", -1.0) == 1.0, "Expected a mesh cache hit on the third job.");
+        require(
+            counter(third, "operator_cache_hits", 0.0) == counter(second, "operator_cache_misses", 0.0) &&
+                counter(third, "operator_cache_misses", -1.0) == 0.0,
+            "Expected the third job to load every operator the second one stored."
+        );
+        require(
+            same_result(first, second) && same_result(second, third),
+            "Cached mesh and operators changed the result."
+        );
+
+        // An entry idle past --mesh-cache-max-age-hours is evicted; the entry
+        // in use is kept whatever its age.
+        const fs::path stale_entry = cache_dir / "0000000000000000-np1";
+        write_text(stale_entry / "complete", "ranks 1\n");
+        const auto two_days_ago = fs::file_time_type::clock::now() - std::chrono::hours(48);
+        fs::last_write_time(stale_entry / "complete", two_days_ago);
+        fs::last_write_time(stale_entry, two_days_ago);
+        const json fourth = run_job(
+            driver_binary,
+            run_dir / "fourth",
+            cache_dir,
+            input_json,
+            " --mesh-cache-max-age-hours 24",
+            skipped);
+        require(counter(fourth, "mesh_cache_hit", -1.0) == 1.0, "Expected a mesh cache hit on the fourth job.");
+        require(counter(fourth, "cache_evictions", -1.0) == 1.0, "Expected exactly the stale entry to be evicted.");
+        require(!fs::exists(stale_entry), "Expected the stale cache entry to be removed.");
+        require(same_result(third, fourth), "Eviction changed the result.");
+
+        std::cout << "Operator cache integration test passed. Run dir: " << run_dir << std::endl;
+
+        std::error_code cleanup_error;
+        fs::remove_all(run_dir, cleanup_error);
+        return 0;
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << "Operator cache integration test failed: " << ex.what() << std::endl;
+        return 1;
+    }
+}
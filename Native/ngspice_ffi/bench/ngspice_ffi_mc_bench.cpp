@@ -0,0 +1,214 @@
+// SPDX-License-Identifier: MIT
+
+// Monte-Carlo throughput benchmark for ngspice_ffi.
+//
+// Samples an RC low-pass filter with 5% component tolerances and times three
+// ways of running the sweep:
+//   legacy  - one ngspice_run_netlist call per sample (file + re-init + parse)
+//   session - one parse, then alterparam + rerun per sample
+//   pool    - the same jobs spread across isolated worker processes
+//
+// Usage: ngspice_ffi_mc_bench [samples] [workers]
+
+#include "ngspice_ffi.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr double kNominalResistance = 1.0e3;
+constexpr double kNominalCapacitance = 1.0e-6;
+constexpr double kTolerance = 0.05;
+
+struct Sample {
+    double resistance;
+    double capacitance;
+};
+
+std::string make_netlist(double resistance, double capacitance)
+{
+    char buffer[512];
+    std::snprintf(
+        buffer,
+        sizeof(buffer),
+        "rc low-pass monte-carlo\n"
+        ".param rval=%.17g cval=%.17g\n"
+        "V1 in 0 PULSE(0 1 0 1u 1u 10m 20m)\n"
+        "R1 in out {rval}\n"
+        "C1 out 0 {cval}\n"
+        ".tran 10u 5m\n"
+        ".end\n",
+        resistance,
+        capacitance
+    );
+    return buffer;
+}
+
+std::vector<Sample> draw_samples(int count)
+{
+    std::mt19937_64 generator(20240611u);
+    std::normal_distribution<double> resistance(kNominalResistance, kNominalResistance * kTolerance / 3.0);
+    std::normal_distribution<double> capacitance(kNominalCapacitance, kNominalCapacitance * kTolerance / 3.0);
+
+    std::vector<Sample> samples(static_cast<std::size_t>(count));
+    for (auto &sample : samples) {
+        sample.resistance = resistance(generator);
+        sample.capacitance = capacitance(generator);
+    }
+    return samples;
+}
+
+double final_value(const NgspiceResult *result)
+{
+    if (result == nullptr || result->error_code != NGSPICE_FFI_SUCCESS || result->vector_count < 1
+        || result->vectors[0].length < 1) {
+        return std::nan("");
+    }
+    const auto &vector = result->vectors[0];
+    return vector.data[vector.length - 1];
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void report(const char *label, int samples, double seconds, double baseline_seconds, int failures)
+{
+    std::printf(
+        "%-8s %8d samples %10.3f s %10.1f samples/s %7.2fx  failures=%d\n",
+        label,
+        samples,
+        seconds,
+        samples / seconds,
+        baseline_seconds / seconds,
+        failures
+    );
+}
+
+double run_legacy(const std::vector<Sample> &samples, const char *vector_name, std::vector<double> &finals, int &failures)
+{
+    const std::string path = "ngspice_ffi_mc_bench.cir";
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t index = 0; index < samples.size(); ++index) {
+        std::ofstream(path) << make_netlist(samples[index].resistance, samples[index].capacitance);
+        NgspiceResult *result = ngspice_run_netlist(path.c_str(), &vector_name, 1);
+        finals[index] = final_value(result);
+        failures += std::isnan(finals[index]) ? 1 : 0;
+        ngspice_free_result(result);
+    }
+    const double elapsed = seconds_since(start);
+    std::remove(path.c_str());
+    return elapsed;
+}
+
+double run_session(const std::vector<Sample> &samples, const char *vector_name, std::vector<double> &finals, int &failures)
+{
+    const auto start = std::chrono::steady_clock::now();
+    NgspiceSession *session = ngspice_session_open();
+    NgspiceResult *loaded = ngspice_session_load(session, make_netlist(kNominalResistance, kNominalCapacitance).c_str());
+    const bool ready = loaded->error_code == NGSPICE_FFI_SUCCESS;
+    if (!ready) {
+        std::fprintf(stderr, "session load failed: %s\n", loaded->error_message ? loaded->error_message : "");
+    }
+    ngspice_free_result(loaded);
+
+    for (std::size_t index = 0; index < samples.size(); ++index) {
+        if (!ready) {
+            finals[index] = std::nan("");
+            ++failures;
+            continue;
+        }
+        const NgspiceParameter parameters[] = {
+            {NGSPICE_PARAM_NETLIST, "rval", nullptr, samples[index].resistance},
+            {NGSPICE_PARAM_NETLIST, "cval", nullptr, samples[index].capacitance},
+        };
+        NgspiceResult *result = ngspice_session_run(session, parameters, 2, &vector_name, 1);
+        finals[index] = final_value(result);
+        failures += std::isnan(finals[index]) ? 1 : 0;
+        ngspice_free_result(result);
+    }
+    ngspice_session_close(session);
+    return seconds_since(start);
+}
+
+double run_pool(const std::vector<Sample> &samples,
+                int worker_count,
+                const char *vector_name,
+                std::vector<double> &finals,
+                int &failures)
+{
+    const std::string netlist = make_netlist(kNominalResistance, kNominalCapacitance);
+    std::vector<NgspiceParameter> parameters(samples.size() * 2);
+    std::vector<NgspiceJob> jobs(samples.size());
+    for (std::size_t index = 0; index < samples.size(); ++index) {
+        parameters[2 * index] = {NGSPICE_PARAM_NETLIST, "rval", nullptr, samples[index].resistance};
+        parameters[2 * index + 1] = {NGSPICE_PARAM_NETLIST, "cval", nullptr, samples[index].capacitance};
+        jobs[index] = {netlist.c_str(), &parameters[2 * index], 2, &vector_name, 1};
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    NgspicePool *pool = ngspice_pool_open(worker_count, nullptr);
+    if (ngspice_pool_error_code(pool) != NGSPICE_FFI_SUCCESS) {
+        std::fprintf(stderr, "pool open failed: %s\n", ngspice_pool_error_message(pool));
+    }
+    NgspiceBatchResult *batch = ngspice_pool_run(pool, jobs.data(), static_cast<int>(jobs.size()));
+    for (std::size_t index = 0; index < samples.size(); ++index) {
+        finals[index] = batch->error_code == NGSPICE_FFI_SUCCESS ? final_value(batch->results[index]) : std::nan("");
+        failures += std::isnan(finals[index]) ? 1 : 0;
+    }
+    ngspice_free_batch_result(batch);
+    ngspice_pool_close(pool);
+    return seconds_since(start);
+}
+
+double max_difference(const std::vector<double> &a, const std::vector<double> &b)
+{
+    double worst = 0.0;
+    for (std::size_t index = 0; index < a.size(); ++index) {
+        if (!std::isnan(a[index]) && !std::isnan(b[index])) {
+            worst = std::max(worst, std::abs(a[index] - b[index]));
+        }
+    }
+    return worst;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const int sample_count = argc > 1 ? std::max(1, std::atoi(argv[1])) : 200;
+    const int worker_count = argc > 2 ? std::atoi(argv[2]) : 0;
+    const char *vector_name = "v(out)";
+
+    const auto samples = draw_samples(sample_count);
+    std::vector<double> legacy_finals(samples.size());
+    std::vector<double> session_finals(samples.size());
+    std::vector<double> pool_finals(samples.size());
+    int legacy_failures = 0;
+    int session_failures = 0;
+    int pool_failures = 0;
+
+    const double legacy_seconds = run_legacy(samples, vector_name, legacy_finals, legacy_failures);
+    const double session_seconds = run_session(samples, vector_name, session_finals, session_failures);
+    const double pool_seconds = run_pool(samples, worker_count, vector_name, pool_finals, pool_failures);
+
+    report("legacy", sample_count, legacy_seconds, legacy_seconds, legacy_failures);
+    report("session", sample_count, session_seconds, legacy_seconds, session_failures);
+    report("pool", sample_count, pool_seconds, legacy_seconds, pool_failures);
+    std::printf(
+        "max |v(out)| difference vs legacy: session=%.3g pool=%.3g\n",
+        max_difference(legacy_finals, session_finals),
+        max_difference(legacy_finals, pool_finals)
+    );
+
+    return legacy_failures + session_failures + pool_failures == 0 ? 0 : 1;
+}
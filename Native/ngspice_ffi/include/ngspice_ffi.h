@@ -3,6 +3,7 @@
 #ifndef NGSPICE_FFI_H
 #define NGSPICE_FFI_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -15,15 +16,43 @@ enum NgspiceErrorCode {
     NGSPICE_FFI_ERR_INIT_FAILED = 2,
     NGSPICE_FFI_ERR_COMMAND_FAILED = 3,
     NGSPICE_FFI_ERR_VECTOR_NOT_FOUND = 4,
-    NGSPICE_FFI_ERR_RUNTIME = 5
+    NGSPICE_FFI_ERR_RUNTIME = 5,
+    NGSPICE_FFI_ERR_CANCELLED = 6
 };
 
+/*
+ * data always holds `length` real values; for complex vectors (AC, noise and
+ * S-parameter plots) it is the real part, and complex_data holds 2 * length
+ * interleaved (real, imaginary) pairs. complex_data is NULL for real vectors.
+ */
 typedef struct NgspiceVector {
     const char *name;
     double *data;
     int length;
+    double *complex_data;
+    int is_complex;
 } NgspiceVector;
 
+/*
+ * Zero-copy view of one captured log stream. text is the same buffer as the
+ * matching NgspiceResult *_log field (NULL when empty) and length excludes the
+ * terminator. Logs are bounded ring buffers, so the oldest output may have been
+ * discarded; dropped_bytes counts it. error_lines and warning_lines count the
+ * lines classified into stderr, including dropped ones.
+ */
+typedef struct NgspiceLogView {
+    const char *text;
+    size_t length;
+    uint64_t dropped_bytes;
+    int error_lines;
+    int warning_lines;
+} NgspiceLogView;
+
+/*
+ * scale is the plot's independent variable (time, frequency or DC sweep
+ * value), returned once instead of as one of the requested vectors; it is
+ * NULL when the analysis has none, such as an operating point.
+ */
 typedef struct NgspiceResult {
     NgspiceVector *vectors;
     int vector_count;
@@ -31,6 +60,9 @@ typedef struct NgspiceResult {
     const char *error_message;
     const char *stdout_log;
     const char *stderr_log;
+    NgspiceVector *scale;
+    NgspiceLogView stdout_view;
+    NgspiceLogView stderr_view;
 } NgspiceResult;
 
 NgspiceResult *ngspice_run_netlist(const char *netlist_path,
@@ -39,6 +71,274 @@ NgspiceResult *ngspice_run_netlist(const char *netlist_path,
 
 void ngspice_free_result(NgspiceResult *result);
 
+enum NgspiceParameterKind {
+    NGSPICE_PARAM_NETLIST = 0,
+    NGSPICE_PARAM_DEVICE = 1
+};
+
+/*
+ * One parameter change applied before a rerun.
+ *
+ * NGSPICE_PARAM_NETLIST issues `alterparam <target> = <value>` for a `.param`
+ * entry; `parameter` must be NULL. Netlist parameters take effect through a
+ * `reset`, which also discards earlier device changes.
+ * NGSPICE_PARAM_DEVICE issues `alter <target> [<parameter>] = <value>` for a
+ * device instance such as "R1" or "m1" with parameter "w"; a NULL parameter
+ * alters the primary value.
+ */
+typedef struct NgspiceParameter {
+    int kind;
+    const char *target;
+    const char *parameter;
+    double value;
+} NgspiceParameter;
+
+/*
+ * ngspice's shared library keeps one simulator per process, so at most one
+ * session can be open at a time. ngspice_session_open always returns a handle
+ * (NULL only on allocation failure); check ngspice_session_error_code before
+ * submitting, and release the handle with ngspice_session_close in every case.
+ * Calling ngspice_run_netlist while a session is open replaces the session's
+ * circuit; the session must then be reloaded.
+ */
+typedef struct NgspiceSession NgspiceSession;
+
+NgspiceSession *ngspice_session_open(void);
+
+int ngspice_session_error_code(const NgspiceSession *session);
+
+const char *ngspice_session_error_message(const NgspiceSession *session);
+
+/*
+ * capacity_bytes bounds each captured stream (stdout and stderr); <= 0 uses
+ * the 64 KiB default, keeping the most recent output. suppress_status drops
+ * ngspice's progress/status lines from stdout_log.
+ */
+typedef struct NgspiceLogOptions {
+    int capacity_bytes;
+    int suppress_status;
+} NgspiceLogOptions;
+
+NgspiceLogOptions ngspice_default_log_options(void);
+
+/* Applies to later calls on this session; NULL restores the defaults. */
+int ngspice_session_set_log_options(NgspiceSession *session, const NgspiceLogOptions *options);
+
+/* Parses an in-memory netlist (newline separated) and makes it the session circuit. */
+NgspiceResult *ngspice_session_load(NgspiceSession *session, const char *netlist_text);
+
+/* Applies parameter changes to the loaded circuit and reruns it without re-parsing. */
+NgspiceResult *ngspice_session_run(NgspiceSession *session,
+                                   const NgspiceParameter *parameters,
+                                   int parameter_count,
+                                   const char *const *requested_vectors,
+                                   int requested_vector_count);
+
+/*
+ * Progress callback for streaming runs. It is invoked on the calling thread,
+ * never on ngspice's simulation thread. percent is ngspice's reported
+ * completion (negative when unknown) and stored_samples the number of rows
+ * captured so far. Return nonzero to halt the simulation.
+ */
+typedef int (*NgspiceProgressCallback)(double percent, int stored_samples, void *user_data);
+
+typedef struct NgspiceStreamOptions {
+    int decimation;
+    int initial_capacity;
+    int progress_interval_ms;
+    NgspiceProgressCallback progress;
+    void *user_data;
+} NgspiceStreamOptions;
+
+/* decimation=1 (keep every sample), initial_capacity=4096, progress_interval_ms=100, no callback. */
+NgspiceStreamOptions ngspice_default_stream_options(void);
+
+/*
+ * Like ngspice_session_run, but runs the simulation with `bg_run` and captures
+ * the requested vectors from ngspice's SendData callback as samples arrive,
+ * keeping every `decimation`-th sample plus the final one. When the analysis
+ * produces several plots, the last one is returned. A run halted through the
+ * progress callback returns the samples captured so far with
+ * NGSPICE_FFI_ERR_CANCELLED. options may be NULL for the defaults.
+ */
+NgspiceResult *ngspice_session_run_streaming(NgspiceSession *session,
+                                             const NgspiceParameter *parameters,
+                                             int parameter_count,
+                                             const char *const *requested_vectors,
+                                             int requested_vector_count,
+                                             const NgspiceStreamOptions *options);
+
+void ngspice_session_close(NgspiceSession *session);
+
+/*
+ * One simulation for a worker pool. Workers keep the last netlist they parsed,
+ * so jobs sharing the same netlist text only pay for the parameter changes.
+ */
+typedef struct NgspiceJob {
+    const char *netlist;
+    const NgspiceParameter *parameters;
+    int parameter_count;
+    const char *const *requested_vectors;
+    int requested_vector_count;
+} NgspiceJob;
+
+typedef struct NgspiceBatchResult {
+    NgspiceResult **results;
+    int result_count;
+    int error_code;
+    const char *error_message;
+} NgspiceBatchResult;
+
+/*
+ * A pool of isolated ngspice worker processes. worker_count <= 0 uses the
+ * hardware concurrency. worker_executable may be NULL, in which case
+ * $NGSPICE_FFI_WORKER or the ngspice_ffi_worker binary installed next to this
+ * library is used. Like sessions, ngspice_pool_open always returns a handle;
+ * check ngspice_pool_error_code and release it with ngspice_pool_close.
+ */
+typedef struct NgspicePool NgspicePool;
+
+NgspicePool *ngspice_pool_open(int worker_count, const char *worker_executable);
+
+int ngspice_pool_error_code(const NgspicePool *pool);
+
+const char *ngspice_pool_error_message(const NgspicePool *pool);
+
+int ngspice_pool_worker_count(const NgspicePool *pool);
+
+/* Runs every job and returns results in job order; a crashed worker fails only its job. */
+NgspiceBatchResult *ngspice_pool_run(NgspicePool *pool, const NgspiceJob *jobs, int job_count);
+
+void ngspice_free_batch_result(NgspiceBatchResult *result);
+
+/*
+ * Monte-Carlo and parameter sweeps over a worker pool.
+ *
+ * The netlist is parsed once per worker; every variant applies its parameter
+ * values with the same alterparam/alter mechanism as NgspiceParameter. GRID
+ * parameters span a Cartesian product (the last GRID parameter varies
+ * fastest), and samples_per_point variants are drawn at each grid point from
+ * the FIXED/UNIFORM/GAUSSIAN parameters. Draws depend only on seed and the
+ * variant index, so results are reproducible regardless of scheduling.
+ */
+enum NgspiceDistribution {
+    NGSPICE_DIST_FIXED = 0,
+    NGSPICE_DIST_UNIFORM = 1,
+    NGSPICE_DIST_GAUSSIAN = 2,
+    NGSPICE_DIST_GRID = 3
+};
+
+/*
+ * FIXED uses nominal. UNIFORM draws from [low, high]. GAUSSIAN draws from
+ * N(nominal, sigma^2), clamped to [low, high] when low < high. GRID takes
+ * grid_count values from grid_values.
+ */
+typedef struct NgspiceVariedParameter {
+    int kind;
+    const char *target;
+    const char *parameter;
+    int distribution;
+    double nominal;
+    double sigma;
+    double low;
+    double high;
+    const double *grid_values;
+    int grid_count;
+} NgspiceVariedParameter;
+
+enum NgspiceMeasureKind {
+    NGSPICE_MEASURE_FINAL = 0,
+    NGSPICE_MEASURE_MIN = 1,
+    NGSPICE_MEASURE_MAX = 2,
+    NGSPICE_MEASURE_AVERAGE = 3,
+    NGSPICE_MEASURE_RMS = 4,
+    NGSPICE_MEASURE_AT = 5
+};
+
+/*
+ * A scalar reduced from one vector of every variant, computed inside the
+ * worker so only scalars cross the process boundary. Complex vectors are
+ * measured by magnitude. AVERAGE and RMS are integrated over the plot scale
+ * (time-weighted for transients); AT interpolates linearly at scale value
+ * `at`. Optional spec limits define yield.
+ */
+typedef struct NgspiceMeasure {
+    const char *vector;
+    int kind;
+    double at;
+    int has_lower_limit;
+    double lower_limit;
+    int has_upper_limit;
+    double upper_limit;
+} NgspiceMeasure;
+
+typedef struct NgspiceSweepSpec {
+    const char *netlist;
+    const NgspiceVariedParameter *parameters;
+    int parameter_count;
+    const NgspiceMeasure *measures;
+    int measure_count;
+    int samples_per_point;
+    uint64_t seed;
+    const double *percentiles;
+    int percentile_count;
+} NgspiceSweepSpec;
+
+/*
+ * Statistics of one measure over the variants that simulated successfully.
+ * percentiles holds one value per requested percentile (linear interpolation
+ * between order statistics). yield is pass_count / variant_count, so failed
+ * variants count against it.
+ */
+typedef struct NgspiceMeasureStats {
+    int count;
+    double mean;
+    double stddev;
+    double min;
+    double max;
+    double *percentiles;
+    int pass_count;
+    double yield;
+} NgspiceMeasureStats;
+
+/*
+ * parameter_values is variant_count x parameter_count and measurements is
+ * variant_count x measure_count, both row-major; failed variants hold NaN
+ * measurements and their code in variant_error_codes. pass_count/yield count
+ * variants that meet every measure's limits.
+ */
+typedef struct NgspiceSweepResult {
+    int error_code;
+    const char *error_message;
+    int variant_count;
+    int parameter_count;
+    int measure_count;
+    double *parameter_values;
+    double *measurements;
+    int *variant_error_codes;
+    int failed_count;
+    const char *first_failure_message;
+    NgspiceMeasureStats *stats;
+    int pass_count;
+    double yield;
+} NgspiceSweepResult;
+
+/*
+ * Runs the cartesian product of all GRID parameters with samples_per_point
+ * random draws per grid point, spread across the pool. Variant v belongs to
+ * grid point v / samples_per_point (last GRID parameter varies fastest) and
+ * its draws depend only on (seed, v), so a sweep is reproducible regardless of
+ * worker count.
+ */
+NgspiceSweepResult *ngspice_pool_sweep(NgspicePool *pool, const NgspiceSweepSpec *spec);
+
+void ngspice_free_sweep_result(NgspiceSweepResult *result);
+
+void ngspice_pool_close(NgspicePool *pool);
+
+/* Request loop of the ngspice_ffi_worker executable; serves one pool connection. */
+int ngspice_worker_main(int socket_fd);
+
 #ifdef __cplusplus
 }
 #endif
@@ -4,23 +4,330 @@
 
 #include <sharedspice.h>
 
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <exception>
 #include <memory>
+#include <mutex>
+#include <limits>
+#include <new>
+#include <random>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
+extern char **environ;
+
+struct NgspiceSession {
+    int error_code = NGSPICE_FFI_SUCCESS;
+    std::string error_message;
+    NgspiceLogOptions log_options{0, 0};
+    bool owns_engine = false;
+    bool loaded = false;
+    std::uint64_t circuit_generation = 0;
+};
+
+namespace {
+
+struct PoolWorker {
+    pid_t pid = -1;
+    int socket_fd = -1;
+    bool has_netlist = false;
+    std::string loaded_netlist;
+};
+
+} // namespace
+
+struct NgspicePool {
+    int error_code = NGSPICE_FFI_SUCCESS;
+    std::string error_message;
+    std::string worker_executable;
+    std::vector<PoolWorker> workers;
+    std::mutex mutex;
+};
+
 namespace {
 
+constexpr const char *kWorkerExecutableName = "ngspice_ffi_worker";
+constexpr int kWorkerSocketFd = 3;
+constexpr int kMaxPoolWorkers = 256;
+constexpr std::uint32_t kMaxFrameBytes = 1u << 30;
+constexpr int kDefaultWorkerTimeoutSeconds = 3600;
+constexpr int kWorkerQuitTimeoutSeconds = 2;
+
+constexpr int kDefaultStreamCapacity = 4096;
+constexpr int kDefaultLogCapacityBytes = 64 * 1024;
+constexpr std::size_t kInitialLogBytes = 1024;
+constexpr int kDefaultProgressIntervalMs = 100;
+constexpr auto kBackgroundStartTimeout = std::chrono::seconds(10);
+
+constexpr std::uint8_t kWorkerLoad = 1;
+constexpr std::uint8_t kWorkerRun = 2;
+constexpr std::uint8_t kWorkerQuit = 3;
+constexpr std::uint8_t kWorkerRunMeasured = 4;
+
+constexpr long long kMaxSweepVariants = 10000000;
+
+// Growable column whose storage is handed to NgspiceVector::data without a
+// final copy.
+class ColumnBuffer {
+public:
+    void reserve(std::size_t capacity)
+    {
+        if (capacity <= capacity_) {
+            return;
+        }
+        std::unique_ptr<double[]> grown(new double[capacity]);
+        if (size_ > 0) {
+            std::memcpy(grown.get(), data_.get(), size_ * sizeof(double));
+        }
+        data_ = std::move(grown);
+        capacity_ = capacity;
+    }
+
+    void push_back(double value)
+    {
+        if (size_ == capacity_) {
+            reserve(std::max<std::size_t>(capacity_ * 2, 64));
+        }
+        data_[size_++] = value;
+    }
+
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+    double *release()
+    {
+        size_ = 0;
+        capacity_ = 0;
+        return data_.release();
+    }
+
+private:
+    std::unique_ptr<double[]> data_;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = 0;
+};
+
+// Samples captured from SendInitData/SendData. Everything except the atomics
+// is written only by ngspice's background thread while the run is in flight
+// and read by the caller once ngspice reports the thread has stopped.
+struct StreamColumn {
+    std::string name;
+    int source = -1;
+    bool is_complex = false;
+    ColumnBuffer real;
+    ColumnBuffer interleaved;
+    double last_real = 0.0;
+    double last_imag = 0.0;
+};
+
+struct StreamCapture {
+    std::vector<std::string> requested;
+    std::size_t initial_capacity = kDefaultStreamCapacity;
+    long long decimation = 1;
+
+    bool initialized = false;
+    std::vector<StreamColumn> columns;
+    bool has_scale = false;
+    StreamColumn scale;
+    std::vector<std::string> missing;
+    bool last_row_kept = true;
+    bool out_of_memory = false;
+    long long received = 0;
+
+    std::atomic<int> stored{0};
+    std::atomic<double> percent{-1.0};
+};
+
+// Keeps the most recent `capacity` bytes of one output stream. Not
+// thread-safe: the ngspice callbacks append under RunContext::log_mutex, and
+// the caller only reads once no background thread can write. The buffer grows
+// on demand up to
+// the capacity, then wraps; release() rotates it in place and hands the same
+// allocation to NgspiceResult.
+class LogRing {
+public:
+    void set_capacity(std::size_t capacity)
+    {
+        capacity_ = std::max<std::size_t>(capacity, 1);
+    }
+
+    void append_line(const char *text, std::size_t length)
+    {
+        if (size_ > 0 || dropped_bytes_ > 0) {
+            push("\n", 1);
+        }
+        push(text, length);
+    }
+
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    std::uint64_t dropped_bytes() const
+    {
+        return dropped_bytes_;
+    }
+
+    std::string str() const
+    {
+        std::string text;
+        text.reserve(size_);
+        for (std::size_t offset = 0; offset < size_; ++offset) {
+            text.push_back(buffer_[(start_ + offset) % allocated_]);
+        }
+        return text;
+    }
+
+    // Returns the text oldest-first and NUL-terminated (nullptr when empty);
+    // the caller owns it and frees it with delete[].
+    char *release(std::size_t &length)
+    {
+        length = size_;
+        if (size_ == 0) {
+            return nullptr;
+        }
+        if (start_ != 0) {
+            std::rotate(buffer_.get(), buffer_.get() + start_, buffer_.get() + allocated_);
+            start_ = 0;
+        }
+        buffer_[size_] = '\0';
+        allocated_ = 0;
+        size_ = 0;
+        return buffer_.release();
+    }
+
+private:
+    void grow(std::size_t needed)
+    {
+        const std::size_t target = std::min(capacity_, std::max({needed, allocated_ * 2, kInitialLogBytes}));
+        std::unique_ptr<char[]> grown(new char[target + 1]);
+        if (size_ > 0) {
+            std::memcpy(grown.get(), buffer_.get(), size_);
+        }
+        buffer_ = std::move(grown);
+        allocated_ = target;
+    }
+
+    void push(const char *data, std::size_t length)
+    {
+        if (length >= capacity_) {
+            dropped_bytes_ += size_ + length - capacity_;
+            data += length - capacity_;
+            length = capacity_;
+            size_ = 0;
+            start_ = 0;
+        }
+        if (size_ + length > allocated_ && allocated_ < capacity_) {
+            grow(size_ + length);
+        }
+        if (size_ + length > allocated_) {
+            const std::size_t overflow = size_ + length - allocated_;
+            start_ = (start_ + overflow) % allocated_;
+            size_ -= overflow;
+            dropped_bytes_ += overflow;
+        }
+
+        const std::size_t write = (start_ + size_) % allocated_;
+        const std::size_t first = std::min(length, allocated_ - write);
+        std::memcpy(buffer_.get() + write, data, first);
+        std::memcpy(buffer_.get(), data + first, length - first);
+        size_ += length;
+    }
+
+    std::unique_ptr<char[]> buffer_;
+    std::size_t capacity_ = kDefaultLogCapacityBytes;
+    std::size_t allocated_ = 0;
+    std::size_t start_ = 0;
+    std::size_t size_ = 0;
+    std::uint64_t dropped_bytes_ = 0;
+};
+
 struct RunContext {
-    std::string stdout_log;
-    std::string stderr_log;
+    LogRing stdout_log;
+    LogRing stderr_log;
+    int error_lines = 0;
+    int warning_lines = 0;
+    bool suppress_status = false;
     bool controlled_exit = false;
     int exit_code = 0;
     bool quit_exit = false;
+    std::atomic<StreamCapture *> stream{nullptr};
+
+    // Output can arrive from the caller and from ngspice's background thread
+    // at once (e.g. while cancelling a bg_run); the callbacks append under
+    // this mutex and drop everything once `logs_closed` is set.
+    std::mutex log_mutex;
+    bool logs_closed = false;
+};
+
+// ngspice is a process-wide singleton: its callbacks receive this state and
+// forward output to whichever call currently holds the engine lock. The
+// background-thread signal lives here rather than in RunContext because
+// ngspice's final BGThreadRunning callback can arrive after the run that
+// started it has returned.
+struct EngineState {
+    std::mutex mutex;
+    std::atomic<RunContext *> active{nullptr};
+    bool initialized = false;
+    bool session_open = false;
+    int loaded_circuits = 0;
+    std::uint64_t circuit_generation = 0;
+
+    std::mutex background_mutex;
+    std::condition_variable background_wake;
+    std::atomic<unsigned long> background_events{0};
+};
+
+EngineState &engine_state()
+{
+    static EngineState state;
+    return state;
+}
+
+class EngineLock {
+public:
+    explicit EngineLock(RunContext &ctx)
+        : lock_(engine_state().mutex)
+    {
+        engine_state().active = &ctx;
+    }
+
+    ~EngineLock()
+    {
+        engine_state().active = nullptr;
+    }
+
+    EngineLock(const EngineLock &) = delete;
+    EngineLock &operator=(const EngineLock &) = delete;
+
+private:
+    std::lock_guard<std::mutex> lock_;
 };
 
 char *dup_c_string(const std::string &value)
@@ -31,6 +338,15 @@ char *dup_c_string(const std::string &value)
     return out;
 }
 
+void fill_log_view(NgspiceLogView &view, const char *text, std::size_t length)
+{
+    view.text = text;
+    view.length = length;
+    view.dropped_bytes = 0;
+    view.error_lines = 0;
+    view.warning_lines = 0;
+}
+
 NgspiceResult *make_result(int code,
                            const std::string &message,
                            const std::string &stdout_log,
@@ -43,6 +359,50 @@ NgspiceResult *make_result(int code,
     result->error_message = message.empty() ? nullptr : dup_c_string(message);
     result->stdout_log = stdout_log.empty() ? nullptr : dup_c_string(stdout_log);
     result->stderr_log = stderr_log.empty() ? nullptr : dup_c_string(stderr_log);
+    result->scale = nullptr;
+    fill_log_view(result->stdout_view, result->stdout_log, stdout_log.size());
+    fill_log_view(result->stderr_view, result->stderr_log, stderr_log.size());
+    return result;
+}
+
+void release_vector_buffers(NgspiceVector &vector)
+{
+    delete[] vector.name;
+    vector.name = nullptr;
+    delete[] vector.data;
+    vector.data = nullptr;
+    delete[] vector.complex_data;
+    vector.complex_data = nullptr;
+    vector.length = 0;
+    vector.is_complex = 0;
+}
+
+void free_vector(NgspiceVector *vector)
+{
+    if (vector != nullptr) {
+        release_vector_buffers(*vector);
+        delete vector;
+    }
+}
+
+// Moves the run's logs into the result without copying them.
+NgspiceResult *make_result(int code, const std::string &message, RunContext &ctx)
+{
+    auto *result = make_result(code, message, "", "");
+    std::size_t length = 0;
+
+    result->stdout_view.dropped_bytes = ctx.stdout_log.dropped_bytes();
+    result->stderr_view.dropped_bytes = ctx.stderr_log.dropped_bytes();
+    char *stdout_text = ctx.stdout_log.release(length);
+    result->stdout_log = stdout_text;
+    result->stdout_view.text = stdout_text;
+    result->stdout_view.length = length;
+    char *stderr_text = ctx.stderr_log.release(length);
+    result->stderr_log = stderr_text;
+    result->stderr_view.text = stderr_text;
+    result->stderr_view.length = length;
+    result->stderr_view.error_lines = ctx.error_lines;
+    result->stderr_view.warning_lines = ctx.warning_lines;
     return result;
 }
 
@@ -95,35 +455,242 @@ std::string quote_path_for_command(const std::string &path)
     return escaped;
 }
 
-void append_log_line(std::string &target, const char *line)
+RunContext *active_context(void *user_data)
+{
+    if (user_data == nullptr) {
+        return nullptr;
+    }
+    return static_cast<EngineState *>(user_data)->active.load();
+}
+
+// Maps "V(out)", "<plot>.out" and "out" to one key, and "i(v1)" to
+// "v1#branch", matching how ngspice names plot vectors. Only the current plot's
+// prefix is stripped so subcircuit nodes such as "x1.n2" keep their path.
+std::string normalize_vector_name(const std::string &name, const std::string &plot)
+{
+    std::string key = to_lower_copy(trim_copy(name));
+    if (!plot.empty() && key.size() > plot.size() + 1 && key[plot.size()] == '.'
+        && key.compare(0, plot.size(), to_lower_copy(plot)) == 0) {
+        key.erase(0, plot.size() + 1);
+    }
+    if (key.size() > 3 && key[1] == '(' && key.back() == ')' && key.find(',') == std::string::npos) {
+        const std::string inner = key.substr(2, key.size() - 3);
+        if (key[0] == 'v') {
+            return inner;
+        }
+        if (key[0] == 'i') {
+            return inner + "#branch";
+        }
+    }
+    return key;
+}
+
+double parse_status_percent(const char *begin, const char *end)
+{
+    const char *percent_sign = end;
+    while (percent_sign > begin && percent_sign[-1] != '%') {
+        --percent_sign;
+    }
+    if (percent_sign == begin) {
+        return -1.0;
+    }
+    --percent_sign;
+    const char *start = percent_sign;
+    while (start > begin && (std::isdigit(static_cast<unsigned char>(start[-1])) != 0 || start[-1] == '.')) {
+        --start;
+    }
+    if (start == percent_sign) {
+        return -1.0;
+    }
+    return std::strtod(start, nullptr);
+}
+
+void reset_stream_column(StreamColumn &column, const pvecinfo vector, int source, std::size_t capacity)
+{
+    column.name = vector->vecname;
+    column.source = source;
+    column.is_complex = !static_cast<bool>(vector->is_real);
+    column.real.reserve(capacity);
+    if (column.is_complex) {
+        column.interleaved.reserve(capacity * 2);
+    }
+}
+
+void begin_stream(StreamCapture &stream, pvecinfoall info)
+{
+    stream.initialized = true;
+    stream.columns.clear();
+    stream.has_scale = false;
+    stream.scale = StreamColumn{};
+    stream.missing.clear();
+    stream.last_row_kept = true;
+    stream.received = 0;
+    stream.stored.store(0);
+
+    const int vector_count = info == nullptr ? 0 : info->veccount;
+    const std::string plot = info != nullptr && info->name != nullptr ? info->name : "";
+    std::unordered_map<std::string, int> index;
+    index.reserve(static_cast<std::size_t>(std::max(vector_count, 0)) * 2);
+    void *scale_vector = nullptr;
+    for (int vector_index = 0; vector_index < vector_count; ++vector_index) {
+        const pvecinfo vector = info->vecs[vector_index];
+        if (vector != nullptr && vector->vecname != nullptr) {
+            index.emplace(normalize_vector_name(vector->vecname, plot), vector_index);
+            if (scale_vector == nullptr) {
+                scale_vector = vector->pdvecscale;
+            }
+        }
+    }
+
+    // vecinfo carries no scale flag, but every vector points at its scale's
+    // dvec, so the scale is the entry whose own dvec matches that pointer.
+    for (int vector_index = 0; scale_vector != nullptr && vector_index < vector_count; ++vector_index) {
+        const pvecinfo vector = info->vecs[vector_index];
+        if (vector != nullptr && vector->vecname != nullptr && vector->pdvec == scale_vector) {
+            reset_stream_column(stream.scale, vector, vector_index, stream.initial_capacity);
+            stream.has_scale = true;
+            break;
+        }
+    }
+
+    auto add_column = [&stream, info](int vector_index) {
+        stream.columns.emplace_back();
+        reset_stream_column(stream.columns.back(), info->vecs[vector_index], vector_index, stream.initial_capacity);
+    };
+
+    if (stream.requested.empty()) {
+        for (int vector_index = 0; vector_index < vector_count; ++vector_index) {
+            if (info->vecs[vector_index] != nullptr && info->vecs[vector_index]->vecname != nullptr) {
+                add_column(vector_index);
+            }
+        }
+    } else {
+        for (const auto &requested : stream.requested) {
+            const auto found = index.find(normalize_vector_name(requested, plot));
+            if (found == index.end()) {
+                stream.missing.push_back(requested);
+            } else {
+                add_column(found->second);
+            }
+        }
+    }
+}
+
+void store_stream_value(StreamColumn &column, pvecvaluesall values, bool keep)
 {
-    if (line == nullptr) {
+    const pvecvalues value = column.source < values->veccount ? values->vecsa[column.source] : nullptr;
+    const double real = value != nullptr ? value->creal : 0.0;
+    const double imag = value != nullptr ? value->cimag : 0.0;
+    if (!keep) {
+        column.last_real = real;
+        column.last_imag = imag;
         return;
     }
+    column.real.push_back(real);
+    if (column.is_complex) {
+        column.interleaved.push_back(real);
+        column.interleaved.push_back(imag);
+    }
+}
+
+void append_stream_sample(StreamCapture &stream, pvecvaluesall values)
+{
+    if (!stream.initialized || values == nullptr) {
+        return;
+    }
+
+    const bool keep = stream.received % stream.decimation == 0;
+    ++stream.received;
+    for (auto &column : stream.columns) {
+        store_stream_value(column, values, keep);
+    }
+    if (stream.has_scale) {
+        store_stream_value(stream.scale, values, keep);
+    }
+    stream.last_row_kept = keep;
+    if (keep && !stream.columns.empty()) {
+        stream.stored.store(static_cast<int>(stream.columns.front().real.size()), std::memory_order_relaxed);
+    }
+}
+
+void flush_stream_column(StreamColumn &column)
+{
+    column.real.push_back(column.last_real);
+    if (column.is_complex) {
+        column.interleaved.push_back(column.last_real);
+        column.interleaved.push_back(column.last_imag);
+    }
+}
+
+// A decimated stream always ends on the simulation's final sample.
+void finish_stream(StreamCapture &stream)
+{
+    if (stream.last_row_kept) {
+        return;
+    }
+    for (auto &column : stream.columns) {
+        flush_stream_column(column);
+    }
+    if (stream.has_scale) {
+        flush_stream_column(stream.scale);
+    }
+    stream.last_row_kept = true;
+}
+
+// Allocation-free helpers for classifying ngspice output in place.
+void trim_range(const char *&begin, const char *&end)
+{
+    while (begin < end && std::isspace(static_cast<unsigned char>(*begin)) != 0) {
+        ++begin;
+    }
+    while (end > begin && std::isspace(static_cast<unsigned char>(end[-1])) != 0) {
+        --end;
+    }
+}
 
-    if (!target.empty() && target.back() != '\n') {
-        target.push_back('\n');
+bool contains_case_insensitive(const char *begin, const char *end, const char *needle)
+{
+    const std::size_t needle_length = std::strlen(needle);
+    for (const char *cursor = begin; cursor + needle_length <= end; ++cursor) {
+        std::size_t matched = 0;
+        while (matched < needle_length
+               && std::tolower(static_cast<unsigned char>(cursor[matched])) == needle[matched]) {
+            ++matched;
+        }
+        if (matched == needle_length) {
+            return true;
+        }
     }
-    target.append(line);
+    return false;
 }
 
 int callback_send_char(char *output, int, void *user_data)
 {
-    if (user_data == nullptr) {
+    auto *ctx = active_context(user_data);
+    if (ctx == nullptr || output == nullptr) {
         return 0;
     }
 
-    auto *ctx = static_cast<RunContext *>(user_data);
-    const std::string line = output == nullptr ? std::string() : trim_copy(output);
-    if (line.empty()) {
+    const char *begin = output;
+    const char *end = output + std::strlen(output);
+    trim_range(begin, end);
+    if (begin == end) {
         return 0;
     }
 
-    const auto lower = to_lower_copy(line);
-    if (lower.find("error") != std::string::npos || lower.find("warning") != std::string::npos) {
-        append_log_line(ctx->stderr_log, line.c_str());
+    const auto length = static_cast<std::size_t>(end - begin);
+    std::lock_guard<std::mutex> lock(ctx->log_mutex);
+    if (ctx->logs_closed) {
+        return 0;
+    }
+    if (contains_case_insensitive(begin, end, "error")) {
+        ++ctx->error_lines;
+        ctx->stderr_log.append_line(begin, length);
+    } else if (contains_case_insensitive(begin, end, "warning")) {
+        ++ctx->warning_lines;
+        ctx->stderr_log.append_line(begin, length);
     } else {
-        append_log_line(ctx->stdout_log, line.c_str());
+        ctx->stdout_log.append_line(begin, length);
     }
 
     return 0;
@@ -131,46 +698,101 @@ int callback_send_char(char *output, int, void *user_data)
 
 int callback_send_stat(char *status, int, void *user_data)
 {
-    if (user_data == nullptr) {
+    auto *ctx = active_context(user_data);
+    if (ctx == nullptr || status == nullptr) {
+        return 0;
+    }
+
+    const char *begin = status;
+    const char *end = status + std::strlen(status);
+    trim_range(begin, end);
+    if (begin == end) {
         return 0;
     }
 
-    auto *ctx = static_cast<RunContext *>(user_data);
-    const std::string line = status == nullptr ? std::string() : trim_copy(status);
-    if (!line.empty()) {
-        append_log_line(ctx->stdout_log, line.c_str());
+    if (auto *stream = ctx->stream.load(); stream != nullptr) {
+        if (const double percent = parse_status_percent(begin, end); percent >= 0.0) {
+            stream->percent.store(percent, std::memory_order_relaxed);
+        }
+    }
+    if (!ctx->suppress_status) {
+        std::lock_guard<std::mutex> lock(ctx->log_mutex);
+        if (!ctx->logs_closed) {
+            ctx->stdout_log.append_line(begin, static_cast<std::size_t>(end - begin));
+        }
     }
     return 0;
 }
 
 int callback_controlled_exit(int status, NG_BOOL, NG_BOOL quit_exit, int, void *user_data)
 {
-    if (user_data == nullptr) {
+    auto *ctx = active_context(user_data);
+    if (ctx == nullptr) {
         return 0;
     }
 
-    auto *ctx = static_cast<RunContext *>(user_data);
     ctx->controlled_exit = true;
     ctx->exit_code = status;
     ctx->quit_exit = static_cast<bool>(quit_exit);
     return 0;
 }
 
-int callback_send_data(pvecvaluesall, int, int, void *)
+int callback_send_data(pvecvaluesall values, int, int, void *user_data)
 {
+    auto *ctx = active_context(user_data);
+    auto *stream = ctx != nullptr ? ctx->stream.load() : nullptr;
+    if (stream == nullptr || stream->out_of_memory) {
+        return 0;
+    }
+    // Exceptions must not unwind into ngspice's simulation thread.
+    try {
+        append_stream_sample(*stream, values);
+    } catch (...) {
+        stream->out_of_memory = true;
+    }
     return 0;
 }
 
-int callback_send_init_data(pvecinfoall, int, void *)
+int callback_send_init_data(pvecinfoall info, int, void *user_data)
 {
+    auto *ctx = active_context(user_data);
+    auto *stream = ctx != nullptr ? ctx->stream.load() : nullptr;
+    if (stream == nullptr) {
+        return 0;
+    }
+    try {
+        begin_stream(*stream, info);
+    } catch (...) {
+        stream->out_of_memory = true;
+    }
     return 0;
 }
 
-int callback_bg_running(NG_BOOL, int, void *)
+// Only touches process-lifetime state; see EngineState.
+int callback_bg_running(NG_BOOL, int, void *user_data)
 {
+    if (user_data == nullptr) {
+        return 0;
+    }
+    auto *state = static_cast<EngineState *>(user_data);
+    {
+        std::lock_guard<std::mutex> lock(state->background_mutex);
+        state->background_events.fetch_add(1);
+    }
+    state->background_wake.notify_all();
     return 0;
 }
 
+// After a controlled exit ngspice's state is unusable: force a fresh
+// ngSpice_Init on the next call and invalidate every loaded circuit.
+void mark_engine_lost()
+{
+    auto &state = engine_state();
+    state.initialized = false;
+    state.loaded_circuits = 0;
+    ++state.circuit_generation;
+}
+
 bool run_command(const std::string &command, RunContext &ctx, std::string &error_out)
 {
     std::string mutable_command = command;
@@ -179,17 +801,18 @@ bool run_command(const std::string &command, RunContext &ctx, std::string &error
         std::ostringstream oss;
         oss << "ngSpice_Command failed for: " << command << " (rc=" << rc << ")";
         if (!ctx.stderr_log.empty()) {
-            oss << "; stderr: " << ctx.stderr_log;
+            oss << "; stderr: " << ctx.stderr_log.str();
         }
         error_out = oss.str();
         return false;
     }
 
     if (ctx.controlled_exit && !ctx.quit_exit) {
+        mark_engine_lost();
         std::ostringstream oss;
         oss << "ngspice requested controlled exit (code=" << ctx.exit_code << ")";
         if (!ctx.stderr_log.empty()) {
-            oss << "; stderr: " << ctx.stderr_log;
+            oss << "; stderr: " << ctx.stderr_log.str();
         }
         error_out = oss.str();
         return false;
@@ -198,89 +821,15 @@ bool run_command(const std::string &command, RunContext &ctx, std::string &error
     return true;
 }
 
-pvector_info get_vector_info_with_fallback(const std::string &requested, const std::string &current_plot)
-{
-    if (requested.empty()) {
-        return nullptr;
-    }
-
-    auto try_vector = [](const std::string &name) -> pvector_info {
-        if (name.empty()) {
-            return nullptr;
-        }
-        std::string mutable_name(name);
-        return ngGet_Vec_Info(mutable_name.data());
-    };
-
-    if (auto *info = try_vector(requested)) {
-        return info;
-    }
-
-    const std::string lower_requested = to_lower_copy(requested);
-    if (!equals_case_insensitive(lower_requested, requested)) {
-        if (auto *info = try_vector(lower_requested)) {
-            return info;
-        }
-    }
-
-    if (!current_plot.empty() && requested.find('.') == std::string::npos) {
-        const std::string scoped = current_plot + "." + requested;
-        if (auto *info = try_vector(scoped)) {
-            return info;
-        }
-
-        const std::string scoped_lower = current_plot + "." + lower_requested;
-        if (!equals_case_insensitive(scoped, scoped_lower)) {
-            if (auto *info = try_vector(scoped_lower)) {
-                return info;
-            }
-        }
-    }
-
-    if (!current_plot.empty()) {
-        std::string plot_name(current_plot);
-        char **all_vectors = ngSpice_AllVecs(plot_name.data());
-        if (all_vectors != nullptr) {
-            for (int idx = 0; all_vectors[idx] != nullptr; ++idx) {
-                const std::string candidate(all_vectors[idx]);
-                const auto separator = candidate.rfind('.');
-                const std::string short_name = (separator == std::string::npos) ? candidate : candidate.substr(separator + 1);
-                if (equals_case_insensitive(short_name, requested) || equals_case_insensitive(candidate, requested)) {
-                    if (auto *info = try_vector(candidate)) {
-                        return info;
-                    }
-                }
-            }
-        }
-    }
-
-    return nullptr;
-}
-
-NgspiceResult *run_impl(const char *netlist_path,
-                        const char *const *requested_vectors,
-                        int requested_vector_count)
+// Requires the engine lock. Initializes ngspice once per process (or again
+// after a controlled exit) instead of on every simulation.
+int ensure_engine(RunContext &ctx, std::string &error_out)
 {
-    if (!non_empty_path(netlist_path)) {
-        return make_result(
-            NGSPICE_FFI_ERR_INVALID_ARGUMENT,
-            "netlist_path must be a non-empty string",
-            "",
-            ""
-        );
-    }
-
-    if (requested_vector_count < 0) {
-        return make_result(
-            NGSPICE_FFI_ERR_INVALID_ARGUMENT,
-            "requested_vector_count must be >= 0",
-            "",
-            ""
-        );
+    auto &state = engine_state();
+    if (state.initialized) {
+        return NGSPICE_FFI_SUCCESS;
     }
 
-    RunContext ctx;
-
     ngSpice_nospinit();
     ngSpice_nospiceinit();
 
@@ -291,127 +840,2138 @@ NgspiceResult *run_impl(const char *netlist_path,
         callback_send_data,
         callback_send_init_data,
         callback_bg_running,
-        &ctx
+        &state
     );
 
     if (init_rc != 0) {
         std::ostringstream oss;
         oss << "ngSpice_Init failed (rc=" << init_rc << ")";
-        return make_result(NGSPICE_FFI_ERR_INIT_FAILED, oss.str(), ctx.stdout_log, ctx.stderr_log);
+        error_out = oss.str();
+        return NGSPICE_FFI_ERR_INIT_FAILED;
     }
 
-    std::string command_error;
-    if (!run_command("set noaskquit", ctx, command_error)) {
-        return make_result(NGSPICE_FFI_ERR_COMMAND_FAILED, command_error, ctx.stdout_log, ctx.stderr_log);
-    }
-    if (!run_command("destroy all", ctx, command_error)) {
-        return make_result(NGSPICE_FFI_ERR_COMMAND_FAILED, command_error, ctx.stdout_log, ctx.stderr_log);
-    }
+    state.initialized = true;
+    state.loaded_circuits = 0;
+    ++state.circuit_generation;
 
-    const std::string source_command = "source " + quote_path_for_command(netlist_path);
-    if (!run_command(source_command, ctx, command_error)) {
-        return make_result(NGSPICE_FFI_ERR_COMMAND_FAILED, command_error, ctx.stdout_log, ctx.stderr_log);
+    if (!run_command("set noaskquit", ctx, error_out)) {
+        return NGSPICE_FFI_ERR_COMMAND_FAILED;
     }
+    return NGSPICE_FFI_SUCCESS;
+}
 
-    if (!run_command("run", ctx, command_error)) {
-        return make_result(NGSPICE_FFI_ERR_COMMAND_FAILED, command_error, ctx.stdout_log, ctx.stderr_log);
+// Requires the engine lock. Drops every circuit and plot so a new netlist
+// does not accumulate on top of the previous ones.
+bool release_circuits(RunContext &ctx, std::string &error_out)
+{
+    auto &state = engine_state();
+    while (state.loaded_circuits > 0) {
+        if (!run_command("remcirc", ctx, error_out)) {
+            state.loaded_circuits = 0;
+            return false;
+        }
+        --state.loaded_circuits;
     }
+    ++state.circuit_generation;
+    return run_command("destroy all", ctx, error_out);
+}
+
+// ngspice's simulation_types values for the independent variable of
+// transient and frequency-domain plots (sim.h: SV_TIME, SV_FREQUENCY).
+constexpr int kVectorTypeTime = 1;
+constexpr int kVectorTypeFrequency = 2;
+
+// Case-insensitive index of the current plot, built with one ngSpice_AllVecs
+// call: normalized name -> name as ngspice reports it.
+struct PlotIndex {
+    std::string plot;
+    std::vector<std::string> names;
+    std::unordered_map<std::string, std::size_t> by_key;
+};
 
-    std::string current_plot;
+PlotIndex index_current_plot()
+{
+    PlotIndex index;
     if (char *plot = ngSpice_CurPlot(); plot != nullptr) {
-        current_plot = plot;
+        index.plot = plot;
+    }
+    if (index.plot.empty()) {
+        return index;
     }
 
-    std::vector<std::string> vector_names;
-    if (requested_vectors != nullptr && requested_vector_count > 0) {
+    std::string mutable_plot(index.plot);
+    char **all_vectors = ngSpice_AllVecs(mutable_plot.data());
+    if (all_vectors == nullptr) {
+        return index;
+    }
+    for (int idx = 0; all_vectors[idx] != nullptr; ++idx) {
+        index.names.emplace_back(all_vectors[idx]);
+    }
+    index.by_key.reserve(index.names.size() * 2);
+    for (std::size_t position = 0; position < index.names.size(); ++position) {
+        index.by_key.emplace(normalize_vector_name(index.names[position], index.plot), position);
+    }
+    return index;
+}
+
+pvector_info vector_info_for(const PlotIndex &index, const std::string &name)
+{
+    std::string qualified = index.plot.empty() || name.find('.') != std::string::npos
+        ? name
+        : index.plot + "." + name;
+    if (auto *info = ngGet_Vec_Info(qualified.data())) {
+        return info;
+    }
+    std::string bare(name);
+    return ngGet_Vec_Info(bare.data());
+}
+
+// Resolves a requested name through the plot index, falling back to ngspice's
+// own lookup for names outside the current plot (e.g. "const.pi").
+pvector_info resolve_vector(const PlotIndex &index, const std::string &requested)
+{
+    const auto found = index.by_key.find(normalize_vector_name(requested, index.plot));
+    if (found != index.by_key.end()) {
+        return vector_info_for(index, index.names[found->second]);
+    }
+    std::string mutable_name(requested);
+    return ngGet_Vec_Info(mutable_name.data());
+}
+
+// The plot's independent variable: a time or frequency typed vector, else a
+// DC sweep vector ("v-sweep", "temp-sweep", ...). Operating points have none.
+pvector_info find_scale_vector(const PlotIndex &index)
+{
+    for (const char *name : {"time", "frequency"}) {
+        if (const auto found = index.by_key.find(name); found != index.by_key.end()) {
+            return vector_info_for(index, index.names[found->second]);
+        }
+    }
+    for (const auto &name : index.names) {
+        const std::string lower = to_lower_copy(name);
+        if (lower.size() > 6 && lower.compare(lower.size() - 6, 6, "-sweep") == 0) {
+            return vector_info_for(index, name);
+        }
+    }
+    for (const auto &name : index.names) {
+        pvector_info info = vector_info_for(index, name);
+        if (info != nullptr && (info->v_type == kVectorTypeTime || info->v_type == kVectorTypeFrequency)) {
+            return info;
+        }
+    }
+    return nullptr;
+}
+
+// Copies one ngspice vector; complex vectors keep their real part in `data`
+// and both parts interleaved in `complex_data`.
+bool copy_vector_info(pvector_info info, const std::string &fallback_name, NgspiceVector &output)
+{
+    const int length = info->v_length;
+    output.name = dup_c_string(info->v_name != nullptr ? info->v_name : fallback_name);
+    output.length = length;
+    output.data = new double[static_cast<std::size_t>(length)]{};
+
+    if (info->v_realdata != nullptr) {
+        std::memcpy(output.data, info->v_realdata, static_cast<std::size_t>(length) * sizeof(double));
+        return true;
+    }
+    if (info->v_compdata == nullptr) {
+        return false;
+    }
+
+    output.is_complex = 1;
+    output.complex_data = new double[static_cast<std::size_t>(length) * 2];
+    for (int value_index = 0; value_index < length; ++value_index) {
+        output.data[value_index] = info->v_compdata[value_index].cx_real;
+        output.complex_data[2 * value_index] = info->v_compdata[value_index].cx_real;
+        output.complex_data[2 * value_index + 1] = info->v_compdata[value_index].cx_imag;
+    }
+    return true;
+}
+
+// Copies the requested vectors (or every vector of the current plot) and the
+// plot's scale out of ngspice after a run. Requires the engine lock.
+NgspiceResult *collect_vectors(const char *const *requested_vectors,
+                               int requested_vector_count,
+                               RunContext &ctx)
+{
+    const PlotIndex index = index_current_plot();
+
+    std::vector<std::string> vector_names;
+    if (requested_vectors != nullptr && requested_vector_count > 0) {
         vector_names.reserve(static_cast<std::size_t>(requested_vector_count));
         for (int idx = 0; idx < requested_vector_count; ++idx) {
             const char *name = requested_vectors[idx];
             if (name == nullptr) {
                 continue;
             }
-            const std::string trimmed = trim_copy(name);
-            if (!trimmed.empty()) {
-                vector_names.push_back(trimmed);
+            const std::string trimmed = trim_copy(name);
+            if (!trimmed.empty()) {
+                vector_names.push_back(trimmed);
+            }
+        }
+    }
+
+    if (vector_names.empty()) {
+        if (index.plot.empty()) {
+            return make_result(
+                NGSPICE_FFI_ERR_VECTOR_NOT_FOUND,
+                "ngspice did not expose a current plot after run",
+                ctx
+            );
+        }
+        vector_names = index.names;
+    }
+
+    if (vector_names.empty()) {
+        return make_result(
+            NGSPICE_FFI_ERR_VECTOR_NOT_FOUND,
+            "no vectors available after simulation run",
+            ctx
+        );
+    }
+
+    std::vector<pvector_info> infos(vector_names.size(), nullptr);
+    for (std::size_t position = 0; position < vector_names.size(); ++position) {
+        const std::string &requested = vector_names[position];
+        infos[position] = resolve_vector(index, requested);
+        if (infos[position] == nullptr) {
+            std::ostringstream oss;
+            oss << "requested vector not found: " << requested;
+            return make_result(NGSPICE_FFI_ERR_VECTOR_NOT_FOUND, oss.str(), ctx);
+        }
+        if (infos[position]->v_length <= 0) {
+            std::ostringstream oss;
+            oss << "vector has no samples: " << requested;
+            return make_result(NGSPICE_FFI_ERR_RUNTIME, oss.str(), ctx);
+        }
+    }
+
+    auto *result = make_result(NGSPICE_FFI_SUCCESS, "", ctx);
+    result->vector_count = static_cast<int>(vector_names.size());
+    result->vectors = new NgspiceVector[vector_names.size()]{};
+
+    for (std::size_t position = 0; position < vector_names.size(); ++position) {
+        if (!copy_vector_info(infos[position], vector_names[position], result->vectors[position])) {
+            ngspice_free_result(result);
+            std::ostringstream oss;
+            oss << "vector has no readable data: " << vector_names[position];
+            return make_result(NGSPICE_FFI_ERR_RUNTIME, oss.str(), ctx);
+        }
+    }
+
+    if (pvector_info scale = find_scale_vector(index); scale != nullptr && scale->v_length > 0) {
+        result->scale = new NgspiceVector{};
+        if (!copy_vector_info(scale, "scale", *result->scale)) {
+            free_vector(result->scale);
+            result->scale = nullptr;
+        }
+    }
+
+    return result;
+}
+
+NgspiceResult *run_impl(const char *netlist_path,
+                        const char *const *requested_vectors,
+                        int requested_vector_count)
+{
+    if (!non_empty_path(netlist_path)) {
+        return make_result(
+            NGSPICE_FFI_ERR_INVALID_ARGUMENT,
+            "netlist_path must be a non-empty string",
+            "",
+            ""
+        );
+    }
+
+    if (requested_vector_count < 0) {
+        return make_result(
+            NGSPICE_FFI_ERR_INVALID_ARGUMENT,
+            "requested_vector_count must be >= 0",
+            "",
+            ""
+        );
+    }
+
+    RunContext ctx;
+    EngineLock lock(ctx);
+
+    std::string command_error;
+    if (const int init_code = ensure_engine(ctx, command_error); init_code != NGSPICE_FFI_SUCCESS) {
+        return make_result(init_code, command_error, ctx);
+    }
+    if (!release_circuits(ctx, command_error)) {
+        return make_result(NGSPICE_FFI_ERR_COMMAND_FAILED, command_error, ctx);
+    }
+
+    const std::string source_command = "source " + quote_path_for_command(netlist_path);
+    if (!run_command(source_command, ctx, command_error)) {
+        return make_result(NGSPICE_FFI_ERR_COMMAND_FAILED, command_error, ctx);
+    }
+    ++engine_state().loaded_circuits;
+
+    if (!run_command("run", ctx, command_error)) {
+        return make_result(NGSPICE_FFI_ERR_COMMAND_FAILED, command_error, ctx);
+    }
+
+    return collect_vectors(requested_vectors, requested_vector_count, ctx);
+}
+
+NgspiceLogOptions default_log_options()
+{
+    NgspiceLogOptions options{};
+    options.capacity_bytes = kDefaultLogCapacityBytes;
+    options.suppress_status = 0;
+    return options;
+}
+
+void configure_logs(RunContext &ctx, const NgspiceLogOptions &options)
+{
+    const auto capacity = static_cast<std::size_t>(options.capacity_bytes > 0 ? options.capacity_bytes : kDefaultLogCapacityBytes);
+    ctx.stdout_log.set_capacity(capacity);
+    ctx.stderr_log.set_capacity(capacity);
+    ctx.suppress_status = options.suppress_status != 0;
+}
+
+void set_session_error(NgspiceSession &session, int code, const std::string &message)
+{
+    session.error_code = code;
+    session.error_message = message;
+}
+
+void open_session_impl(NgspiceSession &session)
+{
+    RunContext ctx;
+    EngineLock lock(ctx);
+
+    auto &state = engine_state();
+    if (state.session_open) {
+        set_session_error(
+            session,
+            NGSPICE_FFI_ERR_INIT_FAILED,
+            "an ngspice session is already open in this process; use ngspice_pool_open for concurrent simulations"
+        );
+        return;
+    }
+
+    std::string init_error;
+    if (const int init_code = ensure_engine(ctx, init_error); init_code != NGSPICE_FFI_SUCCESS) {
+        set_session_error(session, init_code, init_error);
+        return;
+    }
+
+    state.session_open = true;
+    session.owns_engine = true;
+}
+
+void close_session_impl(NgspiceSession &session)
+{
+    if (!session.owns_engine) {
+        return;
+    }
+
+    RunContext ctx;
+    EngineLock lock(ctx);
+    auto &state = engine_state();
+    if (state.initialized && session.loaded && session.circuit_generation == state.circuit_generation) {
+        std::string ignored;
+        release_circuits(ctx, ignored);
+    }
+    state.session_open = false;
+    session.owns_engine = false;
+    session.loaded = false;
+}
+
+NgspiceResult *check_session(const NgspiceSession *session)
+{
+    if (session == nullptr) {
+        return make_result(NGSPICE_FFI_ERR_INVALID_ARGUMENT, "session must not be NULL", "", "");
+    }
+    if (session->error_code != NGSPICE_FFI_SUCCESS) {
+        return make_result(session->error_code, session->error_message, "", "");
+    }
+    return nullptr;
+}
+
+// Splits netlist text into the NULL-terminated line array ngSpice_Circ expects,
+// appending ".end" when the caller omitted it.
+std::vector<std::string> split_netlist_lines(const std::string &text)
+{
+    std::vector<std::string> lines;
+    std::size_t start = 0;
+    while (start <= text.size()) {
+        auto end = text.find('\n', start);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        std::string line = text.substr(start, end - start);
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        lines.push_back(std::move(line));
+        start = end + 1;
+    }
+
+    while (!lines.empty() && trim_copy(lines.back()).empty()) {
+        lines.pop_back();
+    }
+    if (lines.empty() || !equals_case_insensitive(trim_copy(lines.back()), ".end")) {
+        lines.emplace_back(".end");
+    }
+    return lines;
+}
+
+NgspiceResult *load_session_impl(NgspiceSession &session, const char *netlist_text)
+{
+    if (netlist_text == nullptr || trim_copy(netlist_text).empty()) {
+        return make_result(
+            NGSPICE_FFI_ERR_INVALID_ARGUMENT,
+            "netlist_text must be a non-empty string",
+            "",
+            ""
+        );
+    }
+
+    RunContext ctx;
+    configure_logs(ctx, session.log_options);
+    EngineLock lock(ctx);
+
+    session.loaded = false;
+    std::string command_error;
+    if (const int init_code = ensure_engine(ctx, command_error); init_code != NGSPICE_FFI_SUCCESS) {
+        return make_result(init_code, command_error, ctx);
+    }
+    if (!release_circuits(ctx, command_error)) {
+        return make_result(NGSPICE_FFI_ERR_COMMAND_FAILED, command_error, ctx);
+    }
+
+    std::vector<std::string> lines = split_netlist_lines(netlist_text);
+    std::vector<char *> line_pointers;
+    line_pointers.reserve(lines.size() + 1);
+    for (auto &line : lines) {
+        line_pointers.push_back(line.data());
+    }
+    line_pointers.push_back(nullptr);
+
+    const int rc = ngSpice_Circ(line_pointers.data());
+    if (rc != 0 || (ctx.controlled_exit && !ctx.quit_exit)) {
+        if (ctx.controlled_exit && !ctx.quit_exit) {
+            mark_engine_lost();
+        }
+        std::ostringstream oss;
+        oss << "ngSpice_Circ failed to load the netlist (rc=" << rc << ")";
+        if (!ctx.stderr_log.empty()) {
+            oss << "; stderr: " << ctx.stderr_log.str();
+        }
+        return make_result(NGSPICE_FFI_ERR_COMMAND_FAILED, oss.str(), ctx);
+    }
+
+    auto &state = engine_state();
+    ++state.loaded_circuits;
+    session.loaded = true;
+    session.circuit_generation = state.circuit_generation;
+    return make_result(NGSPICE_FFI_SUCCESS, "", ctx);
+}
+
+bool is_command_token(const char *value)
+{
+    if (!non_empty_path(value)) {
+        return false;
+    }
+    for (const char *c = value; *c != '\0'; ++c) {
+        const auto ch = static_cast<unsigned char>(*c);
+        if (std::isspace(ch) != 0 || ch == '=' || ch == ';') {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string format_parameter_value(double value)
+{
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+    return buffer;
+}
+
+// Checks parameter entries before anything is sent to ngspice; returns an
+// empty string when all of them are usable.
+std::string validate_parameters(const NgspiceParameter *parameters, int parameter_count)
+{
+    if (parameter_count < 0) {
+        return "parameter_count must be >= 0";
+    }
+    if (parameter_count > 0 && parameters == nullptr) {
+        return "parameters must not be NULL when parameter_count > 0";
+    }
+
+    for (int index = 0; index < parameter_count; ++index) {
+        const auto &parameter = parameters[index];
+        std::ostringstream oss;
+        oss << "parameters[" << index << "]";
+        if (parameter.kind != NGSPICE_PARAM_NETLIST && parameter.kind != NGSPICE_PARAM_DEVICE) {
+            return oss.str() + ".kind is not a valid NgspiceParameterKind";
+        }
+        if (!is_command_token(parameter.target)) {
+            return oss.str() + ".target must be a non-empty name without spaces, '=' or ';'";
+        }
+        if (parameter.kind == NGSPICE_PARAM_NETLIST && parameter.parameter != nullptr) {
+            return oss.str() + ".parameter must be NULL for NGSPICE_PARAM_NETLIST";
+        }
+        if (parameter.parameter != nullptr && !is_command_token(parameter.parameter)) {
+            return oss.str() + ".parameter must be a name without spaces, '=' or ';'";
+        }
+        if (!std::isfinite(parameter.value)) {
+            return oss.str() + ".value must be finite";
+        }
+    }
+    return "";
+}
+
+// Netlist parameters go first because the `reset` that applies them also
+// restores device values from the parsed deck.
+bool apply_parameters(const NgspiceParameter *parameters,
+                      int parameter_count,
+                      RunContext &ctx,
+                      std::string &error_out)
+{
+    bool needs_reset = false;
+    for (int index = 0; index < parameter_count; ++index) {
+        const auto &parameter = parameters[index];
+        if (parameter.kind != NGSPICE_PARAM_NETLIST) {
+            continue;
+        }
+        const std::string command = std::string("alterparam ") + parameter.target + " = " + format_parameter_value(parameter.value);
+        if (!run_command(command, ctx, error_out)) {
+            return false;
+        }
+        needs_reset = true;
+    }
+
+    if (needs_reset && !run_command("reset", ctx, error_out)) {
+        return false;
+    }
+
+    for (int index = 0; index < parameter_count; ++index) {
+        const auto &parameter = parameters[index];
+        if (parameter.kind != NGSPICE_PARAM_DEVICE) {
+            continue;
+        }
+        std::string command = std::string("alter ") + parameter.target;
+        if (parameter.parameter != nullptr) {
+            command += std::string(" ") + parameter.parameter;
+        }
+        command += " = " + format_parameter_value(parameter.value);
+        if (!run_command(command, ctx, error_out)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+NgspiceResult *validate_run_arguments(const NgspiceParameter *parameters,
+                                      int parameter_count,
+                                      int requested_vector_count)
+{
+    if (const std::string invalid = validate_parameters(parameters, parameter_count); !invalid.empty()) {
+        return make_result(NGSPICE_FFI_ERR_INVALID_ARGUMENT, invalid, "", "");
+    }
+    if (requested_vector_count < 0) {
+        return make_result(
+            NGSPICE_FFI_ERR_INVALID_ARGUMENT,
+            "requested_vector_count must be >= 0",
+            "",
+            ""
+        );
+    }
+    return nullptr;
+}
+
+// Requires the engine lock. Checks the session still owns the loaded circuit,
+// applies the parameter changes and drops earlier plots; returns an error
+// result, or nullptr when the circuit is ready to run.
+NgspiceResult *prepare_session_run(NgspiceSession &session,
+                                   const NgspiceParameter *parameters,
+                                   int parameter_count,
+                                   RunContext &ctx)
+{
+    auto &state = engine_state();
+    if (!session.loaded || !state.initialized || session.circuit_generation != state.circuit_generation) {
+        session.loaded = false;
+        return make_result(
+            NGSPICE_FFI_ERR_INVALID_ARGUMENT,
+            "no netlist is loaded in this session; call ngspice_session_load first",
+            "",
+            ""
+        );
+    }
+
+    std::string command_error;
+    if (!apply_parameters(parameters, parameter_count, ctx, command_error)) {
+        return make_result(NGSPICE_FFI_ERR_COMMAND_FAILED, command_error, ctx);
+    }
+
+    // Earlier runs' plots are no longer needed; dropping them keeps memory flat
+    // across long parameter sweeps.
+    if (!run_command("destroy all", ctx, command_error)) {
+        return make_result(NGSPICE_FFI_ERR_COMMAND_FAILED, command_error, ctx);
+    }
+    return nullptr;
+}
+
+NgspiceResult *run_session_impl(NgspiceSession &session,
+                                const NgspiceParameter *parameters,
+                                int parameter_count,
+                                const char *const *requested_vectors,
+                                int requested_vector_count)
+{
+    if (auto *invalid = validate_run_arguments(parameters, parameter_count, requested_vector_count)) {
+        return invalid;
+    }
+
+    RunContext ctx;
+    configure_logs(ctx, session.log_options);
+    EngineLock lock(ctx);
+
+    if (auto *failed = prepare_session_run(session, parameters, parameter_count, ctx)) {
+        return failed;
+    }
+
+    std::string command_error;
+    if (!run_command("run", ctx, command_error)) {
+        return make_result(NGSPICE_FFI_ERR_COMMAND_FAILED, command_error, ctx);
+    }
+
+    return collect_vectors(requested_vectors, requested_vector_count, ctx);
+}
+
+NgspiceStreamOptions default_stream_options()
+{
+    NgspiceStreamOptions options{};
+    options.decimation = 1;
+    options.initial_capacity = kDefaultStreamCapacity;
+    options.progress_interval_ms = kDefaultProgressIntervalMs;
+    options.progress = nullptr;
+    options.user_data = nullptr;
+    return options;
+}
+
+bool background_run_done(unsigned long events_before)
+{
+    return engine_state().background_events.load() - events_before >= 2;
+}
+
+// Stops a `bg_run` from the caller thread. The halt command's own output would
+// race the background thread's writes into the logs, so the logs are closed
+// first and the command bypasses run_command (which reads them).
+void halt_background_run(RunContext &ctx)
+{
+    {
+        std::lock_guard<std::mutex> lock(ctx.log_mutex);
+        ctx.logs_closed = true;
+    }
+    std::string command = "bg_halt";
+    ngSpice_Command(command.data());
+}
+
+// Waits for a `bg_run` to finish, polling the caller's progress callback.
+// ngspice reports the background thread through BGThreadRunning twice (start
+// and end) and through ngSpice_running(); either two events or an observed
+// running -> stopped transition means the simulation thread is done with the
+// stream. Returns false if the thread was not seen starting in time; it has
+// then been halted and waited for, so the engine lock may be released.
+bool wait_for_background_run(unsigned long events_before,
+                             const NgspiceStreamOptions &options,
+                             StreamCapture &stream,
+                             RunContext &ctx,
+                             bool &cancelled)
+{
+    auto &state = engine_state();
+    const auto interval = std::chrono::milliseconds(std::max(options.progress_interval_ms, 1));
+    const auto started_at = std::chrono::steady_clock::now();
+    bool observed_running = false;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(state.background_mutex);
+            state.background_wake.wait_for(lock, interval, [&] { return background_run_done(events_before); });
+        }
+
+        const bool running = ngSpice_running();
+        observed_running = observed_running || running;
+        if (background_run_done(events_before) || (observed_running && !running)) {
+            return true;
+        }
+        if (!observed_running && std::chrono::steady_clock::now() - started_at > kBackgroundStartTimeout) {
+            // A late-starting thread would write into this call's context
+            // after it returned. bg_halt joins a running thread; if the
+            // thread only starts after it, wait for that and halt again.
+            halt_background_run(ctx);
+            {
+                std::unique_lock<std::mutex> lock(state.background_mutex);
+                state.background_wake.wait_for(lock, kBackgroundStartTimeout, [&] {
+                    return state.background_events.load() != events_before;
+                });
+            }
+            if (state.background_events.load() != events_before && !background_run_done(events_before)) {
+                halt_background_run(ctx);
+            }
+            return false;
+        }
+
+        if (options.progress != nullptr && !cancelled) {
+            const double percent = stream.percent.load(std::memory_order_relaxed);
+            const int stored = stream.stored.load(std::memory_order_relaxed);
+            if (options.progress(percent, stored, options.user_data) != 0) {
+                cancelled = true;
+                halt_background_run(ctx);
+            }
+        }
+    }
+}
+
+void release_stream_column(StreamColumn &column, NgspiceVector &output)
+{
+    output.name = dup_c_string(column.name);
+    output.length = static_cast<int>(column.real.size());
+    output.data = column.real.release();
+    if (column.is_complex) {
+        output.is_complex = 1;
+        output.complex_data = column.interleaved.release();
+    }
+}
+
+NgspiceResult *streaming_result(StreamCapture &stream, RunContext &ctx, bool cancelled)
+{
+    if (stream.out_of_memory) {
+        return make_result(
+            NGSPICE_FFI_ERR_RUNTIME,
+            "out of memory while capturing streamed vectors",
+            ctx
+        );
+    }
+    if (!stream.initialized) {
+        return make_result(
+            NGSPICE_FFI_ERR_COMMAND_FAILED,
+            cancelled ? "simulation cancelled before producing output" : "simulation produced no output",
+            ctx
+        );
+    }
+    if (!stream.missing.empty()) {
+        std::ostringstream oss;
+        oss << "requested vector not found: " << stream.missing.front();
+        return make_result(NGSPICE_FFI_ERR_VECTOR_NOT_FOUND, oss.str(), ctx);
+    }
+    if (stream.columns.empty()) {
+        return make_result(
+            NGSPICE_FFI_ERR_VECTOR_NOT_FOUND,
+            "no vectors available after simulation run",
+            ctx
+        );
+    }
+
+    finish_stream(stream);
+
+    auto *result = make_result(
+        cancelled ? NGSPICE_FFI_ERR_CANCELLED : NGSPICE_FFI_SUCCESS,
+        cancelled ? "simulation cancelled by progress callback" : "",
+        ctx
+    );
+    result->vector_count = static_cast<int>(stream.columns.size());
+    result->vectors = new NgspiceVector[stream.columns.size()]{};
+    for (std::size_t index = 0; index < stream.columns.size(); ++index) {
+        release_stream_column(stream.columns[index], result->vectors[index]);
+    }
+    if (stream.has_scale) {
+        result->scale = new NgspiceVector{};
+        release_stream_column(stream.scale, *result->scale);
+    }
+    return result;
+}
+
+NgspiceResult *run_streaming_impl(NgspiceSession &session,
+                                  const NgspiceParameter *parameters,
+                                  int parameter_count,
+                                  const char *const *requested_vectors,
+                                  int requested_vector_count,
+                                  const NgspiceStreamOptions *options_in)
+{
+    if (auto *invalid = validate_run_arguments(parameters, parameter_count, requested_vector_count)) {
+        return invalid;
+    }
+
+    const NgspiceStreamOptions options = options_in != nullptr ? *options_in : default_stream_options();
+    if (options.decimation < 0 || options.initial_capacity < 0 || options.progress_interval_ms < 0) {
+        return make_result(
+            NGSPICE_FFI_ERR_INVALID_ARGUMENT,
+            "stream options must not be negative",
+            "",
+            ""
+        );
+    }
+
+    StreamCapture stream;
+    stream.decimation = std::max(options.decimation, 1);
+    stream.initial_capacity = static_cast<std::size_t>(options.initial_capacity);
+    for (int index = 0; requested_vectors != nullptr && index < requested_vector_count; ++index) {
+        if (requested_vectors[index] != nullptr && !trim_copy(requested_vectors[index]).empty()) {
+            stream.requested.emplace_back(trim_copy(requested_vectors[index]));
+        }
+    }
+
+    RunContext ctx;
+    configure_logs(ctx, session.log_options);
+    EngineLock lock(ctx);
+
+    if (auto *failed = prepare_session_run(session, parameters, parameter_count, ctx)) {
+        return failed;
+    }
+
+    ctx.stream = &stream;
+    const unsigned long events_before = engine_state().background_events.load();
+    std::string command_error;
+    if (!run_command("bg_run", ctx, command_error)) {
+        ctx.stream = nullptr;
+        return make_result(NGSPICE_FFI_ERR_COMMAND_FAILED, command_error, ctx);
+    }
+
+    bool cancelled = false;
+    const bool finished = wait_for_background_run(events_before, options, stream, ctx, cancelled);
+    ctx.stream = nullptr;
+    if (!finished) {
+        return make_result(
+            NGSPICE_FFI_ERR_COMMAND_FAILED,
+            "ngspice background run did not start",
+            ctx
+        );
+    }
+
+    if (ctx.controlled_exit && !ctx.quit_exit) {
+        mark_engine_lost();
+        std::ostringstream oss;
+        oss << "ngspice requested controlled exit (code=" << ctx.exit_code << ")";
+        return make_result(NGSPICE_FFI_ERR_COMMAND_FAILED, oss.str(), ctx);
+    }
+
+    // The columns already hold everything the caller asked for; release
+    // ngspice's own copy of the plot right away.
+    run_command("destroy all", ctx, command_error);
+    return streaming_result(stream, ctx, cancelled);
+}
+
+class WireWriter {
+public:
+    void put_u8(std::uint8_t value)
+    {
+        buffer_.push_back(static_cast<char>(value));
+    }
+
+    void put_u32(std::uint32_t value)
+    {
+        put_raw(&value, sizeof(value));
+    }
+
+    void put_i32(std::int32_t value)
+    {
+        put_raw(&value, sizeof(value));
+    }
+
+    void put_u64(std::uint64_t value)
+    {
+        put_raw(&value, sizeof(value));
+    }
+
+    void put_f64(double value)
+    {
+        put_raw(&value, sizeof(value));
+    }
+
+    void put_doubles(const double *values, std::size_t count)
+    {
+        put_raw(values, count * sizeof(double));
+    }
+
+    void put_string(const char *value)
+    {
+        const std::size_t size = value == nullptr ? 0 : std::strlen(value);
+        put_u32(static_cast<std::uint32_t>(size));
+        put_raw(value, size);
+    }
+
+    const std::string &bytes() const
+    {
+        return buffer_;
+    }
+
+private:
+    void put_raw(const void *data, std::size_t size)
+    {
+        if (size > 0) {
+            buffer_.append(static_cast<const char *>(data), size);
+        }
+    }
+
+    std::string buffer_;
+};
+
+class WireReader {
+public:
+    explicit WireReader(const std::string &bytes)
+        : bytes_(bytes)
+    {
+    }
+
+    bool get_u8(std::uint8_t &value)
+    {
+        return get_raw(&value, sizeof(value));
+    }
+
+    bool get_u32(std::uint32_t &value)
+    {
+        return get_raw(&value, sizeof(value));
+    }
+
+    bool get_i32(std::int32_t &value)
+    {
+        return get_raw(&value, sizeof(value));
+    }
+
+    bool get_u64(std::uint64_t &value)
+    {
+        return get_raw(&value, sizeof(value));
+    }
+
+    bool get_f64(double &value)
+    {
+        return get_raw(&value, sizeof(value));
+    }
+
+    bool get_doubles(double *values, std::size_t count)
+    {
+        if (count > (bytes_.size() - offset_) / sizeof(double)) {
+            return false;
+        }
+        return get_raw(values, count * sizeof(double));
+    }
+
+    bool get_string(std::string &value)
+    {
+        std::uint32_t size = 0;
+        if (!get_u32(size) || size > bytes_.size() - offset_) {
+            return false;
+        }
+        value.assign(bytes_, offset_, size);
+        offset_ += size;
+        return true;
+    }
+
+private:
+    bool get_raw(void *data, std::size_t size)
+    {
+        if (size > bytes_.size() - offset_) {
+            return false;
+        }
+        if (size > 0) {
+            std::memcpy(data, bytes_.data() + offset_, size);
+        }
+        offset_ += size;
+        return true;
+    }
+
+    const std::string &bytes_;
+    std::size_t offset_ = 0;
+};
+
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+bool write_all(int fd, const char *data, std::size_t size)
+{
+    while (size > 0) {
+        const ssize_t written = ::send(fd, data, size, kSendFlags);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+bool read_all(int fd, char *data, std::size_t size)
+{
+    while (size > 0) {
+        const ssize_t received = ::recv(fd, data, size, 0);
+        if (received < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        if (received == 0) {
+            return false;
+        }
+        data += received;
+        size -= static_cast<std::size_t>(received);
+    }
+    return true;
+}
+
+bool write_frame(int fd, const std::string &payload)
+{
+    const auto size = static_cast<std::uint32_t>(payload.size());
+    return write_all(fd, reinterpret_cast<const char *>(&size), sizeof(size))
+        && write_all(fd, payload.data(), payload.size());
+}
+
+bool read_frame(int fd, std::string &payload)
+{
+    std::uint32_t size = 0;
+    if (!read_all(fd, reinterpret_cast<char *>(&size), sizeof(size)) || size > kMaxFrameBytes) {
+        return false;
+    }
+    payload.resize(size);
+    return size == 0 || read_all(fd, payload.data(), size);
+}
+
+void put_parameters(WireWriter &writer, const NgspiceParameter *parameters, int parameter_count)
+{
+    writer.put_u32(static_cast<std::uint32_t>(parameter_count));
+    for (int index = 0; index < parameter_count; ++index) {
+        const auto &parameter = parameters[index];
+        writer.put_i32(parameter.kind);
+        writer.put_string(parameter.target);
+        writer.put_u8(parameter.parameter != nullptr ? 1 : 0);
+        writer.put_string(parameter.parameter);
+        writer.put_f64(parameter.value);
+    }
+}
+
+void put_string_list(WireWriter &writer, const char *const *values, int count)
+{
+    const int safe_count = values == nullptr ? 0 : std::max(count, 0);
+    writer.put_u32(static_cast<std::uint32_t>(safe_count));
+    for (int index = 0; index < safe_count; ++index) {
+        writer.put_string(values[index]);
+    }
+}
+
+void put_vector(WireWriter &writer, const NgspiceVector &vector)
+{
+    const auto length = static_cast<std::size_t>(std::max(vector.length, 0));
+    writer.put_string(vector.name);
+    writer.put_u32(static_cast<std::uint32_t>(length));
+    writer.put_doubles(vector.data, length);
+    writer.put_u8(vector.complex_data != nullptr ? 1 : 0);
+    if (vector.complex_data != nullptr) {
+        writer.put_doubles(vector.complex_data, length * 2);
+    }
+}
+
+void put_log_counters(WireWriter &writer, const NgspiceLogView &view)
+{
+    writer.put_u64(view.dropped_bytes);
+    writer.put_i32(view.error_lines);
+    writer.put_i32(view.warning_lines);
+}
+
+bool get_log_counters(WireReader &reader, NgspiceLogView &view)
+{
+    std::uint64_t dropped = 0;
+    std::int32_t errors = 0;
+    std::int32_t warnings = 0;
+    if (!reader.get_u64(dropped) || !reader.get_i32(errors) || !reader.get_i32(warnings)) {
+        return false;
+    }
+    view.dropped_bytes = dropped;
+    view.error_lines = errors;
+    view.warning_lines = warnings;
+    return true;
+}
+
+void put_result(WireWriter &writer, const NgspiceResult &result)
+{
+    writer.put_i32(result.error_code);
+    writer.put_string(result.error_message);
+    writer.put_string(result.stdout_log);
+    writer.put_string(result.stderr_log);
+    put_log_counters(writer, result.stdout_view);
+    put_log_counters(writer, result.stderr_view);
+    writer.put_u32(static_cast<std::uint32_t>(std::max(result.vector_count, 0)));
+    for (int index = 0; index < result.vector_count; ++index) {
+        put_vector(writer, result.vectors[index]);
+    }
+    writer.put_u8(result.scale != nullptr ? 1 : 0);
+    if (result.scale != nullptr) {
+        put_vector(writer, *result.scale);
+    }
+}
+
+bool get_vector(WireReader &reader, NgspiceVector &vector)
+{
+    std::string name;
+    std::uint32_t length = 0;
+    std::uint8_t is_complex = 0;
+    if (!reader.get_string(name) || !reader.get_u32(length)) {
+        return false;
+    }
+    vector.name = dup_c_string(name);
+    vector.length = static_cast<int>(length);
+    vector.data = new double[length]{};
+    if (!reader.get_doubles(vector.data, length) || !reader.get_u8(is_complex)) {
+        return false;
+    }
+    if (is_complex != 0) {
+        vector.is_complex = 1;
+        vector.complex_data = new double[static_cast<std::size_t>(length) * 2]{};
+        return reader.get_doubles(vector.complex_data, static_cast<std::size_t>(length) * 2);
+    }
+    return true;
+}
+
+NgspiceResult *get_result(WireReader &reader)
+{
+    std::int32_t code = 0;
+    std::string message;
+    std::string stdout_log;
+    std::string stderr_log;
+    std::uint32_t vector_count = 0;
+    NgspiceLogView stdout_counters{};
+    NgspiceLogView stderr_counters{};
+    if (!reader.get_i32(code) || !reader.get_string(message) || !reader.get_string(stdout_log)
+        || !reader.get_string(stderr_log) || !get_log_counters(reader, stdout_counters)
+        || !get_log_counters(reader, stderr_counters) || !reader.get_u32(vector_count)) {
+        return nullptr;
+    }
+
+    auto *result = make_result(code, message, stdout_log, stderr_log);
+    result->stdout_view.dropped_bytes = stdout_counters.dropped_bytes;
+    result->stderr_view.dropped_bytes = stderr_counters.dropped_bytes;
+    result->stderr_view.error_lines = stderr_counters.error_lines;
+    result->stderr_view.warning_lines = stderr_counters.warning_lines;
+    if (vector_count > 0) {
+        result->vector_count = static_cast<int>(vector_count);
+        result->vectors = new NgspiceVector[vector_count]{};
+    }
+    for (std::uint32_t index = 0; index < vector_count; ++index) {
+        if (!get_vector(reader, result->vectors[index])) {
+            ngspice_free_result(result);
+            return nullptr;
+        }
+    }
+
+    std::uint8_t has_scale = 0;
+    if (!reader.get_u8(has_scale)) {
+        ngspice_free_result(result);
+        return nullptr;
+    }
+    if (has_scale != 0) {
+        result->scale = new NgspiceVector{};
+        if (!get_vector(reader, *result->scale)) {
+            ngspice_free_result(result);
+            return nullptr;
+        }
+    }
+    return result;
+}
+
+// A decoded kWorkerRun/kWorkerRunMeasured request; the string vectors own the
+// storage the C views point into.
+struct RunRequest {
+    std::vector<std::string> targets;
+    std::vector<std::string> names;
+    std::vector<NgspiceParameter> parameters;
+    std::vector<std::string> vector_names;
+    std::vector<const char *> vector_pointers;
+};
+
+bool read_run_request(WireReader &reader, RunRequest &request)
+{
+    std::uint32_t parameter_count = 0;
+    if (!reader.get_u32(parameter_count)) {
+        return false;
+    }
+
+    request.targets.resize(parameter_count);
+    request.names.resize(parameter_count);
+    request.parameters.resize(parameter_count);
+    for (std::uint32_t index = 0; index < parameter_count; ++index) {
+        std::int32_t kind = 0;
+        std::uint8_t has_name = 0;
+        if (!reader.get_i32(kind) || !reader.get_string(request.targets[index]) || !reader.get_u8(has_name)
+            || !reader.get_string(request.names[index]) || !reader.get_f64(request.parameters[index].value)) {
+            return false;
+        }
+        request.parameters[index].kind = kind;
+        request.parameters[index].target = request.targets[index].c_str();
+        request.parameters[index].parameter = has_name != 0 ? request.names[index].c_str() : nullptr;
+    }
+
+    std::uint32_t vector_count = 0;
+    if (!reader.get_u32(vector_count)) {
+        return false;
+    }
+    request.vector_names.resize(vector_count);
+    request.vector_pointers.resize(vector_count);
+    for (std::uint32_t index = 0; index < vector_count; ++index) {
+        if (!reader.get_string(request.vector_names[index])) {
+            return false;
+        }
+        request.vector_pointers[index] = request.vector_names[index].c_str();
+    }
+    return true;
+}
+
+NgspiceResult *run_request(NgspiceSession &session, const RunRequest &request)
+{
+    return run_session_impl(
+        session,
+        request.parameters.data(),
+        static_cast<int>(request.parameters.size()),
+        request.vector_pointers.data(),
+        static_cast<int>(request.vector_pointers.size())
+    );
+}
+
+NgspiceResult *serve_run_request(NgspiceSession &session, WireReader &reader)
+{
+    RunRequest request;
+    if (!read_run_request(reader, request)) {
+        return nullptr;
+    }
+    return run_request(session, request);
+}
+
+struct MeasureRequest {
+    std::uint32_t vector_index = 0;
+    int kind = NGSPICE_MEASURE_FINAL;
+    double at = 0.0;
+};
+
+double vector_sample(const NgspiceVector &vector, int index)
+{
+    if (vector.complex_data != nullptr) {
+        return std::hypot(vector.complex_data[2 * index], vector.complex_data[2 * index + 1]);
+    }
+    return vector.data[index];
+}
+
+// Integral of f(sample) over the scale by the trapezoid rule, divided by the
+// scale span; falls back to the sample mean without a usable scale.
+template <typename Transform>
+double scale_weighted_mean(const NgspiceVector &vector, const NgspiceVector *scale, Transform transform)
+{
+    const int length = vector.length;
+    if (scale != nullptr && scale->length == length && length > 1) {
+        const double span = scale->data[length - 1] - scale->data[0];
+        if (span > 0.0) {
+            double integral = 0.0;
+            double previous = transform(vector_sample(vector, 0));
+            for (int index = 1; index < length; ++index) {
+                const double current = transform(vector_sample(vector, index));
+                integral += 0.5 * (previous + current) * (scale->data[index] - scale->data[index - 1]);
+                previous = current;
+            }
+            return integral / span;
+        }
+    }
+
+    double sum = 0.0;
+    for (int index = 0; index < length; ++index) {
+        sum += transform(vector_sample(vector, index));
+    }
+    return sum / length;
+}
+
+double measure_vector(const NgspiceVector &vector, const NgspiceVector *scale, int kind, double at)
+{
+    const int length = vector.length;
+    if (length <= 0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    switch (kind) {
+    case NGSPICE_MEASURE_FINAL:
+        return vector_sample(vector, length - 1);
+    case NGSPICE_MEASURE_MIN:
+    case NGSPICE_MEASURE_MAX: {
+        double extreme = vector_sample(vector, 0);
+        for (int index = 1; index < length; ++index) {
+            const double value = vector_sample(vector, index);
+            extreme = kind == NGSPICE_MEASURE_MIN ? std::min(extreme, value) : std::max(extreme, value);
+        }
+        return extreme;
+    }
+    case NGSPICE_MEASURE_AVERAGE:
+        return scale_weighted_mean(vector, scale, [](double value) { return value; });
+    case NGSPICE_MEASURE_RMS:
+        return std::sqrt(scale_weighted_mean(vector, scale, [](double value) { return value * value; }));
+    case NGSPICE_MEASURE_AT: {
+        if (scale == nullptr || scale->length != length) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        const double *begin = scale->data;
+        const double *end = scale->data + length;
+        if (at < begin[0] || at > end[-1]) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        const auto upper = static_cast<int>(std::lower_bound(begin, end, at) - begin);
+        if (upper == 0 || begin[upper] == at) {
+            return vector_sample(vector, upper);
+        }
+        const double weight = (at - begin[upper - 1]) / (begin[upper] - begin[upper - 1]);
+        return vector_sample(vector, upper - 1) + weight * (vector_sample(vector, upper) - vector_sample(vector, upper - 1));
+    }
+    default:
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+}
+
+// Reduces a successful run to a single "measurements" vector so a sweep only
+// ships scalars back to the host; failed runs are returned unchanged.
+NgspiceResult *measure_result(NgspiceResult *run, const std::vector<MeasureRequest> &measures)
+{
+    if (run->error_code != NGSPICE_FFI_SUCCESS) {
+        return run;
+    }
+
+    auto *measured = make_result(NGSPICE_FFI_SUCCESS, "", "", "");
+    measured->vector_count = 1;
+    measured->vectors = new NgspiceVector[1]{};
+    auto &output = measured->vectors[0];
+    output.name = dup_c_string("measurements");
+    output.length = static_cast<int>(measures.size());
+    output.data = new double[std::max<std::size_t>(measures.size(), 1)]{};
+    for (std::size_t index = 0; index < measures.size(); ++index) {
+        const auto &measure = measures[index];
+        output.data[index] = measure.vector_index < static_cast<std::uint32_t>(run->vector_count)
+            ? measure_vector(run->vectors[measure.vector_index], run->scale, measure.kind, measure.at)
+            : std::numeric_limits<double>::quiet_NaN();
+    }
+    ngspice_free_result(run);
+    return measured;
+}
+
+NgspiceResult *serve_measured_run_request(NgspiceSession &session, WireReader &reader)
+{
+    RunRequest request;
+    std::uint32_t measure_count = 0;
+    if (!read_run_request(reader, request) || !reader.get_u32(measure_count)) {
+        return nullptr;
+    }
+
+    std::vector<MeasureRequest> measures(measure_count);
+    for (auto &measure : measures) {
+        std::int32_t kind = 0;
+        if (!reader.get_u32(measure.vector_index) || !reader.get_i32(kind) || !reader.get_f64(measure.at)) {
+            return nullptr;
+        }
+        measure.kind = kind;
+    }
+
+    return measure_result(run_request(session, request), measures);
+}
+
+NgspiceResult *serve_request(NgspiceSession &session, const std::string &frame, bool &quit)
+{
+    WireReader reader(frame);
+    std::uint8_t opcode = 0;
+    if (!reader.get_u8(opcode)) {
+        return nullptr;
+    }
+
+    if (opcode == kWorkerQuit) {
+        quit = true;
+        return make_result(NGSPICE_FFI_SUCCESS, "", "", "");
+    }
+    if (session.error_code != NGSPICE_FFI_SUCCESS) {
+        return make_result(session.error_code, session.error_message, "", "");
+    }
+    if (opcode == kWorkerLoad) {
+        std::string netlist;
+        if (!reader.get_string(netlist)) {
+            return nullptr;
+        }
+        return load_session_impl(session, netlist.c_str());
+    }
+    if (opcode == kWorkerRun) {
+        return serve_run_request(session, reader);
+    }
+    if (opcode == kWorkerRunMeasured) {
+        return serve_measured_run_request(session, reader);
+    }
+    return nullptr;
+}
+
+int worker_main_impl(int socket_fd)
+{
+    NgspiceSession session;
+    open_session_impl(session);
+
+    std::string frame;
+    bool quit = false;
+    while (!quit && read_frame(socket_fd, frame)) {
+        NgspiceResult *result = nullptr;
+        try {
+            result = serve_request(session, frame, quit);
+            if (result == nullptr) {
+                result = make_result(NGSPICE_FFI_ERR_INVALID_ARGUMENT, "malformed ngspice worker request", "", "");
+            }
+        } catch (const std::exception &error) {
+            result = make_result(NGSPICE_FFI_ERR_RUNTIME, error.what(), "", "");
+        }
+
+        WireWriter writer;
+        put_result(writer, *result);
+        ngspice_free_result(result);
+        if (!write_frame(socket_fd, writer.bytes())) {
+            break;
+        }
+    }
+
+    close_session_impl(session);
+    return 0;
+}
+
+void set_pool_error(NgspicePool &pool, int code, const std::string &message)
+{
+    pool.error_code = code;
+    pool.error_message = message;
+}
+
+std::string default_worker_executable()
+{
+    if (const char *configured = std::getenv("NGSPICE_FFI_WORKER"); non_empty_path(configured)) {
+        return configured;
+    }
+
+    Dl_info info{};
+    if (dladdr(reinterpret_cast<void *>(&ngspice_pool_open), &info) != 0 && info.dli_fname != nullptr) {
+        const std::string library_path(info.dli_fname);
+        const auto slash = library_path.rfind('/');
+        if (slash != std::string::npos) {
+            return library_path.substr(0, slash + 1) + kWorkerExecutableName;
+        }
+    }
+    return kWorkerExecutableName;
+}
+
+bool set_close_on_exec(int fd)
+{
+    const int flags = ::fcntl(fd, F_GETFD);
+    return flags >= 0 && ::fcntl(fd, F_SETFD, flags | FD_CLOEXEC) == 0;
+}
+
+// Seconds a worker may take to answer one request before the host treats it as
+// hung; `$NGSPICE_FFI_WORKER_TIMEOUT` overrides it and 0 waits forever.
+int worker_timeout_seconds()
+{
+    if (const char *configured = std::getenv("NGSPICE_FFI_WORKER_TIMEOUT"); non_empty_path(configured)) {
+        char *end = nullptr;
+        const long seconds = std::strtol(configured, &end, 10);
+        if (end != configured && *end == '\0' && seconds >= 0 && seconds <= std::numeric_limits<int>::max()) {
+            return static_cast<int>(seconds);
+        }
+    }
+    return kDefaultWorkerTimeoutSeconds;
+}
+
+// A timed-out recv fails like a closed socket, so read_frame needs no special case.
+bool set_receive_timeout(int fd, int seconds)
+{
+    timeval timeout{};
+    timeout.tv_sec = seconds;
+    return ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) == 0;
+}
+
+// Waits up to `seconds` for `pid` to exit on its own; false if it is still running.
+bool wait_for_exit(pid_t pid, int seconds)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+    for (;;) {
+        int status = 0;
+        const pid_t reaped = ::waitpid(pid, &status, WNOHANG);
+        if (reaped == pid || (reaped < 0 && errno != EINTR)) {
+            return true;
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+void forget_netlist(PoolWorker &worker)
+{
+    worker.has_netlist = false;
+    worker.loaded_netlist.clear();
+}
+
+void stop_worker(PoolWorker &worker, bool graceful)
+{
+    if (worker.socket_fd >= 0) {
+        if (graceful) {
+            WireWriter writer;
+            writer.put_u8(kWorkerQuit);
+            std::string reply;
+            set_receive_timeout(worker.socket_fd, kWorkerQuitTimeoutSeconds);
+            if (write_frame(worker.socket_fd, writer.bytes())) {
+                read_frame(worker.socket_fd, reply);
+            }
+        }
+        ::close(worker.socket_fd);
+        worker.socket_fd = -1;
+    }
+    if (worker.pid > 0) {
+        // A worker stuck inside ngspice never sees the quit request.
+        if (!graceful || !wait_for_exit(worker.pid, kWorkerQuitTimeoutSeconds)) {
+            ::kill(worker.pid, SIGKILL);
+            int status = 0;
+            while (::waitpid(worker.pid, &status, 0) < 0 && errno == EINTR) {
+            }
+        }
+        worker.pid = -1;
+    }
+    forget_netlist(worker);
+}
+
+// Workers talk over one AF_UNIX stream socket mapped to kWorkerSocketFd in the
+// child. Both ends are close-on-exec from creation so a sibling spawned
+// concurrently never inherits them: a stray copy of a worker's end would keep
+// the host's recv blocked after that worker crashed. Without SOCK_CLOEXEC the
+// socketpair-to-spawn window is serialized instead.
+bool spawn_worker(const std::string &executable, PoolWorker &worker, std::string &error_out)
+{
+#ifdef SOCK_CLOEXEC
+    constexpr int kSocketType = SOCK_STREAM | SOCK_CLOEXEC;
+#else
+    constexpr int kSocketType = SOCK_STREAM;
+    static std::mutex spawn_mutex;
+    std::lock_guard<std::mutex> spawn_lock(spawn_mutex);
+#endif
+    int sockets[2] = {-1, -1};
+    if (::socketpair(AF_UNIX, kSocketType, 0, sockets) != 0) {
+        error_out = std::string("socketpair failed: ") + std::strerror(errno);
+        return false;
+    }
+
+    int child_fd = sockets[1];
+    if (child_fd == kWorkerSocketFd) {
+        child_fd = ::fcntl(sockets[1], F_DUPFD_CLOEXEC, kWorkerSocketFd + 1);
+        ::close(sockets[1]);
+    }
+    if (child_fd < 0 || !set_close_on_exec(sockets[0]) || !set_close_on_exec(child_fd)
+        || !set_receive_timeout(sockets[0], worker_timeout_seconds())) {
+        error_out = std::string("failed to prepare worker socket: ") + std::strerror(errno);
+        ::close(sockets[0]);
+        if (child_fd >= 0) {
+            ::close(child_fd);
+        }
+        return false;
+    }
+#ifdef SO_NOSIGPIPE
+    const int enable = 1;
+    ::setsockopt(sockets[0], SOL_SOCKET, SO_NOSIGPIPE, &enable, sizeof(enable));
+#endif
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, child_fd, kWorkerSocketFd);
+    // ngspice occasionally prints straight to stdout; keep that off the host's stream.
+    posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+
+    std::string fd_argument = std::to_string(kWorkerSocketFd);
+    std::string program(executable);
+    char *argv[] = {program.data(), fd_argument.data(), nullptr};
+
+    pid_t pid = -1;
+    const int rc = ::posix_spawnp(&pid, program.c_str(), &actions, nullptr, argv, environ);
+    posix_spawn_file_actions_destroy(&actions);
+    ::close(child_fd);
+
+    if (rc != 0) {
+        ::close(sockets[0]);
+        error_out = "failed to start ngspice worker '" + executable + "': " + std::strerror(rc);
+        return false;
+    }
+
+    worker.pid = pid;
+    worker.socket_fd = sockets[0];
+    forget_netlist(worker);
+    return true;
+}
+
+NgspiceResult *exchange_with_worker(PoolWorker &worker, const std::string &request)
+{
+    std::string reply;
+    if (write_frame(worker.socket_fd, request) && read_frame(worker.socket_fd, reply)) {
+        WireReader reader(reply);
+        if (auto *result = get_result(reader)) {
+            // A controlled exit resets the worker's ngspice and drops its
+            // circuit, and the reply does not say whether that happened, so
+            // any failure makes the next job load the netlist again.
+            if (result->error_code != NGSPICE_FFI_SUCCESS) {
+                forget_netlist(worker);
+            }
+            return result;
+        }
+    }
+
+    // The worker died (typically an ngspice abort), hung past the reply
+    // timeout or broke the protocol; fail this job only and let the next job
+    // respawn it.
+    stop_worker(worker, false);
+    return make_result(NGSPICE_FFI_ERR_RUNTIME, "ngspice worker exited unexpectedly", "", "");
+}
+
+// Starts the worker if needed and makes `netlist` its loaded circuit; returns
+// an error result, or nullptr when the worker is ready to run.
+NgspiceResult *prepare_worker(const NgspicePool &pool, PoolWorker &worker, const char *netlist)
+{
+    if (worker.socket_fd < 0) {
+        std::string spawn_error;
+        if (!spawn_worker(pool.worker_executable, worker, spawn_error)) {
+            return make_result(NGSPICE_FFI_ERR_INIT_FAILED, spawn_error, "", "");
+        }
+    }
+
+    if (!worker.has_netlist || worker.loaded_netlist != netlist) {
+        WireWriter load;
+        load.put_u8(kWorkerLoad);
+        load.put_string(netlist);
+        NgspiceResult *loaded = exchange_with_worker(worker, load.bytes());
+        if (loaded->error_code != NGSPICE_FFI_SUCCESS) {
+            return loaded;
+        }
+        ngspice_free_result(loaded);
+        worker.has_netlist = true;
+        worker.loaded_netlist = netlist;
+    }
+    return nullptr;
+}
+
+NgspiceResult *run_job_on_worker(const NgspicePool &pool, PoolWorker &worker, const NgspiceJob &job)
+{
+    if (auto *failed = prepare_worker(pool, worker, job.netlist)) {
+        return failed;
+    }
+
+    WireWriter run;
+    run.put_u8(kWorkerRun);
+    put_parameters(run, job.parameters, job.parameter_count);
+    put_string_list(run, job.requested_vectors, job.requested_vector_count);
+    return exchange_with_worker(worker, run.bytes());
+}
+
+std::string validate_job(const NgspiceJob &job, int index)
+{
+    std::ostringstream prefix;
+    prefix << "jobs[" << index << "]";
+    if (job.netlist == nullptr || trim_copy(job.netlist).empty()) {
+        return prefix.str() + ".netlist must be a non-empty string";
+    }
+    if (const std::string invalid = validate_parameters(job.parameters, job.parameter_count); !invalid.empty()) {
+        return prefix.str() + ": " + invalid;
+    }
+    if (job.requested_vector_count < 0) {
+        return prefix.str() + ".requested_vector_count must be >= 0";
+    }
+    return "";
+}
+
+NgspiceBatchResult *make_batch_result(int code, const std::string &message)
+{
+    auto *result = new NgspiceBatchResult{};
+    result->results = nullptr;
+    result->result_count = 0;
+    result->error_code = code;
+    result->error_message = message.empty() ? nullptr : dup_c_string(message);
+    return result;
+}
+
+void open_pool_impl(NgspicePool &pool, int worker_count, const char *worker_executable)
+{
+    if (worker_count <= 0) {
+        worker_count = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    worker_count = std::min(worker_count, kMaxPoolWorkers);
+
+    pool.worker_executable = non_empty_path(worker_executable) ? worker_executable : default_worker_executable();
+    pool.workers.resize(static_cast<std::size_t>(worker_count));
+
+    // Spawn eagerly so a missing worker binary is reported by open, not by the
+    // first batch.
+    for (auto &worker : pool.workers) {
+        std::string spawn_error;
+        if (!spawn_worker(pool.worker_executable, worker, spawn_error)) {
+            set_pool_error(pool, NGSPICE_FFI_ERR_INIT_FAILED, spawn_error);
+            return;
+        }
+    }
+}
+
+NgspiceBatchResult *pool_run_impl(NgspicePool &pool, const NgspiceJob *jobs, int job_count)
+{
+    if (pool.error_code != NGSPICE_FFI_SUCCESS) {
+        return make_batch_result(pool.error_code, pool.error_message);
+    }
+    if (job_count < 0 || (job_count > 0 && jobs == nullptr)) {
+        return make_batch_result(NGSPICE_FFI_ERR_INVALID_ARGUMENT, "jobs must hold job_count >= 0 entries");
+    }
+    for (int index = 0; index < job_count; ++index) {
+        if (const std::string invalid = validate_job(jobs[index], index); !invalid.empty()) {
+            return make_batch_result(NGSPICE_FFI_ERR_INVALID_ARGUMENT, invalid);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(pool.mutex);
+
+    auto *batch = make_batch_result(NGSPICE_FFI_SUCCESS, "");
+    batch->result_count = job_count;
+    batch->results = new NgspiceResult *[static_cast<std::size_t>(std::max(job_count, 1))]{};
+
+    std::atomic<int> next_job{0};
+    auto drive_worker = [&](PoolWorker &worker) {
+        for (int index = next_job.fetch_add(1); index < job_count; index = next_job.fetch_add(1)) {
+            try {
+                batch->results[index] = run_job_on_worker(pool, worker, jobs[index]);
+            } catch (const std::exception &error) {
+                batch->results[index] = make_result(NGSPICE_FFI_ERR_RUNTIME, error.what(), "", "");
+            } catch (...) {
+                batch->results[index] = make_result(NGSPICE_FFI_ERR_RUNTIME, "unexpected ngspice_ffi failure", "", "");
+            }
+        }
+    };
+
+    const std::size_t active_workers = std::min(pool.workers.size(), static_cast<std::size_t>(job_count));
+    std::vector<std::thread> threads;
+    threads.reserve(active_workers > 0 ? active_workers - 1 : 0);
+    for (std::size_t index = 1; index < active_workers; ++index) {
+        threads.emplace_back(drive_worker, std::ref(pool.workers[index]));
+    }
+    if (active_workers > 0) {
+        drive_worker(pool.workers[0]);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    return batch;
+}
+
+std::uint64_t mix_seed(std::uint64_t seed, std::uint64_t index)
+{
+    // splitmix64 finalizer: decorrelates consecutive variant indices.
+    std::uint64_t value = seed + 0x9e3779b97f4a7c15ull * (index + 1);
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+    return value ^ (value >> 31);
+}
+
+struct SweepPlan {
+    long long variant_count = 0;
+    std::vector<int> grid_parameters;
+    std::vector<std::string> vector_names;
+    std::vector<MeasureRequest> measures;
+};
+
+std::string validate_sweep(const NgspiceSweepSpec &spec, SweepPlan &plan)
+{
+    if (spec.netlist == nullptr || trim_copy(spec.netlist).empty()) {
+        return "netlist must be a non-empty string";
+    }
+    if (spec.parameter_count < 0 || (spec.parameter_count > 0 && spec.parameters == nullptr)) {
+        return "parameters must hold parameter_count >= 0 entries";
+    }
+    if (spec.measure_count <= 0 || spec.measures == nullptr) {
+        return "at least one measure is required";
+    }
+    if (spec.percentile_count < 0 || (spec.percentile_count > 0 && spec.percentiles == nullptr)) {
+        return "percentiles must hold percentile_count >= 0 entries";
+    }
+    if (spec.samples_per_point <= 0) {
+        return "samples_per_point must be >= 1";
+    }
+
+    long long variants = spec.samples_per_point;
+    for (int index = 0; index < spec.parameter_count; ++index) {
+        const auto &parameter = spec.parameters[index];
+        std::ostringstream prefix;
+        prefix << "parameters[" << index << "]";
+
+        const NgspiceParameter applied{parameter.kind, parameter.target, parameter.parameter, parameter.nominal};
+        if (std::string invalid = validate_parameters(&applied, 1); !invalid.empty()) {
+            // validate_parameters numbers its single entry 0; report the real index.
+            return invalid.replace(0, invalid.find('.'), prefix.str());
+        }
+
+        switch (parameter.distribution) {
+        case NGSPICE_DIST_FIXED:
+            break;
+        case NGSPICE_DIST_UNIFORM:
+            if (!std::isfinite(parameter.low) || !std::isfinite(parameter.high) || parameter.low > parameter.high) {
+                return prefix.str() + " needs finite low <= high for UNIFORM";
+            }
+            break;
+        case NGSPICE_DIST_GAUSSIAN:
+            if (!std::isfinite(parameter.sigma) || parameter.sigma < 0.0) {
+                return prefix.str() + " needs a finite sigma >= 0 for GAUSSIAN";
+            }
+            break;
+        case NGSPICE_DIST_GRID:
+            if (parameter.grid_values == nullptr || parameter.grid_count <= 0) {
+                return prefix.str() + " needs grid_values for GRID";
             }
+            for (int value = 0; value < parameter.grid_count; ++value) {
+                if (!std::isfinite(parameter.grid_values[value])) {
+                    return prefix.str() + ".grid_values must be finite";
+                }
+            }
+            plan.grid_parameters.push_back(index);
+            variants *= parameter.grid_count;
+            break;
+        default:
+            return prefix.str() + ".distribution is not a valid NgspiceDistribution";
+        }
+        if (variants > kMaxSweepVariants) {
+            return "sweep has too many variants";
         }
     }
+    plan.variant_count = variants;
 
-    if (vector_names.empty()) {
-        if (current_plot.empty()) {
-            return make_result(
-                NGSPICE_FFI_ERR_VECTOR_NOT_FOUND,
-                "ngspice did not expose a current plot after run",
-                ctx.stdout_log,
-                ctx.stderr_log
-            );
+    for (int index = 0; index < spec.percentile_count; ++index) {
+        if (!(spec.percentiles[index] >= 0.0 && spec.percentiles[index] <= 100.0)) {
+            return "percentiles must lie in [0, 100]";
         }
+    }
 
-        std::string mutable_plot(current_plot);
-        char **all_vectors = ngSpice_AllVecs(mutable_plot.data());
-        if (all_vectors != nullptr) {
-            for (int idx = 0; all_vectors[idx] != nullptr; ++idx) {
-                const std::string full_name(all_vectors[idx]);
-                const auto dot_index = full_name.rfind('.');
-                if (dot_index != std::string::npos && dot_index + 1 < full_name.size()) {
-                    vector_names.push_back(full_name.substr(dot_index + 1));
-                } else {
-                    vector_names.push_back(full_name);
-                }
+    std::unordered_map<std::string, std::uint32_t> vector_slots;
+    for (int index = 0; index < spec.measure_count; ++index) {
+        const auto &measure = spec.measures[index];
+        std::ostringstream prefix;
+        prefix << "measures[" << index << "]";
+        if (measure.vector == nullptr || trim_copy(measure.vector).empty()) {
+            return prefix.str() + ".vector must be a non-empty string";
+        }
+        if (measure.kind < NGSPICE_MEASURE_FINAL || measure.kind > NGSPICE_MEASURE_AT) {
+            return prefix.str() + ".kind is not a valid NgspiceMeasureKind";
+        }
+        if (measure.kind == NGSPICE_MEASURE_AT && !std::isfinite(measure.at)) {
+            return prefix.str() + ".at must be finite";
+        }
+
+        const std::string name = trim_copy(measure.vector);
+        const auto slot = vector_slots.emplace(to_lower_copy(name), static_cast<std::uint32_t>(plan.vector_names.size()));
+        if (slot.second) {
+            plan.vector_names.push_back(name);
+        }
+        plan.measures.push_back(MeasureRequest{slot.first->second, measure.kind, measure.at});
+    }
+    return "";
+}
+
+// Fills one variant's parameter values: grid coordinates come from the
+// variant's point index, random draws from a generator seeded by the variant.
+void sweep_variant_values(const NgspiceSweepSpec &spec, const SweepPlan &plan, long long variant, double *values)
+{
+    long long point = variant / spec.samples_per_point;
+    for (auto grid = plan.grid_parameters.rbegin(); grid != plan.grid_parameters.rend(); ++grid) {
+        const auto &parameter = spec.parameters[*grid];
+        values[*grid] = parameter.grid_values[point % parameter.grid_count];
+        point /= parameter.grid_count;
+    }
+
+    std::mt19937_64 generator(mix_seed(spec.seed, static_cast<std::uint64_t>(variant)));
+    for (int index = 0; index < spec.parameter_count; ++index) {
+        const auto &parameter = spec.parameters[index];
+        switch (parameter.distribution) {
+        case NGSPICE_DIST_FIXED:
+            values[index] = parameter.nominal;
+            break;
+        case NGSPICE_DIST_UNIFORM:
+            values[index] = std::uniform_real_distribution<double>(parameter.low, parameter.high)(generator);
+            break;
+        case NGSPICE_DIST_GAUSSIAN: {
+            double value = parameter.sigma > 0.0
+                ? std::normal_distribution<double>(parameter.nominal, parameter.sigma)(generator)
+                : parameter.nominal;
+            if (parameter.low < parameter.high) {
+                value = std::min(std::max(value, parameter.low), parameter.high);
             }
+            values[index] = value;
+            break;
+        }
+        default:
+            break;
         }
     }
+}
 
-    if (vector_names.empty()) {
-        return make_result(
-            NGSPICE_FFI_ERR_VECTOR_NOT_FOUND,
-            "no vectors available after simulation run",
-            ctx.stdout_log,
-            ctx.stderr_log
-        );
+// Welford accumulator; per-thread instances are merged with Chan's formula.
+struct RunningStats {
+    long long count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+
+    void add(double value)
+    {
+        ++count;
+        const double delta = value - mean;
+        mean += delta / static_cast<double>(count);
+        m2 += delta * (value - mean);
+        min = std::min(min, value);
+        max = std::max(max, value);
     }
 
-    auto *result = make_result(NGSPICE_FFI_SUCCESS, "", ctx.stdout_log, ctx.stderr_log);
-    result->vector_count = static_cast<int>(vector_names.size());
-    result->vectors = new NgspiceVector[vector_names.size()]{};
+    void merge(const RunningStats &other)
+    {
+        if (other.count == 0) {
+            return;
+        }
+        const long long total = count + other.count;
+        const double delta = other.mean - mean;
+        mean += delta * static_cast<double>(other.count) / static_cast<double>(total);
+        m2 += other.m2 + delta * delta * static_cast<double>(count) * static_cast<double>(other.count) / static_cast<double>(total);
+        count = total;
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+    }
+};
 
-    for (std::size_t index = 0; index < vector_names.size(); ++index) {
-        const std::string &requested = vector_names[index];
-        pvector_info info = get_vector_info_with_fallback(requested, current_plot);
-        if (info == nullptr) {
-            ngspice_free_result(result);
-            std::ostringstream oss;
-            oss << "requested vector not found: " << requested;
-            return make_result(NGSPICE_FFI_ERR_VECTOR_NOT_FOUND, oss.str(), ctx.stdout_log, ctx.stderr_log);
+struct SweepWorkerState {
+    std::vector<RunningStats> stats;
+    long long first_failure = -1;
+    std::string first_failure_message;
+};
+
+double percentile_of_sorted(const std::vector<double> &sorted, double percentile)
+{
+    if (sorted.empty()) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    const double position = percentile / 100.0 * static_cast<double>(sorted.size() - 1);
+    const auto lower = static_cast<std::size_t>(std::floor(position));
+    const std::size_t upper = std::min(lower + 1, sorted.size() - 1);
+    return sorted[lower] + (position - static_cast<double>(lower)) * (sorted[upper] - sorted[lower]);
+}
+
+bool within_limits(const NgspiceMeasure &measure, double value)
+{
+    return std::isfinite(value)
+        && (measure.has_lower_limit == 0 || value >= measure.lower_limit)
+        && (measure.has_upper_limit == 0 || value <= measure.upper_limit);
+}
+
+NgspiceSweepResult *make_sweep_result(int code, const std::string &message)
+{
+    auto *result = new NgspiceSweepResult{};
+    result->error_code = code;
+    result->error_message = message.empty() ? nullptr : dup_c_string(message);
+    return result;
+}
+
+void run_sweep_variant(const NgspicePool &pool,
+                       PoolWorker &worker,
+                       const NgspiceSweepSpec &spec,
+                       const SweepPlan &plan,
+                       long long variant,
+                       NgspiceSweepResult &result,
+                       SweepWorkerState &state)
+{
+    const double *values = result.parameter_values + variant * spec.parameter_count;
+    double *row = result.measurements + variant * spec.measure_count;
+
+    NgspiceResult *run = prepare_worker(pool, worker, spec.netlist);
+    if (run == nullptr) {
+        std::vector<NgspiceParameter> parameters(static_cast<std::size_t>(spec.parameter_count));
+        for (int index = 0; index < spec.parameter_count; ++index) {
+            const auto &varied = spec.parameters[index];
+            parameters[index] = NgspiceParameter{varied.kind, varied.target, varied.parameter, values[index]};
         }
 
-        const int length = info->v_length;
-        if (length <= 0) {
-            ngspice_free_result(result);
-            std::ostringstream oss;
-            oss << "vector has no samples: " << requested;
-            return make_result(NGSPICE_FFI_ERR_RUNTIME, oss.str(), ctx.stdout_log, ctx.stderr_log);
+        WireWriter request;
+        request.put_u8(kWorkerRunMeasured);
+        put_parameters(request, parameters.data(), spec.parameter_count);
+        request.put_u32(static_cast<std::uint32_t>(plan.vector_names.size()));
+        for (const auto &name : plan.vector_names) {
+            request.put_string(name.c_str());
+        }
+        request.put_u32(static_cast<std::uint32_t>(plan.measures.size()));
+        for (const auto &measure : plan.measures) {
+            request.put_u32(measure.vector_index);
+            request.put_i32(measure.kind);
+            request.put_f64(measure.at);
         }
+        run = exchange_with_worker(worker, request.bytes());
+    }
+
+    const bool measured = run->error_code == NGSPICE_FFI_SUCCESS && run->vector_count == 1
+        && run->vectors[0].length == spec.measure_count;
+    result.variant_error_codes[variant] = measured ? NGSPICE_FFI_SUCCESS
+        : (run->error_code != NGSPICE_FFI_SUCCESS ? run->error_code : NGSPICE_FFI_ERR_RUNTIME);
+    for (int index = 0; index < spec.measure_count; ++index) {
+        row[index] = measured ? run->vectors[0].data[index] : std::numeric_limits<double>::quiet_NaN();
+        if (std::isfinite(row[index])) {
+            state.stats[index].add(row[index]);
+        }
+    }
+    if (!measured) {
+        // A reply without the measurements is a failed run as well.
+        forget_netlist(worker);
+    }
+    if (!measured && (state.first_failure < 0 || variant < state.first_failure)) {
+        state.first_failure = variant;
+        state.first_failure_message = run->error_message != nullptr ? run->error_message : "measurement failed";
+    }
+    ngspice_free_result(run);
+}
 
-        auto &output = result->vectors[index];
-        output.name = dup_c_string(info->v_name != nullptr ? info->v_name : requested);
-        output.length = length;
-        output.data = new double[static_cast<std::size_t>(length)]{};
+void finish_sweep_statistics(const NgspiceSweepSpec &spec,
+                             const std::vector<SweepWorkerState> &states,
+                             NgspiceSweepResult &result)
+{
+    const long long variants = result.variant_count;
+    result.stats = new NgspiceMeasureStats[static_cast<std::size_t>(spec.measure_count)]{};
+
+    std::vector<double> column;
+    column.reserve(static_cast<std::size_t>(variants));
+    for (int measure = 0; measure < spec.measure_count; ++measure) {
+        RunningStats merged;
+        for (const auto &state : states) {
+            merged.merge(state.stats[measure]);
+        }
 
-        if (info->v_realdata != nullptr) {
-            std::memcpy(output.data, info->v_realdata, static_cast<std::size_t>(length) * sizeof(double));
-        } else if (info->v_compdata != nullptr) {
-            for (int value_index = 0; value_index < length; ++value_index) {
-                output.data[value_index] = info->v_compdata[value_index].cx_real;
+        column.clear();
+        int pass_count = 0;
+        for (long long variant = 0; variant < variants; ++variant) {
+            const double value = result.measurements[variant * spec.measure_count + measure];
+            if (std::isfinite(value)) {
+                column.push_back(value);
             }
-        } else {
-            ngspice_free_result(result);
-            std::ostringstream oss;
-            oss << "vector has no readable data: " << requested;
-            return make_result(NGSPICE_FFI_ERR_RUNTIME, oss.str(), ctx.stdout_log, ctx.stderr_log);
+            pass_count += within_limits(spec.measures[measure], value) ? 1 : 0;
+        }
+        std::sort(column.begin(), column.end());
+
+        auto &stats = result.stats[measure];
+        stats.count = static_cast<int>(merged.count);
+        stats.mean = merged.count > 0 ? merged.mean : std::numeric_limits<double>::quiet_NaN();
+        stats.stddev = merged.count > 1 ? std::sqrt(merged.m2 / static_cast<double>(merged.count - 1)) : 0.0;
+        stats.min = merged.count > 0 ? merged.min : std::numeric_limits<double>::quiet_NaN();
+        stats.max = merged.count > 0 ? merged.max : std::numeric_limits<double>::quiet_NaN();
+        stats.pass_count = pass_count;
+        stats.yield = variants > 0 ? static_cast<double>(pass_count) / static_cast<double>(variants) : 0.0;
+        if (spec.percentile_count > 0) {
+            stats.percentiles = new double[static_cast<std::size_t>(spec.percentile_count)];
+            for (int index = 0; index < spec.percentile_count; ++index) {
+                stats.percentiles[index] = percentile_of_sorted(column, spec.percentiles[index]);
+            }
+        }
+    }
+
+    int pass_count = 0;
+    for (long long variant = 0; variant < variants; ++variant) {
+        bool passes = true;
+        for (int measure = 0; measure < spec.measure_count && passes; ++measure) {
+            passes = within_limits(spec.measures[measure], result.measurements[variant * spec.measure_count + measure]);
+        }
+        pass_count += passes ? 1 : 0;
+    }
+    result.pass_count = pass_count;
+    result.yield = variants > 0 ? static_cast<double>(pass_count) / static_cast<double>(variants) : 0.0;
+}
+
+NgspiceSweepResult *pool_sweep_impl(NgspicePool &pool, const NgspiceSweepSpec &spec)
+{
+    if (pool.error_code != NGSPICE_FFI_SUCCESS) {
+        return make_sweep_result(pool.error_code, pool.error_message);
+    }
+
+    SweepPlan plan;
+    if (const std::string invalid = validate_sweep(spec, plan); !invalid.empty()) {
+        return make_sweep_result(NGSPICE_FFI_ERR_INVALID_ARGUMENT, invalid);
+    }
+
+    const long long variants = plan.variant_count;
+    auto *result = make_sweep_result(NGSPICE_FFI_SUCCESS, "");
+    result->variant_count = static_cast<int>(variants);
+    result->parameter_count = spec.parameter_count;
+    result->measure_count = spec.measure_count;
+    result->parameter_values = new double[static_cast<std::size_t>(std::max<long long>(variants * spec.parameter_count, 1))]{};
+    result->measurements = new double[static_cast<std::size_t>(variants * spec.measure_count)]{};
+    result->variant_error_codes = new int[static_cast<std::size_t>(variants)]{};
+    for (long long variant = 0; variant < variants; ++variant) {
+        sweep_variant_values(spec, plan, variant, result->parameter_values + variant * spec.parameter_count);
+    }
+
+    std::lock_guard<std::mutex> lock(pool.mutex);
+
+    const std::size_t active_workers = std::min(pool.workers.size(), static_cast<std::size_t>(variants));
+    std::vector<SweepWorkerState> states(active_workers);
+    for (auto &state : states) {
+        state.stats.resize(static_cast<std::size_t>(spec.measure_count));
+    }
+
+    std::atomic<long long> next_variant{0};
+    auto drive_worker = [&](std::size_t worker_index) {
+        auto &state = states[worker_index];
+        auto &worker = pool.workers[worker_index];
+        // The worker's circuit state is unknown after an exception, so the
+        // next variant loads the netlist again.
+        auto fail_variant = [&](long long variant, const char *message) {
+            forget_netlist(worker);
+            result->variant_error_codes[variant] = NGSPICE_FFI_ERR_RUNTIME;
+            std::fill_n(result->measurements + variant * spec.measure_count, spec.measure_count,
+                        std::numeric_limits<double>::quiet_NaN());
+            if (state.first_failure < 0 || variant < state.first_failure) {
+                state.first_failure = variant;
+                state.first_failure_message = message;
+            }
+        };
+        for (long long variant = next_variant.fetch_add(1); variant < variants; variant = next_variant.fetch_add(1)) {
+            try {
+                run_sweep_variant(pool, worker, spec, plan, variant, *result, state);
+            } catch (const std::exception &error) {
+                fail_variant(variant, error.what());
+            } catch (...) {
+                fail_variant(variant, "unexpected ngspice_ffi failure");
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(active_workers > 0 ? active_workers - 1 : 0);
+    for (std::size_t index = 1; index < active_workers; ++index) {
+        threads.emplace_back(drive_worker, index);
+    }
+    if (active_workers > 0) {
+        drive_worker(0);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (long long variant = 0; variant < variants; ++variant) {
+        result->failed_count += result->variant_error_codes[variant] != NGSPICE_FFI_SUCCESS ? 1 : 0;
+    }
+    const SweepWorkerState *first_failure = nullptr;
+    for (const auto &state : states) {
+        if (state.first_failure >= 0 && (first_failure == nullptr || state.first_failure < first_failure->first_failure)) {
+            first_failure = &state;
         }
     }
+    if (first_failure != nullptr) {
+        result->first_failure_message = dup_c_string(first_failure->first_failure_message);
+    }
 
+    finish_sweep_statistics(spec, states, *result);
     return result;
 }
 
@@ -438,17 +2998,15 @@ extern "C" void ngspice_free_result(NgspiceResult *result)
 
     if (result->vectors != nullptr) {
         for (int index = 0; index < result->vector_count; ++index) {
-            auto &vector = result->vectors[index];
-            delete[] vector.name;
-            vector.name = nullptr;
-            delete[] vector.data;
-            vector.data = nullptr;
-            vector.length = 0;
+            release_vector_buffers(result->vectors[index]);
         }
         delete[] result->vectors;
         result->vectors = nullptr;
     }
 
+    free_vector(result->scale);
+    result->scale = nullptr;
+
     delete[] result->error_message;
     result->error_message = nullptr;
     delete[] result->stdout_log;
@@ -458,3 +3016,259 @@ extern "C" void ngspice_free_result(NgspiceResult *result)
 
     delete result;
 }
+
+extern "C" NgspiceSession *ngspice_session_open(void)
+{
+    NgspiceSession *session = nullptr;
+    try {
+        session = new NgspiceSession{};
+        open_session_impl(*session);
+    } catch (const std::bad_alloc &) {
+        delete session;
+        return nullptr;
+    } catch (const std::exception &error) {
+        set_session_error(*session, NGSPICE_FFI_ERR_RUNTIME, error.what());
+    } catch (...) {
+        set_session_error(*session, NGSPICE_FFI_ERR_RUNTIME, "unexpected ngspice_ffi failure");
+    }
+    return session;
+}
+
+extern "C" int ngspice_session_error_code(const NgspiceSession *session)
+{
+    return session == nullptr ? NGSPICE_FFI_ERR_INVALID_ARGUMENT : session->error_code;
+}
+
+extern "C" const char *ngspice_session_error_message(const NgspiceSession *session)
+{
+    if (session == nullptr || session->error_message.empty()) {
+        return nullptr;
+    }
+    return session->error_message.c_str();
+}
+
+extern "C" NgspiceResult *ngspice_session_load(NgspiceSession *session, const char *netlist_text)
+{
+    try {
+        if (auto *invalid = check_session(session)) {
+            return invalid;
+        }
+        return load_session_impl(*session, netlist_text);
+    } catch (const std::exception &error) {
+        return make_result(NGSPICE_FFI_ERR_RUNTIME, error.what(), "", "");
+    } catch (...) {
+        return make_result(NGSPICE_FFI_ERR_RUNTIME, "unexpected ngspice_ffi failure", "", "");
+    }
+}
+
+extern "C" NgspiceResult *ngspice_session_run(NgspiceSession *session,
+                                               const NgspiceParameter *parameters,
+                                               int parameter_count,
+                                               const char *const *requested_vectors,
+                                               int requested_vector_count)
+{
+    try {
+        if (auto *invalid = check_session(session)) {
+            return invalid;
+        }
+        return run_session_impl(*session, parameters, parameter_count, requested_vectors, requested_vector_count);
+    } catch (const std::exception &error) {
+        return make_result(NGSPICE_FFI_ERR_RUNTIME, error.what(), "", "");
+    } catch (...) {
+        return make_result(NGSPICE_FFI_ERR_RUNTIME, "unexpected ngspice_ffi failure", "", "");
+    }
+}
+
+extern "C" NgspiceLogOptions ngspice_default_log_options(void)
+{
+    return default_log_options();
+}
+
+extern "C" int ngspice_session_set_log_options(NgspiceSession *session, const NgspiceLogOptions *options)
+{
+    if (session == nullptr) {
+        return NGSPICE_FFI_ERR_INVALID_ARGUMENT;
+    }
+    if (options != nullptr && options->capacity_bytes < 0) {
+        return NGSPICE_FFI_ERR_INVALID_ARGUMENT;
+    }
+    session->log_options = options != nullptr ? *options : default_log_options();
+    return NGSPICE_FFI_SUCCESS;
+}
+
+extern "C" NgspiceStreamOptions ngspice_default_stream_options(void)
+{
+    return default_stream_options();
+}
+
+extern "C" NgspiceResult *ngspice_session_run_streaming(NgspiceSession *session,
+                                                         const NgspiceParameter *parameters,
+                                                         int parameter_count,
+                                                         const char *const *requested_vectors,
+                                                         int requested_vector_count,
+                                                         const NgspiceStreamOptions *options)
+{
+    try {
+        if (auto *invalid = check_session(session)) {
+            return invalid;
+        }
+        return run_streaming_impl(
+            *session,
+            parameters,
+            parameter_count,
+            requested_vectors,
+            requested_vector_count,
+            options
+        );
+    } catch (const std::exception &error) {
+        return make_result(NGSPICE_FFI_ERR_RUNTIME, error.what(), "", "");
+    } catch (...) {
+        return make_result(NGSPICE_FFI_ERR_RUNTIME, "unexpected ngspice_ffi failure", "", "");
+    }
+}
+
+extern "C" void ngspice_session_close(NgspiceSession *session)
+{
+    if (session == nullptr) {
+        return;
+    }
+    try {
+        close_session_impl(*session);
+    } catch (...) {
+    }
+    delete session;
+}
+
+extern "C" NgspicePool *ngspice_pool_open(int worker_count, const char *worker_executable)
+{
+    NgspicePool *pool = nullptr;
+    try {
+        pool = new NgspicePool{};
+        open_pool_impl(*pool, worker_count, worker_executable);
+    } catch (const std::bad_alloc &) {
+        if (pool != nullptr) {
+            for (auto &worker : pool->workers) {
+                stop_worker(worker, false);
+            }
+        }
+        delete pool;
+        return nullptr;
+    } catch (const std::exception &error) {
+        set_pool_error(*pool, NGSPICE_FFI_ERR_RUNTIME, error.what());
+    } catch (...) {
+        set_pool_error(*pool, NGSPICE_FFI_ERR_RUNTIME, "unexpected ngspice_ffi failure");
+    }
+    return pool;
+}
+
+extern "C" int ngspice_pool_error_code(const NgspicePool *pool)
+{
+    return pool == nullptr ? NGSPICE_FFI_ERR_INVALID_ARGUMENT : pool->error_code;
+}
+
+extern "C" const char *ngspice_pool_error_message(const NgspicePool *pool)
+{
+    if (pool == nullptr || pool->error_message.empty()) {
+        return nullptr;
+    }
+    return pool->error_message.c_str();
+}
+
+extern "C" int ngspice_pool_worker_count(const NgspicePool *pool)
+{
+    return pool == nullptr ? 0 : static_cast<int>(pool->workers.size());
+}
+
+extern "C" NgspiceBatchResult *ngspice_pool_run(NgspicePool *pool, const NgspiceJob *jobs, int job_count)
+{
+    try {
+        if (pool == nullptr) {
+            return make_batch_result(NGSPICE_FFI_ERR_INVALID_ARGUMENT, "pool must not be NULL");
+        }
+        return pool_run_impl(*pool, jobs, job_count);
+    } catch (const std::exception &error) {
+        return make_batch_result(NGSPICE_FFI_ERR_RUNTIME, error.what());
+    } catch (...) {
+        return make_batch_result(NGSPICE_FFI_ERR_RUNTIME, "unexpected ngspice_ffi failure");
+    }
+}
+
+extern "C" void ngspice_free_batch_result(NgspiceBatchResult *result)
+{
+    if (result == nullptr) {
+        return;
+    }
+
+    if (result->results != nullptr) {
+        for (int index = 0; index < result->result_count; ++index) {
+            ngspice_free_result(result->results[index]);
+            result->results[index] = nullptr;
+        }
+        delete[] result->results;
+        result->results = nullptr;
+    }
+
+    delete[] result->error_message;
+    result->error_message = nullptr;
+
+    delete result;
+}
+
+extern "C" NgspiceSweepResult *ngspice_pool_sweep(NgspicePool *pool, const NgspiceSweepSpec *spec)
+{
+    try {
+        if (pool == nullptr || spec == nullptr) {
+            return make_sweep_result(NGSPICE_FFI_ERR_INVALID_ARGUMENT, "pool and spec must not be NULL");
+        }
+        return pool_sweep_impl(*pool, *spec);
+    } catch (const std::exception &error) {
+        return make_sweep_result(NGSPICE_FFI_ERR_RUNTIME, error.what());
+    } catch (...) {
+        return make_sweep_result(NGSPICE_FFI_ERR_RUNTIME, "unexpected ngspice_ffi failure");
+    }
+}
+
+extern "C" void ngspice_free_sweep_result(NgspiceSweepResult *result)
+{
+    if (result == nullptr) {
+        return;
+    }
+
+    if (result->stats != nullptr) {
+        for (int index = 0; index < result->measure_count; ++index) {
+            delete[] result->stats[index].percentiles;
+        }
+        delete[] result->stats;
+    }
+    delete[] result->parameter_values;
+    delete[] result->measurements;
+    delete[] result->variant_error_codes;
+    delete[] result->first_failure_message;
+    delete[] result->error_message;
+
+    delete result;
+}
+
+extern "C" void ngspice_pool_close(NgspicePool *pool)
+{
+    if (pool == nullptr) {
+        return;
+    }
+    try {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        for (auto &worker : pool->workers) {
+            stop_worker(worker, true);
+        }
+    } catch (...) {
+    }
+    delete pool;
+}
+
+extern "C" int ngspice_worker_main(int socket_fd)
+{
+    try {
+        return worker_main_impl(socket_fd);
+    } catch (...) {
+        return 1;
+    }
+}
@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+
+#include "ngspice_ffi.h"
+
+#include <cstdlib>
+
+// Spawned by ngspice_pool_open with the pool socket number as its only
+// argument; each worker process owns one independent ngspice instance.
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        return 2;
+    }
+
+    char *end = nullptr;
+    const long socket_fd = std::strtol(argv[1], &end, 10);
+    if (end == argv[1] || *end != '\0' || socket_fd < 0) {
+        return 2;
+    }
+
+    return ngspice_worker_main(static_cast<int>(socket_fd));
+}
@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: MIT
+
+// A pool worker must still run jobs after one of its jobs failed.
+//
+// A controlled ngspice exit drops the worker's parsed circuit, and the reply
+// cannot tell it apart from any other failed run, so every failed job makes
+// the worker load the netlist again for the next one. A controlled exit
+// cannot be provoked portably from a netlist; the failing job here requests a
+// vector that does not exist, which takes the same reload path.
+//
+// Usage: ngspice_ffi_pool_recovery_test <ngspice_ffi_worker>
+
+#include "ngspice_ffi.h"
+
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+const char *const kNetlist =
+    "rc low-pass pool recovery\n"
+    ".param rval=1k cval=1u\n"
+    "V1 in 0 PULSE(0 1 0 1u 1u 10m 20m)\n"
+    "R1 in out {rval}\n"
+    "C1 out 0 {cval}\n"
+    ".tran 10u 5m\n"
+    ".end\n";
+
+bool check(bool condition, const char *message)
+{
+    if (!condition) {
+        std::fprintf(stderr, "FAIL: %s\n", message);
+    }
+    return condition;
+}
+
+double final_value(const NgspiceResult *result)
+{
+    if (result == nullptr || result->error_code != NGSPICE_FFI_SUCCESS || result->vector_count < 1
+        || result->vectors[0].length < 1) {
+        return std::nan("");
+    }
+    const auto &vector = result->vectors[0];
+    return vector.data[vector.length - 1];
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <ngspice_ffi_worker>\n", argv[0]);
+        return 2;
+    }
+
+    NgspicePool *pool = ngspice_pool_open(1, argv[1]);
+    if (ngspice_pool_error_code(pool) != NGSPICE_FFI_SUCCESS) {
+        std::fprintf(stderr, "FAIL: ngspice_pool_open: %s\n", ngspice_pool_error_message(pool));
+        ngspice_pool_close(pool);
+        return 1;
+    }
+
+    const char *const good_vectors[] = {"v(out)"};
+    const char *const missing_vectors[] = {"v(missing)"};
+    const NgspiceParameter resistance = {NGSPICE_PARAM_NETLIST, "rval", nullptr, 2.0e3};
+
+    // One worker runs all three jobs in order against the same netlist.
+    NgspiceJob jobs[3] = {};
+    jobs[0].netlist = kNetlist;
+    jobs[0].requested_vectors = good_vectors;
+    jobs[0].requested_vector_count = 1;
+    jobs[1].netlist = kNetlist;
+    jobs[1].parameters = &resistance;
+    jobs[1].parameter_count = 1;
+    jobs[1].requested_vectors = missing_vectors;
+    jobs[1].requested_vector_count = 1;
+    jobs[2] = jobs[0];
+
+    NgspiceBatchResult *batch = ngspice_pool_run(pool, jobs, 3);
+    bool ok = check(batch != nullptr, "ngspice_pool_run returned NULL");
+    if (ok) {
+        ok = check(batch->result_count == 3, "expected three results");
+    }
+    if (ok) {
+        const double first = final_value(batch->results[0]);
+        const double third = final_value(batch->results[2]);
+        const NgspiceResult *after = batch->results[2];
+        ok = check(batch->results[0]->error_code == NGSPICE_FFI_SUCCESS, "first job failed") && ok;
+        ok = check(batch->results[1]->error_code != NGSPICE_FFI_SUCCESS, "job with a missing vector succeeded") && ok;
+        if (after->error_code != NGSPICE_FFI_SUCCESS) {
+            std::fprintf(
+                stderr,
+                "FAIL: job after the failure: %s\n",
+                after->error_message != nullptr ? after->error_message : "(no message)"
+            );
+            ok = false;
+        }
+        // The reload must also undo the failed job's parameter change.
+        ok = check(std::isfinite(first) && std::abs(third - first) <= 1.0e-9 * std::abs(first) + 1.0e-12,
+                   "job after the failure does not match the first run") && ok;
+    }
+
+    ngspice_free_batch_result(batch);
+    ngspice_pool_close(pool);
+    return ok ? 0 : 1;
+}
@@ -17,11 +17,29 @@ enum O3DErrorCode
     O3D_ERR_RUNTIME = 5
 };
 
+enum O3DPrimitiveMask
+{
+    O3D_PRIMITIVE_PLANE = 1,
+    O3D_PRIMITIVE_SPHERE = 2,
+    O3D_PRIMITIVE_CYLINDER = 4,
+    O3D_PRIMITIVE_CONE = 8,
+    O3D_PRIMITIVE_TORUS = 16,
+    O3D_PRIMITIVE_ALL = 31
+};
+
+// Parameter layout per type:
+//   plane:    a, b, c, d with ax + by + cz + d = 0
+//   sphere:   center xyz, radius
+//   cylinder: axis point xyz, axis direction xyz, radius
+//   cone:     apex xyz, axis direction xyz (opening side), half angle in radians
+//   torus:    center xyz, axis direction xyz, major radius, minor radius
 typedef struct O3DPrimitive
 {
     const char *type;
     float parameters[10];
     float inlier_ratio;
+    int inlier_offset;
+    int inlier_count;
 } O3DPrimitive;
 
 typedef struct O3DResult
@@ -31,13 +49,42 @@ typedef struct O3DResult
     float unassigned_points_ratio;
     int error_code;
     const char *error_message;
+    // Populated by open3d_extract_primitives_ex only: the sampled points and
+    // normals (xyz triples), and the inlier point indices of every primitive
+    // stored back to back; primitive i owns
+    // inlier_indices[inlier_offset, inlier_offset + inlier_count).
+    float *points;
+    float *normals;
+    int num_points;
+    int *inlier_indices;
+    int num_inlier_indices;
 } O3DResult;
 
+typedef struct O3DExtractOptions
+{
+    int sample_point_count;
+    float distance_threshold;
+    float normal_angle_threshold_degrees;
+    float min_inlier_ratio;
+    int min_primitive_points;
+    int max_primitives;
+    int num_iterations;
+    unsigned int primitive_mask;
+    unsigned long long seed;
+} O3DExtractOptions;
+
 O3DResult *open3d_extract_primitives(const char *input_mesh_path,
                                      float distance_threshold,
                                      int ransac_n,
                                      int num_iterations);
 
+void open3d_default_extract_options(O3DExtractOptions *options);
+
+// Octree-localized, normal-aware multi-primitive detection. Every minimal
+// sample proposes all enabled primitive types; accepted inliers are flagged
+// rather than removed, and reported as index ranges into `points`.
+O3DResult *open3d_extract_primitives_ex(const char *input_mesh_path, const O3DExtractOptions *options);
+
 void open3d_free_result(O3DResult *result);
 
 #ifdef __cplusplus
@@ -2,15 +2,20 @@
 
 #include "open3d_ffi.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
+#include <complex>
+#include <cstdint>
 #include <cstring>
 #include <exception>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <random>
 #include <string>
-#include <unordered_set>
+#include <thread>
 #include <vector>
 
 #include <open3d/Open3D.h>
@@ -22,12 +27,27 @@ constexpr std::size_t kSamplePointCount = 20000;
 constexpr std::size_t kMinPointsForPrimitive = 64;
 constexpr float kMinInlierRatio = 0.03f;
 constexpr int kMaxExtractedPrimitives = 12;
+constexpr int kHypothesesPerTask = 64;
+constexpr std::size_t kPreemptiveSampleSize = 1024;
+constexpr int kLocalityNeighbors = 256;
+constexpr std::uint64_t kRansacSeed = 0x41534147455F5253ULL;
+constexpr int kMortonBits = 21;
+constexpr int kMinSampleLevel = 1;
+constexpr int kMaxSampleLevel = 8;
+constexpr int kDetectionSampleSize = 4;
+constexpr float kDefaultNormalAngleDegrees = 20.0f;
+constexpr float kDefaultDistanceThreshold = 0.01f;
+constexpr int kDefaultNumIterations = 1000;
+constexpr double kMinConeHalfAngle = 0.035;
+constexpr double kPi = 3.14159265358979323846;
 
 enum class PrimitiveKind
 {
     plane,
     cylinder,
-    sphere
+    sphere,
+    cone,
+    torus
 };
 
 struct PrimitiveCandidate
@@ -56,6 +76,10 @@ const char *kind_name(PrimitiveKind kind)
         return "cylinder";
     case PrimitiveKind::sphere:
         return "sphere";
+    case PrimitiveKind::cone:
+        return "cone";
+    case PrimitiveKind::torus:
+        return "torus";
     default:
         return "unknown";
     }
@@ -72,234 +96,1348 @@ O3DResult *make_error_result(int code, const std::string &message)
     return result;
 }
 
-bool sample_unique_indices(int count,
-                           std::size_t upper_bound,
-                           std::mt19937_64 &rng,
-                           std::vector<std::size_t> &out_indices)
+bool fit_sphere_from_four_points(const Eigen::Vector3d &p0,
+                                 const Eigen::Vector3d &p1,
+                                 const Eigen::Vector3d &p2,
+                                 const Eigen::Vector3d &p3,
+                                 Eigen::Vector3d &center,
+                                 double &radius)
+{
+    Eigen::Matrix3d lhs;
+    Eigen::Vector3d rhs;
+    lhs.row(0) = (2.0 * (p1 - p0)).transpose();
+    lhs.row(1) = (2.0 * (p2 - p0)).transpose();
+    lhs.row(2) = (2.0 * (p3 - p0)).transpose();
+
+    rhs(0) = p1.squaredNorm() - p0.squaredNorm();
+    rhs(1) = p2.squaredNorm() - p0.squaredNorm();
+    rhs(2) = p3.squaredNorm() - p0.squaredNorm();
+
+    const double det = lhs.determinant();
+    if (!std::isfinite(det) || std::abs(det) < 1.0e-12)
+    {
+        return false;
+    }
+
+    center = lhs.colPivHouseholderQr().solve(rhs);
+    if (!center.allFinite())
+    {
+        return false;
+    }
+
+    radius = (center - p0).norm();
+    if (!std::isfinite(radius) || radius <= 1.0e-9)
+    {
+        return false;
+    }
+    return true;
+}
+
+// Structure-of-arrays copy of the active points in a seeded random order, so
+// any prefix is an unbiased subsample for preemptive scoring and the distance
+// kernels stream contiguous floats.
+struct PointSoA
+{
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    std::vector<std::size_t> source_index;
+
+    std::size_t size() const
+    {
+        return x.size();
+    }
+};
+
+PointSoA make_shuffled_soa(const std::vector<Eigen::Vector3d> &points, std::uint64_t seed)
+{
+    PointSoA soa;
+    soa.source_index.resize(points.size());
+    std::iota(soa.source_index.begin(), soa.source_index.end(), std::size_t{0});
+    std::mt19937_64 rng(seed);
+    std::shuffle(soa.source_index.begin(), soa.source_index.end(), rng);
+
+    soa.x.resize(points.size());
+    soa.y.resize(points.size());
+    soa.z.resize(points.size());
+    for (std::size_t slot = 0; slot < points.size(); ++slot)
+    {
+        const Eigen::Vector3d &point = points[soa.source_index[slot]];
+        soa.x[slot] = static_cast<float>(point.x());
+        soa.y[slot] = static_cast<float>(point.y());
+        soa.z[slot] = static_cast<float>(point.z());
+    }
+    return soa;
+}
+
+struct PlaneModel
+{
+    float a;
+    float b;
+    float c;
+    float d;
+
+    float distance(float x, float y, float z) const
+    {
+        return std::abs(a * x + b * y + c * z + d);
+    }
+
+    bool compatible(float x, float y, float z, float nx, float ny, float nz, float threshold, float min_alignment) const
+    {
+        return (distance(x, y, z) <= threshold) & (std::abs(a * nx + b * ny + c * nz) >= min_alignment);
+    }
+};
+
+struct SphereModel
+{
+    float cx;
+    float cy;
+    float cz;
+    float radius;
+
+    float distance(float x, float y, float z) const
+    {
+        const float dx = x - cx;
+        const float dy = y - cy;
+        const float dz = z - cz;
+        return std::abs(std::sqrt(dx * dx + dy * dy + dz * dz) - radius);
+    }
+
+    bool compatible(float x, float y, float z, float nx, float ny, float nz, float threshold, float min_alignment) const
+    {
+        const float dx = x - cx;
+        const float dy = y - cy;
+        const float dz = z - cz;
+        const float length = std::sqrt(dx * dx + dy * dy + dz * dz);
+        const float alignment = std::abs(dx * nx + dy * ny + dz * nz);
+        return (std::abs(length - radius) <= threshold) & (alignment >= min_alignment * length);
+    }
+};
+
+struct CylinderModel
+{
+    float px;
+    float py;
+    float pz;
+    float ax;
+    float ay;
+    float az;
+    float radius;
+
+    float distance(float x, float y, float z) const
+    {
+        const float ox = x - px;
+        const float oy = y - py;
+        const float oz = z - pz;
+        const float along = ox * ax + oy * ay + oz * az;
+        const float radial_squared = std::max(ox * ox + oy * oy + oz * oz - along * along, 0.0f);
+        return std::abs(std::sqrt(radial_squared) - radius);
+    }
+
+    bool compatible(float x, float y, float z, float nx, float ny, float nz, float threshold, float min_alignment) const
+    {
+        const float ox = x - px;
+        const float oy = y - py;
+        const float oz = z - pz;
+        const float along = ox * ax + oy * ay + oz * az;
+        const float rx = ox - along * ax;
+        const float ry = oy - along * ay;
+        const float rz = oz - along * az;
+        const float radial = std::sqrt(rx * rx + ry * ry + rz * rz);
+        const float alignment = std::abs(rx * nx + ry * ny + rz * nz);
+        return (std::abs(radial - radius) <= threshold) & (alignment >= min_alignment * radial);
+    }
+};
+
+struct ConeModel
+{
+    float apex_x;
+    float apex_y;
+    float apex_z;
+    float ax;
+    float ay;
+    float az;
+    float half_angle;
+
+    float distance(float x, float y, float z) const
+    {
+        const float vx = x - apex_x;
+        const float vy = y - apex_y;
+        const float vz = z - apex_z;
+        const float height = vx * ax + vy * ay + vz * az;
+        const float radial = std::sqrt(std::max(vx * vx + vy * vy + vz * vz - height * height, 0.0f));
+        const float cos_angle = std::cos(half_angle);
+        const float sin_angle = std::sin(half_angle);
+        return (height * cos_angle + radial * sin_angle >= 0.0f) ? std::abs(radial * cos_angle - height * sin_angle)
+                                                                 : std::sqrt(height * height + radial * radial);
+    }
+
+    bool compatible(float x, float y, float z, float nx, float ny, float nz, float threshold, float min_alignment) const
+    {
+        const float cos_angle = std::cos(half_angle);
+        const float sin_angle = std::sin(half_angle);
+        const float vx = x - apex_x;
+        const float vy = y - apex_y;
+        const float vz = z - apex_z;
+        const float height = vx * ax + vy * ay + vz * az;
+        const float rx = vx - height * ax;
+        const float ry = vy - height * ay;
+        const float rz = vz - height * az;
+        const float radial = std::sqrt(rx * rx + ry * ry + rz * rz);
+        const float along_generator = height * cos_angle + radial * sin_angle;
+        const float distance = (along_generator >= 0.0f) ? std::abs(radial * cos_angle - height * sin_angle)
+                                                         : std::sqrt(height * height + radial * radial);
+        const float inv_radial = 1.0f / std::max(radial, 1.0e-12f);
+        const float alignment = std::abs(cos_angle * inv_radial * (rx * nx + ry * ny + rz * nz) -
+                                         sin_angle * (ax * nx + ay * ny + az * nz));
+        return (distance <= threshold) & (alignment >= min_alignment);
+    }
+};
+
+struct TorusModel
+{
+    float cx;
+    float cy;
+    float cz;
+    float ax;
+    float ay;
+    float az;
+    float major_radius;
+    float minor_radius;
+
+    float distance(float x, float y, float z) const
+    {
+        const float qx = x - cx;
+        const float qy = y - cy;
+        const float qz = z - cz;
+        const float height = qx * ax + qy * ay + qz * az;
+        const float radial = std::sqrt(std::max(qx * qx + qy * qy + qz * qz - height * height, 0.0f));
+        const float offset = radial - major_radius;
+        return std::abs(std::sqrt(offset * offset + height * height) - minor_radius);
+    }
+
+    bool compatible(float x, float y, float z, float nx, float ny, float nz, float threshold, float min_alignment) const
+    {
+        const float qx = x - cx;
+        const float qy = y - cy;
+        const float qz = z - cz;
+        const float height = qx * ax + qy * ay + qz * az;
+        const float rx = qx - height * ax;
+        const float ry = qy - height * ay;
+        const float rz = qz - height * az;
+        const float radial = std::sqrt(rx * rx + ry * ry + rz * rz);
+        const float offset = radial - major_radius;
+        const float tube = std::sqrt(offset * offset + height * height);
+        const float inv_radial = 1.0f / std::max(radial, 1.0e-12f);
+        const float alignment = std::abs(offset * inv_radial * (rx * nx + ry * ny + rz * nz) +
+                                         height * (ax * nx + ay * ny + az * nz));
+        return (std::abs(tube - minor_radius) <= threshold) & (alignment >= min_alignment * tube);
+    }
+};
+
+// Branch-free inlier count over a contiguous SoA range; the model's distance
+// is inlined so the loop vectorizes.
+template <typename Model>
+std::size_t count_within(const PointSoA &soa, std::size_t begin, std::size_t end, const Model &model, float threshold)
+{
+    const float *x = soa.x.data();
+    const float *y = soa.y.data();
+    const float *z = soa.z.data();
+    std::uint32_t count = 0;
+    for (std::size_t slot = begin; slot < end; ++slot)
+    {
+        count += (model.distance(x[slot], y[slot], z[slot]) <= threshold) ? 1u : 0u;
+    }
+    return count;
+}
+
+template <typename Model>
+void collect_within(const PointSoA &soa, const Model &model, float threshold, std::vector<std::size_t> &out_inliers)
+{
+    out_inliers.clear();
+    for (std::size_t slot = 0; slot < soa.size(); ++slot)
+    {
+        if (model.distance(soa.x[slot], soa.y[slot], soa.z[slot]) <= threshold)
+        {
+            out_inliers.push_back(soa.source_index[slot]);
+        }
+    }
+    std::sort(out_inliers.begin(), out_inliers.end());
+}
+
+template <typename Visitor>
+auto visit_model(PrimitiveKind kind, const std::array<float, 10> &p, Visitor &&visitor)
+{
+    switch (kind)
+    {
+    case PrimitiveKind::sphere:
+        return visitor(SphereModel{p[0], p[1], p[2], p[3]});
+    case PrimitiveKind::cylinder:
+        return visitor(CylinderModel{p[0], p[1], p[2], p[3], p[4], p[5], p[6]});
+    case PrimitiveKind::cone:
+        return visitor(ConeModel{p[0], p[1], p[2], p[3], p[4], p[5], p[6]});
+    case PrimitiveKind::torus:
+        return visitor(TorusModel{p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]});
+    case PrimitiveKind::plane:
+    default:
+        return visitor(PlaneModel{p[0], p[1], p[2], p[3]});
+    }
+}
+
+bool make_plane_hypothesis(const std::vector<Eigen::Vector3d> &points,
+                           const std::vector<std::size_t> &sample,
+                           std::array<float, 10> &parameters)
+{
+    Eigen::Vector3d normal;
+    Eigen::Vector3d anchor = points[sample[0]];
+    if (sample.size() == 3)
+    {
+        normal = (points[sample[1]] - anchor).cross(points[sample[2]] - anchor);
+    }
+    else
+    {
+        anchor = Eigen::Vector3d::Zero();
+        for (std::size_t index : sample)
+        {
+            anchor += points[index];
+        }
+        anchor /= static_cast<double>(sample.size());
+        Eigen::Matrix3d covariance = Eigen::Matrix3d::Zero();
+        for (std::size_t index : sample)
+        {
+            const Eigen::Vector3d offset = points[index] - anchor;
+            covariance += offset * offset.transpose();
+        }
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver(covariance);
+        normal = solver.eigenvectors().col(0);
+    }
+
+    const double norm = normal.norm();
+    if (!std::isfinite(norm) || norm <= 1.0e-12)
+    {
+        return false;
+    }
+    normal /= norm;
+    parameters = {};
+    parameters[0] = static_cast<float>(normal.x());
+    parameters[1] = static_cast<float>(normal.y());
+    parameters[2] = static_cast<float>(normal.z());
+    parameters[3] = static_cast<float>(-normal.dot(anchor));
+    return true;
+}
+
+bool make_sphere_hypothesis(const std::vector<Eigen::Vector3d> &points,
+                            const std::vector<std::size_t> &sample,
+                            std::array<float, 10> &parameters)
+{
+    Eigen::Vector3d center;
+    double radius = 0.0;
+    if (!fit_sphere_from_four_points(points[sample[0]], points[sample[1]], points[sample[2]], points[sample[3]], center, radius))
+    {
+        return false;
+    }
+    parameters = {};
+    parameters[0] = static_cast<float>(center.x());
+    parameters[1] = static_cast<float>(center.y());
+    parameters[2] = static_cast<float>(center.z());
+    parameters[3] = static_cast<float>(radius);
+    return true;
+}
+
+bool make_cylinder_hypothesis(const std::vector<Eigen::Vector3d> &points,
+                              const std::vector<std::size_t> &sample,
+                              std::array<float, 10> &parameters)
+{
+    const Eigen::Vector3d &p0 = points[sample[0]];
+    const Eigen::Vector3d &p1 = points[sample[1]];
+    const Eigen::Vector3d &p2 = points[sample[2]];
+
+    Eigen::Vector3d axis = p1 - p0;
+    const double axis_norm = axis.norm();
+    if (!std::isfinite(axis_norm) || axis_norm <= 1.0e-9)
+    {
+        return false;
+    }
+    axis /= axis_norm;
+
+    const Eigen::Vector3d v = p2 - p0;
+    const double radius = (v - v.dot(axis) * axis).norm();
+    if (!std::isfinite(radius) || radius <= 1.0e-9)
+    {
+        return false;
+    }
+
+    parameters = {};
+    parameters[0] = static_cast<float>(p0.x());
+    parameters[1] = static_cast<float>(p0.y());
+    parameters[2] = static_cast<float>(p0.z());
+    parameters[3] = static_cast<float>(axis.x());
+    parameters[4] = static_cast<float>(axis.y());
+    parameters[5] = static_cast<float>(axis.z());
+    parameters[6] = static_cast<float>(radius);
+    return true;
+}
+
+struct RansacContext
+{
+    const std::vector<Eigen::Vector3d> &points;
+    const PointSoA &soa;
+    const open3d::geometry::KDTreeFlann &kdtree;
+    float distance_threshold;
+    int ransac_n;
+    int num_iterations;
+    std::uint64_t seed;
+};
+
+std::uint64_t mix_seed(std::uint64_t value)
+{
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+int sample_size_for(PrimitiveKind kind, int ransac_n)
+{
+    switch (kind)
+    {
+    case PrimitiveKind::sphere:
+        return 4;
+    case PrimitiveKind::cylinder:
+        return 3;
+    case PrimitiveKind::plane:
+    default:
+        return ransac_n;
+    }
+}
+
+// Draws a minimal sample. Local hypotheses take the remaining points from the
+// anchor's KD-tree neighbourhood, which finds small primitives far more often
+// than uniform draws; every other hypothesis stays global so large shapes are
+// still seeded from well-spread points.
+bool draw_sample(const RansacContext &context,
+                 int count,
+                 bool local,
+                 std::mt19937_64 &rng,
+                 std::vector<int> &neighbors,
+                 std::vector<double> &neighbor_distances,
+                 std::vector<std::size_t> &out_sample)
+{
+    out_sample.clear();
+    const std::size_t point_count = context.points.size();
+    if (count <= 0 || point_count < static_cast<std::size_t>(count))
+    {
+        return false;
+    }
+
+    std::uniform_int_distribution<std::size_t> uniform(0, point_count - 1);
+    const auto add_unique = [&out_sample](std::size_t index) {
+        if (std::find(out_sample.begin(), out_sample.end(), index) == out_sample.end())
+        {
+            out_sample.push_back(index);
+        }
+    };
+
+    add_unique(uniform(rng));
+    if (local)
+    {
+        const int found = context.kdtree.SearchKNN(context.points[out_sample[0]], kLocalityNeighbors, neighbors, neighbor_distances);
+        if (found > count)
+        {
+            std::uniform_int_distribution<int> pick(1, found - 1);
+            for (int attempt = 0; out_sample.size() < static_cast<std::size_t>(count) && attempt < count * 16; ++attempt)
+            {
+                add_unique(static_cast<std::size_t>(neighbors[pick(rng)]));
+            }
+        }
+    }
+    for (int attempt = 0; out_sample.size() < static_cast<std::size_t>(count) && attempt < count * 64; ++attempt)
+    {
+        add_unique(uniform(rng));
+    }
+    return out_sample.size() == static_cast<std::size_t>(count);
+}
+
+struct TaskBest
+{
+    std::size_t count = 0;
+    std::array<float, 10> parameters{};
+};
+
+// Evaluates one fixed-size chunk of hypotheses with its own derived seed. Each
+// hypothesis is first scored on the SoA prefix and abandoned when that score is
+// more than three standard deviations below what the chunk's best would give.
+TaskBest run_hypothesis_task(const RansacContext &context, PrimitiveKind kind, int task)
+{
+    TaskBest best;
+    const std::size_t point_count = context.soa.size();
+    const std::size_t preemptive_count = std::min(point_count, kPreemptiveSampleSize);
+    const int sample_size = sample_size_for(kind, context.ransac_n);
+    const int first = task * kHypothesesPerTask;
+    const int last = std::min(context.num_iterations, first + kHypothesesPerTask);
+
+    std::mt19937_64 rng(mix_seed(context.seed ^ (static_cast<std::uint64_t>(kind) << 32) ^ static_cast<std::uint64_t>(task)));
+    std::vector<int> neighbors;
+    std::vector<double> neighbor_distances;
+    std::vector<std::size_t> sample;
+    std::array<float, 10> parameters{};
+
+    for (int iteration = first; iteration < last; ++iteration)
+    {
+        if (!draw_sample(context, sample_size, (iteration % 2) == 0, rng, neighbors, neighbor_distances, sample))
+        {
+            continue;
+        }
+
+        bool valid = false;
+        switch (kind)
+        {
+        case PrimitiveKind::sphere:
+            valid = make_sphere_hypothesis(context.points, sample, parameters);
+            break;
+        case PrimitiveKind::cylinder:
+            valid = make_cylinder_hypothesis(context.points, sample, parameters);
+            break;
+        case PrimitiveKind::plane:
+        default:
+            valid = make_plane_hypothesis(context.points, sample, parameters);
+            break;
+        }
+        if (!valid)
+        {
+            continue;
+        }
+
+        const std::size_t count = visit_model(kind, parameters, [&](const auto &model) -> std::size_t {
+            const std::size_t preemptive = count_within(context.soa, 0, preemptive_count, model, context.distance_threshold);
+            if (best.count > 0 && preemptive_count < point_count)
+            {
+                const double expected = static_cast<double>(best.count) * static_cast<double>(preemptive_count) /
+                                        static_cast<double>(point_count);
+                if (static_cast<double>(preemptive) + 3.0 * std::sqrt(expected) < expected)
+                {
+                    return 0;
+                }
+            }
+            return preemptive + count_within(context.soa, preemptive_count, point_count, model, context.distance_threshold);
+        });
+
+        if (count > best.count)
+        {
+            best.count = count;
+            best.parameters = parameters;
+        }
+    }
+    return best;
+}
+
+// Runs every hypothesis chunk for plane, sphere, and cylinder on one worker
+// pool. Chunks are reduced in a fixed order, so the result depends only on the
+// seed and not on the number of threads or their scheduling.
+std::array<PrimitiveCandidate, 3> fit_candidates(const RansacContext &context)
+{
+    static constexpr PrimitiveKind kKinds[3] = {PrimitiveKind::plane, PrimitiveKind::sphere, PrimitiveKind::cylinder};
+    const int tasks_per_kind = (context.num_iterations + kHypothesesPerTask - 1) / kHypothesesPerTask;
+    const int task_count = tasks_per_kind * 3;
+    std::vector<TaskBest> results(static_cast<std::size_t>(task_count));
+
+    std::atomic<int> next_task{0};
+    const auto worker = [&]() {
+        for (int task = next_task.fetch_add(1); task < task_count; task = next_task.fetch_add(1))
+        {
+            results[static_cast<std::size_t>(task)] = run_hypothesis_task(context, kKinds[task / tasks_per_kind], task % tasks_per_kind);
+        }
+    };
+
+    const int thread_count = std::max(1, std::min(task_count, static_cast<int>(std::thread::hardware_concurrency())));
+    std::vector<std::thread> threads;
+    threads.reserve(static_cast<std::size_t>(thread_count - 1));
+    for (int index = 1; index < thread_count; ++index)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    std::array<PrimitiveCandidate, 3> candidates;
+    for (int kind_index = 0; kind_index < 3; ++kind_index)
+    {
+        PrimitiveCandidate &candidate = candidates[static_cast<std::size_t>(kind_index)];
+        candidate.kind = kKinds[kind_index];
+        const TaskBest *best = nullptr;
+        for (int task = 0; task < tasks_per_kind; ++task)
+        {
+            const TaskBest &result = results[static_cast<std::size_t>(kind_index * tasks_per_kind + task)];
+            if (result.count > 0 && (best == nullptr || result.count > best->count))
+            {
+                best = &result;
+            }
+        }
+        if (best == nullptr)
+        {
+            continue;
+        }
+
+        candidate.parameters = best->parameters;
+        visit_model(candidate.kind, candidate.parameters, [&](const auto &model) {
+            collect_within(context.soa, model, context.distance_threshold, candidate.inliers);
+        });
+        candidate.inlier_ratio = static_cast<float>(candidate.inliers.size()) / static_cast<float>(context.points.size());
+    }
+    return candidates;
+}
+
+// Sampled points with normals in Morton order. Points sharing an octree cell
+// at any level are contiguous, so localized samples are drawn from a slot
+// range found by binary search instead of an explicit tree.
+struct OrientedPointSet
+{
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    std::vector<float> nx;
+    std::vector<float> ny;
+    std::vector<float> nz;
+    std::vector<std::uint64_t> morton;
+    std::vector<std::size_t> source_index;
+
+    std::size_t size() const
+    {
+        return x.size();
+    }
+
+    Eigen::Vector3d point(std::size_t slot) const
+    {
+        return Eigen::Vector3d(x[slot], y[slot], z[slot]);
+    }
+
+    Eigen::Vector3d normal(std::size_t slot) const
+    {
+        return Eigen::Vector3d(nx[slot], ny[slot], nz[slot]);
+    }
+};
+
+std::uint64_t spread_morton_bits(std::uint64_t value)
+{
+    value &= 0x1FFFFFULL;
+    value = (value | (value << 32)) & 0x1F00000000FFFFULL;
+    value = (value | (value << 16)) & 0x1F0000FF0000FFULL;
+    value = (value | (value << 8)) & 0x100F00F00F00F00FULL;
+    value = (value | (value << 4)) & 0x10C30C30C30C30C3ULL;
+    value = (value | (value << 2)) & 0x1249249249249249ULL;
+    return value;
+}
+
+OrientedPointSet make_oriented_point_set(const open3d::geometry::PointCloud &cloud)
+{
+    const std::size_t count = cloud.points_.size();
+    Eigen::Vector3d lower = cloud.points_.front();
+    Eigen::Vector3d upper = cloud.points_.front();
+    for (const Eigen::Vector3d &point : cloud.points_)
+    {
+        lower = lower.cwiseMin(point);
+        upper = upper.cwiseMax(point);
+    }
+    const double extent = std::max((upper - lower).maxCoeff(), 1.0e-12);
+    const double scale = static_cast<double>((1ULL << kMortonBits) - 1) / extent;
+
+    std::vector<std::pair<std::uint64_t, std::size_t>> order(count);
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        const Eigen::Vector3d cell = (cloud.points_[index] - lower) * scale;
+        order[index] = {spread_morton_bits(static_cast<std::uint64_t>(cell.x())) |
+                            (spread_morton_bits(static_cast<std::uint64_t>(cell.y())) << 1) |
+                            (spread_morton_bits(static_cast<std::uint64_t>(cell.z())) << 2),
+                        index};
+    }
+    std::sort(order.begin(), order.end());
+
+    OrientedPointSet set;
+    for (auto *array : {&set.x, &set.y, &set.z, &set.nx, &set.ny, &set.nz})
+    {
+        array->resize(count);
+    }
+    set.morton.resize(count);
+    set.source_index.resize(count);
+    for (std::size_t slot = 0; slot < count; ++slot)
+    {
+        const std::size_t index = order[slot].second;
+        const Eigen::Vector3d &point = cloud.points_[index];
+        const Eigen::Vector3d normal = cloud.normals_[index].normalized();
+        set.x[slot] = static_cast<float>(point.x());
+        set.y[slot] = static_cast<float>(point.y());
+        set.z[slot] = static_cast<float>(point.z());
+        set.nx[slot] = static_cast<float>(normal.x());
+        set.ny[slot] = static_cast<float>(normal.y());
+        set.nz[slot] = static_cast<float>(normal.z());
+        set.morton[slot] = order[slot].first;
+        set.source_index[slot] = index;
+    }
+    return set;
+}
+
+std::pair<std::size_t, std::size_t> octree_cell_range(const OrientedPointSet &set, std::size_t slot, int level)
+{
+    if (level <= 0)
+    {
+        return {0, set.size()};
+    }
+    const int shift = 3 * (kMortonBits - level);
+    const std::uint64_t key = set.morton[slot] >> shift;
+    const auto begin = std::lower_bound(set.morton.begin(), set.morton.end(), key << shift);
+    const auto end = std::lower_bound(begin, set.morton.end(), (key + 1) << shift);
+    return {static_cast<std::size_t>(begin - set.morton.begin()), static_cast<std::size_t>(end - set.morton.begin())};
+}
+
+template <typename Model>
+std::size_t count_compatible(const OrientedPointSet &set,
+                             const std::uint8_t *assigned,
+                             const Model &model,
+                             float threshold,
+                             float min_alignment)
+{
+    std::uint32_t count = 0;
+    const std::size_t size = set.size();
+    for (std::size_t slot = 0; slot < size; ++slot)
+    {
+        const bool hit = model.compatible(set.x[slot], set.y[slot], set.z[slot], set.nx[slot], set.ny[slot], set.nz[slot], threshold, min_alignment);
+        count += (hit & (assigned[slot] == 0)) ? 1u : 0u;
+    }
+    return count;
+}
+
+template <typename Model>
+std::size_t count_compatible_subset(const OrientedPointSet &set,
+                                    const std::vector<std::size_t> &slots,
+                                    const Model &model,
+                                    float threshold,
+                                    float min_alignment)
+{
+    std::size_t count = 0;
+    for (std::size_t slot : slots)
+    {
+        count += model.compatible(set.x[slot], set.y[slot], set.z[slot], set.nx[slot], set.ny[slot], set.nz[slot], threshold, min_alignment)
+                     ? 1u
+                     : 0u;
+    }
+    return count;
+}
+
+bool normals_agree(const Eigen::Vector3d &expected, const Eigen::Vector3d &normal, double min_alignment)
+{
+    return std::abs(expected.dot(normal)) >= min_alignment;
+}
+
+void closest_points_between_lines(const Eigen::Vector3d &p1,
+                                  const Eigen::Vector3d &d1,
+                                  const Eigen::Vector3d &p2,
+                                  const Eigen::Vector3d &d2,
+                                  Eigen::Vector3d &out_midpoint,
+                                  bool &out_valid)
+{
+    const Eigen::Vector3d w = p1 - p2;
+    const double a = d1.dot(d1);
+    const double b = d1.dot(d2);
+    const double c = d2.dot(d2);
+    const double d = d1.dot(w);
+    const double e = d2.dot(w);
+    const double denominator = a * c - b * b;
+    out_valid = std::abs(denominator) > 1.0e-12 * a * c;
+    if (!out_valid)
+    {
+        return;
+    }
+    const double s = (b * e - c * d) / denominator;
+    const double t = (a * e - b * d) / denominator;
+    out_midpoint = 0.5 * ((p1 + s * d1) + (p2 + t * d2));
+}
+
+struct DetectionSample
+{
+    std::array<Eigen::Vector3d, kDetectionSampleSize> points;
+    std::array<Eigen::Vector3d, kDetectionSampleSize> normals;
+};
+
+bool plane_from_sample(const DetectionSample &sample, double min_alignment, std::array<float, 10> &parameters)
+{
+    Eigen::Vector3d normal = (sample.points[1] - sample.points[0]).cross(sample.points[2] - sample.points[0]);
+    const double norm = normal.norm();
+    if (!std::isfinite(norm) || norm <= 1.0e-12)
+    {
+        return false;
+    }
+    normal /= norm;
+    for (int index = 0; index < 3; ++index)
+    {
+        if (!normals_agree(normal, sample.normals[index], min_alignment))
+        {
+            return false;
+        }
+    }
+    parameters = {};
+    parameters[0] = static_cast<float>(normal.x());
+    parameters[1] = static_cast<float>(normal.y());
+    parameters[2] = static_cast<float>(normal.z());
+    parameters[3] = static_cast<float>(-normal.dot(sample.points[0]));
+    return true;
+}
+
+// Two oriented points fix a sphere; the third verifies it.
+bool sphere_from_sample(const DetectionSample &sample, double threshold, double min_alignment, std::array<float, 10> &parameters)
 {
-    out_indices.clear();
-    if (count <= 0 || upper_bound < static_cast<std::size_t>(count))
+    Eigen::Vector3d center;
+    bool valid = false;
+    closest_points_between_lines(sample.points[0], sample.normals[0], sample.points[1], sample.normals[1], center, valid);
+    if (!valid)
     {
         return false;
     }
-
-    std::unordered_set<std::size_t> seen;
-    seen.reserve(static_cast<std::size_t>(count * 2));
-    std::uniform_int_distribution<std::size_t> dist(0, upper_bound - 1);
-
-    std::size_t attempts = 0;
-    const std::size_t max_attempts = static_cast<std::size_t>(count) * 64;
-    while (out_indices.size() < static_cast<std::size_t>(count) && attempts++ < max_attempts)
+    const double radius = 0.5 * ((sample.points[0] - center).norm() + (sample.points[1] - center).norm());
+    if (!std::isfinite(radius) || radius <= 1.0e-9)
+    {
+        return false;
+    }
+    for (int index = 0; index < 3; ++index)
     {
-        const std::size_t value = dist(rng);
-        if (seen.insert(value).second)
+        const Eigen::Vector3d offset = sample.points[index] - center;
+        const double length = offset.norm();
+        if (std::abs(length - radius) > threshold || !normals_agree(offset / length, sample.normals[index], min_alignment))
         {
-            out_indices.push_back(value);
+            return false;
         }
     }
-    return out_indices.size() == static_cast<std::size_t>(count);
+    parameters = {};
+    parameters[0] = static_cast<float>(center.x());
+    parameters[1] = static_cast<float>(center.y());
+    parameters[2] = static_cast<float>(center.z());
+    parameters[3] = static_cast<float>(radius);
+    return true;
 }
 
-bool fit_sphere_from_four_points(const Eigen::Vector3d &p0,
-                                 const Eigen::Vector3d &p1,
-                                 const Eigen::Vector3d &p2,
-                                 const Eigen::Vector3d &p3,
-                                 Eigen::Vector3d &center,
-                                 double &radius)
+// The axis is perpendicular to both normals; the normal lines projected onto
+// the cross-section plane meet at the axis. The third point verifies.
+bool cylinder_from_sample(const DetectionSample &sample, double threshold, double min_alignment, std::array<float, 10> &parameters)
 {
-    Eigen::Matrix3d lhs;
-    Eigen::Vector3d rhs;
-    lhs.row(0) = (2.0 * (p1 - p0)).transpose();
-    lhs.row(1) = (2.0 * (p2 - p0)).transpose();
-    lhs.row(2) = (2.0 * (p3 - p0)).transpose();
-
-    rhs(0) = p1.squaredNorm() - p0.squaredNorm();
-    rhs(1) = p2.squaredNorm() - p0.squaredNorm();
-    rhs(2) = p3.squaredNorm() - p0.squaredNorm();
-
-    const double det = lhs.determinant();
-    if (!std::isfinite(det) || std::abs(det) < 1.0e-12)
+    Eigen::Vector3d axis = sample.normals[0].cross(sample.normals[1]);
+    const double axis_norm = axis.norm();
+    if (!std::isfinite(axis_norm) || axis_norm <= 1.0e-6)
     {
         return false;
     }
+    axis /= axis_norm;
 
-    center = lhs.colPivHouseholderQr().solve(rhs);
-    if (!center.allFinite())
+    const auto flatten = [&axis](const Eigen::Vector3d &value) { return Eigen::Vector3d(value - value.dot(axis) * axis); };
+    Eigen::Vector3d center;
+    bool valid = false;
+    closest_points_between_lines(flatten(sample.points[0]), flatten(sample.normals[0]), flatten(sample.points[1]), flatten(sample.normals[1]), center, valid);
+    if (!valid)
     {
         return false;
     }
-
-    radius = (center - p0).norm();
+    const double radius = 0.5 * ((flatten(sample.points[0]) - center).norm() + (flatten(sample.points[1]) - center).norm());
     if (!std::isfinite(radius) || radius <= 1.0e-9)
     {
         return false;
     }
+    for (int index = 0; index < 3; ++index)
+    {
+        const Eigen::Vector3d radial = flatten(sample.points[index]) - center;
+        const double length = radial.norm();
+        if (std::abs(length - radius) > threshold || !normals_agree(radial / length, sample.normals[index], min_alignment))
+        {
+            return false;
+        }
+    }
+    parameters = {};
+    parameters[0] = static_cast<float>(center.x());
+    parameters[1] = static_cast<float>(center.y());
+    parameters[2] = static_cast<float>(center.z());
+    parameters[3] = static_cast<float>(axis.x());
+    parameters[4] = static_cast<float>(axis.y());
+    parameters[5] = static_cast<float>(axis.z());
+    parameters[6] = static_cast<float>(radius);
     return true;
 }
 
-PrimitiveCandidate fit_sphere_candidate(const std::shared_ptr<open3d::geometry::PointCloud> &cloud,
-                                        float distance_threshold,
-                                        int num_iterations)
+// The apex is the common point of the three tangent planes; the unit
+// directions from the apex to the samples lie on a circle whose plane normal
+// is the axis.
+bool cone_from_sample(const DetectionSample &sample, double threshold, double min_alignment, std::array<float, 10> &parameters)
 {
-    PrimitiveCandidate best;
-    best.kind = PrimitiveKind::sphere;
+    Eigen::Matrix3d planes;
+    Eigen::Vector3d offsets;
+    for (int index = 0; index < 3; ++index)
+    {
+        planes.row(index) = sample.normals[index].transpose();
+        offsets(index) = sample.normals[index].dot(sample.points[index]);
+    }
+    if (std::abs(planes.determinant()) < 1.0e-6)
+    {
+        return false;
+    }
+    const Eigen::Vector3d apex = planes.colPivHouseholderQr().solve(offsets);
+    if (!apex.allFinite())
+    {
+        return false;
+    }
 
-    const auto &points = cloud->points_;
-    if (points.size() < 4)
+    std::array<Eigen::Vector3d, 3> directions;
+    for (int index = 0; index < 3; ++index)
+    {
+        const Eigen::Vector3d offset = sample.points[index] - apex;
+        const double length = offset.norm();
+        if (length <= 1.0e-9)
+        {
+            return false;
+        }
+        directions[static_cast<std::size_t>(index)] = offset / length;
+    }
+    Eigen::Vector3d axis = (directions[1] - directions[0]).cross(directions[2] - directions[0]);
+    const double axis_norm = axis.norm();
+    if (!std::isfinite(axis_norm) || axis_norm <= 1.0e-9)
+    {
+        return false;
+    }
+    axis /= axis_norm;
+    if (axis.dot(directions[0] + directions[1] + directions[2]) < 0.0)
     {
-        return best;
+        axis = -axis;
     }
 
-    std::mt19937_64 rng(std::random_device{}());
-    std::vector<std::size_t> sample;
+    double half_angle = 0.0;
+    for (const Eigen::Vector3d &direction : directions)
+    {
+        half_angle += std::acos(std::clamp(axis.dot(direction), -1.0, 1.0)) / 3.0;
+    }
+    if (half_angle < kMinConeHalfAngle || half_angle > 0.5 * kPi - kMinConeHalfAngle)
+    {
+        return false;
+    }
 
-    for (int iteration = 0; iteration < num_iterations; ++iteration)
+    const ConeModel model{static_cast<float>(apex.x()),
+                          static_cast<float>(apex.y()),
+                          static_cast<float>(apex.z()),
+                          static_cast<float>(axis.x()),
+                          static_cast<float>(axis.y()),
+                          static_cast<float>(axis.z()),
+                          static_cast<float>(half_angle)};
+    for (int index = 0; index < 3; ++index)
     {
-        if (!sample_unique_indices(4, points.size(), rng, sample))
+        const Eigen::Vector3d &point = sample.points[index];
+        const Eigen::Vector3d &normal = sample.normals[index];
+        if (!model.compatible(static_cast<float>(point.x()), static_cast<float>(point.y()), static_cast<float>(point.z()),
+                              static_cast<float>(normal.x()), static_cast<float>(normal.y()), static_cast<float>(normal.z()),
+                              static_cast<float>(threshold), static_cast<float>(min_alignment)))
         {
-            continue;
+            return false;
         }
+    }
 
-        Eigen::Vector3d center;
-        double radius = 0.0;
-        if (!fit_sphere_from_four_points(points[sample[0]],
-                                         points[sample[1]],
-                                         points[sample[2]],
-                                         points[sample[3]],
-                                         center,
-                                         radius))
+    parameters = {};
+    parameters[0] = model.apex_x;
+    parameters[1] = model.apex_y;
+    parameters[2] = model.apex_z;
+    parameters[3] = model.ax;
+    parameters[4] = model.ay;
+    parameters[5] = model.az;
+    parameters[6] = model.half_angle;
+    return true;
+}
+
+// Tube centers p_i - r n_i of four oriented torus points are coplanar, which
+// is a cubic in the minor radius r. Each real root gives a candidate whose
+// centre circle passes through the first three tube centers; the fourth
+// verifies it.
+bool torus_from_sample(const DetectionSample &sample, double threshold, double min_alignment, std::array<float, 10> &parameters)
+{
+    const auto coplanarity = [&sample](double r) {
+        Eigen::Matrix3d columns;
+        for (int index = 1; index < 4; ++index)
         {
-            continue;
+            columns.col(index - 1) = (sample.points[index] - sample.points[0]) - r * (sample.normals[index] - sample.normals[0]);
         }
+        return columns.determinant();
+    };
+
+    static constexpr double kNodes[4] = {0.0, 1.0, -1.0, 2.0};
+    Eigen::Matrix4d vandermonde;
+    Eigen::Vector4d values;
+    for (int row = 0; row < 4; ++row)
+    {
+        const double r = kNodes[row];
+        vandermonde.row(row) << 1.0, r, r * r, r * r * r;
+        values(row) = coplanarity(r);
+    }
+    const Eigen::Vector4d coefficients = vandermonde.fullPivLu().solve(values);
 
-        std::vector<std::size_t> inliers;
-        inliers.reserve(points.size() / 8);
-        for (std::size_t idx = 0; idx < points.size(); ++idx)
+    std::vector<double> roots;
+    const double scale = coefficients.cwiseAbs().maxCoeff();
+    if (!(scale > 0.0))
+    {
+        return false;
+    }
+    if (std::abs(coefficients(3)) > 1.0e-9 * scale)
+    {
+        Eigen::Matrix3d companion = Eigen::Matrix3d::Zero();
+        companion(1, 0) = 1.0;
+        companion(2, 1) = 1.0;
+        for (int row = 0; row < 3; ++row)
         {
-            const double radial = (points[idx] - center).norm();
-            if (std::abs(radial - radius) <= static_cast<double>(distance_threshold))
+            companion(row, 2) = -coefficients(row) / coefficients(3);
+        }
+        const Eigen::EigenSolver<Eigen::Matrix3d> solver(companion, false);
+        for (int index = 0; index < 3; ++index)
+        {
+            const std::complex<double> root = solver.eigenvalues()(index);
+            if (std::abs(root.imag()) <= 1.0e-9 * std::max(1.0, std::abs(root.real())))
             {
-                inliers.push_back(idx);
+                roots.push_back(root.real());
             }
         }
-
-        if (inliers.size() > best.inliers.size())
+    }
+    else if (std::abs(coefficients(2)) > 1.0e-9 * scale)
+    {
+        const double discriminant = coefficients(1) * coefficients(1) - 4.0 * coefficients(2) * coefficients(0);
+        if (discriminant >= 0.0)
         {
-            best.inliers = std::move(inliers);
-            best.parameters = {};
-            best.parameters[0] = static_cast<float>(center.x());
-            best.parameters[1] = static_cast<float>(center.y());
-            best.parameters[2] = static_cast<float>(center.z());
-            best.parameters[3] = static_cast<float>(radius);
-            best.inlier_ratio = static_cast<float>(best.inliers.size()) / static_cast<float>(points.size());
+            const double root = std::sqrt(discriminant);
+            roots.push_back((-coefficients(1) + root) / (2.0 * coefficients(2)));
+            roots.push_back((-coefficients(1) - root) / (2.0 * coefficients(2)));
         }
     }
 
-    return best;
+    for (double r : roots)
+    {
+        if (!std::isfinite(r) || std::abs(r) <= 1.0e-9)
+        {
+            continue;
+        }
+        std::array<Eigen::Vector3d, 4> centers;
+        for (int index = 0; index < 4; ++index)
+        {
+            centers[static_cast<std::size_t>(index)] = sample.points[index] - r * sample.normals[index];
+        }
+        const Eigen::Vector3d u = centers[1] - centers[0];
+        const Eigen::Vector3d v = centers[2] - centers[0];
+        const Eigen::Vector3d w = u.cross(v);
+        const double w_squared = w.squaredNorm();
+        if (w_squared <= 1.0e-18)
+        {
+            continue;
+        }
+        const Eigen::Vector3d center = centers[0] + (u.squaredNorm() * v.cross(w) + v.squaredNorm() * w.cross(u)) / (2.0 * w_squared);
+        const Eigen::Vector3d axis = w / std::sqrt(w_squared);
+        const double major_radius = (centers[0] - center).norm();
+        const double minor_radius = std::abs(r);
+        if (!std::isfinite(major_radius) || major_radius <= 1.0e-9)
+        {
+            continue;
+        }
+
+        const TorusModel model{static_cast<float>(center.x()),
+                               static_cast<float>(center.y()),
+                               static_cast<float>(center.z()),
+                               static_cast<float>(axis.x()),
+                               static_cast<float>(axis.y()),
+                               static_cast<float>(axis.z()),
+                               static_cast<float>(major_radius),
+                               static_cast<float>(minor_radius)};
+        bool verified = true;
+        for (int index = 0; index < 4 && verified; ++index)
+        {
+            const Eigen::Vector3d &point = sample.points[index];
+            const Eigen::Vector3d &normal = sample.normals[index];
+            verified = model.compatible(static_cast<float>(point.x()), static_cast<float>(point.y()), static_cast<float>(point.z()),
+                                        static_cast<float>(normal.x()), static_cast<float>(normal.y()), static_cast<float>(normal.z()),
+                                        static_cast<float>(threshold), static_cast<float>(min_alignment));
+        }
+        if (!verified)
+        {
+            continue;
+        }
+
+        parameters = {};
+        parameters[0] = model.cx;
+        parameters[1] = model.cy;
+        parameters[2] = model.cz;
+        parameters[3] = model.ax;
+        parameters[4] = model.ay;
+        parameters[5] = model.az;
+        parameters[6] = model.major_radius;
+        parameters[7] = model.minor_radius;
+        return true;
+    }
+    return false;
 }
 
-PrimitiveCandidate fit_cylinder_candidate(const std::shared_ptr<open3d::geometry::PointCloud> &cloud,
-                                          float distance_threshold,
-                                          int num_iterations)
+struct DetectionSettings
 {
-    PrimitiveCandidate best;
-    best.kind = PrimitiveKind::cylinder;
+    float distance_threshold;
+    float min_alignment;
+    unsigned int primitive_mask;
+    int num_iterations;
+};
 
-    const auto &points = cloud->points_;
-    if (points.size() < 3)
-    {
-        return best;
-    }
+struct DetectionRound
+{
+    const OrientedPointSet &points;
+    const std::vector<std::uint8_t> &assigned;
+    const std::vector<std::size_t> &unassigned_slots;
+    const std::vector<std::size_t> &preemptive_slots;
+    const std::array<double, kMaxSampleLevel + 1> &level_weights;
+    const DetectionSettings &settings;
+    std::uint64_t seed;
+};
 
-    std::mt19937_64 rng(std::random_device{}());
-    std::vector<std::size_t> sample;
+struct DetectedCandidate
+{
+    PrimitiveKind kind = PrimitiveKind::plane;
+    std::array<float, 10> parameters{};
+    std::size_t score = 0;
+    int level = 0;
+};
 
-    for (int iteration = 0; iteration < num_iterations; ++iteration)
+// Draws a minimal set from one octree cell at a randomly chosen level,
+// falling back to coarser cells while the chosen one has too few unassigned
+// points.
+bool draw_localized_sample(const DetectionRound &round, std::mt19937_64 &rng, DetectionSample &sample, int &out_level)
+{
+    std::uniform_int_distribution<std::size_t> pick_anchor(0, round.unassigned_slots.size() - 1);
+    std::discrete_distribution<int> pick_level(round.level_weights.begin(), round.level_weights.end());
+    const std::size_t anchor = round.unassigned_slots[pick_anchor(rng)];
+
+    std::array<std::size_t, kDetectionSampleSize> slots{};
+    for (int level = pick_level(rng); level >= 0; --level)
     {
-        if (!sample_unique_indices(3, points.size(), rng, sample))
+        const auto [begin, end] = octree_cell_range(round.points, anchor, level);
+        if (end - begin < static_cast<std::size_t>(kDetectionSampleSize) * 2)
         {
             continue;
         }
-
-        const Eigen::Vector3d &p0 = points[sample[0]];
-        const Eigen::Vector3d &p1 = points[sample[1]];
-        const Eigen::Vector3d &p2 = points[sample[2]];
-
-        Eigen::Vector3d axis = p1 - p0;
-        const double axis_norm = axis.norm();
-        if (!std::isfinite(axis_norm) || axis_norm <= 1.0e-9)
+        std::uniform_int_distribution<std::size_t> pick_slot(begin, end - 1);
+        slots[0] = anchor;
+        int filled = 1;
+        for (int attempt = 0; filled < kDetectionSampleSize && attempt < kDetectionSampleSize * 16; ++attempt)
         {
-            continue;
+            const std::size_t slot = pick_slot(rng);
+            if (round.assigned[slot] != 0 || std::find(slots.begin(), slots.begin() + filled, slot) != slots.begin() + filled)
+            {
+                continue;
+            }
+            slots[static_cast<std::size_t>(filled++)] = slot;
+        }
+        if (filled == kDetectionSampleSize)
+        {
+            for (int index = 0; index < kDetectionSampleSize; ++index)
+            {
+                sample.points[static_cast<std::size_t>(index)] = round.points.point(slots[static_cast<std::size_t>(index)]);
+                sample.normals[static_cast<std::size_t>(index)] = round.points.normal(slots[static_cast<std::size_t>(index)]);
+            }
+            out_level = level;
+            return true;
         }
-        axis /= axis_norm;
+    }
+    return false;
+}
+
+DetectedCandidate run_detection_task(const DetectionRound &round, int task)
+{
+    static constexpr PrimitiveKind kKinds[5] = {
+        PrimitiveKind::plane, PrimitiveKind::sphere, PrimitiveKind::cylinder, PrimitiveKind::cone, PrimitiveKind::torus};
+
+    DetectedCandidate best;
+    const DetectionSettings &settings = round.settings;
+    const double threshold = settings.distance_threshold;
+    const double min_alignment = settings.min_alignment;
+    const double unassigned = static_cast<double>(round.unassigned_slots.size());
+    const double preemptive_count = static_cast<double>(round.preemptive_slots.size());
+    const int first = task * kHypothesesPerTask;
+    const int last = std::min(settings.num_iterations, first + kHypothesesPerTask);
 
-        const Eigen::Vector3d v = p2 - p0;
-        const Eigen::Vector3d radial_vec = v - v.dot(axis) * axis;
-        const double radius = radial_vec.norm();
-        if (!std::isfinite(radius) || radius <= 1.0e-9)
+    std::mt19937_64 rng(mix_seed(round.seed ^ static_cast<std::uint64_t>(task)));
+    DetectionSample sample;
+    std::array<float, 10> parameters{};
+
+    for (int iteration = first; iteration < last; ++iteration)
+    {
+        int level = 0;
+        if (!draw_localized_sample(round, rng, sample, level))
         {
             continue;
         }
 
-        std::vector<std::size_t> inliers;
-        inliers.reserve(points.size() / 8);
-        for (std::size_t idx = 0; idx < points.size(); ++idx)
+        for (int kind_index = 0; kind_index < 5; ++kind_index)
         {
-            const Eigen::Vector3d offset = points[idx] - p0;
-            const Eigen::Vector3d projected = offset.dot(axis) * axis;
-            const double radial_distance = (offset - projected).norm();
-            if (std::abs(radial_distance - radius) <= static_cast<double>(distance_threshold))
+            if ((settings.primitive_mask & (1u << kind_index)) == 0)
+            {
+                continue;
+            }
+            const PrimitiveKind kind = kKinds[kind_index];
+            bool valid = false;
+            switch (kind)
+            {
+            case PrimitiveKind::plane:
+                valid = plane_from_sample(sample, min_alignment, parameters);
+                break;
+            case PrimitiveKind::sphere:
+                valid = sphere_from_sample(sample, threshold, min_alignment, parameters);
+                break;
+            case PrimitiveKind::cylinder:
+                valid = cylinder_from_sample(sample, threshold, min_alignment, parameters);
+                break;
+            case PrimitiveKind::cone:
+                valid = cone_from_sample(sample, threshold, min_alignment, parameters);
+                break;
+            case PrimitiveKind::torus:
+                valid = torus_from_sample(sample, threshold, min_alignment, parameters);
+                break;
+            }
+            if (!valid)
+            {
+                continue;
+            }
+
+            const std::size_t score = visit_model(kind, parameters, [&](const auto &model) -> std::size_t {
+                if (best.score > 0 && preemptive_count < unassigned)
+                {
+                    const double expected = static_cast<double>(best.score) * preemptive_count / unassigned;
+                    const double preemptive = static_cast<double>(count_compatible_subset(
+                        round.points, round.preemptive_slots, model, settings.distance_threshold, settings.min_alignment));
+                    if (preemptive + 3.0 * std::sqrt(expected) < expected)
+                    {
+                        return 0;
+                    }
+                }
+                return count_compatible(round.points, round.assigned.data(), model, settings.distance_threshold, settings.min_alignment);
+            });
+
+            if (score > best.score)
             {
-                inliers.push_back(idx);
+                best.kind = kind;
+                best.parameters = parameters;
+                best.score = score;
+                best.level = level;
             }
         }
+    }
+    return best;
+}
 
-        if (inliers.size() > best.inliers.size())
+DetectedCandidate detect_best_candidate(const DetectionRound &round)
+{
+    const int task_count = (round.settings.num_iterations + kHypothesesPerTask - 1) / kHypothesesPerTask;
+    std::vector<DetectedCandidate> results(static_cast<std::size_t>(task_count));
+    std::atomic<int> next_task{0};
+    const auto worker = [&]() {
+        for (int task = next_task.fetch_add(1); task < task_count; task = next_task.fetch_add(1))
         {
-            best.inliers = std::move(inliers);
-            best.parameters = {};
-            best.parameters[0] = static_cast<float>(p0.x());
-            best.parameters[1] = static_cast<float>(p0.y());
-            best.parameters[2] = static_cast<float>(p0.z());
-            best.parameters[3] = static_cast<float>(axis.x());
-            best.parameters[4] = static_cast<float>(axis.y());
-            best.parameters[5] = static_cast<float>(axis.z());
-            best.parameters[6] = static_cast<float>(radius);
-            best.inlier_ratio = static_cast<float>(best.inliers.size()) / static_cast<float>(points.size());
+            results[static_cast<std::size_t>(task)] = run_detection_task(round, task);
         }
+    };
+
+    const int thread_count = std::max(1, std::min(task_count, static_cast<int>(std::thread::hardware_concurrency())));
+    std::vector<std::thread> threads;
+    threads.reserve(static_cast<std::size_t>(thread_count - 1));
+    for (int index = 1; index < thread_count; ++index)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread &thread : threads)
+    {
+        thread.join();
     }
 
+    DetectedCandidate best;
+    for (const DetectedCandidate &result : results)
+    {
+        if (result.score > best.score)
+        {
+            best = result;
+        }
+    }
     return best;
 }
 
-PrimitiveCandidate fit_plane_candidate(const std::shared_ptr<open3d::geometry::PointCloud> &cloud,
-                                       float distance_threshold,
-                                       int ransac_n,
-                                       int num_iterations)
+struct DetectedPrimitive
 {
-    PrimitiveCandidate candidate;
-    candidate.kind = PrimitiveKind::plane;
+    PrimitiveKind kind;
+    std::array<float, 10> parameters;
+    std::vector<std::size_t> inliers;
+};
 
-    if (cloud->points_.size() < static_cast<std::size_t>(std::max(3, ransac_n)))
+// Schnabel-style loop: each round proposes candidates of every enabled type
+// from localized minimal sets, accepts the best-supported one, and flags its
+// inliers as assigned. Sampling levels that produced accepted shapes are
+// favoured in later rounds.
+std::vector<DetectedPrimitive> detect_primitives(const OrientedPointSet &points,
+                                                 const DetectionSettings &settings,
+                                                 float min_inlier_ratio,
+                                                 std::size_t min_primitive_points,
+                                                 int max_primitives,
+                                                 std::uint64_t seed,
+                                                 std::vector<std::uint8_t> &assigned)
+{
+    std::vector<DetectedPrimitive> detected;
+    assigned.assign(points.size(), 0);
+    std::array<double, kMaxSampleLevel + 1> level_weights{};
+    for (int level = kMinSampleLevel; level <= kMaxSampleLevel; ++level)
     {
-        return candidate;
+        level_weights[static_cast<std::size_t>(level)] = 1.0;
     }
 
-    auto segmentation = cloud->SegmentPlane(distance_threshold, ransac_n, num_iterations);
-    const Eigen::Vector4d model = std::get<0>(segmentation);
-    candidate.inliers = std::get<1>(segmentation);
-    candidate.parameters = {};
-    candidate.parameters[0] = static_cast<float>(model.x());
-    candidate.parameters[1] = static_cast<float>(model.y());
-    candidate.parameters[2] = static_cast<float>(model.z());
-    candidate.parameters[3] = static_cast<float>(model.w());
-
-    if (!cloud->points_.empty())
+    const std::size_t min_support =
+        std::max(min_primitive_points, static_cast<std::size_t>(std::ceil(min_inlier_ratio * static_cast<float>(points.size()))));
+    std::vector<std::size_t> unassigned_slots;
+    std::vector<std::size_t> preemptive_slots;
+    for (int round_index = 0; round_index < max_primitives; ++round_index)
     {
-        candidate.inlier_ratio = static_cast<float>(candidate.inliers.size()) /
-                                 static_cast<float>(cloud->points_.size());
+        unassigned_slots.clear();
+        for (std::size_t slot = 0; slot < points.size(); ++slot)
+        {
+            if (assigned[slot] == 0)
+            {
+                unassigned_slots.push_back(slot);
+            }
+        }
+        if (unassigned_slots.size() < std::max<std::size_t>(min_support, kDetectionSampleSize * 2))
+        {
+            break;
+        }
+
+        const std::uint64_t round_seed = mix_seed(seed + static_cast<std::uint64_t>(round_index));
+        preemptive_slots = unassigned_slots;
+        std::mt19937_64 shuffle_rng(round_seed);
+        std::shuffle(preemptive_slots.begin(), preemptive_slots.end(), shuffle_rng);
+        preemptive_slots.resize(std::min(preemptive_slots.size(), kPreemptiveSampleSize));
+
+        const DetectionRound round{points, assigned, unassigned_slots, preemptive_slots, level_weights, settings, round_seed};
+        const DetectedCandidate best = detect_best_candidate(round);
+        if (best.score < min_support)
+        {
+            break;
+        }
+
+        DetectedPrimitive primitive{best.kind, best.parameters, {}};
+        visit_model(best.kind, best.parameters, [&](const auto &model) {
+            for (std::size_t slot : unassigned_slots)
+            {
+                if (model.compatible(points.x[slot], points.y[slot], points.z[slot], points.nx[slot], points.ny[slot], points.nz[slot],
+                                     settings.distance_threshold, settings.min_alignment))
+                {
+                    assigned[slot] = 1;
+                    primitive.inliers.push_back(points.source_index[slot]);
+                }
+            }
+        });
+        std::sort(primitive.inliers.begin(), primitive.inliers.end());
+        detected.push_back(std::move(primitive));
+        level_weights[static_cast<std::size_t>(best.level)] += 1.0;
     }
-    return candidate;
+    return detected;
 }
 
 bool candidate_better(const PrimitiveCandidate &left, const PrimitiveCandidate &right)
@@ -362,18 +1500,20 @@ O3DResult *extract_impl(const char *input_mesh_path,
             break;
         }
 
-        PrimitiveCandidate plane = fit_plane_candidate(active_cloud, distance_threshold, ransac_n, num_iterations);
-        PrimitiveCandidate sphere = fit_sphere_candidate(active_cloud, distance_threshold, num_iterations);
-        PrimitiveCandidate cylinder = fit_cylinder_candidate(active_cloud, distance_threshold, num_iterations);
+        const std::uint64_t pass_seed = mix_seed(kRansacSeed + static_cast<std::uint64_t>(primitive_index));
+        const PointSoA soa = make_shuffled_soa(active_cloud->points_, pass_seed);
+        const open3d::geometry::KDTreeFlann kdtree(*active_cloud);
+        const RansacContext context{
+            active_cloud->points_, soa, kdtree, distance_threshold, ransac_n, num_iterations, pass_seed};
+        std::array<PrimitiveCandidate, 3> candidates = fit_candidates(context);
 
-        PrimitiveCandidate best = plane;
-        if (candidate_better(sphere, best))
-        {
-            best = sphere;
-        }
-        if (candidate_better(cylinder, best))
+        PrimitiveCandidate best = std::move(candidates[0]);
+        for (std::size_t index = 1; index < candidates.size(); ++index)
         {
-            best = cylinder;
+            if (candidate_better(candidates[index], best))
+            {
+                best = std::move(candidates[index]);
+            }
         }
 
         if (best.inliers.empty() || best.inlier_ratio < kMinInlierRatio)
@@ -398,7 +1538,7 @@ O3DResult *extract_impl(const char *input_mesh_path,
 
     auto *result = new O3DResult{};
     result->num_primitives = static_cast<int>(extracted.size());
-    result->primitives = new O3DPrimitive[extracted.size()];
+    result->primitives = new O3DPrimitive[extracted.size()]{};
     for (std::size_t i = 0; i < extracted.size(); ++i)
     {
         const PrimitiveCandidate &candidate = extracted[i];
@@ -420,6 +1560,129 @@ O3DResult *extract_impl(const char *input_mesh_path,
     return result;
 }
 
+O3DResult *extract_ex_impl(const char *input_mesh_path, const O3DExtractOptions &options)
+{
+    if (input_mesh_path == nullptr || input_mesh_path[0] == '\0')
+    {
+        return make_error_result(O3D_ERR_INVALID_ARGUMENT, "input_mesh_path must be non-empty");
+    }
+    if (options.sample_point_count < static_cast<int>(kDetectionSampleSize) * 2)
+    {
+        return make_error_result(O3D_ERR_INVALID_ARGUMENT, "sample_point_count is too small");
+    }
+    if (!std::isfinite(options.distance_threshold) || options.distance_threshold <= 0.0f)
+    {
+        return make_error_result(O3D_ERR_INVALID_ARGUMENT, "distance_threshold must be > 0");
+    }
+    if (!std::isfinite(options.normal_angle_threshold_degrees) || options.normal_angle_threshold_degrees <= 0.0f ||
+        options.normal_angle_threshold_degrees >= 90.0f)
+    {
+        return make_error_result(O3D_ERR_INVALID_ARGUMENT, "normal_angle_threshold_degrees must be in (0, 90)");
+    }
+    if (!std::isfinite(options.min_inlier_ratio) || options.min_inlier_ratio < 0.0f || options.min_inlier_ratio > 1.0f)
+    {
+        return make_error_result(O3D_ERR_INVALID_ARGUMENT, "min_inlier_ratio must be in [0, 1]");
+    }
+    if (options.min_primitive_points < kDetectionSampleSize || options.max_primitives < 1)
+    {
+        return make_error_result(O3D_ERR_INVALID_ARGUMENT, "min_primitive_points and max_primitives are out of range");
+    }
+    if (options.num_iterations < 16)
+    {
+        return make_error_result(O3D_ERR_INVALID_ARGUMENT, "num_iterations must be >= 16");
+    }
+    if ((options.primitive_mask & O3D_PRIMITIVE_ALL) == 0)
+    {
+        return make_error_result(O3D_ERR_INVALID_ARGUMENT, "primitive_mask must enable at least one primitive type");
+    }
+
+    open3d::geometry::TriangleMesh mesh;
+    if (!open3d::io::ReadTriangleMesh(input_mesh_path, mesh, false))
+    {
+        return make_error_result(O3D_ERR_MESH_LOAD_FAILED, "failed to load mesh");
+    }
+    if (!mesh.HasVertices() || !mesh.HasTriangles())
+    {
+        return make_error_result(O3D_ERR_MESH_LOAD_FAILED, "mesh is empty or invalid");
+    }
+
+    std::shared_ptr<open3d::geometry::PointCloud> cloud =
+        mesh.SamplePointsUniformly(static_cast<std::size_t>(options.sample_point_count), true);
+    if (!cloud || cloud->points_.empty() || !cloud->HasNormals())
+    {
+        return make_error_result(O3D_ERR_POINTCLOUD_GENERATION_FAILED, "failed to sample oriented point cloud from mesh");
+    }
+
+    const OrientedPointSet points = make_oriented_point_set(*cloud);
+    const DetectionSettings settings{
+        options.distance_threshold,
+        static_cast<float>(std::cos(static_cast<double>(options.normal_angle_threshold_degrees) * kPi / 180.0)),
+        options.primitive_mask & O3D_PRIMITIVE_ALL,
+        options.num_iterations};
+    std::vector<std::uint8_t> assigned;
+    const std::vector<DetectedPrimitive> detected = detect_primitives(points,
+                                                                      settings,
+                                                                      options.min_inlier_ratio,
+                                                                      static_cast<std::size_t>(options.min_primitive_points),
+                                                                      options.max_primitives,
+                                                                      options.seed,
+                                                                      assigned);
+    if (detected.empty())
+    {
+        return make_error_result(O3D_ERR_PRIMITIVE_FIT_TIMEOUT, "RANSAC failed to extract primitives");
+    }
+
+    const std::size_t point_count = cloud->points_.size();
+    std::size_t inlier_total = 0;
+    for (const DetectedPrimitive &primitive : detected)
+    {
+        inlier_total += primitive.inliers.size();
+    }
+
+    std::unique_ptr<O3DResult, decltype(&open3d_free_result)> result(new O3DResult{}, &open3d_free_result);
+    result->primitives = new O3DPrimitive[detected.size()]{};
+    result->num_primitives = static_cast<int>(detected.size());
+    result->points = new float[point_count * 3];
+    result->normals = new float[point_count * 3];
+    result->num_points = static_cast<int>(point_count);
+    result->inlier_indices = new int[inlier_total];
+    result->num_inlier_indices = static_cast<int>(inlier_total);
+
+    for (std::size_t index = 0; index < point_count; ++index)
+    {
+        const Eigen::Vector3d normal = cloud->normals_[index].normalized();
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            result->points[index * 3 + static_cast<std::size_t>(axis)] = static_cast<float>(cloud->points_[index](axis));
+            result->normals[index * 3 + static_cast<std::size_t>(axis)] = static_cast<float>(normal(axis));
+        }
+    }
+
+    std::size_t offset = 0;
+    for (std::size_t index = 0; index < detected.size(); ++index)
+    {
+        const DetectedPrimitive &source = detected[index];
+        O3DPrimitive &primitive = result->primitives[index];
+        primitive.type = duplicate_c_string(kind_name(source.kind));
+        for (int param_index = 0; param_index < 10; ++param_index)
+        {
+            primitive.parameters[param_index] = source.parameters[static_cast<std::size_t>(param_index)];
+        }
+        primitive.inlier_ratio = static_cast<float>(source.inliers.size()) / static_cast<float>(point_count);
+        primitive.inlier_offset = static_cast<int>(offset);
+        primitive.inlier_count = static_cast<int>(source.inliers.size());
+        for (std::size_t inlier : source.inliers)
+        {
+            result->inlier_indices[offset++] = static_cast<int>(inlier);
+        }
+    }
+
+    result->unassigned_points_ratio = static_cast<float>(point_count - inlier_total) / static_cast<float>(point_count);
+    result->error_code = O3D_SUCCESS;
+    result->error_message = nullptr;
+    return result.release();
+}
+
 } // namespace
 
 extern "C" O3DResult *open3d_extract_primitives(const char *input_mesh_path,
@@ -441,6 +1704,44 @@ extern "C" O3DResult *open3d_extract_primitives(const char *input_mesh_path,
     }
 }
 
+extern "C" void open3d_default_extract_options(O3DExtractOptions *options)
+{
+    if (options == nullptr)
+    {
+        return;
+    }
+    options->sample_point_count = static_cast<int>(kSamplePointCount);
+    options->distance_threshold = kDefaultDistanceThreshold;
+    options->normal_angle_threshold_degrees = kDefaultNormalAngleDegrees;
+    options->min_inlier_ratio = kMinInlierRatio;
+    options->min_primitive_points = static_cast<int>(kMinPointsForPrimitive);
+    options->max_primitives = kMaxExtractedPrimitives;
+    options->num_iterations = kDefaultNumIterations;
+    options->primitive_mask = O3D_PRIMITIVE_ALL;
+    options->seed = kRansacSeed;
+}
+
+extern "C" O3DResult *open3d_extract_primitives_ex(const char *input_mesh_path, const O3DExtractOptions *options)
+{
+    if (options == nullptr)
+    {
+        return make_error_result(O3D_ERR_INVALID_ARGUMENT, "options must be non-null");
+    }
+
+    try
+    {
+        return extract_ex_impl(input_mesh_path, *options);
+    }
+    catch (const std::exception &error)
+    {
+        return make_error_result(O3D_ERR_RUNTIME, std::string("unexpected Open3D failure: ") + error.what());
+    }
+    catch (...)
+    {
+        return make_error_result(O3D_ERR_RUNTIME, "unexpected non-standard exception in open3d_extract_primitives_ex");
+    }
+}
+
 extern "C" void open3d_free_result(O3DResult *result)
 {
     if (result == nullptr)
@@ -458,5 +1759,8 @@ extern "C" void open3d_free_result(O3DResult *result)
     }
 
     delete[] const_cast<char *>(result->error_message);
+    delete[] result->points;
+    delete[] result->normals;
+    delete[] result->inlier_indices;
     delete result;
 }
@@ -20,26 +20,91 @@ enum QuartetErrorCode
     QUARTET_ERR_RUNTIME = 6
 };
 
+enum
+{
+    QUARTET_QUALITY_HISTOGRAM_BINS = 10
+};
+
 typedef struct QuartetStats
 {
     int node_count;
     int tetrahedra_count;
     float worst_element_quality;
+    float mean_element_quality;
+    // Element counts per quality bin of width 1 / QUARTET_QUALITY_HISTOGRAM_BINS over [0, 1].
+    int quality_histogram[QUARTET_QUALITY_HISTOGRAM_BINS];
+    int boundary_patch_count;
 } QuartetStats;
 
+// In-memory volume mesh handed to callers that build solver meshes directly
+// instead of re-parsing an output file. Tetrahedra are positively oriented,
+// boundary triangles face outward, and boundary attributes are 1-based
+// surface patch ids separated by detected feature edges.
+typedef struct QuartetMeshData
+{
+    float *vertices;
+    int vertex_count;
+    int *tetrahedra;
+    int tetrahedra_count;
+    int *boundary_triangles;
+    int *boundary_attributes;
+    int boundary_triangle_count;
+} QuartetMeshData;
+
+typedef struct QuartetSizingRegion
+{
+    float min_corner[3];
+    float max_corner[3];
+    float target_size;
+} QuartetSizingRegion;
+
+// Target element size field used to grade the interior of the mesh. The
+// surface stays at `dx`; interior sizes grow by `grading` per unit depth up to
+// `max_size`, and are further capped by any region box or point sample (for
+// example sizes derived from a prior solution's error estimate) covering them.
+typedef struct QuartetSizingField
+{
+    float max_size;
+    float grading;
+    const QuartetSizingRegion *regions;
+    int region_count;
+    const float *sample_points;
+    const float *sample_sizes;
+    int sample_count;
+} QuartetSizingField;
+
 typedef struct QuartetResult
 {
     QuartetStats stats;
     int error_code;
     const char *error_message;
+    QuartetMeshData *mesh;
 } QuartetResult;
 
+// The output format follows the file extension: `.mesh` writes MFEM mesh
+// v1.0 with boundary attributes per feature patch, anything else writes
+// Quartet's `.tet` format.
 QuartetResult *quartet_generate_mesh(const char *input_obj_path,
                                      const char *output_tet_path,
                                      float dx,
                                      int optimize_quality,
                                      float feature_angle_threshold);
 
+QuartetResult *quartet_generate_mesh_graded(const char *input_obj_path,
+                                            const char *output_tet_path,
+                                            float dx,
+                                            int optimize_quality,
+                                            float feature_angle_threshold,
+                                            const QuartetSizingField *sizing_field);
+
+// Meshes without writing a file and returns the mesh in `result->mesh`.
+// `sizing_field` may be null for a uniform mesh.
+QuartetResult *quartet_generate_mesh_data(const char *input_obj_path,
+                                          float dx,
+                                          int optimize_quality,
+                                          float feature_angle_threshold,
+                                          const QuartetSizingField *sizing_field);
+
 void quartet_free_result(QuartetResult *result);
 
 #ifdef __cplusplus
@@ -3,20 +3,24 @@
 #include "quartet_ffi.h"
 
 #include <algorithm>
+#include <array>
+#include <cctype>
 #include <cmath>
 #include <cstddef>
 #include <cstring>
 #include <exception>
 #include <filesystem>
+#include <fstream>
 #include <limits>
+#include <memory>
 #include <new>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "feature.h"
-#include "make_signed_distance.h"
 #include "make_tet_mesh.h"
 #include "read_obj.h"
 #include "sdf.h"
@@ -36,6 +40,16 @@ constexpr float kRelativeMinDxFactor = 1.0f / 2000.0f;
 constexpr float kRelativeMaxDxFactor = 2.0f;
 constexpr int kMaxGridAxisCells = 2048;
 constexpr long long kMaxGridCellCount = 512LL * 512LL * 512LL;
+constexpr int kSdfTileSize = 8;
+constexpr int kSdfTileVolume = kSdfTileSize * kSdfTileSize * kSdfTileSize;
+constexpr int kNarrowBandCells = 4;
+constexpr int kSizingOctreeMaxDepth = 7;
+constexpr int kMaxGradingPasses = 8;
+constexpr float kGradingCollapseRatio = 0.8f;
+constexpr float kGradingMaxEdgeRatio = 1.33f;
+constexpr float kMinGradedQuality = 0.2f;
+constexpr std::size_t kMinTetsPerQualityWorker = 16384;
+constexpr float kPi = 3.14159265358979323846f;
 
 struct EdgeKey
 {
@@ -58,6 +72,29 @@ struct EdgeKeyHash
     }
 };
 
+struct FaceKey
+{
+    int a;
+    int b;
+    int c;
+
+    bool operator==(const FaceKey &other) const
+    {
+        return a == other.a && b == other.b && c == other.c;
+    }
+};
+
+struct FaceKeyHash
+{
+    std::size_t operator()(const FaceKey &face) const noexcept
+    {
+        const std::size_t h1 = static_cast<std::size_t>(face.a) * 73856093ULL;
+        const std::size_t h2 = static_cast<std::size_t>(face.b) * 19349663ULL;
+        const std::size_t h3 = static_cast<std::size_t>(face.c) * 83492791ULL;
+        return h1 ^ h2 ^ h3;
+    }
+};
+
 char *duplicate_c_string(const std::string &text)
 {
     const std::size_t size = text.size();
@@ -66,6 +103,21 @@ char *duplicate_c_string(const std::string &text)
     return copy;
 }
 
+void free_mesh_data(QuartetMeshData *mesh)
+{
+    if (!mesh)
+    {
+        return;
+    }
+    delete[] mesh->vertices;
+    delete[] mesh->tetrahedra;
+    delete[] mesh->boundary_triangles;
+    delete[] mesh->boundary_attributes;
+    delete mesh;
+}
+
+using MeshDataPtr = std::unique_ptr<QuartetMeshData, decltype(&free_mesh_data)>;
+
 QuartetResult *make_result(const QuartetStats &stats, int code, const std::string &message)
 {
     auto *result = new QuartetResult{};
@@ -215,46 +267,1283 @@ bool validate_dx(float dx, const Vec3f &bbox_min, const Vec3f &bbox_max, std::st
     return true;
 }
 
-float compute_worst_element_quality(const TetMesh &mesh)
+// Robust 2D orientation with simulation-of-simplicity tie breaking, so a ray
+// passing exactly through a shared edge or vertex is counted exactly once.
+int orientation_2d(double x1, double y1, double x2, double y2, double &twice_signed_area)
 {
-    if (mesh.tSize() == 0)
+    twice_signed_area = y1 * x2 - x1 * y2;
+    if (twice_signed_area > 0.0)
     {
-        return 0.0f;
+        return 1;
+    }
+    if (twice_signed_area < 0.0)
+    {
+        return -1;
+    }
+    if (y2 > y1)
+    {
+        return 1;
+    }
+    if (y2 < y1)
+    {
+        return -1;
+    }
+    if (x1 > x2)
+    {
+        return 1;
+    }
+    if (x1 < x2)
+    {
+        return -1;
+    }
+    return 0;
+}
+
+bool point_in_triangle_2d(double x0,
+                          double y0,
+                          double x1,
+                          double y1,
+                          double x2,
+                          double y2,
+                          double x3,
+                          double y3,
+                          double &a,
+                          double &b,
+                          double &c)
+{
+    x1 -= x0;
+    x2 -= x0;
+    x3 -= x0;
+    y1 -= y0;
+    y2 -= y0;
+    y3 -= y0;
+
+    const int sign_a = orientation_2d(x2, y2, x3, y3, a);
+    if (sign_a == 0)
+    {
+        return false;
+    }
+    const int sign_b = orientation_2d(x3, y3, x1, y1, b);
+    if (sign_b != sign_a)
+    {
+        return false;
+    }
+    const int sign_c = orientation_2d(x1, y1, x2, y2, c);
+    if (sign_c != sign_a)
+    {
+        return false;
+    }
+
+    const double sum = a + b + c;
+    if (sum == 0.0)
+    {
+        return false;
+    }
+    a /= sum;
+    b /= sum;
+    c /= sum;
+    return true;
+}
+
+float point_segment_distance(const Vec3f &x0, const Vec3f &x1, const Vec3f &x2)
+{
+    const Vec3f edge = x2 - x1;
+    const float length_squared = mag2(edge);
+    if (length_squared <= 0.0f)
+    {
+        return dist(x0, x1);
+    }
+    const float s = std::clamp(dot(x2 - x0, edge) / length_squared, 0.0f, 1.0f);
+    return dist(x0, s * x1 + (1.0f - s) * x2);
+}
+
+float point_triangle_distance(const Vec3f &x0, const Vec3f &x1, const Vec3f &x2, const Vec3f &x3)
+{
+    const Vec3f x13 = x1 - x3;
+    const Vec3f x23 = x2 - x3;
+    const Vec3f x03 = x0 - x3;
+    const float m13 = mag2(x13);
+    const float m23 = mag2(x23);
+    const float d = dot(x13, x23);
+    const float inv_det = 1.0f / std::max(m13 * m23 - d * d, 1.0e-30f);
+    const float a = dot(x13, x03);
+    const float b = dot(x23, x03);
+
+    const float w23 = inv_det * (m23 * a - d * b);
+    const float w31 = inv_det * (m13 * b - d * a);
+    const float w12 = 1.0f - w23 - w31;
+    if (w23 >= 0.0f && w31 >= 0.0f && w12 >= 0.0f)
+    {
+        return dist(x0, w23 * x1 + w31 * x2 + w12 * x3);
+    }
+    if (w23 > 0.0f)
+    {
+        return std::min(point_segment_distance(x0, x1, x2), point_segment_distance(x0, x1, x3));
+    }
+    if (w31 > 0.0f)
+    {
+        return std::min(point_segment_distance(x0, x1, x2), point_segment_distance(x0, x2, x3));
+    }
+    return std::min(point_segment_distance(x0, x1, x3), point_segment_distance(x0, x2, x3));
+}
+
+// Block-sparse signed distance field. Exact distances are stored only in
+// kSdfTileSize^3 tiles within kNarrowBandCells of the surface; every other tile
+// keeps a single inside/outside sign. Inside/outside is resolved from sorted
+// per-row ray crossings, so construction allocates no dense scratch grid and
+// its storage grows with surface area instead of bounding-box volume. This
+// bounds the build only: Quartet's make_tet_mesh takes a concrete SDF and
+// reads its dense phi, so materialize() still fills a volume-sized array.
+class NarrowBandSdf
+{
+    using RowCrossing = std::pair<std::size_t, float>;
+
+public:
+    NarrowBandSdf(const Vec3f &origin, float dx, int ni, int nj, int nk)
+        : origin_(origin),
+          dx_(dx),
+          band_distance_(static_cast<float>(kNarrowBandCells) * dx),
+          ni_(ni),
+          nj_(nj),
+          nk_(nk),
+          ti_((ni + kSdfTileSize - 1) / kSdfTileSize),
+          tj_((nj + kSdfTileSize - 1) / kSdfTileSize),
+          tk_((nk + kSdfTileSize - 1) / kSdfTileSize)
+    {
+        const std::size_t tile_count = static_cast<std::size_t>(ti_) * tj_ * tk_;
+        tile_slots_.assign(tile_count, -1);
+        tile_signs_.assign(tile_count, 1);
+    }
+
+    void build(const std::vector<Vec3i> &triangles, const std::vector<Vec3f> &vertices)
+    {
+        std::vector<Vec3f> grid_vertices;
+        grid_vertices.reserve(vertices.size());
+        for (const Vec3f &vertex : vertices)
+        {
+            grid_vertices.push_back((vertex - origin_) / dx_);
+        }
+
+        allocate_band_tiles(triangles, grid_vertices);
+        compute_band_distances(triangles, vertices, grid_vertices);
+        collect_row_crossings(triangles, grid_vertices);
+        apply_signs();
+    }
+
+    // SDF is not an interface Quartet lets us back with tiles, so the handoff
+    // expands them into phi in place without any additional scratch arrays.
+    void materialize(SDF &sdf) const
+    {
+        for (int tk = 0; tk < tk_; ++tk)
+        {
+            for (int tj = 0; tj < tj_; ++tj)
+            {
+                for (int ti = 0; ti < ti_; ++ti)
+                {
+                    const std::size_t tile = tile_index(ti, tj, tk);
+                    const int slot = tile_slots_[tile];
+                    const float far_value = static_cast<float>(tile_signs_[tile]) * band_distance_;
+                    const int i0 = ti * kSdfTileSize;
+                    const int j0 = tj * kSdfTileSize;
+                    const int k0 = tk * kSdfTileSize;
+                    for (int k = k0; k < std::min(k0 + kSdfTileSize, nk_); ++k)
+                    {
+                        for (int j = j0; j < std::min(j0 + kSdfTileSize, nj_); ++j)
+                        {
+                            for (int i = i0; i < std::min(i0 + kSdfTileSize, ni_); ++i)
+                            {
+                                sdf.phi(i, j, k) = (slot < 0)
+                                                       ? far_value
+                                                       : band_values_[static_cast<std::size_t>(slot) * kSdfTileVolume +
+                                                                      local_index(i - i0, j - j0, k - k0)];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    std::size_t tile_index(int ti, int tj, int tk) const
+    {
+        return (static_cast<std::size_t>(tk) * tj_ + tj) * ti_ + ti;
+    }
+
+    static int local_index(int li, int lj, int lk)
+    {
+        return (lk * kSdfTileSize + lj) * kSdfTileSize + li;
+    }
+
+    float *band_value(int i, int j, int k)
+    {
+        const int slot = tile_slots_[tile_index(i / kSdfTileSize, j / kSdfTileSize, k / kSdfTileSize)];
+        if (slot < 0)
+        {
+            return nullptr;
+        }
+        return &band_values_[static_cast<std::size_t>(slot) * kSdfTileVolume +
+                             local_index(i % kSdfTileSize, j % kSdfTileSize, k % kSdfTileSize)];
+    }
+
+    void triangle_node_range(const Vec3f &p,
+                             const Vec3f &q,
+                             const Vec3f &r,
+                             int lo[3],
+                             int hi[3]) const
+    {
+        const int extent[3] = {ni_, nj_, nk_};
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const float min_value = std::min({p[axis], q[axis], r[axis]});
+            const float max_value = std::max({p[axis], q[axis], r[axis]});
+            lo[axis] = std::clamp(static_cast<int>(std::floor(min_value)) - kNarrowBandCells, 0, extent[axis] - 1);
+            hi[axis] = std::clamp(static_cast<int>(std::ceil(max_value)) + kNarrowBandCells, 0, extent[axis] - 1);
+        }
+    }
+
+    void allocate_band_tiles(const std::vector<Vec3i> &triangles, const std::vector<Vec3f> &grid_vertices)
+    {
+        for (const Vec3i &triangle : triangles)
+        {
+            int lo[3];
+            int hi[3];
+            triangle_node_range(grid_vertices[triangle[0]], grid_vertices[triangle[1]], grid_vertices[triangle[2]], lo, hi);
+            for (int tk = lo[2] / kSdfTileSize; tk <= hi[2] / kSdfTileSize; ++tk)
+            {
+                for (int tj = lo[1] / kSdfTileSize; tj <= hi[1] / kSdfTileSize; ++tj)
+                {
+                    for (int ti = lo[0] / kSdfTileSize; ti <= hi[0] / kSdfTileSize; ++ti)
+                    {
+                        int &slot = tile_slots_[tile_index(ti, tj, tk)];
+                        if (slot < 0)
+                        {
+                            slot = static_cast<int>(band_tile_count_++);
+                        }
+                    }
+                }
+            }
+        }
+        band_values_.assign(band_tile_count_ * kSdfTileVolume, band_distance_);
+    }
+
+    void compute_band_distances(const std::vector<Vec3i> &triangles,
+                                const std::vector<Vec3f> &vertices,
+                                const std::vector<Vec3f> &grid_vertices)
+    {
+        for (const Vec3i &triangle : triangles)
+        {
+            const Vec3f &a = vertices[triangle[0]];
+            const Vec3f &b = vertices[triangle[1]];
+            const Vec3f &c = vertices[triangle[2]];
+            int lo[3];
+            int hi[3];
+            triangle_node_range(grid_vertices[triangle[0]], grid_vertices[triangle[1]], grid_vertices[triangle[2]], lo, hi);
+            for (int k = lo[2]; k <= hi[2]; ++k)
+            {
+                for (int j = lo[1]; j <= hi[1]; ++j)
+                {
+                    for (int i = lo[0]; i <= hi[0]; ++i)
+                    {
+                        const Vec3f position = origin_ + dx_ * Vec3f(static_cast<float>(i), static_cast<float>(j), static_cast<float>(k));
+                        float *stored = band_value(i, j, k);
+                        *stored = std::min(*stored, point_triangle_distance(position, a, b, c));
+                    }
+                }
+            }
+        }
+    }
+
+    // Records where each +x ray through a (j, k) grid row crosses the surface
+    // as (row, x) pairs sorted by row then x. Memory is proportional to the
+    // number of crossings, i.e. to surface area, rather than to the voxel count.
+    void collect_row_crossings(const std::vector<Vec3i> &triangles, const std::vector<Vec3f> &grid_vertices)
+    {
+        row_crossings_.clear();
+        for (const Vec3i &triangle : triangles)
+        {
+            const Vec3f &p = grid_vertices[triangle[0]];
+            const Vec3f &q = grid_vertices[triangle[1]];
+            const Vec3f &r = grid_vertices[triangle[2]];
+            const int j0 = std::max(static_cast<int>(std::ceil(std::min({p[1], q[1], r[1]}))), 0);
+            const int j1 = std::min(static_cast<int>(std::floor(std::max({p[1], q[1], r[1]}))), nj_ - 1);
+            const int k0 = std::max(static_cast<int>(std::ceil(std::min({p[2], q[2], r[2]}))), 0);
+            const int k1 = std::min(static_cast<int>(std::floor(std::max({p[2], q[2], r[2]}))), nk_ - 1);
+            for (int k = k0; k <= k1; ++k)
+            {
+                for (int j = j0; j <= j1; ++j)
+                {
+                    double a = 0.0;
+                    double b = 0.0;
+                    double c = 0.0;
+                    if (!point_in_triangle_2d(j, k, p[1], p[2], q[1], q[2], r[1], r[2], a, b, c))
+                    {
+                        continue;
+                    }
+                    const std::size_t row = static_cast<std::size_t>(k) * nj_ + j;
+                    row_crossings_.emplace_back(row, static_cast<float>(a * p[0] + b * q[0] + c * r[0]));
+                }
+            }
+        }
+        std::sort(row_crossings_.begin(), row_crossings_.end());
+    }
+
+    bool is_inside(int i, int j, int k) const
+    {
+        const std::size_t row = static_cast<std::size_t>(k) * nj_ + j;
+        const auto begin = std::lower_bound(row_crossings_.begin(),
+                                            row_crossings_.end(),
+                                            RowCrossing(row, -std::numeric_limits<float>::infinity()));
+        const auto end = std::upper_bound(begin, row_crossings_.end(), RowCrossing(row, static_cast<float>(i)));
+        return ((end - begin) % 2) == 1;
+    }
+
+    void apply_signs()
+    {
+        for (int tk = 0; tk < tk_; ++tk)
+        {
+            for (int tj = 0; tj < tj_; ++tj)
+            {
+                for (int ti = 0; ti < ti_; ++ti)
+                {
+                    const std::size_t tile = tile_index(ti, tj, tk);
+                    const int i0 = ti * kSdfTileSize;
+                    const int j0 = tj * kSdfTileSize;
+                    const int k0 = tk * kSdfTileSize;
+                    if (tile_slots_[tile] < 0)
+                    {
+                        tile_signs_[tile] = is_inside(i0, j0, k0) ? -1 : 1;
+                        continue;
+                    }
+
+                    for (int k = k0; k < std::min(k0 + kSdfTileSize, nk_); ++k)
+                    {
+                        for (int j = j0; j < std::min(j0 + kSdfTileSize, nj_); ++j)
+                        {
+                            for (int i = i0; i < std::min(i0 + kSdfTileSize, ni_); ++i)
+                            {
+                                if (is_inside(i, j, k))
+                                {
+                                    float *stored = band_value(i, j, k);
+                                    *stored = -*stored;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        row_crossings_.clear();
+        row_crossings_.shrink_to_fit();
+    }
+
+    Vec3f origin_;
+    float dx_;
+    float band_distance_;
+    int ni_;
+    int nj_;
+    int nk_;
+    int ti_;
+    int tj_;
+    int tk_;
+    std::size_t band_tile_count_ = 0;
+    std::vector<int> tile_slots_;
+    std::vector<signed char> tile_signs_;
+    std::vector<float> band_values_;
+    std::vector<RowCrossing> row_crossings_;
+};
+
+bool is_positive_finite(float value)
+{
+    return std::isfinite(value) && value > 0.0f;
+}
+
+bool validate_sizing_field(const QuartetSizingField &field, float dx, std::string &reason)
+{
+    if (!std::isfinite(field.max_size) || field.max_size < dx)
+    {
+        reason = "sizing max_size must be finite and at least dx";
+        return false;
+    }
+    if (!std::isfinite(field.grading) || field.grading < 0.0f)
+    {
+        reason = "sizing grading must be a finite non-negative value";
+        return false;
+    }
+    if (field.region_count < 0 || (field.region_count > 0 && field.regions == nullptr))
+    {
+        reason = "sizing regions are missing";
+        return false;
+    }
+    for (int index = 0; index < field.region_count; ++index)
+    {
+        const QuartetSizingRegion &region = field.regions[index];
+        if (!is_positive_finite(region.target_size))
+        {
+            reason = "sizing region target_size must be a finite positive value";
+            return false;
+        }
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            if (!std::isfinite(region.min_corner[axis]) || !std::isfinite(region.max_corner[axis]) ||
+                region.min_corner[axis] > region.max_corner[axis])
+            {
+                reason = "sizing region bounds are invalid";
+                return false;
+            }
+        }
+    }
+    if (field.sample_count < 0 ||
+        (field.sample_count > 0 && (field.sample_points == nullptr || field.sample_sizes == nullptr)))
+    {
+        reason = "sizing samples are missing";
+        return false;
+    }
+    for (int index = 0; index < field.sample_count; ++index)
+    {
+        if (!is_positive_finite(field.sample_sizes[index]))
+        {
+            reason = "sizing sample sizes must be finite positive values";
+            return false;
+        }
+    }
+    return true;
+}
+
+// Adaptive octree background grid holding a piecewise-constant target edge
+// length. Cells refine until they are no larger than the size they carry, so
+// resolution follows the sizing field rather than the bounding box.
+class SizingOctree
+{
+public:
+    SizingOctree(const Vec3f &bbox_min, const Vec3f &bbox_max, float min_size)
+        : min_size_(min_size)
+    {
+        const Vec3f span = bbox_max - bbox_min;
+        const float extent = std::max({span[0], span[1], span[2], min_size});
+        const Vec3f center = 0.5f * (bbox_min + bbox_max);
+        const Vec3f half(0.5f * extent, 0.5f * extent, 0.5f * extent);
+        nodes_.push_back(Node{center - half, extent, std::numeric_limits<float>::infinity(), -1, 0});
+    }
+
+    template <typename PointSize, typename BoxSize>
+    void build(PointSize point_size, BoxSize box_size)
+    {
+        for (std::size_t index = 0; index < nodes_.size(); ++index)
+        {
+            float size = box_size(nodes_[index].lo, nodes_[index].lo + Vec3f(nodes_[index].extent,
+                                                                              nodes_[index].extent,
+                                                                              nodes_[index].extent));
+            for (int corner = 0; corner < 9; ++corner)
+            {
+                const Vec3f offset = (corner == 8) ? Vec3f(0.5f, 0.5f, 0.5f)
+                                                   : Vec3f(static_cast<float>(corner & 1),
+                                                           static_cast<float>((corner >> 1) & 1),
+                                                           static_cast<float>((corner >> 2) & 1));
+                size = std::min(size, point_size(nodes_[index].lo + nodes_[index].extent * offset));
+            }
+            nodes_[index].size = std::max(size, min_size_);
+
+            if (nodes_[index].depth < kSizingOctreeMaxDepth && nodes_[index].extent > nodes_[index].size)
+            {
+                subdivide(index);
+            }
+        }
+    }
+
+    // Refines around a point sample so a prior solution's local size request
+    // does not leak across a large leaf.
+    void insert_sample(const Vec3f &point, float size)
+    {
+        size = std::max(size, min_size_);
+        std::size_t index = leaf_index(point);
+        while (nodes_[index].depth < kSizingOctreeMaxDepth && nodes_[index].extent > size)
+        {
+            subdivide(index);
+            index = child_containing(index, point);
+        }
+        nodes_[index].size = std::min(nodes_[index].size, size);
+    }
+
+    float query(const Vec3f &point) const
+    {
+        return nodes_[leaf_index(point)].size;
+    }
+
+private:
+    struct Node
+    {
+        Vec3f lo;
+        float extent;
+        float size;
+        int first_child;
+        int depth;
+    };
+
+    void subdivide(std::size_t index)
+    {
+        const int first_child = static_cast<int>(nodes_.size());
+        const Node parent = nodes_[index];
+        const float half = 0.5f * parent.extent;
+        for (int child = 0; child < 8; ++child)
+        {
+            const Vec3f offset(static_cast<float>(child & 1),
+                               static_cast<float>((child >> 1) & 1),
+                               static_cast<float>((child >> 2) & 1));
+            nodes_.push_back(Node{parent.lo + half * offset, half, parent.size, -1, parent.depth + 1});
+        }
+        nodes_[index].first_child = first_child;
+    }
+
+    std::size_t child_containing(std::size_t index, const Vec3f &point) const
+    {
+        const Node &node = nodes_[index];
+        const float half = 0.5f * node.extent;
+        int child = 0;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            if (point[axis] >= node.lo[axis] + half)
+            {
+                child |= (1 << axis);
+            }
+        }
+        return static_cast<std::size_t>(node.first_child + child);
+    }
+
+    std::size_t leaf_index(const Vec3f &point) const
+    {
+        std::size_t index = 0;
+        while (nodes_[index].first_child >= 0)
+        {
+            index = child_containing(index, point);
+        }
+        return index;
+    }
+
+    float min_size_;
+    std::vector<Node> nodes_;
+};
+
+// Turns phi, which Quartet no longer needs once it has meshed, into the depth
+// below the surface (zero outside). phi saturates at `band_distance`, so the
+// band's exact interior values seed a chamfer distance with 3x3x3 weights 1,
+// sqrt(2) and sqrt(3) cells, swept once forward and once backward through the
+// grid. That overestimates the Euclidean depth by a few percent at most.
+void fill_interior_depth(SDF &sdf, float band_distance)
+{
+    Array3f &phi = sdf.phi;
+    const float unreached = std::numeric_limits<float>::infinity();
+    std::vector<bool> outside(static_cast<std::size_t>(phi.ni) * phi.nj * phi.nk);
+    std::size_t node = 0;
+    for (int k = 0; k < phi.nk; ++k)
+    {
+        for (int j = 0; j < phi.nj; ++j)
+        {
+            for (int i = 0; i < phi.ni; ++i, ++node)
+            {
+                const float value = phi(i, j, k);
+                outside[node] = value >= 0.0f;
+                phi(i, j, k) = (value < 0.0f && -value < band_distance) ? -value : unreached;
+            }
+        }
+    }
+
+    const float weights[4] = {0.0f, sdf.dx, std::sqrt(2.0f) * sdf.dx, std::sqrt(3.0f) * sdf.dx};
+    for (int step : {1, -1})
+    {
+        for (int k = (step > 0) ? 0 : phi.nk - 1; k >= 0 && k < phi.nk; k += step)
+        {
+            for (int j = (step > 0) ? 0 : phi.nj - 1; j >= 0 && j < phi.nj; j += step)
+            {
+                for (int i = (step > 0) ? 0 : phi.ni - 1; i >= 0 && i < phi.ni; i += step)
+                {
+                    float depth = phi(i, j, k);
+                    for (int dk = -1; dk <= 1; ++dk)
+                    {
+                        for (int dj = -1; dj <= 1; ++dj)
+                        {
+                            for (int di = -1; di <= 1; ++di)
+                            {
+                                // Only neighbours this sweep has already visited.
+                                const int order = (dk != 0) ? dk : ((dj != 0) ? dj : di);
+                                const int ui = i + di;
+                                const int uj = j + dj;
+                                const int uk = k + dk;
+                                if (order != -step || ui < 0 || uj < 0 || uk < 0 || ui >= phi.ni || uj >= phi.nj ||
+                                    uk >= phi.nk)
+                                {
+                                    continue;
+                                }
+                                depth = std::min(depth, phi(ui, uj, uk) + weights[std::abs(di) + std::abs(dj) + std::abs(dk)]);
+                            }
+                        }
+                    }
+                    phi(i, j, k) = depth;
+                }
+            }
+        }
     }
 
-    float worst_quality = std::numeric_limits<float>::infinity();
-    for (std::size_t index = 0; index < mesh.tSize(); ++index)
+    node = 0;
+    for (int k = 0; k < phi.nk; ++k)
     {
-        const Tet tet = mesh.getTet(static_cast<int>(index));
-        const float quality = compute_tet_quality(tet);
-        if (!std::isfinite(quality))
+        for (int j = 0; j < phi.nj; ++j)
         {
-            return 0.0f;
+            for (int i = 0; i < phi.ni; ++i, ++node)
+            {
+                if (outside[node])
+                {
+                    phi(i, j, k) = 0.0f;
+                }
+            }
         }
-        worst_quality = std::min(worst_quality, quality);
     }
+}
+
+// Expects phi to hold interior depth (see fill_interior_depth).
+SizingOctree build_sizing_octree(const QuartetSizingField &field,
+                                 const SDF &sdf,
+                                 const Vec3f &bbox_min,
+                                 const Vec3f &bbox_max)
+{
+    const float dx = sdf.dx;
+    const int extent[3] = {sdf.phi.ni, sdf.phi.nj, sdf.phi.nk};
+    const auto depth_size = [&](const Vec3f &point) {
+        int node[3];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const float grid = (point[axis] - sdf.origin[axis]) / dx;
+            node[axis] = std::clamp(static_cast<int>(std::lround(grid)), 0, extent[axis] - 1);
+        }
+        return std::min(field.max_size, dx + field.grading * sdf.phi(node[0], node[1], node[2]));
+    };
+    const auto region_size = [&](const Vec3f &lo, const Vec3f &hi) {
+        float size = field.max_size;
+        for (int index = 0; index < field.region_count; ++index)
+        {
+            const QuartetSizingRegion &region = field.regions[index];
+            bool overlaps = true;
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                overlaps = overlaps && lo[axis] <= region.max_corner[axis] && hi[axis] >= region.min_corner[axis];
+            }
+            if (overlaps)
+            {
+                size = std::min(size, region.target_size);
+            }
+        }
+        return size;
+    };
+
+    SizingOctree octree(bbox_min, bbox_max, dx);
+    octree.build(depth_size, region_size);
+    for (int index = 0; index < field.sample_count; ++index)
+    {
+        const float *point = field.sample_points + 3 * static_cast<std::ptrdiff_t>(index);
+        octree.insert_sample(Vec3f(point[0], point[1], point[2]), field.sample_sizes[index]);
+    }
+    return octree;
+}
+
+float signed_tet_volume(const Vec3f &p0, const Vec3f &p1, const Vec3f &p2, const Vec3f &p3)
+{
+    return dot(p1 - p0, cross(p2 - p0, p3 - p0)) / 6.0f;
+}
 
-    if (!std::isfinite(worst_quality))
+// Mean-ratio shape quality: 1 for a regular tetrahedron, 0 when degenerate.
+float tet_shape_quality(const Vec3f &p0, const Vec3f &p1, const Vec3f &p2, const Vec3f &p3)
+{
+    const float edge_length_sum = mag2(p1 - p0) + mag2(p2 - p0) + mag2(p3 - p0) + mag2(p2 - p1) +
+                                  mag2(p3 - p1) + mag2(p3 - p2);
+    if (edge_length_sum <= 0.0f)
     {
         return 0.0f;
     }
-    return worst_quality;
+    const float volume = std::abs(signed_tet_volume(p0, p1, p2, p3));
+    return 12.0f * std::cbrt(9.0f * volume * volume) / edge_length_sum;
+}
+
+// Coarsens the uniform Quartet lattice toward the sizing field by collapsing
+// short interior edges. Boundary vertices never move, so the surface and any
+// detected features keep their `dx` resolution; a collapse is rejected if it
+// would invert a tetrahedron, lower quality below kMinGradedQuality (or the
+// local worst, if that is already lower), or create an edge longer than
+// kGradingMaxEdgeRatio times the local target size.
+void grade_tet_mesh(TetMesh &mesh, const SizingOctree &octree)
+{
+    std::vector<Vec3f> vertices(mesh.vSize());
+    for (std::size_t index = 0; index < vertices.size(); ++index)
+    {
+        vertices[index] = mesh.V(static_cast<int>(index));
+    }
+    std::vector<Vec4i> tets(mesh.tSize());
+    for (std::size_t index = 0; index < tets.size(); ++index)
+    {
+        tets[index] = mesh.T(static_cast<int>(index));
+    }
+
+    std::vector<char> boundary(vertices.size(), 0);
+    {
+        std::unordered_map<FaceKey, int, FaceKeyHash> face_counts;
+        face_counts.reserve(tets.size() * 2);
+        for (const Vec4i &tet : tets)
+        {
+            for (int skip = 0; skip < 4; ++skip)
+            {
+                int face[3];
+                int cursor = 0;
+                for (int corner = 0; corner < 4; ++corner)
+                {
+                    if (corner != skip)
+                    {
+                        face[cursor++] = tet[corner];
+                    }
+                }
+                std::sort(face, face + 3);
+                ++face_counts[FaceKey{face[0], face[1], face[2]}];
+            }
+        }
+        for (const auto &entry : face_counts)
+        {
+            if (entry.second == 1)
+            {
+                boundary[entry.first.a] = 1;
+                boundary[entry.first.b] = 1;
+                boundary[entry.first.c] = 1;
+            }
+        }
+    }
+
+    std::vector<std::vector<int>> incident(vertices.size());
+    for (std::size_t index = 0; index < tets.size(); ++index)
+    {
+        for (int corner = 0; corner < 4; ++corner)
+        {
+            incident[tets[index][corner]].push_back(static_cast<int>(index));
+        }
+    }
+
+    std::vector<char> tet_alive(tets.size(), 1);
+    const auto target_size = [&](int a, int b) {
+        return octree.query(0.5f * (vertices[a] + vertices[b]));
+    };
+
+    struct Candidate
+    {
+        float ratio;
+        int from;
+        int to;
+    };
+
+    for (int pass = 0; pass < kMaxGradingPasses; ++pass)
+    {
+        std::vector<Candidate> candidates;
+        for (std::size_t index = 0; index < tets.size(); ++index)
+        {
+            if (!tet_alive[index])
+            {
+                continue;
+            }
+            const Vec4i &tet = tets[index];
+            for (int first = 0; first < 4; ++first)
+            {
+                for (int second = first + 1; second < 4; ++second)
+                {
+                    int a = tet[first];
+                    int b = tet[second];
+                    if (a > b)
+                    {
+                        std::swap(a, b);
+                    }
+                    if (boundary[a] && boundary[b])
+                    {
+                        continue;
+                    }
+                    const float ratio = dist(vertices[a], vertices[b]) / target_size(a, b);
+                    if (ratio >= kGradingCollapseRatio)
+                    {
+                        continue;
+                    }
+                    if (boundary[a])
+                    {
+                        candidates.push_back(Candidate{ratio, b, a});
+                    }
+                    else
+                    {
+                        candidates.push_back(Candidate{ratio, a, b});
+                    }
+                }
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [](const Candidate &lhs, const Candidate &rhs) {
+            if (lhs.ratio != rhs.ratio)
+            {
+                return lhs.ratio < rhs.ratio;
+            }
+            return lhs.from != rhs.from ? lhs.from < rhs.from : lhs.to < rhs.to;
+        });
+
+        std::vector<char> locked(vertices.size(), 0);
+        int collapsed = 0;
+        for (const Candidate &candidate : candidates)
+        {
+            const int from = candidate.from;
+            const int to = candidate.to;
+            if (locked[from] || locked[to] || incident[from].empty())
+            {
+                continue;
+            }
+
+            float local_worst = 1.0f;
+            for (int tet_index : incident[from])
+            {
+                const Vec4i &tet = tets[tet_index];
+                local_worst = std::min(local_worst,
+                                       tet_shape_quality(vertices[tet[0]], vertices[tet[1]], vertices[tet[2]], vertices[tet[3]]));
+            }
+            const float quality_floor = std::min(kMinGradedQuality, local_worst);
+
+            bool shares_edge = false;
+            bool acceptable = true;
+            for (int tet_index : incident[from])
+            {
+                const Vec4i &tet = tets[tet_index];
+                if (tet[0] == to || tet[1] == to || tet[2] == to || tet[3] == to)
+                {
+                    shares_edge = true;
+                    continue;
+                }
+                Vec3f moved[4];
+                for (int corner = 0; corner < 4; ++corner)
+                {
+                    moved[corner] = vertices[tet[corner] == from ? to : tet[corner]];
+                }
+                const float before = signed_tet_volume(vertices[tet[0]], vertices[tet[1]], vertices[tet[2]], vertices[tet[3]]);
+                const float after = signed_tet_volume(moved[0], moved[1], moved[2], moved[3]);
+                if ((before > 0.0f) != (after > 0.0f) || after == 0.0f ||
+                    tet_shape_quality(moved[0], moved[1], moved[2], moved[3]) < quality_floor)
+                {
+                    acceptable = false;
+                    break;
+                }
+                for (int corner = 0; corner < 4; ++corner)
+                {
+                    const int other = tet[corner];
+                    if (other != from &&
+                        dist(vertices[to], vertices[other]) > kGradingMaxEdgeRatio * target_size(to, other))
+                    {
+                        acceptable = false;
+                        break;
+                    }
+                }
+                if (!acceptable)
+                {
+                    break;
+                }
+            }
+            if (!shares_edge || !acceptable)
+            {
+                continue;
+            }
+
+            const std::vector<int> affected = std::move(incident[from]);
+            incident[from].clear();
+            for (int tet_index : affected)
+            {
+                Vec4i &tet = tets[tet_index];
+                for (int corner = 0; corner < 4; ++corner)
+                {
+                    locked[tet[corner]] = 1;
+                }
+                if (tet[0] == to || tet[1] == to || tet[2] == to || tet[3] == to)
+                {
+                    tet_alive[tet_index] = 0;
+                    for (int corner = 0; corner < 4; ++corner)
+                    {
+                        std::vector<int> &list = incident[tet[corner]];
+                        list.erase(std::remove(list.begin(), list.end(), tet_index), list.end());
+                    }
+                    continue;
+                }
+                for (int corner = 0; corner < 4; ++corner)
+                {
+                    if (tet[corner] == from)
+                    {
+                        tet[corner] = to;
+                    }
+                }
+                incident[to].push_back(tet_index);
+            }
+            ++collapsed;
+        }
+
+        if (collapsed == 0)
+        {
+            break;
+        }
+    }
+
+    std::vector<int> remap(vertices.size(), -1);
+    std::vector<Vec3f> graded_vertices;
+    std::vector<Vec4i> graded_tets;
+    for (std::size_t index = 0; index < tets.size(); ++index)
+    {
+        if (!tet_alive[index])
+        {
+            continue;
+        }
+        Vec4i tet = tets[index];
+        for (int corner = 0; corner < 4; ++corner)
+        {
+            int &mapped = remap[tet[corner]];
+            if (mapped < 0)
+            {
+                mapped = static_cast<int>(graded_vertices.size());
+                graded_vertices.push_back(vertices[tet[corner]]);
+            }
+            tet[corner] = mapped;
+        }
+        graded_tets.push_back(tet);
+    }
+    mesh = TetMesh(graded_vertices, graded_tets);
+}
+
+struct QualitySummary
+{
+    float worst = 0.0f;
+    float mean = 0.0f;
+    std::array<int, QUARTET_QUALITY_HISTOGRAM_BINS> histogram{};
+};
+
+// Element quality is evaluated in contiguous chunks on worker threads; each
+// worker keeps its own minimum, sum, and histogram, which are merged at the end.
+QualitySummary summarize_element_quality(const TetMesh &mesh)
+{
+    QualitySummary summary;
+    const std::size_t tet_count = mesh.tSize();
+    if (tet_count == 0)
+    {
+        return summary;
+    }
+
+    struct Partial
+    {
+        float worst = std::numeric_limits<float>::infinity();
+        double sum = 0.0;
+        std::array<int, QUARTET_QUALITY_HISTOGRAM_BINS> histogram{};
+    };
+
+    const std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t worker_count = std::min(hardware, (tet_count + kMinTetsPerQualityWorker - 1) / kMinTetsPerQualityWorker);
+    const std::size_t chunk = (tet_count + worker_count - 1) / worker_count;
+    std::vector<Partial> partials(worker_count);
+
+    const auto evaluate = [&mesh, &partials, chunk, tet_count](std::size_t worker) {
+        Partial &partial = partials[worker];
+        const std::size_t end = std::min(tet_count, (worker + 1) * chunk);
+        for (std::size_t index = worker * chunk; index < end; ++index)
+        {
+            float quality = compute_tet_quality(mesh.getTet(static_cast<int>(index)));
+            if (!std::isfinite(quality))
+            {
+                quality = 0.0f;
+            }
+            partial.worst = std::min(partial.worst, quality);
+            partial.sum += quality;
+            const int bin = static_cast<int>(std::clamp(quality, 0.0f, 1.0f) * QUARTET_QUALITY_HISTOGRAM_BINS);
+            ++partial.histogram[std::min(bin, QUARTET_QUALITY_HISTOGRAM_BINS - 1)];
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(worker_count - 1);
+    for (std::size_t worker = 1; worker < worker_count; ++worker)
+    {
+        workers.emplace_back(evaluate, worker);
+    }
+    evaluate(0);
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+
+    float worst = std::numeric_limits<float>::infinity();
+    double sum = 0.0;
+    for (const Partial &partial : partials)
+    {
+        worst = std::min(worst, partial.worst);
+        sum += partial.sum;
+        for (int bin = 0; bin < QUARTET_QUALITY_HISTOGRAM_BINS; ++bin)
+        {
+            summary.histogram[bin] += partial.histogram[bin];
+        }
+    }
+    summary.worst = std::isfinite(worst) ? worst : 0.0f;
+    summary.mean = static_cast<float>(sum / static_cast<double>(tet_count));
+    return summary;
+}
+
+std::vector<Vec4i> positively_oriented_tets(const TetMesh &mesh)
+{
+    std::vector<Vec4i> tets(mesh.tSize());
+    for (std::size_t index = 0; index < tets.size(); ++index)
+    {
+        Vec4i tet = mesh.T(static_cast<int>(index));
+        if (signed_tet_volume(mesh.V(tet[0]), mesh.V(tet[1]), mesh.V(tet[2]), mesh.V(tet[3])) < 0.0f)
+        {
+            std::swap(tet[2], tet[3]);
+        }
+        tets[index] = tet;
+    }
+    return tets;
+}
+
+struct BoundarySurface
+{
+    std::vector<std::array<int, 3>> triangles;
+    std::vector<int> attributes;
+    int patch_count = 0;
+};
+
+// Collects outward-facing boundary triangles and splits them into patches
+// along edges whose dihedral angle exceeds the feature threshold, so solver
+// boundary conditions can target individual CAD faces by attribute.
+BoundarySurface extract_boundary_surface(const TetMesh &mesh, const std::vector<Vec4i> &tets, float feature_angle_threshold)
+{
+    static constexpr int kOutwardFaces[4][3] = {{1, 2, 3}, {0, 3, 2}, {0, 1, 3}, {0, 2, 1}};
+
+    BoundarySurface surface;
+    std::unordered_map<FaceKey, std::pair<int, int>, FaceKeyHash> faces;
+    faces.reserve(tets.size() * 2);
+    for (std::size_t index = 0; index < tets.size(); ++index)
+    {
+        const Vec4i &tet = tets[index];
+        for (int face = 0; face < 4; ++face)
+        {
+            int sorted[3] = {tet[kOutwardFaces[face][0]], tet[kOutwardFaces[face][1]], tet[kOutwardFaces[face][2]]};
+            std::sort(sorted, sorted + 3);
+            auto &entry = faces[FaceKey{sorted[0], sorted[1], sorted[2]}];
+            if (entry.first++ == 0)
+            {
+                entry.second = static_cast<int>(index) * 4 + face;
+            }
+        }
+    }
+
+    for (const auto &entry : faces)
+    {
+        if (entry.second.first != 1)
+        {
+            continue;
+        }
+        const Vec4i &tet = tets[entry.second.second / 4];
+        const int *corners = kOutwardFaces[entry.second.second % 4];
+        surface.triangles.push_back({tet[corners[0]], tet[corners[1]], tet[corners[2]]});
+    }
+    std::sort(surface.triangles.begin(), surface.triangles.end());
+
+    const std::size_t triangle_count = surface.triangles.size();
+    surface.attributes.assign(triangle_count, 1);
+    const bool split_features = std::isfinite(feature_angle_threshold) && feature_angle_threshold > 0.0f &&
+                                feature_angle_threshold < 180.0f;
+    if (!split_features)
+    {
+        surface.patch_count = triangle_count > 0 ? 1 : 0;
+        return surface;
+    }
+
+    std::vector<Vec3f> normals(triangle_count);
+    std::vector<std::pair<EdgeKey, int>> edges;
+    edges.reserve(triangle_count * 3);
+    for (std::size_t index = 0; index < triangle_count; ++index)
+    {
+        const std::array<int, 3> &triangle = surface.triangles[index];
+        const Vec3f normal = cross(mesh.V(triangle[1]) - mesh.V(triangle[0]), mesh.V(triangle[2]) - mesh.V(triangle[0]));
+        const float length = mag(normal);
+        normals[index] = (length > 0.0f) ? normal / length : normal;
+        for (int corner = 0; corner < 3; ++corner)
+        {
+            const int u = triangle[corner];
+            const int v = triangle[(corner + 1) % 3];
+            edges.emplace_back((u < v) ? EdgeKey{u, v} : EdgeKey{v, u}, static_cast<int>(index));
+        }
+    }
+    std::sort(edges.begin(), edges.end(), [](const auto &lhs, const auto &rhs) {
+        if (lhs.first.a != rhs.first.a)
+        {
+            return lhs.first.a < rhs.first.a;
+        }
+        if (lhs.first.b != rhs.first.b)
+        {
+            return lhs.first.b < rhs.first.b;
+        }
+        return lhs.second < rhs.second;
+    });
+
+    const float smooth_cosine = std::cos(feature_angle_threshold * kPi / 180.0f);
+    std::vector<std::array<int, 3>> neighbors(triangle_count, {-1, -1, -1});
+    for (std::size_t begin = 0; begin < edges.size();)
+    {
+        std::size_t end = begin + 1;
+        while (end < edges.size() && edges[end].first == edges[begin].first)
+        {
+            ++end;
+        }
+        if (end - begin == 2)
+        {
+            const int first = edges[begin].second;
+            const int second = edges[begin + 1].second;
+            if (dot(normals[first], normals[second]) >= smooth_cosine)
+            {
+                for (auto [from, to] : {std::pair<int, int>{first, second}, std::pair<int, int>{second, first}})
+                {
+                    for (int &slot : neighbors[from])
+                    {
+                        if (slot < 0)
+                        {
+                            slot = to;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+        begin = end;
+    }
+
+    std::fill(surface.attributes.begin(), surface.attributes.end(), 0);
+    std::vector<int> stack;
+    for (std::size_t seed = 0; seed < triangle_count; ++seed)
+    {
+        if (surface.attributes[seed] != 0)
+        {
+            continue;
+        }
+        const int patch = ++surface.patch_count;
+        surface.attributes[seed] = patch;
+        stack.push_back(static_cast<int>(seed));
+        while (!stack.empty())
+        {
+            const int current = stack.back();
+            stack.pop_back();
+            for (int neighbor : neighbors[current])
+            {
+                if (neighbor >= 0 && surface.attributes[neighbor] == 0)
+                {
+                    surface.attributes[neighbor] = patch;
+                    stack.push_back(neighbor);
+                }
+            }
+        }
+    }
+    return surface;
+}
+
+bool has_mfem_extension(const std::filesystem::path &path)
+{
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return extension == ".mesh";
+}
+
+// Writes MFEM mesh v1.0 so mfem-driver can load the result directly.
+bool write_mfem_mesh(const std::filesystem::path &path,
+                     const TetMesh &mesh,
+                     const std::vector<Vec4i> &tets,
+                     const BoundarySurface &surface)
+{
+    std::ofstream out(path, std::ios::binary);
+    if (!out)
+    {
+        return false;
+    }
+    out.precision(std::numeric_limits<float>::max_digits10);
+
+    constexpr int kMfemTriangle = 2;
+    constexpr int kMfemTetrahedron = 4;
+    out << "MFEM mesh v1.0\n\ndimension\n3\n\nelements\n" << tets.size() << '\n';
+    for (const Vec4i &tet : tets)
+    {
+        out << 1 << ' ' << kMfemTetrahedron << ' ' << tet[0] << ' ' << tet[1] << ' ' << tet[2] << ' ' << tet[3] << '\n';
+    }
+
+    out << "\nboundary\n" << surface.triangles.size() << '\n';
+    for (std::size_t index = 0; index < surface.triangles.size(); ++index)
+    {
+        const std::array<int, 3> &triangle = surface.triangles[index];
+        out << surface.attributes[index] << ' ' << kMfemTriangle << ' ' << triangle[0] << ' ' << triangle[1] << ' '
+            << triangle[2] << '\n';
+    }
+
+    out << "\nvertices\n" << mesh.vSize() << "\n3\n";
+    for (std::size_t index = 0; index < mesh.vSize(); ++index)
+    {
+        const Vec3f &position = mesh.V(static_cast<int>(index));
+        out << position[0] << ' ' << position[1] << ' ' << position[2] << '\n';
+    }
+    return static_cast<bool>(out);
+}
+
+MeshDataPtr make_mesh_data(const TetMesh &mesh, const std::vector<Vec4i> &tets, const BoundarySurface &surface)
+{
+    MeshDataPtr data(new QuartetMeshData{}, &free_mesh_data);
+    const std::size_t vertex_count = mesh.vSize();
+    const std::size_t triangle_count = surface.triangles.size();
+
+    data->vertices = new float[vertex_count * 3];
+    data->vertex_count = static_cast<int>(vertex_count);
+    for (std::size_t index = 0; index < vertex_count; ++index)
+    {
+        const Vec3f &position = mesh.V(static_cast<int>(index));
+        data->vertices[index * 3 + 0] = position[0];
+        data->vertices[index * 3 + 1] = position[1];
+        data->vertices[index * 3 + 2] = position[2];
+    }
+
+    data->tetrahedra = new int[tets.size() * 4];
+    data->tetrahedra_count = static_cast<int>(tets.size());
+    for (std::size_t index = 0; index < tets.size(); ++index)
+    {
+        for (int corner = 0; corner < 4; ++corner)
+        {
+            data->tetrahedra[index * 4 + corner] = tets[index][corner];
+        }
+    }
+
+    data->boundary_triangles = new int[triangle_count * 3];
+    data->boundary_attributes = new int[triangle_count];
+    data->boundary_triangle_count = static_cast<int>(triangle_count);
+    for (std::size_t index = 0; index < triangle_count; ++index)
+    {
+        for (int corner = 0; corner < 3; ++corner)
+        {
+            data->boundary_triangles[index * 3 + corner] = surface.triangles[index][corner];
+        }
+        data->boundary_attributes[index] = surface.attributes[index];
+    }
+    return data;
 }
 
 QuartetResult *generate_mesh_impl(const char *input_obj_path,
                                   const char *output_tet_path,
                                   float dx,
                                   int optimize_quality,
-                                  float feature_angle_threshold)
+                                  float feature_angle_threshold,
+                                  const QuartetSizingField *sizing_field,
+                                  bool return_mesh_data)
 {
     QuartetStats stats{};
-    if (!is_non_empty_path(input_obj_path) || !is_non_empty_path(output_tet_path))
+    const bool write_output = !return_mesh_data;
+    if (!is_non_empty_path(input_obj_path) || (write_output && !is_non_empty_path(output_tet_path)))
     {
         return make_result(stats, QUARTET_ERR_INVALID_ARGUMENT, "input and output paths must be non-empty");
     }
 
     const std::filesystem::path input_path(input_obj_path);
-    const std::filesystem::path output_path(output_tet_path);
+    const std::filesystem::path output_path(write_output ? output_tet_path : "");
     if (!std::filesystem::exists(input_path))
     {
         return make_result(stats, QUARTET_ERR_IO, "input OBJ mesh path does not exist");
@@ -292,6 +1581,12 @@ QuartetResult *generate_mesh_impl(const char *input_obj_path,
         return make_result(stats, QUARTET_ERR_INVALID_DX, dx_reason);
     }
 
+    std::string sizing_reason;
+    if (sizing_field != nullptr && !validate_sizing_field(*sizing_field, dx, sizing_reason))
+    {
+        return make_result(stats, QUARTET_ERR_INVALID_ARGUMENT, sizing_reason);
+    }
+
     const float span_x = bbox_max[0] - bbox_min[0];
     const float span_y = bbox_max[1] - bbox_min[1];
     const float span_z = bbox_max[2] - bbox_min[2];
@@ -300,8 +1595,11 @@ QuartetResult *generate_mesh_impl(const char *input_obj_path,
     const int nj = static_cast<int>(std::ceil(span_y / dx)) + 5;
     const int nk = static_cast<int>(std::ceil(span_z / dx)) + 5;
 
+    NarrowBandSdf narrow_band(origin, dx, ni, nj, nk);
+    narrow_band.build(surface_triangles, surface_vertices);
+
     SDF sdf(origin, dx, ni, nj, nk);
-    make_signed_distance(surface_triangles, surface_vertices, sdf);
+    narrow_band.materialize(sdf);
 
     TetMesh tet_mesh;
     const bool optimize = (optimize_quality != 0);
@@ -321,33 +1619,66 @@ QuartetResult *generate_mesh_impl(const char *input_obj_path,
         make_tet_mesh(tet_mesh, sdf, optimize, false, false);
     }
 
+    if (sizing_field != nullptr && tet_mesh.tSize() > 0)
+    {
+        fill_interior_depth(sdf, static_cast<float>(kNarrowBandCells) * dx);
+        const SizingOctree octree = build_sizing_octree(*sizing_field, sdf, bbox_min, bbox_max);
+        grade_tet_mesh(tet_mesh, octree);
+    }
+
     if (tet_mesh.vSize() == 0 || tet_mesh.tSize() == 0)
     {
         return make_result(stats, QUARTET_ERR_RUNTIME, "quartet generated an empty tetrahedral mesh");
     }
 
-    try
+    const std::vector<Vec4i> oriented_tets = positively_oriented_tets(tet_mesh);
+    const BoundarySurface boundary_surface =
+        extract_boundary_surface(tet_mesh, oriented_tets, detect_features ? feature_angle_threshold : 0.0f);
+
+    if (write_output)
     {
-        if (!output_path.parent_path().empty())
+        try
         {
-            std::filesystem::create_directories(output_path.parent_path());
+            if (!output_path.parent_path().empty())
+            {
+                std::filesystem::create_directories(output_path.parent_path());
+            }
+        }
+        catch (const std::exception &error)
+        {
+            return make_result(stats, QUARTET_ERR_IO, std::string("failed creating output directory: ") + error.what());
+        }
+
+        if (has_mfem_extension(output_path))
+        {
+            if (!write_mfem_mesh(output_path, tet_mesh, oriented_tets, boundary_surface))
+            {
+                return make_result(stats, QUARTET_ERR_IO, "failed to write output MFEM mesh");
+            }
+        }
+        else if (!tet_mesh.writeToFile(output_path.string().c_str()))
+        {
+            return make_result(stats, QUARTET_ERR_IO, "failed to write output .tet mesh");
         }
-    }
-    catch (const std::exception &error)
-    {
-        return make_result(stats, QUARTET_ERR_IO, std::string("failed creating output directory: ") + error.what());
     }
 
-    if (!tet_mesh.writeToFile(output_path.string().c_str()))
+    MeshDataPtr mesh_data(nullptr, &free_mesh_data);
+    if (return_mesh_data)
     {
-        return make_result(stats, QUARTET_ERR_IO, "failed to write output .tet mesh");
+        mesh_data = make_mesh_data(tet_mesh, oriented_tets, boundary_surface);
     }
 
+    const QualitySummary quality = summarize_element_quality(tet_mesh);
     stats.node_count = static_cast<int>(tet_mesh.vSize());
     stats.tetrahedra_count = static_cast<int>(tet_mesh.tSize());
-    stats.worst_element_quality = compute_worst_element_quality(tet_mesh);
+    stats.worst_element_quality = quality.worst;
+    stats.mean_element_quality = quality.mean;
+    std::copy(quality.histogram.begin(), quality.histogram.end(), stats.quality_histogram);
+    stats.boundary_patch_count = boundary_surface.patch_count;
 
-    return make_result(stats, QUARTET_SUCCESS, "");
+    QuartetResult *result = make_result(stats, QUARTET_SUCCESS, "");
+    result->mesh = mesh_data.release();
+    return result;
 }
 
 } // namespace
@@ -360,7 +1691,7 @@ extern "C" QuartetResult *quartet_generate_mesh(const char *input_obj_path,
 {
     try
     {
-        return generate_mesh_impl(input_obj_path, output_tet_path, dx, optimize_quality, feature_angle_threshold);
+        return generate_mesh_impl(input_obj_path, output_tet_path, dx, optimize_quality, feature_angle_threshold, nullptr, false);
     }
     catch (const std::bad_alloc &)
     {
@@ -379,6 +1710,73 @@ extern "C" QuartetResult *quartet_generate_mesh(const char *input_obj_path,
     }
 }
 
+extern "C" QuartetResult *quartet_generate_mesh_graded(const char *input_obj_path,
+                                                         const char *output_tet_path,
+                                                         float dx,
+                                                         int optimize_quality,
+                                                         float feature_angle_threshold,
+                                                         const QuartetSizingField *sizing_field)
+{
+    if (sizing_field == nullptr)
+    {
+        QuartetStats stats{};
+        return make_result(stats, QUARTET_ERR_INVALID_ARGUMENT, "sizing_field must be non-null");
+    }
+
+    try
+    {
+        return generate_mesh_impl(input_obj_path,
+                                  output_tet_path,
+                                  dx,
+                                  optimize_quality,
+                                  feature_angle_threshold,
+                                  sizing_field,
+                                  false);
+    }
+    catch (const std::bad_alloc &)
+    {
+        QuartetStats stats{};
+        return make_result(stats, QUARTET_ERR_BAD_ALLOC, "quartet meshing ran out of memory");
+    }
+    catch (const std::exception &error)
+    {
+        QuartetStats stats{};
+        return make_result(stats, QUARTET_ERR_RUNTIME, std::string("unexpected Quartet failure: ") + error.what());
+    }
+    catch (...)
+    {
+        QuartetStats stats{};
+        return make_result(stats, QUARTET_ERR_RUNTIME, "unexpected non-standard exception in quartet_generate_mesh_graded");
+    }
+}
+
+extern "C" QuartetResult *quartet_generate_mesh_data(const char *input_obj_path,
+                                                       float dx,
+                                                       int optimize_quality,
+                                                       float feature_angle_threshold,
+                                                       const QuartetSizingField *sizing_field)
+{
+    try
+    {
+        return generate_mesh_impl(input_obj_path, nullptr, dx, optimize_quality, feature_angle_threshold, sizing_field, true);
+    }
+    catch (const std::bad_alloc &)
+    {
+        QuartetStats stats{};
+        return make_result(stats, QUARTET_ERR_BAD_ALLOC, "quartet meshing ran out of memory");
+    }
+    catch (const std::exception &error)
+    {
+        QuartetStats stats{};
+        return make_result(stats, QUARTET_ERR_RUNTIME, std::string("unexpected Quartet failure: ") + error.what());
+    }
+    catch (...)
+    {
+        QuartetStats stats{};
+        return make_result(stats, QUARTET_ERR_RUNTIME, "unexpected non-standard exception in quartet_generate_mesh_data");
+    }
+}
+
 extern "C" void quartet_free_result(QuartetResult *result)
 {
     if (!result)
@@ -388,5 +1786,6 @@ extern "C" void quartet_free_result(QuartetResult *result)
 
     char *message = const_cast<char *>(result->error_message);
     delete[] message;
+    free_mesh_data(result->mesh);
     delete result;
 }
@@ -19,11 +19,53 @@ enum VtkErrorCode
     VTK_ERR_RUNTIME = 7
 };
 
+enum VtkFileFormat
+{
+    /* PNG for color and normal buffers, TIFF for depth. */
+    VTK_FORMAT_DEFAULT = 0,
+    VTK_FORMAT_PNG = 1,
+    VTK_FORMAT_TIFF = 2,
+    /* Raw NumPy array: uint8 (H, W, 3) or float32 (H, W). */
+    VTK_FORMAT_NPY = 3,
+    /* Uncompressed OpenEXR with one float channel "Z"; depth only. */
+    VTK_FORMAT_EXR = 4
+};
+
+enum VtkPoseSpace
+{
+    /* Pose coordinates are world coordinates. */
+    VTK_POSE_WORLD = 0,
+    /*
+     * Positions and focal points are offsets from the mesh bounding-box
+     * center in units of its diagonal, so one rig fits any mesh.
+     */
+    VTK_POSE_NORMALIZED = 1
+};
+
 typedef struct VtkViewResult
 {
     const char *color_path;
     const char *depth_path;
     const char *normal_path;
+    /*
+     * In-memory buffers, set only when VtkRenderOptions.return_buffers is
+     * non-zero. Rows are top-down and tightly packed: RGB8 for color and
+     * normal, float32 linear eye-space depth for depth.
+     */
+    unsigned char *color_pixels;
+    float *depth_pixels;
+    unsigned char *normal_pixels;
+    int width;
+    int height;
+    /* Per-view pinhole intrinsics, flat row-major 3x3. */
+    float intrinsics[9];
+    /*
+     * Per-view world-to-camera transform, flat row-major 4x4, in the OpenGL
+     * camera convention (camera looks down -Z, +Y up).
+     */
+    float extrinsics[16];
+    float near_clip;
+    float far_clip;
 } VtkViewResult;
 
 typedef struct VtkRenderOutput
@@ -47,6 +89,98 @@ VtkRenderOutput *vtk_render_pack(const char *input_mesh_path,
 
 void vtk_free_result(VtkRenderOutput *result);
 
+typedef struct VtkRenderOptions
+{
+    int output_color;
+    int output_depth;
+    int output_normal;
+    /* Encode PNG/TIFF files into output_directory. */
+    int write_files;
+    /* Attach raw pixel buffers to each VtkViewResult. */
+    int return_buffers;
+    /*
+     * Produce color, depth and normals from one raster pass per view using a
+     * multi-target framebuffer, instead of a second render for normals.
+     */
+    int single_pass;
+    /*
+     * Worker threads that encode files while the next view renders; 0
+     * encodes inline on the calling thread.
+     */
+    int encoder_threads;
+    /* 0-9; -1 keeps the writer default. Applies to PNG and TIFF (deflate). */
+    int compression_level;
+    /* VtkFileFormat for color and normal files: DEFAULT, PNG or NPY. */
+    int color_format;
+    /* VtkFileFormat for depth files: DEFAULT, TIFF, NPY or EXR. */
+    int depth_format;
+} VtkRenderOptions;
+
+typedef struct VtkCameraPose
+{
+    double position[3];
+    double focal_point[3];
+    double view_up[3];
+    /* Vertical field of view; <= 0 uses the 30 degree default. */
+    double view_angle_degrees;
+} VtkCameraPose;
+
+/*
+ * Fills options with all buffers enabled, file output on, no in-memory
+ * buffers, single-pass capture, and two encoder threads.
+ */
+void vtk_default_render_options(VtkRenderOptions *options);
+
+/*
+ * Persistent off-screen renderer. A session owns one render window, GL
+ * context, renderer and actor set; meshes submitted to it replace the mapper
+ * inputs, so context creation and shader compilation happen once per session
+ * instead of once per mesh. A session must only be used from one thread at a
+ * time.
+ *
+ * vtk_session_open always returns a handle (NULL only on allocation failure);
+ * check vtk_session_error_code before submitting, and release the handle with
+ * vtk_session_close in every case.
+ */
+typedef struct VtkRenderSession VtkRenderSession;
+
+VtkRenderSession *vtk_session_open(int width, int height);
+
+int vtk_session_error_code(const VtkRenderSession *session);
+
+const char *vtk_session_error_message(const VtkRenderSession *session);
+
+VtkRenderOutput *vtk_session_render(VtkRenderSession *session,
+                                    const char *input_mesh_path,
+                                    const char *output_directory,
+                                    const char *const *views,
+                                    int num_views,
+                                    int output_color,
+                                    int output_depth,
+                                    int output_normal);
+
+/* output_directory may be NULL when options->write_files is zero. */
+VtkRenderOutput *vtk_session_render_ex(VtkRenderSession *session,
+                                       const char *input_mesh_path,
+                                       const char *output_directory,
+                                       const char *const *views,
+                                       int num_views,
+                                       const VtkRenderOptions *options);
+
+/*
+ * Renders one view per pose in a single call. Views are named
+ * "<index>_pose" in output files.
+ */
+VtkRenderOutput *vtk_session_render_rig(VtkRenderSession *session,
+                                        const char *input_mesh_path,
+                                        const char *output_directory,
+                                        const VtkCameraPose *poses,
+                                        int num_poses,
+                                        int pose_space,
+                                        const VtkRenderOptions *options);
+
+void vtk_session_close(VtkRenderSession *session);
+
 #ifdef __cplusplus
 }
 #endif
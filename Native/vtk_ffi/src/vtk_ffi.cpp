@@ -6,10 +6,19 @@
 #include <array>
 #include <cctype>
 #include <cmath>
+#include <condition_variable>
+#include <cstdint>
 #include <cstring>
+#include <deque>
 #include <exception>
 #include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <vtkActor.h>
@@ -31,7 +40,19 @@
 #include <vtkSmartPointer.h>
 #include <vtkTIFFWriter.h>
 #include <vtkUnsignedCharArray.h>
-#include <vtkWindowToImageFilter.h>
+
+#include <vtkMatrix4x4.h>
+#include <vtkObjectFactory.h>
+#include <vtkOpenGLFramebufferObject.h>
+#include <vtkOpenGLPolyDataMapper.h>
+#include <vtkOpenGLRenderPass.h>
+#include <vtkOpenGLRenderWindow.h>
+#include <vtkOpenGLState.h>
+#include <vtkRenderState.h>
+#include <vtkRenderStepsPass.h>
+#include <vtkShaderProgram.h>
+#include <vtkTextureObject.h>
+#include <vtk_glew.h>
 
 #if defined(__linux__)
 #if __has_include(<vtkEGLRenderWindow.h>)
@@ -45,8 +66,341 @@
 namespace
 {
 
+constexpr std::size_t kEncoderQueueDepthPerThread = 2;
+
+// Renders the scene once into an offscreen framebuffer with two color
+// attachments and a float depth attachment. The surface shader is patched to
+// write the world-space normal (mapped to [0, 1]) into the second attachment
+// next to the lit color, so color, depth and normals come from one raster
+// pass. The buffers are read back before the framebuffer is released and
+// stay in OpenGL row order (bottom-up).
+class MultiTargetCapturePass : public vtkOpenGLRenderPass
+{
+public:
+    static MultiTargetCapturePass *New();
+    vtkTypeMacro(MultiTargetCapturePass, vtkOpenGLRenderPass);
+
+    std::vector<unsigned char> color;
+    std::vector<unsigned char> normal;
+    std::vector<float> depth;
+    bool capture_color = true;
+    bool capture_normal = true;
+    bool capture_depth = true;
+
+    void Render(const vtkRenderState *state) override
+    {
+        this->NumberOfRenderedProps = 0;
+        captured_ = false;
+
+        vtkRenderer *renderer = state->GetRenderer();
+        auto *render_window = vtkOpenGLRenderWindow::SafeDownCast(renderer->GetRenderWindow());
+        if (render_window == nullptr)
+        {
+            return;
+        }
+        int width = 0;
+        int height = 0;
+        int origin_x = 0;
+        int origin_y = 0;
+        renderer->GetTiledSizeAndOrigin(&width, &height, &origin_x, &origin_y);
+        allocate_targets(render_window, width, height);
+
+        double view_rows[16];
+        vtkMatrix4x4::DeepCopy(view_rows, renderer->GetActiveCamera()->GetViewTransformMatrix());
+        // The rotation block of the world-to-view matrix, uploaded column-major, is its
+        // transpose: the view-to-world rotation used by the patched shader.
+        for (int row = 0; row < 3; ++row)
+        {
+            for (int column = 0; column < 3; ++column)
+            {
+                view_to_world_[row * 3 + column] = static_cast<float>(view_rows[row * 4 + column]);
+            }
+        }
+
+        vtkOpenGLState *gl_state = render_window->GetState();
+        gl_state->PushFramebufferBindings();
+        frame_buffer_->Bind();
+        frame_buffer_->AddColorAttachment(0, color_texture_);
+        frame_buffer_->AddColorAttachment(1, normal_texture_);
+        frame_buffer_->ActivateDrawBuffers(2);
+        frame_buffer_->AddDepthAttachment(depth_texture_);
+        frame_buffer_->StartNonOrtho(width, height);
+        const char *status = nullptr;
+        if (!vtkOpenGLFramebufferObject::GetFrameBufferStatus(GL_FRAMEBUFFER, status))
+        {
+            gl_state->PopFramebufferBindings();
+            return;
+        }
+        gl_state->vtkglClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        gl_state->vtkglClearDepth(1.0);
+        gl_state->vtkglDepthMask(GL_TRUE);
+        gl_state->vtkglClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        this->PreRender(state);
+        steps_pass_->Render(state);
+        this->NumberOfRenderedProps += steps_pass_->GetNumberOfRenderedProps();
+        this->PostRender(state);
+
+        const std::size_t pixel_count = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+        gl_state->vtkglPixelStorei(GL_PACK_ALIGNMENT, 1);
+        if (capture_color)
+        {
+            color.resize(pixel_count * 3);
+            frame_buffer_->ActivateReadBuffer(0);
+            glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, color.data());
+        }
+        if (capture_normal)
+        {
+            normal.resize(pixel_count * 3);
+            frame_buffer_->ActivateReadBuffer(1);
+            glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, normal.data());
+        }
+        if (capture_depth)
+        {
+            depth.resize(pixel_count);
+            glReadPixels(0, 0, width, height, GL_DEPTH_COMPONENT, GL_FLOAT, depth.data());
+        }
+        gl_state->PopFramebufferBindings();
+        captured_ = true;
+    }
+
+    bool captured() const
+    {
+        return captured_;
+    }
+
+    bool PreReplaceShaderValues(std::string &,
+                                std::string &,
+                                std::string &fragment_shader,
+                                vtkAbstractMapper *mapper,
+                                vtkProp *) override
+    {
+        if (vtkOpenGLPolyDataMapper::SafeDownCast(mapper) == nullptr)
+        {
+            return true;
+        }
+        vtkShaderProgram::Substitute(fragment_shader,
+                                     "//VTK::Normal::Dec",
+                                     "//VTK::Normal::Dec\nuniform mat3 autosageViewToWorld;\n",
+                                     false);
+        vtkShaderProgram::Substitute(fragment_shader,
+                                     "//VTK::Light::Impl",
+                                     "//VTK::Light::Impl\n"
+                                     "  gl_FragData[1] = vec4(normalize(autosageViewToWorld * normalVCVSOutput) * 0.5 + 0.5, 1.0);\n",
+                                     false);
+        return true;
+    }
+
+    bool SetShaderParameters(vtkShaderProgram *program,
+                             vtkAbstractMapper *,
+                             vtkProp *,
+                             vtkOpenGLVertexArrayObject *) override
+    {
+        if (program->IsUniformUsed("autosageViewToWorld"))
+        {
+            program->SetUniformMatrix3x3("autosageViewToWorld", view_to_world_);
+        }
+        return true;
+    }
+
+    void ReleaseGraphicsResources(vtkWindow *window) override
+    {
+        steps_pass_->ReleaseGraphicsResources(window);
+        frame_buffer_->ReleaseGraphicsResources(window);
+        color_texture_->ReleaseGraphicsResources(window);
+        normal_texture_->ReleaseGraphicsResources(window);
+        depth_texture_->ReleaseGraphicsResources(window);
+        allocated_width_ = 0;
+        allocated_height_ = 0;
+    }
+
+protected:
+    MultiTargetCapturePass() = default;
+    ~MultiTargetCapturePass() override = default;
+
+private:
+    MultiTargetCapturePass(const MultiTargetCapturePass &) = delete;
+    void operator=(const MultiTargetCapturePass &) = delete;
+
+    void allocate_targets(vtkOpenGLRenderWindow *render_window, int width, int height)
+    {
+        if (allocated_width_ == 0)
+        {
+            frame_buffer_->SetContext(render_window);
+            color_texture_->SetContext(render_window);
+            normal_texture_->SetContext(render_window);
+            depth_texture_->SetContext(render_window);
+            color_texture_->Allocate2D(width, height, 4, VTK_UNSIGNED_CHAR);
+            normal_texture_->Allocate2D(width, height, 4, VTK_UNSIGNED_CHAR);
+            depth_texture_->AllocateDepth(width, height, vtkTextureObject::Float32);
+        }
+        else if (allocated_width_ != width || allocated_height_ != height)
+        {
+            color_texture_->Resize(width, height);
+            normal_texture_->Resize(width, height);
+            depth_texture_->Resize(width, height);
+        }
+        allocated_width_ = width;
+        allocated_height_ = height;
+    }
+
+    vtkNew<vtkRenderStepsPass> steps_pass_;
+    vtkNew<vtkOpenGLFramebufferObject> frame_buffer_;
+    vtkNew<vtkTextureObject> color_texture_;
+    vtkNew<vtkTextureObject> normal_texture_;
+    vtkNew<vtkTextureObject> depth_texture_;
+    float view_to_world_[9] = {1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+    int allocated_width_ = 0;
+    int allocated_height_ = 0;
+    bool captured_ = false;
+};
+
+vtkStandardNewMacro(MultiTargetCapturePass);
+
+// Fixed set of threads that run file-encoding tasks so that compression
+// overlaps with rendering the next view. The queue is bounded so a fast
+// renderer cannot buffer an unbounded number of frames. Each task returns an
+// error message, empty on success; wait() drains the queue and reports the
+// first failure.
+class EncoderPool
+{
+public:
+    using Task = std::function<std::string()>;
+
+    explicit EncoderPool(int thread_count)
+        : max_pending_(static_cast<std::size_t>(thread_count) * kEncoderQueueDepthPerThread)
+    {
+        workers_.reserve(static_cast<std::size_t>(thread_count));
+        for (int index = 0; index < thread_count; ++index)
+        {
+            workers_.emplace_back([this]() { run(); });
+        }
+    }
+
+    ~EncoderPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        work_ready_.notify_all();
+        for (std::thread &worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    EncoderPool(const EncoderPool &) = delete;
+    EncoderPool &operator=(const EncoderPool &) = delete;
+
+    int thread_count() const
+    {
+        return static_cast<int>(workers_.size());
+    }
+
+    void submit(Task task)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        slot_free_.wait(lock, [this]() { return queue_.size() < max_pending_; });
+        queue_.push_back(std::move(task));
+        ++outstanding_;
+        lock.unlock();
+        work_ready_.notify_one();
+    }
+
+    std::string wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        all_done_.wait(lock, [this]() { return outstanding_ == 0; });
+        std::string error;
+        error.swap(first_error_);
+        return error;
+    }
+
+private:
+    void run()
+    {
+        for (;;)
+        {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                work_ready_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+                if (queue_.empty())
+                {
+                    return;
+                }
+                task = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            slot_free_.notify_one();
+
+            std::string error;
+            try
+            {
+                error = task();
+            }
+            catch (const std::exception &failure)
+            {
+                error = std::string("encoder task failed: ") + failure.what();
+            }
+            catch (...)
+            {
+                error = "encoder task failed with unknown exception";
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!error.empty() && first_error_.empty())
+            {
+                first_error_ = std::move(error);
+            }
+            if (--outstanding_ == 0)
+            {
+                all_done_.notify_all();
+            }
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable work_ready_;
+    std::condition_variable slot_free_;
+    std::condition_variable all_done_;
+    std::deque<Task> queue_;
+    std::size_t outstanding_ = 0;
+    std::size_t max_pending_;
+    std::string first_error_;
+    bool stopping_ = false;
+    std::vector<std::thread> workers_;
+};
+
+} // namespace
+
+struct VtkRenderSession
+{
+    vtkSmartPointer<vtkRenderWindow> render_window;
+    vtkSmartPointer<vtkRenderer> renderer;
+    vtkSmartPointer<vtkPolyDataMapper> color_mapper;
+    vtkSmartPointer<vtkActor> color_actor;
+    vtkSmartPointer<vtkPolyDataMapper> normal_mapper;
+    vtkSmartPointer<vtkActor> normal_actor;
+    vtkSmartPointer<MultiTargetCapturePass> capture_pass;
+    std::unique_ptr<EncoderPool> encoder_pool;
+    int width = 0;
+    int height = 0;
+    int error_code = VTK_SUCCESS;
+    std::string error_message;
+};
+
+namespace
+{
+
 constexpr int kMinDimension = 16;
 constexpr int kMaxDimension = 8192;
+constexpr std::size_t kMinPixelsPerDepthWorker = 1u << 18;
+constexpr double kDefaultViewAngleDegrees = 30.0;
+constexpr int kDefaultEncoderThreads = 2;
+constexpr int kMaxEncoderThreads = 64;
+constexpr int kMaxCompressionLevel = 9;
 
 struct ViewPaths
 {
@@ -55,6 +409,46 @@ struct ViewPaths
     std::string normal;
 };
 
+struct ViewBuffers
+{
+    std::vector<unsigned char> color;
+    std::vector<float> depth;
+    std::vector<unsigned char> normal;
+};
+
+struct ViewSpec
+{
+    std::string name;
+    bool has_pose = false;
+    VtkCameraPose pose{};
+};
+
+struct ViewCamera
+{
+    std::array<float, 9> intrinsics{};
+    std::array<float, 16> extrinsics{};
+    float near_clip = 0.0f;
+    float far_clip = 0.0f;
+};
+
+struct RenderRequest
+{
+    std::filesystem::path mesh_path;
+    std::filesystem::path output_dir;
+    std::vector<ViewSpec> views;
+    int pose_space = VTK_POSE_WORLD;
+    int encoder_threads = 0;
+    int compression_level = -1;
+    int color_format = VTK_FORMAT_PNG;
+    int depth_format = VTK_FORMAT_TIFF;
+    bool output_color = false;
+    bool output_depth = false;
+    bool output_normal = false;
+    bool write_files = false;
+    bool return_buffers = false;
+    bool single_pass = false;
+};
+
 char *duplicate_c_string(const std::string &text)
 {
     const std::size_t size = text.size();
@@ -207,6 +601,58 @@ bool set_view_pose(vtkCamera *camera,
                         center[2] + direction[2] * distance);
     camera->SetViewUp(up[0], up[1], up[2]);
     camera->OrthogonalizeViewUp();
+    camera->SetViewAngle(kDefaultViewAngleDegrees);
+    return true;
+}
+
+bool apply_camera_pose(vtkCamera *camera,
+                       const VtkCameraPose &pose,
+                       int pose_space,
+                       const std::array<double, 3> &center,
+                       double diagonal,
+                       std::string &error)
+{
+    std::array<double, 3> position{};
+    std::array<double, 3> focal_point{};
+    std::array<double, 3> forward{};
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        position[axis] = pose.position[axis];
+        focal_point[axis] = pose.focal_point[axis];
+        if (pose_space == VTK_POSE_NORMALIZED)
+        {
+            position[axis] = center[axis] + position[axis] * diagonal;
+            focal_point[axis] = center[axis] + focal_point[axis] * diagonal;
+        }
+        forward[axis] = focal_point[axis] - position[axis];
+        if (!std::isfinite(position[axis]) || !std::isfinite(focal_point[axis]) || !std::isfinite(pose.view_up[axis]))
+        {
+            error = "camera pose contains non-finite values";
+            return false;
+        }
+    }
+
+    double up[3] = {pose.view_up[0], pose.view_up[1], pose.view_up[2]};
+    double side[3] = {0.0, 0.0, 0.0};
+    vtkMath::Cross(forward.data(), up, side);
+    if (vtkMath::Norm(forward.data()) <= 0.0 || vtkMath::Norm(side) <= 1.0e-9 * vtkMath::Norm(forward.data()) * vtkMath::Norm(up))
+    {
+        error = "camera pose needs distinct position and focal point and a view_up not parallel to the view direction";
+        return false;
+    }
+
+    const double view_angle = pose.view_angle_degrees > 0.0 ? pose.view_angle_degrees : kDefaultViewAngleDegrees;
+    if (view_angle >= 180.0)
+    {
+        error = "camera view_angle_degrees must be below 180";
+        return false;
+    }
+
+    camera->SetFocalPoint(focal_point[0], focal_point[1], focal_point[2]);
+    camera->SetPosition(position[0], position[1], position[2]);
+    camera->SetViewUp(up[0], up[1], up[2]);
+    camera->OrthogonalizeViewUp();
+    camera->SetViewAngle(view_angle);
     return true;
 }
 
@@ -229,52 +675,92 @@ void compute_camera_intrinsics(vtkCamera *camera, int width, int height, float *
     out_intrinsics[8] = 1.0f;
 }
 
-bool write_rgb_capture(vtkRenderWindow *render_window, const std::filesystem::path &path, std::string &error)
+ViewCamera capture_view_camera(vtkCamera *camera, int width, int height)
 {
-    vtkNew<vtkWindowToImageFilter> capture;
-    capture->SetInput(render_window);
-    capture->ReadFrontBufferOff();
-    capture->SetInputBufferTypeToRGB();
-    capture->Update();
-
-    vtkNew<vtkPNGWriter> writer;
-    writer->SetFileName(path.string().c_str());
-    writer->SetInputConnection(capture->GetOutputPort());
-    writer->Write();
+    ViewCamera view;
+    compute_camera_intrinsics(camera, width, height, view.intrinsics.data());
+    double elements[16];
+    vtkMatrix4x4::DeepCopy(elements, camera->GetViewTransformMatrix());
+    for (int index = 0; index < 16; ++index)
+    {
+        view.extrinsics[static_cast<std::size_t>(index)] = static_cast<float>(elements[index]);
+    }
+    double clip[2] = {0.0, 0.0};
+    camera->GetClippingRange(clip);
+    view.near_clip = static_cast<float>(clip[0]);
+    view.far_clip = static_cast<float>(clip[1]);
+    return view;
+}
 
-    if (!std::filesystem::exists(path))
+// Reads the back buffer as tightly packed RGB8 rows in OpenGL order (bottom-up).
+bool read_rgb_pixels(vtkRenderWindow *render_window, int width, int height, std::vector<unsigned char> &pixels, std::string &error)
+{
+    vtkNew<vtkUnsignedCharArray> data;
+    render_window->GetPixelData(0, 0, width - 1, height - 1, 0, data, 0);
+    const std::size_t byte_count = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 3;
+    if (data->GetNumberOfTuples() * data->GetNumberOfComponents() != static_cast<vtkIdType>(byte_count))
     {
-        error = "failed to write RGB buffer to " + path.string();
+        error = "failed to read RGB buffer";
         return false;
     }
+    pixels.resize(byte_count);
+    std::memcpy(pixels.data(), data->GetPointer(0), byte_count);
     return true;
 }
 
-bool write_depth_capture(vtkRenderer *renderer,
-                         vtkRenderWindow *render_window,
-                         int width,
-                         int height,
-                         const std::filesystem::path &path,
-                         std::string &error)
+// Maps window-space depth to eye-space distance for a perspective projection
+// with the given clip planes. The Z-buffer is already clamped to [0, 1], so
+// the denominator stays >= near_clip; keeping the loop free of branches lets
+// the compiler vectorize it.
+void linearize_depth_range(float *depth, std::size_t count, float near_clip, float far_clip)
+{
+    const float numerator = near_clip * far_clip;
+    const float range = far_clip - near_clip;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        depth[i] = numerator / (far_clip - depth[i] * range);
+    }
+}
+
+void linearize_depth_buffer(float *depth, std::size_t count, float near_clip, float far_clip)
 {
-    vtkNew<vtkWindowToImageFilter> depth_capture;
-    depth_capture->SetInput(render_window);
-    depth_capture->ReadFrontBufferOff();
-    depth_capture->SetInputBufferTypeToZBuffer();
-    depth_capture->Update();
+    const std::size_t hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t worker_count = std::min(hardware_threads, std::max<std::size_t>(1, count / kMinPixelsPerDepthWorker));
+    if (worker_count <= 1)
+    {
+        linearize_depth_range(depth, count, near_clip, far_clip);
+        return;
+    }
 
-    vtkImageData *z_image = depth_capture->GetOutput();
-    if (!z_image)
+    const std::size_t chunk = (count + worker_count - 1) / worker_count;
+    std::vector<std::thread> workers;
+    workers.reserve(worker_count - 1);
+    for (std::size_t worker = 1; worker < worker_count; ++worker)
     {
-        error = "failed to capture Z-buffer image";
-        return false;
+        const std::size_t begin = std::min(count, worker * chunk);
+        const std::size_t end = std::min(count, begin + chunk);
+        workers.emplace_back(linearize_depth_range, depth + begin, end - begin, near_clip, far_clip);
+    }
+    linearize_depth_range(depth, std::min(count, chunk), near_clip, far_clip);
+    for (std::thread &worker : workers)
+    {
+        worker.join();
     }
+}
 
-    int dims[3] = {0, 0, 0};
-    z_image->GetDimensions(dims);
-    if (dims[0] != width || dims[1] != height)
+// Reads the float Z-buffer directly and converts it to linear depth in place.
+bool read_linear_depth(vtkRenderer *renderer,
+                       vtkRenderWindow *render_window,
+                       int width,
+                       int height,
+                       std::vector<float> &depth,
+                       std::string &error)
+{
+    const std::size_t count = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+    depth.resize(count);
+    if (render_window->GetZbufferData(0, 0, width - 1, height - 1, depth.data()) != VTK_OK)
     {
-        error = "unexpected Z-buffer dimensions";
+        error = "failed to capture Z-buffer image";
         return false;
     }
 
@@ -282,30 +768,62 @@ bool write_depth_capture(vtkRenderer *renderer,
     renderer->GetActiveCamera()->GetClippingRange(clip);
     const double near_clip = std::max(1.0e-6, clip[0]);
     const double far_clip = std::max(near_clip + 1.0e-6, clip[1]);
+    linearize_depth_buffer(depth.data(), count, static_cast<float>(near_clip), static_cast<float>(far_clip));
+    return true;
+}
 
-    vtkNew<vtkImageData> linear_depth;
-    linear_depth->SetDimensions(width, height, 1);
-    linear_depth->AllocateScalars(VTK_FLOAT, 1);
+bool write_rgb_png(const std::vector<unsigned char> &pixels,
+                   int width,
+                   int height,
+                   int compression_level,
+                   const std::filesystem::path &path,
+                   std::string &error)
+{
+    vtkNew<vtkImageData> image;
+    image->SetDimensions(width, height, 1);
+    image->AllocateScalars(VTK_UNSIGNED_CHAR, 3);
+    std::memcpy(image->GetScalarPointer(), pixels.data(), pixels.size());
 
-    for (int y = 0; y < height; ++y)
+    vtkNew<vtkPNGWriter> writer;
+    writer->SetFileName(path.string().c_str());
+    if (compression_level >= 0)
     {
-        for (int x = 0; x < width; ++x)
-        {
-            const double z_buffer = z_image->GetScalarComponentAsDouble(x, y, 0, 0);
-            const double z_ndc = (2.0 * z_buffer) - 1.0;
-            const double denom = far_clip + near_clip - z_ndc * (far_clip - near_clip);
-            double linear_value = (2.0 * near_clip * far_clip) / denom;
-            if (!std::isfinite(linear_value))
-            {
-                linear_value = far_clip;
-            }
-            linear_depth->SetScalarComponentFromFloat(x, y, 0, 0, static_cast<float>(linear_value));
-        }
+        writer->SetCompressionLevel(compression_level);
+    }
+    writer->SetInputData(image);
+    writer->Write();
+
+    if (!std::filesystem::exists(path))
+    {
+        error = "failed to write RGB buffer to " + path.string();
+        return false;
     }
+    return true;
+}
+
+bool write_depth_tiff(const std::vector<float> &depth,
+                      int width,
+                      int height,
+                      int compression_level,
+                      const std::filesystem::path &path,
+                      std::string &error)
+{
+    vtkNew<vtkImageData> image;
+    image->SetDimensions(width, height, 1);
+    image->AllocateScalars(VTK_FLOAT, 1);
+    std::memcpy(image->GetScalarPointer(), depth.data(), depth.size() * sizeof(float));
 
     vtkNew<vtkTIFFWriter> writer;
     writer->SetFileName(path.string().c_str());
-    writer->SetInputData(linear_depth);
+    if (compression_level == 0)
+    {
+        writer->SetCompressionToNoCompression();
+    }
+    else if (compression_level > 0)
+    {
+        writer->SetCompressionToDeflate();
+    }
+    writer->SetInputData(image);
     writer->Write();
 
     if (!std::filesystem::exists(path))
@@ -316,7 +834,200 @@ bool write_depth_capture(vtkRenderer *renderer,
     return true;
 }
 
-vtkSmartPointer<vtkPolyData> make_normal_colored_polydata(vtkPolyData *mesh, std::string &error)
+// Writes a NumPy v1.0 array of shape (height, width[, components]) with rows
+// flipped to top-down order.
+template <typename T>
+bool write_npy(const std::vector<T> &pixels,
+               int width,
+               int height,
+               int components,
+               const char *descr,
+               const std::filesystem::path &path,
+               std::string &error)
+{
+    std::string header = std::string("{'descr': '") + descr + "', 'fortran_order': False, 'shape': (" +
+                         std::to_string(height) + ", " + std::to_string(width) +
+                         (components > 1 ? ", " + std::to_string(components) : std::string()) + "), }";
+    const std::size_t preamble = 10;
+    const std::size_t padded = (preamble + header.size() + 1 + 63) / 64 * 64;
+    header.append(padded - preamble - header.size() - 1, ' ');
+    header.push_back('\n');
+
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    const unsigned char magic[8] = {0x93, 'N', 'U', 'M', 'P', 'Y', 1, 0};
+    const std::uint16_t header_length = static_cast<std::uint16_t>(header.size());
+    const unsigned char length_bytes[2] = {static_cast<unsigned char>(header_length & 0xFF),
+                                           static_cast<unsigned char>(header_length >> 8)};
+    stream.write(reinterpret_cast<const char *>(magic), sizeof(magic));
+    stream.write(reinterpret_cast<const char *>(length_bytes), sizeof(length_bytes));
+    stream.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+    const std::size_t row = static_cast<std::size_t>(width) * static_cast<std::size_t>(components);
+    for (int y = height - 1; y >= 0; --y)
+    {
+        stream.write(reinterpret_cast<const char *>(pixels.data() + row * static_cast<std::size_t>(y)),
+                     static_cast<std::streamsize>(row * sizeof(T)));
+    }
+    if (!stream)
+    {
+        error = "failed to write array to " + path.string();
+        return false;
+    }
+    return true;
+}
+
+template <typename T>
+void append_le(std::string &out, T value)
+{
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    out.append(bytes, sizeof(T));
+}
+
+void append_exr_attribute(std::string &out, const char *name, const char *type, const std::string &value)
+{
+    out.append(name).push_back('\0');
+    out.append(type).push_back('\0');
+    append_le<std::int32_t>(out, static_cast<std::int32_t>(value.size()));
+    out.append(value);
+}
+
+// Writes a single-part, uncompressed scanline OpenEXR file with one FLOAT
+// channel "Z", which is what depth consumers such as Blender and OpenCV read.
+bool write_depth_exr(const std::vector<float> &depth, int width, int height, const std::filesystem::path &path, std::string &error)
+{
+    std::string header;
+    append_le<std::uint32_t>(header, 20000630u);
+    append_le<std::uint32_t>(header, 2u);
+
+    std::string channels("Z");
+    channels.push_back('\0');
+    append_le<std::int32_t>(channels, 2);
+    append_le<std::int32_t>(channels, 0);
+    append_le<std::int32_t>(channels, 1);
+    append_le<std::int32_t>(channels, 1);
+    channels.push_back('\0');
+    append_exr_attribute(header, "channels", "chlist", channels);
+    append_exr_attribute(header, "compression", "compression", std::string(1, '\0'));
+
+    std::string window;
+    append_le<std::int32_t>(window, 0);
+    append_le<std::int32_t>(window, 0);
+    append_le<std::int32_t>(window, width - 1);
+    append_le<std::int32_t>(window, height - 1);
+    append_exr_attribute(header, "dataWindow", "box2i", window);
+    append_exr_attribute(header, "displayWindow", "box2i", window);
+    append_exr_attribute(header, "lineOrder", "lineOrder", std::string(1, '\0'));
+
+    std::string aspect;
+    append_le<float>(aspect, 1.0f);
+    append_exr_attribute(header, "pixelAspectRatio", "float", aspect);
+    std::string center;
+    append_le<float>(center, 0.0f);
+    append_le<float>(center, 0.0f);
+    append_exr_attribute(header, "screenWindowCenter", "v2f", center);
+    append_exr_attribute(header, "screenWindowWidth", "float", aspect);
+    header.push_back('\0');
+
+    const std::size_t row_bytes = static_cast<std::size_t>(width) * sizeof(float);
+    const std::size_t line_bytes = 8 + row_bytes;
+    const std::uint64_t first_line = header.size() + static_cast<std::size_t>(height) * sizeof(std::uint64_t);
+    for (int y = 0; y < height; ++y)
+    {
+        append_le<std::uint64_t>(header, first_line + static_cast<std::uint64_t>(y) * line_bytes);
+    }
+
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    stream.write(header.data(), static_cast<std::streamsize>(header.size()));
+    std::string line_prefix;
+    for (int y = 0; y < height; ++y)
+    {
+        line_prefix.clear();
+        append_le<std::int32_t>(line_prefix, y);
+        append_le<std::int32_t>(line_prefix, static_cast<std::int32_t>(row_bytes));
+        stream.write(line_prefix.data(), static_cast<std::streamsize>(line_prefix.size()));
+        stream.write(reinterpret_cast<const char *>(depth.data() + static_cast<std::size_t>(height - 1 - y) * width),
+                     static_cast<std::streamsize>(row_bytes));
+    }
+    if (!stream)
+    {
+        error = "failed to write depth buffer to " + path.string();
+        return false;
+    }
+    return true;
+}
+
+const char *rgb_extension(int format)
+{
+    return format == VTK_FORMAT_NPY ? ".npy" : ".png";
+}
+
+const char *depth_extension(int format)
+{
+    switch (format)
+    {
+    case VTK_FORMAT_NPY:
+        return ".npy";
+    case VTK_FORMAT_EXR:
+        return ".exr";
+    default:
+        return ".tiff";
+    }
+}
+
+std::string encode_rgb_file(const std::vector<unsigned char> &pixels,
+                            int width,
+                            int height,
+                            int format,
+                            int compression_level,
+                            const std::filesystem::path &path)
+{
+    std::string error;
+    const bool written = format == VTK_FORMAT_NPY ? write_npy(pixels, width, height, 3, "|u1", path, error)
+                                                  : write_rgb_png(pixels, width, height, compression_level, path, error);
+    return written ? std::string() : error;
+}
+
+std::string encode_depth_file(const std::vector<float> &depth,
+                              int width,
+                              int height,
+                              int format,
+                              int compression_level,
+                              const std::filesystem::path &path)
+{
+    std::string error;
+    bool written = false;
+    switch (format)
+    {
+    case VTK_FORMAT_NPY:
+        written = write_npy(depth, width, height, 1, "<f4", path, error);
+        break;
+    case VTK_FORMAT_EXR:
+        written = write_depth_exr(depth, width, height, path, error);
+        break;
+    default:
+        written = write_depth_tiff(depth, width, height, compression_level, path, error);
+        break;
+    }
+    return written ? std::string() : error;
+}
+
+// Copies bottom-up OpenGL rows into a new top-down array owned by the caller.
+template <typename T>
+T *copy_rows_top_down(const std::vector<T> &source, int width, int height, int components)
+{
+    const std::size_t row = static_cast<std::size_t>(width) * static_cast<std::size_t>(components);
+    T *copy = new T[row * static_cast<std::size_t>(height)];
+    for (int y = 0; y < height; ++y)
+    {
+        std::memcpy(copy + row * static_cast<std::size_t>(height - 1 - y),
+                    source.data() + row * static_cast<std::size_t>(y),
+                    row * sizeof(T));
+    }
+    return copy;
+}
+
+vtkSmartPointer<vtkPolyData> compute_point_normals(vtkPolyData *mesh, std::string &error)
 {
     vtkNew<vtkPolyDataNormals> normals_filter;
     normals_filter->SetInputData(mesh);
@@ -334,13 +1045,23 @@ vtkSmartPointer<vtkPolyData> make_normal_colored_polydata(vtkPolyData *mesh, std
         return nullptr;
     }
 
-    vtkDataArray *normals = normals_poly->GetPointData()->GetNormals();
-    if (!normals)
+    if (!normals_poly->GetPointData()->GetNormals())
     {
         error = "mesh normals are unavailable";
         return nullptr;
     }
+    return normals_poly;
+}
+
+vtkSmartPointer<vtkPolyData> make_normal_colored_polydata(vtkPolyData *mesh, std::string &error)
+{
+    vtkSmartPointer<vtkPolyData> normals_poly = compute_point_normals(mesh, error);
+    if (!normals_poly)
+    {
+        return nullptr;
+    }
 
+    vtkDataArray *normals = normals_poly->GetPointData()->GetNormals();
     vtkNew<vtkUnsignedCharArray> normal_colors;
     normal_colors->SetName("NormalColors");
     normal_colors->SetNumberOfComponents(3);
@@ -363,131 +1084,310 @@ vtkSmartPointer<vtkPolyData> make_normal_colored_polydata(vtkPolyData *mesh, std
     return normals_poly;
 }
 
-VtkRenderOutput *render_pack_impl(const char *input_mesh_path,
-                                  const char *output_directory,
-                                  int width,
-                                  int height,
-                                  const char *const *views,
-                                  int num_views,
-                                  int output_color,
-                                  int output_depth,
-                                  int output_normal)
+std::string validate_dimensions(int width, int height)
 {
+    if (width < kMinDimension || width > kMaxDimension ||
+        height < kMinDimension || height > kMaxDimension)
+    {
+        return "width and height must be between 16 and 8192";
+    }
+    return std::string();
+}
+
+void set_session_error(VtkRenderSession &session, int code, const std::string &message)
+{
+    session.error_code = code;
+    session.error_message = message;
+}
+
+// Creates the window, renderer and both actors once and renders an empty
+// frame so the off-screen context exists before the first submission.
+void open_session_impl(VtkRenderSession &session, int width, int height)
+{
+    const std::string dimension_error = validate_dimensions(width, height);
+    if (!dimension_error.empty())
+    {
+        set_session_error(session, VTK_ERR_INVALID_ARGUMENT, dimension_error);
+        return;
+    }
+    session.width = width;
+    session.height = height;
+
+    session.render_window = vtkSmartPointer<vtkRenderWindow>::New();
+#ifdef __APPLE__
+    session.render_window->SetOffScreenRendering(1);
+#elif defined(__linux__)
+    session.render_window->SetWindowName("AutoSage_Headless_Context");
+    session.render_window->SetOffScreenRendering(1);
+#else
+#error "Unsupported platform for VTK rendering"
+#endif
+    if (session.render_window->GetOffScreenRendering() != 1)
+    {
+        set_session_error(session, VTK_ERR_HEADLESS_CONTEXT_FAILED, "VTK off-screen rendering is unavailable");
+        return;
+    }
+    session.render_window->SetSize(width, height);
+
+    session.renderer = vtkSmartPointer<vtkRenderer>::New();
+    session.renderer->SetBackground(0.0, 0.0, 0.0);
+    session.render_window->AddRenderer(session.renderer);
+
+    session.color_mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+    session.color_mapper->ScalarVisibilityOff();
+
+    session.color_actor = vtkSmartPointer<vtkActor>::New();
+    session.color_actor->SetMapper(session.color_mapper);
+    session.color_actor->GetProperty()->SetColor(0.85, 0.85, 0.9);
+    session.color_actor->GetProperty()->SetInterpolationToPhong();
+    session.color_actor->SetVisibility(0);
+    session.renderer->AddActor(session.color_actor);
+
+    session.normal_mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+    session.normal_mapper->ScalarVisibilityOn();
+    session.normal_mapper->SetScalarModeToUsePointData();
+    session.normal_mapper->SetColorModeToDirectScalars();
+    session.normal_mapper->SelectColorArray("NormalColors");
+
+    session.normal_actor = vtkSmartPointer<vtkActor>::New();
+    session.normal_actor->SetMapper(session.normal_mapper);
+    session.normal_actor->GetProperty()->LightingOff();
+    session.normal_actor->SetVisibility(0);
+    session.renderer->AddActor(session.normal_actor);
+
+    session.capture_pass = vtkSmartPointer<MultiTargetCapturePass>::New();
+
+    // Validate that an off-screen context can be created before any submission.
+    try
+    {
+        session.render_window->Render();
+    }
+    catch (const std::exception &error)
+    {
+        set_session_error(session, VTK_ERR_HEADLESS_CONTEXT_FAILED, std::string("headless context initialization failed: ") + error.what());
+    }
+    catch (...)
+    {
+        set_session_error(session, VTK_ERR_HEADLESS_CONTEXT_FAILED, "headless context initialization failed with unknown exception");
+    }
+}
+
+VtkRenderOptions legacy_render_options(int output_color, int output_depth, int output_normal)
+{
+    VtkRenderOptions options{};
+    options.output_color = output_color;
+    options.output_depth = output_depth;
+    options.output_normal = output_normal;
+    options.write_files = 1;
+    options.return_buffers = 0;
+    options.single_pass = 0;
+    options.encoder_threads = 0;
+    options.compression_level = -1;
+    options.color_format = VTK_FORMAT_DEFAULT;
+    options.depth_format = VTK_FORMAT_DEFAULT;
+    return options;
+}
+
+// Validates everything except the view list and copies it into the request.
+std::string apply_render_options(const char *input_mesh_path,
+                                 const char *output_directory,
+                                 const VtkRenderOptions &options,
+                                 RenderRequest &request)
+{
+    const bool has_output_directory = output_directory != nullptr && output_directory[0] != '\0';
     if (input_mesh_path == nullptr || input_mesh_path[0] == '\0' ||
-        output_directory == nullptr || output_directory[0] == '\0')
+        (options.write_files != 0 && !has_output_directory))
     {
-        return make_error_output(VTK_ERR_INVALID_ARGUMENT, "input_mesh_path and output_directory are required");
+        return "input_mesh_path and output_directory are required";
     }
-    if (width < kMinDimension || width > kMaxDimension ||
-        height < kMinDimension || height > kMaxDimension)
+    if (options.output_color == 0 && options.output_depth == 0 && options.output_normal == 0)
     {
-        return make_error_output(VTK_ERR_INVALID_ARGUMENT, "width and height must be between 16 and 8192");
+        return "at least one output buffer must be enabled";
     }
-    if (num_views <= 0 || views == nullptr)
+    if (options.write_files == 0 && options.return_buffers == 0)
+    {
+        return "write_files or return_buffers must be enabled";
+    }
+    if (options.encoder_threads < 0 || options.encoder_threads > kMaxEncoderThreads)
+    {
+        return "encoder_threads must be between 0 and 64";
+    }
+    if (options.compression_level < -1 || options.compression_level > kMaxCompressionLevel)
+    {
+        return "compression_level must be -1 or between 0 and 9";
+    }
+    if (options.color_format != VTK_FORMAT_DEFAULT && options.color_format != VTK_FORMAT_PNG &&
+        options.color_format != VTK_FORMAT_NPY)
+    {
+        return "color_format must be DEFAULT, PNG or NPY";
+    }
+    if (options.depth_format != VTK_FORMAT_DEFAULT && options.depth_format != VTK_FORMAT_TIFF &&
+        options.depth_format != VTK_FORMAT_NPY && options.depth_format != VTK_FORMAT_EXR)
+    {
+        return "depth_format must be DEFAULT, TIFF, NPY or EXR";
+    }
+
+    request.mesh_path = std::filesystem::path(input_mesh_path);
+    request.output_dir = has_output_directory ? std::filesystem::path(output_directory) : std::filesystem::path();
+    request.output_color = options.output_color != 0;
+    request.output_depth = options.output_depth != 0;
+    request.output_normal = options.output_normal != 0;
+    request.write_files = options.write_files != 0;
+    request.return_buffers = options.return_buffers != 0;
+    request.single_pass = options.single_pass != 0;
+    request.encoder_threads = options.encoder_threads;
+    request.compression_level = options.compression_level;
+    request.color_format = options.color_format == VTK_FORMAT_DEFAULT ? VTK_FORMAT_PNG : options.color_format;
+    request.depth_format = options.depth_format == VTK_FORMAT_DEFAULT ? VTK_FORMAT_TIFF : options.depth_format;
+    return std::string();
+}
+
+std::string build_render_request(const char *input_mesh_path,
+                                 const char *output_directory,
+                                 const char *const *views,
+                                 int num_views,
+                                 const VtkRenderOptions &options,
+                                 RenderRequest &request)
+{
+    const std::string options_error = apply_render_options(input_mesh_path, output_directory, options, request);
+    if (!options_error.empty())
     {
-        return make_error_output(VTK_ERR_INVALID_ARGUMENT, "at least one view must be specified");
+        return options_error;
     }
-    if (output_color == 0 && output_depth == 0 && output_normal == 0)
+    if (num_views <= 0 || views == nullptr)
     {
-        return make_error_output(VTK_ERR_INVALID_ARGUMENT, "at least one output buffer must be enabled");
+        return "at least one view must be specified";
     }
 
-    std::vector<std::string> requested_views;
-    requested_views.reserve(static_cast<std::size_t>(num_views));
+    request.views.clear();
+    request.views.reserve(static_cast<std::size_t>(num_views));
     for (int i = 0; i < num_views; ++i)
     {
         if (views[i] == nullptr || views[i][0] == '\0')
         {
-            return make_error_output(VTK_ERR_INVALID_ARGUMENT, "view names must be non-empty strings");
+            return "view names must be non-empty strings";
         }
-        requested_views.push_back(to_lower_ascii(std::string(views[i])));
+        ViewSpec view;
+        view.name = to_lower_ascii(std::string(views[i]));
+        request.views.push_back(std::move(view));
     }
+    return std::string();
+}
 
-    const std::filesystem::path mesh_path(input_mesh_path);
-    const std::filesystem::path output_dir(output_directory);
-    if (!std::filesystem::exists(mesh_path))
+std::string build_rig_request(const char *input_mesh_path,
+                              const char *output_directory,
+                              const VtkCameraPose *poses,
+                              int num_poses,
+                              int pose_space,
+                              const VtkRenderOptions &options,
+                              RenderRequest &request)
+{
+    const std::string options_error = apply_render_options(input_mesh_path, output_directory, options, request);
+    if (!options_error.empty())
     {
-        return make_error_output(VTK_ERR_IO, "input mesh path does not exist");
+        return options_error;
     }
-
-    try
+    if (num_poses <= 0 || poses == nullptr)
     {
-        std::filesystem::create_directories(output_dir);
+        return "at least one camera pose must be specified";
     }
-    catch (const std::exception &error)
+    if (pose_space != VTK_POSE_WORLD && pose_space != VTK_POSE_NORMALIZED)
     {
-        return make_error_output(VTK_ERR_IO, std::string("failed to create output directory: ") + error.what());
+        return "pose_space must be VTK_POSE_WORLD or VTK_POSE_NORMALIZED";
     }
 
-    std::string load_error;
-    vtkSmartPointer<vtkPolyData> mesh = load_mesh(mesh_path, load_error);
-    if (!mesh)
+    request.pose_space = pose_space;
+    request.views.clear();
+    request.views.reserve(static_cast<std::size_t>(num_poses));
+    for (int i = 0; i < num_poses; ++i)
     {
-        return make_error_output(VTK_ERR_MESH_LOAD_FAILED, load_error);
+        ViewSpec view;
+        view.name = "pose";
+        view.has_pose = true;
+        view.pose = poses[i];
+        request.views.push_back(std::move(view));
     }
+    return std::string();
+}
 
-    vtkNew<vtkRenderWindow> render_window;
-#ifdef __APPLE__
-    render_window->SetOffScreenRendering(1);
-#elif defined(__linux__)
-    render_window->SetWindowName("AutoSage_Headless_Context");
-    render_window->SetOffScreenRendering(1);
-#else
-#error "Unsupported platform for VTK rendering"
-#endif
-    if (render_window->GetOffScreenRendering() != 1)
+VtkRenderOutput *render_session_impl(VtkRenderSession &session, const RenderRequest &request)
+{
+    if (session.error_code != VTK_SUCCESS)
     {
-        return make_error_output(VTK_ERR_HEADLESS_CONTEXT_FAILED, "VTK off-screen rendering is unavailable");
+        return make_error_output(session.error_code, session.error_message);
     }
-    render_window->SetSize(width, height);
-
-    vtkNew<vtkRenderer> renderer;
-    renderer->SetBackground(0.0, 0.0, 0.0);
-    render_window->AddRenderer(renderer);
 
-    vtkNew<vtkPolyDataMapper> color_mapper;
-    color_mapper->SetInputData(mesh);
-    color_mapper->ScalarVisibilityOff();
-
-    vtkNew<vtkActor> color_actor;
-    color_actor->SetMapper(color_mapper);
-    color_actor->GetProperty()->SetColor(0.85, 0.85, 0.9);
-    color_actor->GetProperty()->SetInterpolationToPhong();
-    renderer->AddActor(color_actor);
-
-    std::string normals_error;
-    vtkSmartPointer<vtkPolyData> normal_poly = make_normal_colored_polydata(mesh, normals_error);
-    if (!normal_poly)
+    const std::filesystem::path &mesh_path = request.mesh_path;
+    const std::filesystem::path &output_dir = request.output_dir;
+    if (!std::filesystem::exists(mesh_path))
     {
-        return make_error_output(VTK_ERR_BUFFER_EXTRACTION_FAILED, normals_error);
+        return make_error_output(VTK_ERR_IO, "input mesh path does not exist");
     }
 
-    vtkNew<vtkPolyDataMapper> normal_mapper;
-    normal_mapper->SetInputData(normal_poly);
-    normal_mapper->ScalarVisibilityOn();
-    normal_mapper->SetScalarModeToUsePointData();
-    normal_mapper->SetColorModeToDirectScalars();
-    normal_mapper->SelectColorArray("NormalColors");
-
-    vtkNew<vtkActor> normal_actor;
-    normal_actor->SetMapper(normal_mapper);
-    normal_actor->GetProperty()->LightingOff();
-    normal_actor->SetVisibility(0);
-    renderer->AddActor(normal_actor);
+    if (request.write_files)
+    {
+        try
+        {
+            std::filesystem::create_directories(output_dir);
+        }
+        catch (const std::exception &error)
+        {
+            return make_error_output(VTK_ERR_IO, std::string("failed to create output directory: ") + error.what());
+        }
+    }
 
-    // Validate that an off-screen context can be created before processing views.
-    try
+    std::string load_error;
+    vtkSmartPointer<vtkPolyData> mesh = load_mesh(mesh_path, load_error);
+    if (!mesh)
     {
-        render_window->Render();
+        return make_error_output(VTK_ERR_MESH_LOAD_FAILED, load_error);
     }
-    catch (const std::exception &error)
+
+    vtkRenderWindow *render_window = session.render_window;
+    vtkRenderer *renderer = session.renderer;
+    vtkActor *color_actor = session.color_actor;
+    vtkActor *normal_actor = session.normal_actor;
+
+    // Swapping mapper inputs keeps the context and compiled shader programs;
+    // only the vertex buffers are re-uploaded for the new mesh.
+    if (request.single_pass)
     {
-        return make_error_output(VTK_ERR_HEADLESS_CONTEXT_FAILED, std::string("headless context initialization failed: ") + error.what());
+        // The patched surface shader reads the interpolated point normals, so
+        // the color actor draws the normal-bearing mesh and the second actor
+        // is not needed.
+        vtkSmartPointer<vtkPolyData> surface = mesh;
+        if (request.output_normal)
+        {
+            std::string normals_error;
+            surface = compute_point_normals(mesh, normals_error);
+            if (!surface)
+            {
+                return make_error_output(VTK_ERR_BUFFER_EXTRACTION_FAILED, normals_error);
+            }
+        }
+        session.color_mapper->SetInputData(surface);
+        session.capture_pass->capture_color = request.output_color;
+        session.capture_pass->capture_depth = request.output_depth;
+        session.capture_pass->capture_normal = request.output_normal;
+        renderer->SetPass(session.capture_pass);
     }
-    catch (...)
+    else
     {
-        return make_error_output(VTK_ERR_HEADLESS_CONTEXT_FAILED, "headless context initialization failed with unknown exception");
+        session.color_mapper->SetInputData(mesh);
+        if (request.output_normal)
+        {
+            std::string normals_error;
+            vtkSmartPointer<vtkPolyData> normal_poly = make_normal_colored_polydata(mesh, normals_error);
+            if (!normal_poly)
+            {
+                return make_error_output(VTK_ERR_BUFFER_EXTRACTION_FAILED, normals_error);
+            }
+            session.normal_mapper->SetInputData(normal_poly);
+        }
+        renderer->SetPass(nullptr);
     }
+    color_actor->SetVisibility(1);
+    normal_actor->SetVisibility(0);
 
     double bounds[6] = {0, 0, 0, 0, 0, 0};
     mesh->GetBounds(bounds);
@@ -501,15 +1401,54 @@ VtkRenderOutput *render_pack_impl(const char *input_mesh_path,
     const double diagonal = std::max(1.0e-3, std::sqrt(span_x * span_x + span_y * span_y + span_z * span_z));
     const double camera_distance = diagonal * 2.0;
 
-    std::vector<ViewPaths> output_paths(static_cast<std::size_t>(num_views));
-    std::array<float, 9> intrinsics = {0, 0, 0, 0, 0, 0, 0, 0, 1};
+    const int width = session.width;
+    const int height = session.height;
+    const std::size_t num_views = request.views.size();
+    std::vector<ViewPaths> output_paths(num_views);
+    std::vector<ViewBuffers> output_buffers(request.return_buffers ? num_views : 0);
+    std::vector<ViewCamera> view_cameras(num_views);
+    ViewBuffers scratch;
+
+    EncoderPool *pool = nullptr;
+    if (request.write_files && request.encoder_threads > 0)
+    {
+        if (!session.encoder_pool || session.encoder_pool->thread_count() != request.encoder_threads)
+        {
+            session.encoder_pool = std::make_unique<EncoderPool>(request.encoder_threads);
+        }
+        pool = session.encoder_pool.get();
+    }
+    // Queued encodes may reference output_buffers, so every exit path drains
+    // the pool before those buffers go out of scope.
+    struct EncoderDrain
+    {
+        EncoderPool *pool;
+        ~EncoderDrain()
+        {
+            if (pool != nullptr)
+            {
+                pool->wait();
+            }
+        }
+    } drain{pool};
+    const auto dispatch = [pool](EncoderPool::Task task) -> std::string {
+        if (pool != nullptr)
+        {
+            pool->submit(std::move(task));
+            return std::string();
+        }
+        return task();
+    };
 
     vtkCamera *camera = renderer->GetActiveCamera();
-    for (int index = 0; index < num_views; ++index)
+    for (std::size_t index = 0; index < num_views; ++index)
     {
-        const std::string &view_name = requested_views[static_cast<std::size_t>(index)];
+        const ViewSpec &view_spec = request.views[index];
         std::string pose_error;
-        if (!set_view_pose(camera, view_name, center, camera_distance, pose_error))
+        const bool posed = view_spec.has_pose
+                               ? apply_camera_pose(camera, view_spec.pose, request.pose_space, center, diagonal, pose_error)
+                               : set_view_pose(camera, view_spec.name, center, camera_distance, pose_error);
+        if (!posed)
         {
             return make_error_output(VTK_ERR_INVALID_ARGUMENT, pose_error);
         }
@@ -528,83 +1467,237 @@ VtkRenderOutput *render_pack_impl(const char *input_mesh_path,
             return make_error_output(VTK_ERR_HEADLESS_CONTEXT_FAILED, "headless render failed with unknown exception");
         }
 
-        compute_camera_intrinsics(camera, width, height, intrinsics.data());
+        view_cameras[index] = capture_view_camera(camera, width, height);
 
-        const std::string token = sanitize_view_token(view_name);
-        const std::string prefix = std::to_string(index) + "_" + token;
-        ViewPaths &paths = output_paths[static_cast<std::size_t>(index)];
+        ViewBuffers &buffers = request.return_buffers ? output_buffers[index] : scratch;
         std::string buffer_error;
-
-        if (output_color != 0)
+        if (request.single_pass)
         {
-            std::filesystem::path color_path = output_dir / (prefix + "_color.png");
-            color_actor->SetVisibility(1);
-            normal_actor->SetVisibility(0);
-            if (!write_rgb_capture(render_window, color_path, buffer_error))
+            MultiTargetCapturePass &pass = *session.capture_pass;
+            if (!pass.captured())
             {
-                return make_error_output(VTK_ERR_BUFFER_EXTRACTION_FAILED, buffer_error);
+                return make_error_output(VTK_ERR_BUFFER_EXTRACTION_FAILED, "multi-target framebuffer is unavailable");
+            }
+            if (request.output_color)
+            {
+                buffers.color.swap(pass.color);
+            }
+            if (request.output_normal)
+            {
+                buffers.normal.swap(pass.normal);
+            }
+            if (request.output_depth)
+            {
+                buffers.depth.swap(pass.depth);
+                const double near_clip = std::max(1.0e-6, static_cast<double>(view_cameras[index].near_clip));
+                const double far_clip = std::max(near_clip + 1.0e-6, static_cast<double>(view_cameras[index].far_clip));
+                linearize_depth_buffer(buffers.depth.data(), buffers.depth.size(), static_cast<float>(near_clip), static_cast<float>(far_clip));
             }
-            paths.color = std::filesystem::absolute(color_path).string();
         }
-
-        if (output_depth != 0)
+        else
         {
-            std::filesystem::path depth_path = output_dir / (prefix + "_depth.tiff");
-            color_actor->SetVisibility(1);
-            normal_actor->SetVisibility(0);
-            if (!write_depth_capture(renderer, render_window, width, height, depth_path, buffer_error))
+            if (request.output_color && !read_rgb_pixels(render_window, width, height, buffers.color, buffer_error))
             {
                 return make_error_output(VTK_ERR_BUFFER_EXTRACTION_FAILED, buffer_error);
             }
-            paths.depth = std::filesystem::absolute(depth_path).string();
+            if (request.output_depth && !read_linear_depth(renderer, render_window, width, height, buffers.depth, buffer_error))
+            {
+                return make_error_output(VTK_ERR_BUFFER_EXTRACTION_FAILED, buffer_error);
+            }
+            if (request.output_normal)
+            {
+                color_actor->SetVisibility(0);
+                normal_actor->SetVisibility(1);
+                try
+                {
+                    render_window->Render();
+                }
+                catch (const std::exception &error)
+                {
+                    return make_error_output(VTK_ERR_RENDER_FAILED, std::string("normal-buffer render failed: ") + error.what());
+                }
+                catch (...)
+                {
+                    return make_error_output(VTK_ERR_RENDER_FAILED, "normal-buffer render failed with unknown exception");
+                }
+                color_actor->SetVisibility(1);
+                normal_actor->SetVisibility(0);
+                if (!read_rgb_pixels(render_window, width, height, buffers.normal, buffer_error))
+                {
+                    return make_error_output(VTK_ERR_BUFFER_EXTRACTION_FAILED, buffer_error);
+                }
+            }
         }
 
-        if (output_normal != 0)
+        if (!request.write_files)
         {
-            std::filesystem::path normal_path = output_dir / (prefix + "_normal.png");
-            color_actor->SetVisibility(0);
-            normal_actor->SetVisibility(1);
-            try
-            {
-                render_window->Render();
-            }
-            catch (const std::exception &error)
+            continue;
+        }
+
+        // Encoders read from a shared snapshot of this view's buffers; without
+        // return_buffers the snapshot takes ownership so the next view can
+        // render into fresh storage while this one is compressed.
+        std::shared_ptr<const ViewBuffers> source;
+        if (request.return_buffers)
+        {
+            source = std::shared_ptr<const ViewBuffers>(std::shared_ptr<const ViewBuffers>(), &output_buffers[index]);
+        }
+        else
+        {
+            source = std::make_shared<const ViewBuffers>(std::move(scratch));
+            scratch = ViewBuffers();
+        }
+
+        const std::string token = sanitize_view_token(view_spec.name);
+        const std::string prefix = std::to_string(index) + "_" + token;
+        const int compression_level = request.compression_level;
+        ViewPaths &paths = output_paths[index];
+        if (request.output_color)
+        {
+            const std::filesystem::path color_path = output_dir / (prefix + "_color" + rgb_extension(request.color_format));
+            const int format = request.color_format;
+            buffer_error = dispatch([source, width, height, format, compression_level, color_path]() {
+                return encode_rgb_file(source->color, width, height, format, compression_level, color_path);
+            });
+            if (!buffer_error.empty())
             {
-                return make_error_output(VTK_ERR_RENDER_FAILED, std::string("normal-buffer render failed: ") + error.what());
+                return make_error_output(VTK_ERR_IO, buffer_error);
             }
-            catch (...)
+            paths.color = std::filesystem::absolute(color_path).string();
+        }
+        if (request.output_depth)
+        {
+            const std::filesystem::path depth_path = output_dir / (prefix + "_depth" + depth_extension(request.depth_format));
+            const int format = request.depth_format;
+            buffer_error = dispatch([source, width, height, format, compression_level, depth_path]() {
+                return encode_depth_file(source->depth, width, height, format, compression_level, depth_path);
+            });
+            if (!buffer_error.empty())
             {
-                return make_error_output(VTK_ERR_RENDER_FAILED, "normal-buffer render failed with unknown exception");
+                return make_error_output(VTK_ERR_IO, buffer_error);
             }
-            if (!write_rgb_capture(render_window, normal_path, buffer_error))
+            paths.depth = std::filesystem::absolute(depth_path).string();
+        }
+        if (request.output_normal)
+        {
+            const std::filesystem::path normal_path = output_dir / (prefix + "_normal" + rgb_extension(request.color_format));
+            const int format = request.color_format;
+            buffer_error = dispatch([source, width, height, format, compression_level, normal_path]() {
+                return encode_rgb_file(source->normal, width, height, format, compression_level, normal_path);
+            });
+            if (!buffer_error.empty())
             {
-                return make_error_output(VTK_ERR_BUFFER_EXTRACTION_FAILED, buffer_error);
+                return make_error_output(VTK_ERR_IO, buffer_error);
             }
             paths.normal = std::filesystem::absolute(normal_path).string();
-            color_actor->SetVisibility(1);
-            normal_actor->SetVisibility(0);
         }
     }
 
-    auto *result = new VtkRenderOutput{};
-    result->num_views = num_views;
-    result->views = new VtkViewResult[static_cast<std::size_t>(num_views)];
+    if (pool != nullptr)
+    {
+        const std::string encode_error = pool->wait();
+        if (!encode_error.empty())
+        {
+            return make_error_output(VTK_ERR_IO, encode_error);
+        }
+    }
+
+    std::unique_ptr<VtkRenderOutput, decltype(&vtk_free_result)> result(new VtkRenderOutput{}, &vtk_free_result);
+    result->views = new VtkViewResult[num_views]{};
+    result->num_views = static_cast<int>(num_views);
+    // The shared intrinsics predate per-view cameras and report the last view.
     for (int i = 0; i < 9; ++i)
     {
-        result->camera_intrinsics[i] = intrinsics[static_cast<std::size_t>(i)];
+        result->camera_intrinsics[i] = view_cameras.back().intrinsics[static_cast<std::size_t>(i)];
     }
     result->error_code = VTK_SUCCESS;
     result->error_message = nullptr;
 
-    for (int index = 0; index < num_views; ++index)
+    for (std::size_t index = 0; index < num_views; ++index)
     {
-        const ViewPaths &paths = output_paths[static_cast<std::size_t>(index)];
-        result->views[index].color_path = paths.color.empty() ? nullptr : duplicate_c_string(paths.color);
-        result->views[index].depth_path = paths.depth.empty() ? nullptr : duplicate_c_string(paths.depth);
-        result->views[index].normal_path = paths.normal.empty() ? nullptr : duplicate_c_string(paths.normal);
+        const ViewPaths &paths = output_paths[index];
+        const ViewCamera &view_camera = view_cameras[index];
+        VtkViewResult &view = result->views[index];
+        view.color_path = paths.color.empty() ? nullptr : duplicate_c_string(paths.color);
+        view.depth_path = paths.depth.empty() ? nullptr : duplicate_c_string(paths.depth);
+        view.normal_path = paths.normal.empty() ? nullptr : duplicate_c_string(paths.normal);
+        view.width = width;
+        view.height = height;
+        std::copy(view_camera.intrinsics.begin(), view_camera.intrinsics.end(), view.intrinsics);
+        std::copy(view_camera.extrinsics.begin(), view_camera.extrinsics.end(), view.extrinsics);
+        view.near_clip = view_camera.near_clip;
+        view.far_clip = view_camera.far_clip;
+        if (request.return_buffers)
+        {
+            const ViewBuffers &buffers = output_buffers[index];
+            view.color_pixels = buffers.color.empty() ? nullptr : copy_rows_top_down(buffers.color, width, height, 3);
+            view.depth_pixels = buffers.depth.empty() ? nullptr : copy_rows_top_down(buffers.depth, width, height, 1);
+            view.normal_pixels = buffers.normal.empty() ? nullptr : copy_rows_top_down(buffers.normal, width, height, 3);
+        }
     }
 
-    return result;
+    return result.release();
+}
+
+VtkRenderOutput *render_pack_impl(const char *input_mesh_path,
+                                  const char *output_directory,
+                                  int width,
+                                  int height,
+                                  const char *const *views,
+                                  int num_views,
+                                  int output_color,
+                                  int output_depth,
+                                  int output_normal)
+{
+    RenderRequest request;
+    const std::string request_error = build_render_request(input_mesh_path,
+                                                           output_directory,
+                                                           views,
+                                                           num_views,
+                                                           legacy_render_options(output_color, output_depth, output_normal),
+                                                           request);
+    if (!request_error.empty())
+    {
+        return make_error_output(VTK_ERR_INVALID_ARGUMENT, request_error);
+    }
+
+    VtkRenderSession session;
+    open_session_impl(session, width, height);
+    return render_session_impl(session, request);
+}
+
+VtkRenderOutput *session_render_impl(VtkRenderSession &session,
+                                     const char *input_mesh_path,
+                                     const char *output_directory,
+                                     const char *const *views,
+                                     int num_views,
+                                     const VtkRenderOptions &options)
+{
+    RenderRequest request;
+    const std::string request_error = build_render_request(input_mesh_path, output_directory, views, num_views, options, request);
+    if (!request_error.empty())
+    {
+        return make_error_output(VTK_ERR_INVALID_ARGUMENT, request_error);
+    }
+    return render_session_impl(session, request);
+}
+
+VtkRenderOutput *session_render_rig_impl(VtkRenderSession &session,
+                                         const char *input_mesh_path,
+                                         const char *output_directory,
+                                         const VtkCameraPose *poses,
+                                         int num_poses,
+                                         int pose_space,
+                                         const VtkRenderOptions &options)
+{
+    RenderRequest request;
+    const std::string request_error =
+        build_rig_request(input_mesh_path, output_directory, poses, num_poses, pose_space, options, request);
+    if (!request_error.empty())
+    {
+        return make_error_output(VTK_ERR_INVALID_ARGUMENT, request_error);
+    }
+    return render_session_impl(session, request);
 }
 
 } // namespace
@@ -641,6 +1734,159 @@ extern "C" VtkRenderOutput *vtk_render_pack(const char *input_mesh_path,
     }
 }
 
+extern "C" void vtk_default_render_options(VtkRenderOptions *options)
+{
+    if (options == nullptr)
+    {
+        return;
+    }
+    *options = legacy_render_options(1, 1, 1);
+    options->single_pass = 1;
+    options->encoder_threads = kDefaultEncoderThreads;
+}
+
+extern "C" VtkRenderSession *vtk_session_open(int width, int height)
+{
+    VtkRenderSession *session = nullptr;
+    try
+    {
+        session = new VtkRenderSession{};
+        open_session_impl(*session, width, height);
+    }
+    catch (const std::bad_alloc &)
+    {
+        delete session;
+        return nullptr;
+    }
+    catch (const std::exception &error)
+    {
+        set_session_error(*session, VTK_ERR_RUNTIME, std::string("unexpected VTK failure: ") + error.what());
+    }
+    catch (...)
+    {
+        set_session_error(*session, VTK_ERR_RUNTIME, "unexpected non-standard exception in vtk_session_open");
+    }
+    return session;
+}
+
+extern "C" int vtk_session_error_code(const VtkRenderSession *session)
+{
+    return session == nullptr ? VTK_ERR_INVALID_ARGUMENT : session->error_code;
+}
+
+extern "C" const char *vtk_session_error_message(const VtkRenderSession *session)
+{
+    if (session == nullptr || session->error_message.empty())
+    {
+        return nullptr;
+    }
+    return session->error_message.c_str();
+}
+
+extern "C" VtkRenderOutput *vtk_session_render(VtkRenderSession *session,
+                                                const char *input_mesh_path,
+                                                const char *output_directory,
+                                                const char *const *views,
+                                                int num_views,
+                                                int output_color,
+                                                int output_depth,
+                                                int output_normal)
+{
+    if (session == nullptr)
+    {
+        return make_error_output(VTK_ERR_INVALID_ARGUMENT, "session must be non-null");
+    }
+
+    try
+    {
+        return session_render_impl(*session,
+                                   input_mesh_path,
+                                   output_directory,
+                                   views,
+                                   num_views,
+                                   legacy_render_options(output_color, output_depth, output_normal));
+    }
+    catch (const std::exception &error)
+    {
+        return make_error_output(VTK_ERR_RUNTIME, std::string("unexpected VTK failure: ") + error.what());
+    }
+    catch (...)
+    {
+        return make_error_output(VTK_ERR_RUNTIME, "unexpected non-standard exception in vtk_session_render");
+    }
+}
+
+extern "C" VtkRenderOutput *vtk_session_render_ex(VtkRenderSession *session,
+                                                   const char *input_mesh_path,
+                                                   const char *output_directory,
+                                                   const char *const *views,
+                                                   int num_views,
+                                                   const VtkRenderOptions *options)
+{
+    if (session == nullptr || options == nullptr)
+    {
+        return make_error_output(VTK_ERR_INVALID_ARGUMENT, "session and options must be non-null");
+    }
+
+    try
+    {
+        return session_render_impl(*session, input_mesh_path, output_directory, views, num_views, *options);
+    }
+    catch (const std::exception &error)
+    {
+        return make_error_output(VTK_ERR_RUNTIME, std::string("unexpected VTK failure: ") + error.what());
+    }
+    catch (...)
+    {
+        return make_error_output(VTK_ERR_RUNTIME, "unexpected non-standard exception in vtk_session_render_ex");
+    }
+}
+
+extern "C" VtkRenderOutput *vtk_session_render_rig(VtkRenderSession *session,
+                                                    const char *input_mesh_path,
+                                                    const char *output_directory,
+                                                    const VtkCameraPose *poses,
+                                                    int num_poses,
+                                                    int pose_space,
+                                                    const VtkRenderOptions *options)
+{
+    if (session == nullptr || options == nullptr)
+    {
+        return make_error_output(VTK_ERR_INVALID_ARGUMENT, "session and options must be non-null");
+    }
+
+    try
+    {
+        return session_render_rig_impl(*session, input_mesh_path, output_directory, poses, num_poses, pose_space, *options);
+    }
+    catch (const std::exception &error)
+    {
+        return make_error_output(VTK_ERR_RUNTIME, std::string("unexpected VTK failure: ") + error.what());
+    }
+    catch (...)
+    {
+        return make_error_output(VTK_ERR_RUNTIME, "unexpected non-standard exception in vtk_session_render_rig");
+    }
+}
+
+extern "C" void vtk_session_close(VtkRenderSession *session)
+{
+    if (session == nullptr)
+    {
+        return;
+    }
+
+    if (session->render_window)
+    {
+        if (session->capture_pass)
+        {
+            session->capture_pass->ReleaseGraphicsResources(session->render_window);
+        }
+        session->render_window->Finalize();
+    }
+    delete session;
+}
+
 extern "C" void vtk_free_result(VtkRenderOutput *result)
 {
     if (result == nullptr)
@@ -655,6 +1901,9 @@ extern "C" void vtk_free_result(VtkRenderOutput *result)
             delete[] const_cast<char *>(result->views[i].color_path);
             delete[] const_cast<char *>(result->views[i].depth_path);
             delete[] const_cast<char *>(result->views[i].normal_path);
+            delete[] result->views[i].color_pixels;
+            delete[] result->views[i].depth_pixels;
+            delete[] result->views[i].normal_pixels;
         }
         delete[] result->views;
     }
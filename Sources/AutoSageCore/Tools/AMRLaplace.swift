@@ -26,12 +26,16 @@ private struct AMRLaplaceConfig: Codable, Equatable, Sendable {
     let sourceTerm: Double?
     let amrSettings: AMRLaplaceSettings
     let bcs: [AMRLaplaceBoundaryCondition]
+    let probes: ProbesConfig?
+    let fieldOutput: Bool?
 
     enum CodingKeys: String, CodingKey {
         case coefficient
         case sourceTerm = "source_term"
         case amrSettings = "amr_settings"
         case bcs
+        case probes
+        case fieldOutput = "field_output"
     }
 }
 
@@ -130,7 +134,9 @@ public struct AMRLaplaceTool: Tool {
                             ]),
                             "required": .stringArray(["attribute", "type", "value"])
                         ])
-                    ])
+                    ]),
+                    "probes": ProbesConfig.schema,
+                    "field_output": ProbesConfig.fieldOutputSchema
                 ]),
                 "required": .stringArray(["coefficient", "amr_settings", "bcs"])
             ])
@@ -206,6 +212,8 @@ public struct AMRLaplaceTool: Tool {
             throw AutoSageError(code: "invalid_input", message: "config.bcs must include at least one fixed boundary condition.")
         }
 
+        try decoded.config.probes?.validate()
+
         return decoded
     }
 
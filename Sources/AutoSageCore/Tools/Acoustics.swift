@@ -18,15 +18,23 @@ private struct AcousticsConfig: Codable, Equatable, Sendable {
     let waveSpeed: Double
     let dt: Double
     let tFinal: Double
+    let timeIntegration: String?
+    let cfl: Double?
     let initialCondition: AcousticsInitialCondition
     let bcs: [AcousticsBoundaryCondition]
+    let probes: ProbesConfig?
+    let fieldOutput: Bool?
 
     enum CodingKeys: String, CodingKey {
         case waveSpeed = "wave_speed"
         case dt
         case tFinal = "t_final"
+        case timeIntegration = "time_integration"
+        case cfl
         case initialCondition = "initial_condition"
         case bcs
+        case probes
+        case fieldOutput = "field_output"
     }
 }
 
@@ -103,6 +111,12 @@ public struct AcousticsTool: Tool {
                     "wave_speed": .object(["type": .string("number")]),
                     "dt": .object(["type": .string("number")]),
                     "t_final": .object(["type": .string("number")]),
+                    "time_integration": .object([
+                        "type": .string("string"),
+                        "enum": .stringArray(["implicit", "explicit"]),
+                        "description": .string("explicit uses a lumped mass and CFL-limited central-difference substeps.")
+                    ]),
+                    "cfl": .object(["type": .string("number")]),
                     "initial_condition": .object([
                         "type": .string("object"),
                         "properties": .object([
@@ -131,7 +145,9 @@ public struct AcousticsTool: Tool {
                             ]),
                             "required": .stringArray(["attribute", "type"])
                         ])
-                    ])
+                    ]),
+                    "probes": ProbesConfig.schema,
+                    "field_output": ProbesConfig.fieldOutputSchema
                 ]),
                 "required": .stringArray(["wave_speed", "dt", "t_final", "initial_condition", "bcs"])
             ])
@@ -189,6 +205,15 @@ public struct AcousticsTool: Tool {
         if decoded.config.tFinal <= 0 {
             throw AutoSageError(code: "invalid_input", message: "config.t_final must be > 0.")
         }
+        if let timeIntegration = decoded.config.timeIntegration {
+            let normalized = timeIntegration.trimmingCharacters(in: .whitespacesAndNewlines).lowercased()
+            guard normalized == "implicit" || normalized == "explicit" else {
+                throw AutoSageError(code: "invalid_input", message: "config.time_integration must be implicit or explicit.")
+            }
+        }
+        if let cfl = decoded.config.cfl, !(cfl > 0 && cfl < 1) {
+            throw AutoSageError(code: "invalid_input", message: "config.cfl must be in (0, 1).")
+        }
 
         let initialType = decoded.config.initialCondition.type.trimmingCharacters(in: .whitespacesAndNewlines).lowercased()
         guard initialType == "gaussian_pulse" || initialType == "gaussian-pulse" || initialType == "gaussianpulse" else {
@@ -220,6 +245,8 @@ public struct AcousticsTool: Tool {
             }
         }
 
+        try decoded.config.probes?.validate()
+
         return decoded
     }
 
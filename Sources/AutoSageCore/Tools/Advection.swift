@@ -24,6 +24,8 @@ private struct AdvectionConfig: Codable, Equatable, Sendable {
     let outputIntervalSteps: Int?
     let initialCondition: AdvectionInitialCondition
     let bcs: [AdvectionBoundaryCondition]
+    let probes: ProbesConfig?
+    let fieldOutput: Bool?
 
     enum CodingKeys: String, CodingKey {
         case velocityField = "velocity_field"
@@ -33,6 +35,8 @@ private struct AdvectionConfig: Codable, Equatable, Sendable {
         case outputIntervalSteps = "output_interval_steps"
         case initialCondition = "initial_condition"
         case bcs
+        case probes
+        case fieldOutput = "field_output"
     }
 }
 
@@ -144,7 +148,9 @@ public struct AdvectionTool: Tool {
                             ]),
                             "required": .stringArray(["attribute", "type", "value"])
                         ])
-                    ])
+                    ]),
+                    "probes": ProbesConfig.schema,
+                    "field_output": ProbesConfig.fieldOutputSchema
                 ]),
                 "required": .stringArray(["velocity_field", "dt", "t_final", "initial_condition", "bcs"])
             ])
@@ -237,6 +243,8 @@ public struct AdvectionTool: Tool {
             }
         }
 
+        try decoded.config.probes?.validate()
+
         return decoded
     }
 
@@ -13,11 +13,15 @@ private struct AnisotropicDiffusionConfig: Codable, Equatable, Sendable {
     let diffusionTensor: [Double]
     let sourceTerm: Double?
     let bcs: [AnisotropicDiffusionBoundaryCondition]
+    let probes: ProbesConfig?
+    let fieldOutput: Bool?
 
     enum CodingKeys: String, CodingKey {
         case diffusionTensor = "diffusion_tensor"
         case sourceTerm = "source_term"
         case bcs
+        case probes
+        case fieldOutput = "field_output"
     }
 }
 
@@ -110,7 +114,9 @@ public struct AnisotropicDiffusionTool: Tool {
                             ]),
                             "required": .stringArray(["attribute", "type", "value"])
                         ])
-                    ])
+                    ]),
+                    "probes": ProbesConfig.schema,
+                    "field_output": ProbesConfig.fieldOutputSchema
                 ]),
                 "required": .stringArray(["diffusion_tensor", "bcs"])
             ])
@@ -192,6 +198,8 @@ public struct AnisotropicDiffusionTool: Tool {
             throw AutoSageError(code: "invalid_input", message: "config.bcs must include at least one fixed boundary condition.")
         }
 
+        try decoded.config.probes?.validate()
+
         return decoded
     }
 
@@ -15,14 +15,20 @@ private struct CFDConfig: Codable, Equatable, Sendable {
     let density: Double
     let dt: Double
     let tFinal: Double
+    let timeScheme: String?
     let bcs: [CFDBoundaryCondition]
+    let probes: ProbesConfig?
+    let fieldOutput: Bool?
 
     enum CodingKeys: String, CodingKey {
         case viscosity
         case density
         case dt
         case tFinal = "t_final"
+        case timeScheme = "time_scheme"
         case bcs
+        case probes
+        case fieldOutput = "field_output"
     }
 }
 
@@ -100,6 +106,10 @@ public struct CFDTool: Tool {
                     "density": .object(["type": .string("number")]),
                     "dt": .object(["type": .string("number")]),
                     "t_final": .object(["type": .string("number")]),
+                    "time_scheme": .object([
+                        "type": .string("string"),
+                        "enum": .stringArray(["bdf1", "bdf2"])
+                    ]),
                     "bcs": .object([
                         "type": .string("array"),
                         "items": .object([
@@ -118,7 +128,9 @@ public struct CFDTool: Tool {
                             ]),
                             "required": .stringArray(["attr", "type"])
                         ])
-                    ])
+                    ]),
+                    "probes": ProbesConfig.schema,
+                    "field_output": ProbesConfig.fieldOutputSchema
                 ]),
                 "required": .stringArray(["viscosity", "density", "dt", "t_final", "bcs"])
             ])
@@ -181,6 +193,12 @@ public struct CFDTool: Tool {
         if decoded.config.tFinal <= 0 {
             throw AutoSageError(code: "invalid_input", message: "config.t_final must be > 0.")
         }
+        if let timeScheme = decoded.config.timeScheme {
+            let normalized = timeScheme.trimmingCharacters(in: .whitespacesAndNewlines).lowercased()
+            guard normalized == "bdf1" || normalized == "bdf2" else {
+                throw AutoSageError(code: "invalid_input", message: "config.time_scheme must be bdf1 or bdf2.")
+            }
+        }
 
         for boundary in decoded.config.bcs {
             guard boundary.attr > 0 else {
@@ -203,6 +221,8 @@ public struct CFDTool: Tool {
             }
         }
 
+        try decoded.config.probes?.validate()
+
         return decoded
     }
 
@@ -28,6 +28,8 @@ private struct CompressibleConfig: Codable, Equatable, Sendable {
     let outputIntervalSteps: Int?
     let initialCondition: CompressibleInitialCondition
     let bcs: [CompressibleBoundaryCondition]
+    let probes: ProbesConfig?
+    let fieldOutput: Bool?
 
     enum CodingKeys: String, CodingKey {
         case specificHeatRatio = "specific_heat_ratio"
@@ -37,6 +39,8 @@ private struct CompressibleConfig: Codable, Equatable, Sendable {
         case outputIntervalSteps = "output_interval_steps"
         case initialCondition = "initial_condition"
         case bcs
+        case probes
+        case fieldOutput = "field_output"
     }
 }
 
@@ -146,7 +150,9 @@ public struct CompressibleFlowTool: Tool {
                             ]),
                             "required": .stringArray(["attribute", "type"])
                         ])
-                    ])
+                    ]),
+                    "probes": ProbesConfig.schema,
+                    "field_output": ProbesConfig.fieldOutputSchema
                 ]),
                 "required": .stringArray(["specific_heat_ratio", "dt", "t_final", "initial_condition", "bcs"])
             ])
@@ -250,6 +256,8 @@ public struct CompressibleFlowTool: Tool {
             }
         }
 
+        try decoded.config.probes?.validate()
+
         return decoded
     }
 
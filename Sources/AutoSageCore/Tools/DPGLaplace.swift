@@ -14,12 +14,16 @@ private struct DPGLaplaceConfig: Codable, Equatable, Sendable {
     let sourceTerm: Double?
     let order: Int?
     let bcs: [DPGLaplaceBoundaryCondition]
+    let probes: ProbesConfig?
+    let fieldOutput: Bool?
 
     enum CodingKeys: String, CodingKey {
         case coefficient
         case sourceTerm = "source_term"
         case order
         case bcs
+        case probes
+        case fieldOutput = "field_output"
     }
 }
 
@@ -110,7 +114,9 @@ public struct DPGLaplaceTool: Tool {
                             ]),
                             "required": .stringArray(["attribute", "type", "value"])
                         ])
-                    ])
+                    ]),
+                    "probes": ProbesConfig.schema,
+                    "field_output": ProbesConfig.fieldOutputSchema
                 ]),
                 "required": .stringArray(["coefficient", "bcs"])
             ])
@@ -189,6 +195,8 @@ public struct DPGLaplaceTool: Tool {
             }
         }
 
+        try decoded.config.probes?.validate()
+
         return decoded
     }
 
@@ -13,11 +13,17 @@ private struct DarcyConfig: Codable, Equatable, Sendable {
     let permeability: Double
     let sourceTerm: Double?
     let bcs: [DarcyBoundaryCondition]
+    let formulation: String?
+    let probes: ProbesConfig?
+    let fieldOutput: Bool?
 
     enum CodingKeys: String, CodingKey {
         case permeability
         case sourceTerm = "source_term"
         case bcs
+        case formulation
+        case probes
+        case fieldOutput = "field_output"
     }
 }
 
@@ -107,7 +113,13 @@ public struct DarcyTool: Tool {
                             ]),
                             "required": .stringArray(["attribute", "type"])
                         ])
-                    ])
+                    ]),
+                    "formulation": .object([
+                        "type": .string("string"),
+                        "enum": .stringArray(["mixed", "hybridized"])
+                    ]),
+                    "probes": ProbesConfig.schema,
+                    "field_output": ProbesConfig.fieldOutputSchema
                 ]),
                 "required": .stringArray(["permeability", "bcs"])
             ])
@@ -189,6 +201,15 @@ public struct DarcyTool: Tool {
             )
         }
 
+        if let formulation = decoded.config.formulation {
+            let normalized = formulation.trimmingCharacters(in: .whitespacesAndNewlines).lowercased()
+            guard normalized == "mixed" || normalized == "hybridized" else {
+                throw AutoSageError(code: "invalid_input", message: "config.formulation must be mixed or hybridized.")
+            }
+        }
+
+        try decoded.config.probes?.validate()
+
         return decoded
     }
 
@@ -12,11 +12,15 @@ private struct EigenvalueConfig: Codable, Equatable, Sendable {
     let materialCoefficient: Double
     let numEigenmodes: Int
     let bcs: [EigenvalueBoundaryCondition]
+    let probes: ProbesConfig?
+    let fieldOutput: Bool?
 
     enum CodingKeys: String, CodingKey {
         case materialCoefficient = "material_coefficient"
         case numEigenmodes = "num_eigenmodes"
         case bcs
+        case probes
+        case fieldOutput = "field_output"
     }
 }
 
@@ -105,7 +109,9 @@ public struct EigenvalueTool: Tool {
                             ]),
                             "required": .stringArray(["attribute", "type"])
                         ])
-                    ])
+                    ]),
+                    "probes": ProbesConfig.schema,
+                    "field_output": ProbesConfig.fieldOutputSchema
                 ]),
                 "required": .stringArray(["material_coefficient", "num_eigenmodes", "bcs"])
             ])
@@ -182,6 +188,8 @@ public struct EigenvalueTool: Tool {
             )
         }
 
+        try decoded.config.probes?.validate()
+
         return decoded
     }
 
@@ -23,8 +23,12 @@ private struct ElastodynamicsConfig: Codable, Equatable, Sendable {
     let tFinal: Double
     let order: Int?
     let outputIntervalSteps: Int?
+    let outputIntervalTime: Double?
+    let timeStepping: TimeSteppingConfig?
     let initialCondition: ElastodynamicsInitialCondition
     let bcs: [ElastodynamicsBoundaryCondition]
+    let probes: ProbesConfig?
+    let fieldOutput: Bool?
 
     enum CodingKeys: String, CodingKey {
         case density
@@ -34,8 +38,12 @@ private struct ElastodynamicsConfig: Codable, Equatable, Sendable {
         case tFinal = "t_final"
         case order
         case outputIntervalSteps = "output_interval_steps"
+        case outputIntervalTime = "output_interval_time"
+        case timeStepping = "time_stepping"
         case initialCondition = "initial_condition"
         case bcs
+        case probes
+        case fieldOutput = "field_output"
     }
 }
 
@@ -114,6 +122,8 @@ public struct ElastodynamicsTool: Tool {
                     "poisson_ratio": .object(["type": .string("number")]),
                     "dt": .object(["type": .string("number")]),
                     "t_final": .object(["type": .string("number")]),
+                    "output_interval_time": TimeSteppingConfig.outputIntervalTimeSchema,
+                    "time_stepping": TimeSteppingConfig.schema,
                     "order": .object(["type": .string("integer")]),
                     "output_interval_steps": .object(["type": .string("integer")]),
                     "initial_condition": .object([
@@ -148,7 +158,9 @@ public struct ElastodynamicsTool: Tool {
                             ]),
                             "required": .stringArray(["attribute", "type"])
                         ])
-                    ])
+                    ]),
+                    "probes": ProbesConfig.schema,
+                    "field_output": ProbesConfig.fieldOutputSchema
                 ]),
                 "required": .stringArray([
                     "density",
@@ -231,6 +243,8 @@ public struct ElastodynamicsTool: Tool {
         if let outputIntervalSteps = decoded.config.outputIntervalSteps, outputIntervalSteps <= 0 {
             throw AutoSageError(code: "invalid_input", message: "config.output_interval_steps must be > 0.")
         }
+        try TimeSteppingConfig.validateOutputIntervalTime(decoded.config.outputIntervalTime)
+        try decoded.config.timeStepping?.validate()
         if decoded.config.initialCondition.displacement.isEmpty {
             throw AutoSageError(code: "invalid_input", message: "config.initial_condition.displacement must not be empty.")
         }
@@ -265,6 +279,8 @@ public struct ElastodynamicsTool: Tool {
             throw AutoSageError(code: "invalid_input", message: "config.bcs must include at least one fixed boundary condition.")
         }
 
+        try decoded.config.probes?.validate()
+
         return decoded
     }
 
@@ -13,12 +13,16 @@ private struct ElectromagneticModalConfig: Codable, Equatable, Sendable {
     let permeability: Double
     let numModes: Int
     let bcs: [ElectromagneticModalBoundaryCondition]
+    let probes: ProbesConfig?
+    let fieldOutput: Bool?
 
     enum CodingKeys: String, CodingKey {
         case permittivity
         case permeability
         case numModes = "num_modes"
         case bcs
+        case probes
+        case fieldOutput = "field_output"
     }
 }
 
@@ -108,7 +112,9 @@ public struct ElectromagneticModalTool: Tool {
                             ]),
                             "required": .stringArray(["attribute", "type"])
                         ])
-                    ])
+                    ]),
+                    "probes": ProbesConfig.schema,
+                    "field_output": ProbesConfig.fieldOutputSchema
                 ]),
                 "required": .stringArray(["permittivity", "permeability", "num_modes", "bcs"])
             ])
@@ -193,6 +199,8 @@ public struct ElectromagneticModalTool: Tool {
             )
         }
 
+        try decoded.config.probes?.validate()
+
         return decoded
     }
 
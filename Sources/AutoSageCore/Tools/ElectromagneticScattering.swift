@@ -27,6 +27,8 @@ private struct ElectromagneticScatteringConfig: Codable, Equatable, Sendable {
     let pmlAttributes: [Int]
     let sourceCurrent: ElectromagneticScatteringSourceCurrent?
     let bcs: [ElectromagneticScatteringBoundaryCondition]
+    let probes: ProbesConfig?
+    let fieldOutput: Bool?
 
     enum CodingKeys: String, CodingKey {
         case frequency
@@ -35,6 +37,8 @@ private struct ElectromagneticScatteringConfig: Codable, Equatable, Sendable {
         case pmlAttributes = "pml_attributes"
         case sourceCurrent = "source_current"
         case bcs
+        case probes
+        case fieldOutput = "field_output"
     }
 }
 
@@ -147,7 +151,9 @@ public struct ElectromagneticScatteringTool: Tool {
                             ]),
                             "required": .stringArray(["attribute", "type"])
                         ])
-                    ])
+                    ]),
+                    "probes": ProbesConfig.schema,
+                    "field_output": ProbesConfig.fieldOutputSchema
                 ]),
                 "required": .stringArray(["frequency", "permittivity", "permeability", "pml_attributes", "bcs"]),
                 "additionalProperties": .bool(true)
@@ -250,6 +256,8 @@ public struct ElectromagneticScatteringTool: Tool {
             }
         }
 
+        try decoded.config.probes?.validate()
+
         return decoded
     }
 
@@ -13,12 +13,16 @@ private struct ElectromagneticsConfig: Codable, Equatable, Sendable {
     let kappa: Double
     let currentDensity: [Double]?
     let bcs: [ElectromagneticsBoundaryCondition]
+    let probes: ProbesConfig?
+    let fieldOutput: Bool?
 
     enum CodingKeys: String, CodingKey {
         case permeability
         case kappa
         case currentDensity = "current_density"
         case bcs
+        case probes
+        case fieldOutput = "field_output"
     }
 }
 
@@ -111,7 +115,9 @@ public struct ElectromagneticsTool: Tool {
                             ]),
                             "required": .stringArray(["attribute", "type"])
                         ])
-                    ])
+                    ]),
+                    "probes": ProbesConfig.schema,
+                    "field_output": ProbesConfig.fieldOutputSchema
                 ]),
                 "required": .stringArray(["permeability", "kappa", "bcs"])
             ])
@@ -191,6 +197,8 @@ public struct ElectromagneticsTool: Tool {
             )
         }
 
+        try decoded.config.probes?.validate()
+
         return decoded
     }
 
@@ -13,11 +13,15 @@ private struct ElectrostaticsConfig: Codable, Equatable, Sendable {
     let permittivity: Double
     let chargeDensity: Double?
     let bcs: [ElectrostaticsBoundaryCondition]
+    let probes: ProbesConfig?
+    let fieldOutput: Bool?
 
     enum CodingKeys: String, CodingKey {
         case permittivity
         case chargeDensity = "charge_density"
         case bcs
+        case probes
+        case fieldOutput = "field_output"
     }
 }
 
@@ -107,7 +111,9 @@ public struct ElectrostaticsTool: Tool {
                             ]),
                             "required": .stringArray(["attribute", "type", "value"])
                         ])
-                    ])
+                    ]),
+                    "probes": ProbesConfig.schema,
+                    "field_output": ProbesConfig.fieldOutputSchema
                 ]),
                 "required": .stringArray(["permittivity", "bcs"])
             ])
@@ -183,6 +189,8 @@ public struct ElectrostaticsTool: Tool {
             )
         }
 
+        try decoded.config.probes?.validate()
+
         return decoded
     }
 
@@ -14,12 +14,16 @@ private struct FractionalPDEConfig: Codable, Equatable, Sendable {
     let numPoles: Int
     let sourceTerm: Double?
     let bcs: [FractionalPDEBoundaryCondition]
+    let probes: ProbesConfig?
+    let fieldOutput: Bool?
 
     enum CodingKeys: String, CodingKey {
         case alpha
         case numPoles = "num_poles"
         case sourceTerm = "source_term"
         case bcs
+        case probes
+        case fieldOutput = "field_output"
     }
 }
 
@@ -110,7 +114,9 @@ public struct FractionalPDETool: Tool {
                             ]),
                             "required": .stringArray(["attribute", "type", "value"])
                         ])
-                    ])
+                    ]),
+                    "probes": ProbesConfig.schema,
+                    "field_output": ProbesConfig.fieldOutputSchema
                 ]),
                 "required": .stringArray(["alpha", "num_poles", "bcs"])
             ])
@@ -187,6 +193,8 @@ public struct FractionalPDETool: Tool {
             }
         }
 
+        try decoded.config.probes?.validate()
+
         return decoded
     }
 
@@ -15,7 +15,11 @@ private struct HeatConfig: Codable, Equatable, Sendable {
     let initialTemperature: Double
     let dt: Double
     let tFinal: Double
+    let outputIntervalTime: Double?
+    let timeStepping: TimeSteppingConfig?
     let bcs: [HeatBoundaryCondition]
+    let probes: ProbesConfig?
+    let fieldOutput: Bool?
 
     enum CodingKeys: String, CodingKey {
         case conductivity
@@ -23,7 +27,11 @@ private struct HeatConfig: Codable, Equatable, Sendable {
         case initialTemperature = "initial_temperature"
         case dt
         case tFinal = "t_final"
+        case outputIntervalTime = "output_interval_time"
+        case timeStepping = "time_stepping"
         case bcs
+        case probes
+        case fieldOutput = "field_output"
     }
 }
 
@@ -102,6 +110,8 @@ public struct HeatTool: Tool {
                     "initial_temperature": .object(["type": .string("number")]),
                     "dt": .object(["type": .string("number")]),
                     "t_final": .object(["type": .string("number")]),
+                    "output_interval_time": TimeSteppingConfig.outputIntervalTimeSchema,
+                    "time_stepping": TimeSteppingConfig.schema,
                     "bcs": .object([
                         "type": .string("array"),
                         "items": .object([
@@ -116,7 +126,9 @@ public struct HeatTool: Tool {
                             ]),
                             "required": .stringArray(["attribute", "type", "value"])
                         ])
-                    ])
+                    ]),
+                    "probes": ProbesConfig.schema,
+                    "field_output": ProbesConfig.fieldOutputSchema
                 ]),
                 "required": .stringArray(["conductivity", "specific_heat", "initial_temperature", "dt", "t_final", "bcs"])
             ])
@@ -176,6 +188,8 @@ public struct HeatTool: Tool {
         if decoded.config.tFinal <= 0 {
             throw AutoSageError(code: "invalid_input", message: "config.t_final must be > 0.")
         }
+        try TimeSteppingConfig.validateOutputIntervalTime(decoded.config.outputIntervalTime)
+        try decoded.config.timeStepping?.validate()
 
         for boundary in decoded.config.bcs {
             guard boundary.attribute > 0 else {
@@ -190,6 +204,8 @@ public struct HeatTool: Tool {
             }
         }
 
+        try decoded.config.probes?.validate()
+
         return decoded
     }
 
@@ -14,12 +14,16 @@ private struct HyperelasticConfig: Codable, Equatable, Sendable {
     let bulkModulus: Double
     let bodyForce: [Double]?
     let bcs: [HyperelasticBoundaryCondition]
+    let probes: ProbesConfig?
+    let fieldOutput: Bool?
 
     enum CodingKeys: String, CodingKey {
         case shearModulus = "shear_modulus"
         case bulkModulus = "bulk_modulus"
         case bodyForce = "body_force"
         case bcs
+        case probes
+        case fieldOutput = "field_output"
     }
 }
 
@@ -116,7 +120,9 @@ public struct HyperelasticityTool: Tool {
                             ]),
                             "required": .stringArray(["attribute", "type"])
                         ])
-                    ])
+                    ]),
+                    "probes": ProbesConfig.schema,
+                    "field_output": ProbesConfig.fieldOutputSchema
                 ]),
                 "required": .stringArray(["shear_modulus", "bulk_modulus", "bcs"])
             ])
@@ -217,6 +223,8 @@ public struct HyperelasticityTool: Tool {
             }
         }
 
+        try decoded.config.probes?.validate()
+
         return decoded
     }
 
@@ -14,12 +14,16 @@ private struct IncompressibleElasticityConfig: Codable, Equatable, Sendable {
     let bulkModulus: Double
     let order: Int?
     let bcs: [IncompressibleElasticityBoundaryCondition]
+    let probes: ProbesConfig?
+    let fieldOutput: Bool?
 
     enum CodingKeys: String, CodingKey {
         case shearModulus = "shear_modulus"
         case bulkModulus = "bulk_modulus"
         case order
         case bcs
+        case probes
+        case fieldOutput = "field_output"
     }
 }
 
@@ -113,7 +117,9 @@ public struct IncompressibleElasticityTool: Tool {
                             ]),
                             "required": .stringArray(["attribute", "type"])
                         ])
-                    ])
+                    ]),
+                    "probes": ProbesConfig.schema,
+                    "field_output": ProbesConfig.fieldOutputSchema
                 ]),
                 "required": .stringArray(["shear_modulus", "bulk_modulus", "bcs"])
             ])
@@ -211,6 +217,8 @@ public struct IncompressibleElasticityTool: Tool {
             )
         }
 
+        try decoded.config.probes?.validate()
+
         return decoded
     }
 
@@ -9,13 +9,34 @@ private struct JouleHeatingBoundaryCondition: Codable, Equatable, Sendable {
     let value: Double
 }
 
+private struct JouleHeatingCoupling: Codable, Equatable, Sendable {
+    let electricIntervalSteps: Int?
+    let temperatureChangeTolerance: Double?
+    let picardMaxIterations: Int?
+    let picardTolerance: Double?
+
+    enum CodingKeys: String, CodingKey {
+        case electricIntervalSteps = "electric_interval_steps"
+        case temperatureChangeTolerance = "temperature_change_tolerance"
+        case picardMaxIterations = "picard_max_iterations"
+        case picardTolerance = "picard_tolerance"
+    }
+}
+
 private struct JouleHeatingConfig: Codable, Equatable, Sendable {
     let electricalConductivity: Double
     let thermalConductivity: Double
     let heatCapacity: Double
     let dt: Double
     let tFinal: Double
+    let temperatureCoefficient: Double?
+    let referenceTemperature: Double?
+    let coupling: JouleHeatingCoupling?
+    let outputIntervalTime: Double?
+    let timeStepping: TimeSteppingConfig?
     let bcs: [JouleHeatingBoundaryCondition]
+    let probes: ProbesConfig?
+    let fieldOutput: Bool?
 
     enum CodingKeys: String, CodingKey {
         case electricalConductivity = "electrical_conductivity"
@@ -23,7 +44,14 @@ private struct JouleHeatingConfig: Codable, Equatable, Sendable {
         case heatCapacity = "heat_capacity"
         case dt
         case tFinal = "t_final"
+        case temperatureCoefficient = "temperature_coefficient"
+        case referenceTemperature = "reference_temperature"
+        case coupling
+        case outputIntervalTime = "output_interval_time"
+        case timeStepping = "time_stepping"
         case bcs
+        case probes
+        case fieldOutput = "field_output"
     }
 }
 
@@ -102,6 +130,22 @@ public struct JouleHeatingTool: Tool {
                     "heat_capacity": .object(["type": .string("number")]),
                     "dt": .object(["type": .string("number")]),
                     "t_final": .object(["type": .string("number")]),
+                    "temperature_coefficient": .object([
+                        "type": .string("number"),
+                        "description": .string("Linear resistivity coefficient alpha in 1/K; 0 keeps the conductivity constant.")
+                    ]),
+                    "reference_temperature": .object(["type": .string("number")]),
+                    "output_interval_time": TimeSteppingConfig.outputIntervalTimeSchema,
+                    "time_stepping": TimeSteppingConfig.schema,
+                    "coupling": .object([
+                        "type": .string("object"),
+                        "properties": .object([
+                            "electric_interval_steps": .object(["type": .string("integer")]),
+                            "temperature_change_tolerance": .object(["type": .string("number")]),
+                            "picard_max_iterations": .object(["type": .string("integer")]),
+                            "picard_tolerance": .object(["type": .string("number")])
+                        ])
+                    ]),
                     "bcs": .object([
                         "type": .string("array"),
                         "items": .object([
@@ -116,7 +160,9 @@ public struct JouleHeatingTool: Tool {
                             ]),
                             "required": .stringArray(["attribute", "type", "value"])
                         ])
-                    ])
+                    ]),
+                    "probes": ProbesConfig.schema,
+                    "field_output": ProbesConfig.fieldOutputSchema
                 ]),
                 "required": .stringArray([
                     "electrical_conductivity",
@@ -188,6 +234,31 @@ public struct JouleHeatingTool: Tool {
         guard decoded.config.tFinal > 0 else {
             throw AutoSageError(code: "invalid_input", message: "config.t_final must be > 0.")
         }
+        try TimeSteppingConfig.validateOutputIntervalTime(decoded.config.outputIntervalTime)
+        try decoded.config.timeStepping?.validate()
+        if let coupling = decoded.config.coupling {
+            if let interval = coupling.electricIntervalSteps, interval <= 0 {
+                throw AutoSageError(
+                    code: "invalid_input",
+                    message: "config.coupling.electric_interval_steps must be an integer > 0."
+                )
+            }
+            if let tolerance = coupling.temperatureChangeTolerance, tolerance < 0 {
+                throw AutoSageError(
+                    code: "invalid_input",
+                    message: "config.coupling.temperature_change_tolerance must be a number >= 0."
+                )
+            }
+            if let iterations = coupling.picardMaxIterations, iterations <= 0 {
+                throw AutoSageError(
+                    code: "invalid_input",
+                    message: "config.coupling.picard_max_iterations must be an integer > 0."
+                )
+            }
+            if let tolerance = coupling.picardTolerance, !(tolerance > 0) {
+                throw AutoSageError(code: "invalid_input", message: "config.coupling.picard_tolerance must be > 0.")
+            }
+        }
 
         var hasElectricDirichlet = false
         var hasThermalDirichlet = false
@@ -223,6 +294,8 @@ public struct JouleHeatingTool: Tool {
             )
         }
 
+        try decoded.config.probes?.validate()
+
         return decoded
     }
 
@@ -12,11 +12,15 @@ private struct MagnetostaticsConfig: Codable, Equatable, Sendable {
     let permeability: Double
     let currentDensity: [Double]?
     let bcs: [MagnetostaticsBoundaryCondition]
+    let probes: ProbesConfig?
+    let fieldOutput: Bool?
 
     enum CodingKeys: String, CodingKey {
         case permeability
         case currentDensity = "current_density"
         case bcs
+        case probes
+        case fieldOutput = "field_output"
     }
 }
 
@@ -108,7 +112,9 @@ public struct MagnetostaticsTool: Tool {
                             ]),
                             "required": .stringArray(["attribute", "type"])
                         ])
-                    ])
+                    ]),
+                    "probes": ProbesConfig.schema,
+                    "field_output": ProbesConfig.fieldOutputSchema
                 ]),
                 "required": .stringArray(["permeability", "bcs"])
             ])
@@ -183,6 +189,8 @@ public struct MagnetostaticsTool: Tool {
             )
         }
 
+        try decoded.config.probes?.validate()
+
         return decoded
     }
 
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: MIT
+// AutoSage probe output options shared by MFEM driver tools.
+
+import Foundation
+
+struct PointProbeConfig: Codable, Equatable, Sendable {
+    let name: String?
+    let field: String
+    let position: [Double]
+}
+
+struct BoundaryProbeConfig: Codable, Equatable, Sendable {
+    let name: String?
+    let field: String
+    let attribute: Int
+    let quantity: String?
+}
+
+/// `config.probes`: point values and boundary functionals sampled at every
+/// output cycle into probes.csv (or probes.bin with `format` binary).
+struct ProbesConfig: Codable, Equatable, Sendable {
+    let points: [PointProbeConfig]?
+    let boundary: [BoundaryProbeConfig]?
+    let format: String?
+
+    static let schema: JSONValue = .object([
+        "type": .string("object"),
+        "description": .string("Sample output fields at points and over boundaries into a compact time series."),
+        "properties": .object([
+            "points": .object([
+                "type": .string("array"),
+                "items": .object([
+                    "type": .string("object"),
+                    "properties": .object([
+                        "name": .object(["type": .string("string")]),
+                        "field": .object(["type": .string("string")]),
+                        "position": .object([
+                            "type": .string("array"),
+                            "items": .object(["type": .string("number")])
+                        ])
+                    ]),
+                    "required": .stringArray(["field", "position"])
+                ])
+            ]),
+            "boundary": .object([
+                "type": .string("array"),
+                "items": .object([
+                    "type": .string("object"),
+                    "properties": .object([
+                        "name": .object(["type": .string("string")]),
+                        "field": .object(["type": .string("string")]),
+                        "attribute": .object(["type": .string("integer")]),
+                        "quantity": .object([
+                            "type": .string("string"),
+                            "enum": .stringArray(["integral", "average", "flux"])
+                        ])
+                    ]),
+                    "required": .stringArray(["field", "attribute"])
+                ])
+            ]),
+            "format": .object([
+                "type": .string("string"),
+                "enum": .stringArray(["csv", "binary"])
+            ])
+        ])
+    ])
+
+    static let fieldOutputSchema: JSONValue = .object([
+        "type": .string("boolean"),
+        "description": .string("Set to false to skip full-field ParaView output; probes are still written.")
+    ])
+
+    func validate() throws {
+        let points = points ?? []
+        let boundary = boundary ?? []
+        if points.isEmpty && boundary.isEmpty {
+            throw AutoSageError(
+                code: "invalid_input",
+                message: "config.probes must list at least one point or boundary probe."
+            )
+        }
+        if let format, format != "csv" && format != "binary" {
+            throw AutoSageError(code: "invalid_input", message: "config.probes.format must be csv or binary.")
+        }
+        for point in points {
+            if point.field.isEmpty {
+                throw AutoSageError(code: "invalid_input", message: "config.probes.points[].field must be non-empty.")
+            }
+            if point.position.isEmpty || point.position.count > 3 {
+                throw AutoSageError(
+                    code: "invalid_input",
+                    message: "config.probes.points[].position must have 1 to 3 coordinates."
+                )
+            }
+        }
+        for probe in boundary {
+            if probe.field.isEmpty {
+                throw AutoSageError(code: "invalid_input", message: "config.probes.boundary[].field must be non-empty.")
+            }
+            if probe.attribute < 1 {
+                throw AutoSageError(code: "invalid_input", message: "config.probes.boundary[].attribute must be >= 1.")
+            }
+            if let quantity = probe.quantity, !["integral", "average", "flux"].contains(quantity) {
+                throw AutoSageError(
+                    code: "invalid_input",
+                    message: "config.probes.boundary[].quantity must be integral, average, or flux."
+                )
+            }
+        }
+    }
+}
@@ -9,15 +9,30 @@ private struct StokesBoundaryCondition: Codable, Equatable, Sendable {
     let velocity: [Double]?
 }
 
+private struct StokesInflowOverride: Codable, Equatable, Sendable {
+    let attribute: Int
+    let velocity: [Double]
+}
+
 private struct StokesConfig: Codable, Equatable, Sendable {
     let dynamicViscosity: Double
     let bodyForce: [Double]?
     let bcs: [StokesBoundaryCondition]
+    let blockPreconditioner: String?
+    let schurComplement: String?
+    let inflowCases: [[StokesInflowOverride]]?
+    let probes: ProbesConfig?
+    let fieldOutput: Bool?
 
     enum CodingKeys: String, CodingKey {
         case dynamicViscosity = "dynamic_viscosity"
         case bodyForce = "body_force"
         case bcs
+        case blockPreconditioner = "block_preconditioner"
+        case schurComplement = "schur_complement"
+        case inflowCases = "inflow_cases"
+        case probes
+        case fieldOutput = "field_output"
     }
 }
 
@@ -113,7 +128,34 @@ public struct StokesTool: Tool {
                             ]),
                             "required": .stringArray(["attribute", "type"])
                         ])
-                    ])
+                    ]),
+                    "block_preconditioner": .object([
+                        "type": .string("string"),
+                        "enum": .stringArray(["diagonal", "triangular"])
+                    ]),
+                    "schur_complement": .object([
+                        "type": .string("string"),
+                        "enum": .stringArray(["mass_jacobi", "mass_amg", "mass_chebyshev", "lsc"])
+                    ]),
+                    "inflow_cases": .object([
+                        "type": .string("array"),
+                        "items": .object([
+                            "type": .string("array"),
+                            "items": .object([
+                                "type": .string("object"),
+                                "properties": .object([
+                                    "attribute": .object(["type": .string("integer")]),
+                                    "velocity": .object([
+                                        "type": .string("array"),
+                                        "items": .object(["type": .string("number")])
+                                    ])
+                                ]),
+                                "required": .stringArray(["attribute", "velocity"])
+                            ])
+                        ])
+                    ]),
+                    "probes": ProbesConfig.schema,
+                    "field_output": ProbesConfig.fieldOutputSchema
                 ]),
                 "required": .stringArray(["dynamic_viscosity", "bcs"])
             ])
@@ -190,6 +232,24 @@ public struct StokesTool: Tool {
             }
         }
 
+        if let blockPreconditioner = decoded.config.blockPreconditioner {
+            let normalized = blockPreconditioner.trimmingCharacters(in: .whitespacesAndNewlines).lowercased()
+            guard normalized == "diagonal" || normalized == "triangular" else {
+                throw AutoSageError(code: "invalid_input", message: "config.block_preconditioner must be diagonal or triangular.")
+            }
+        }
+        if let schurComplement = decoded.config.schurComplement {
+            let normalized = schurComplement.trimmingCharacters(in: .whitespacesAndNewlines).lowercased()
+            guard ["mass_jacobi", "mass_amg", "mass_chebyshev", "lsc"].contains(normalized) else {
+                throw AutoSageError(
+                    code: "invalid_input",
+                    message: "config.schur_complement must be mass_jacobi, mass_amg, mass_chebyshev or lsc."
+                )
+            }
+        }
+
+        try decoded.config.probes?.validate()
+
         return decoded
     }
 
@@ -14,6 +14,8 @@ private struct StructuralModalConfig: Codable, Equatable, Sendable {
     let poissonRatio: Double
     let numModes: Int
     let bcs: [StructuralModalBoundaryCondition]
+    let probes: ProbesConfig?
+    let fieldOutput: Bool?
 
     enum CodingKeys: String, CodingKey {
         case density
@@ -21,6 +23,8 @@ private struct StructuralModalConfig: Codable, Equatable, Sendable {
         case poissonRatio = "poisson_ratio"
         case numModes = "num_modes"
         case bcs
+        case probes
+        case fieldOutput = "field_output"
     }
 }
 
@@ -111,7 +115,9 @@ public struct StructuralModalTool: Tool {
                             ]),
                             "required": .stringArray(["attribute", "type"])
                         ])
-                    ])
+                    ]),
+                    "probes": ProbesConfig.schema,
+                    "field_output": ProbesConfig.fieldOutputSchema
                 ]),
                 "required": .stringArray(["density", "youngs_modulus", "poisson_ratio", "num_modes", "bcs"])
             ])
@@ -194,6 +200,8 @@ public struct StructuralModalTool: Tool {
             )
         }
 
+        try decoded.config.probes?.validate()
+
         return decoded
     }
 
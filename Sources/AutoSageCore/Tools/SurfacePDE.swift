@@ -14,12 +14,16 @@ private struct SurfacePDEConfig: Codable, Equatable, Sendable {
     let sourceTerm: Double?
     let isClosedSurface: Bool?
     let bcs: [SurfacePDEBoundaryCondition]
+    let probes: ProbesConfig?
+    let fieldOutput: Bool?
 
     enum CodingKeys: String, CodingKey {
         case diffusionCoefficient = "diffusion_coefficient"
         case sourceTerm = "source_term"
         case isClosedSurface = "is_closed_surface"
         case bcs
+        case probes
+        case fieldOutput = "field_output"
     }
 }
 
@@ -110,7 +114,9 @@ public struct SurfacePDETool: Tool {
                             ]),
                             "required": .stringArray(["attribute", "type", "value"])
                         ])
-                    ])
+                    ]),
+                    "probes": ProbesConfig.schema,
+                    "field_output": ProbesConfig.fieldOutputSchema
                 ]),
                 "required": .stringArray(["diffusion_coefficient", "bcs"])
             ])
@@ -187,6 +193,8 @@ public struct SurfacePDETool: Tool {
             )
         }
 
+        try decoded.config.probes?.validate()
+
         return decoded
     }
 
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: MIT
+// AutoSage time-stepping options shared by transient MFEM driver tools.
+
+import Foundation
+
+/// `config.time_stepping` for HeatTransfer, JouleHeating and Elastodynamics.
+/// Without `adaptive` every step uses `config.dt`.
+struct TimeSteppingConfig: Codable, Equatable, Sendable {
+    let adaptive: Bool?
+    let relTol: Double?
+    let absTol: Double?
+    let dtMin: Double?
+    let dtMax: Double?
+    let safety: Double?
+    let maxGrowth: Double?
+    let dtRebuildBand: Double?
+    let maxRejections: Int?
+
+    enum CodingKeys: String, CodingKey {
+        case adaptive
+        case relTol = "rel_tol"
+        case absTol = "abs_tol"
+        case dtMin = "dt_min"
+        case dtMax = "dt_max"
+        case safety
+        case maxGrowth = "max_growth"
+        case dtRebuildBand = "dt_rebuild_band"
+        case maxRejections = "max_rejections"
+    }
+
+    static let schema: JSONValue = .object([
+        "type": .string("object"),
+        "description": .string("Adaptive backward Euler with an embedded error estimate; config.dt is the initial step."),
+        "properties": .object([
+            "adaptive": .object(["type": .string("boolean")]),
+            "rel_tol": .object(["type": .string("number")]),
+            "abs_tol": .object(["type": .string("number")]),
+            "dt_min": .object(["type": .string("number")]),
+            "dt_max": .object(["type": .string("number")]),
+            "safety": .object(["type": .string("number")]),
+            "max_growth": .object(["type": .string("number")]),
+            "dt_rebuild_band": .object(["type": .string("number")]),
+            "max_rejections": .object(["type": .string("integer")])
+        ])
+    ])
+
+    static let outputIntervalTimeSchema: JSONValue = .object([
+        "type": .string("number"),
+        "description": .string("Write output at this simulated-time interval instead of every output_interval_steps steps.")
+    ])
+
+    func validate() throws {
+        if let relTol, relTol <= 0 {
+            throw AutoSageError(code: "invalid_input", message: "config.time_stepping.rel_tol must be > 0.")
+        }
+        if let absTol, absTol <= 0 {
+            throw AutoSageError(code: "invalid_input", message: "config.time_stepping.abs_tol must be > 0.")
+        }
+        if let dtMin, dtMin < 0 {
+            throw AutoSageError(code: "invalid_input", message: "config.time_stepping.dt_min must be >= 0.")
+        }
+        if let dtMax, dtMax < 0 {
+            throw AutoSageError(code: "invalid_input", message: "config.time_stepping.dt_max must be >= 0.")
+        }
+        if let dtMin, let dtMax, dtMin > 0, dtMax > 0, dtMin > dtMax {
+            throw AutoSageError(code: "invalid_input", message: "config.time_stepping.dt_min must not exceed dt_max.")
+        }
+        if let safety, !(safety > 0 && safety <= 1) {
+            throw AutoSageError(code: "invalid_input", message: "config.time_stepping.safety must be in (0, 1].")
+        }
+        if let maxGrowth, maxGrowth <= 1 {
+            throw AutoSageError(code: "invalid_input", message: "config.time_stepping.max_growth must be > 1.")
+        }
+        if let dtRebuildBand, !(dtRebuildBand >= 0 && dtRebuildBand < 1) {
+            throw AutoSageError(code: "invalid_input", message: "config.time_stepping.dt_rebuild_band must be in [0, 1).")
+        }
+        if let maxRejections, maxRejections < 1 {
+            throw AutoSageError(code: "invalid_input", message: "config.time_stepping.max_rejections must be >= 1.")
+        }
+    }
+
+    static func validateOutputIntervalTime(_ value: Double?) throws {
+        if let value, value <= 0 {
+            throw AutoSageError(code: "invalid_input", message: "config.output_interval_time must be > 0.")
+        }
+    }
+}
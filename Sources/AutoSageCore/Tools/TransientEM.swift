@@ -22,8 +22,12 @@ private struct TransientEMConfig: Codable, Equatable, Sendable {
     let tFinal: Double
     let order: Int?
     let outputIntervalSteps: Int?
+    let timeIntegration: String?
+    let cfl: Double?
     let initialCondition: TransientEMInitialCondition
     let bcs: [TransientEMBoundaryCondition]
+    let probes: ProbesConfig?
+    let fieldOutput: Bool?
 
     enum CodingKeys: String, CodingKey {
         case permittivity
@@ -33,8 +37,12 @@ private struct TransientEMConfig: Codable, Equatable, Sendable {
         case tFinal = "t_final"
         case order
         case outputIntervalSteps = "output_interval_steps"
+        case timeIntegration = "time_integration"
+        case cfl
         case initialCondition = "initial_condition"
         case bcs
+        case probes
+        case fieldOutput = "field_output"
     }
 }
 
@@ -113,6 +121,12 @@ public struct TransientEMTool: Tool {
                     "conductivity": .object(["type": .string("number")]),
                     "dt": .object(["type": .string("number")]),
                     "t_final": .object(["type": .string("number")]),
+                    "time_integration": .object([
+                        "type": .string("string"),
+                        "enum": .stringArray(["implicit", "explicit"]),
+                        "description": .string("explicit uses a lumped mass and CFL-limited central-difference substeps.")
+                    ]),
+                    "cfl": .object(["type": .string("number")]),
                     "order": .object(["type": .string("integer")]),
                     "output_interval_steps": .object(["type": .string("integer")]),
                     "initial_condition": .object([
@@ -146,7 +160,9 @@ public struct TransientEMTool: Tool {
                             ]),
                             "required": .stringArray(["attribute", "type"])
                         ])
-                    ])
+                    ]),
+                    "probes": ProbesConfig.schema,
+                    "field_output": ProbesConfig.fieldOutputSchema
                 ]),
                 "required": .stringArray([
                     "permittivity",
@@ -226,6 +242,15 @@ public struct TransientEMTool: Tool {
         if decoded.config.tFinal <= 0 {
             throw AutoSageError(code: "invalid_input", message: "config.t_final must be > 0.")
         }
+        if let timeIntegration = decoded.config.timeIntegration {
+            let normalized = timeIntegration.trimmingCharacters(in: .whitespacesAndNewlines).lowercased()
+            guard normalized == "implicit" || normalized == "explicit" else {
+                throw AutoSageError(code: "invalid_input", message: "config.time_integration must be implicit or explicit.")
+            }
+        }
+        if let cfl = decoded.config.cfl, !(cfl > 0 && cfl < 1) {
+            throw AutoSageError(code: "invalid_input", message: "config.cfl must be in (0, 1).")
+        }
         if let order = decoded.config.order, order < 1 {
             throw AutoSageError(code: "invalid_input", message: "config.order must be >= 1.")
         }
@@ -265,6 +290,8 @@ public struct TransientEMTool: Tool {
             )
         }
 
+        try decoded.config.probes?.validate()
+
         return decoded
     }
 